@@ -10,6 +10,9 @@
 #include "engine/services/renderer_service.h"
 #include "engine/services/asset_service.h"
 #include "engine/services/scene_service.h"
+#include "engine/services/memory_service.h"
+#include "engine/services/metrics_service.h"
+#include "engine/services/profiler_service.h"
 
 #ifndef SNUFF_NSCRIPTING
 #include "engine/services/script_service.h"
@@ -22,6 +25,9 @@
 
 #include <foundation/io/resources.h>
 #include <foundation/auxiliary/timer.h>
+#include <foundation/auxiliary/profiler.h>
+#include <foundation/memory/memory.h>
+#include <foundation/memory/allocator_registry.h>
 
 namespace snuffbox
 {
@@ -71,6 +77,7 @@ namespace snuffbox
     void Application::ApplyConfiguration()
     {
       foundation::Logger::SetVerbosity(config_.verbosity);
+      foundation::Logger::Start();
 
       Debug::LogVerbosity<1>(
         foundation::LogSeverity::kInfo,
@@ -119,6 +126,7 @@ namespace snuffbox
       WindowService* window = GetService<WindowService>();
 
       RendererService* renderer = GetService<RendererService>();
+      MetricsService* metrics = GetService<MetricsService>();
 
       window->BindResizeCallback([&](uint16_t width, uint16_t height)
       { 
@@ -132,17 +140,26 @@ namespace snuffbox
       foundation::Timer delta_time("delta_time");
       float dt = 0.0f;
 
+      foundation::Profiler::SetThreadName("Main");
+
       while (
         should_quit_ == false &&
         window->ProcessEvents() == false)
       {
+        foundation::Profiler::MarkFrame();
         delta_time.Start();
 
         Update(dt);
         renderer->Render(dt);
 
+        foundation::Memory::frame_allocator().Reset();
+        foundation::Memory::double_buffered_allocator().Reset();
+        foundation::AllocatorRegistry::EndFrame();
+
         delta_time.Stop();
         dt = delta_time.Elapsed(foundation::TimeUnits::kSecond);
+
+        metrics->EndFrame(dt);
       }
 
       Shutdown();
@@ -188,6 +205,11 @@ namespace snuffbox
 
       RegisterCVars();
 
+      if (config_.editor_mode == false)
+      {
+        GetService<AssetService>()->MountBuild();
+      }
+
       OnInitialize();
 
       return foundation::ErrorCodes::kSuccess;
@@ -207,6 +229,9 @@ namespace snuffbox
 
       CreateService<AssetService>();
       CreateService<SceneService>();
+      CreateService<MemoryService>();
+      CreateService<MetricsService>();
+      CreateService<ProfilerService>();
 
       CREATE_SCRIPT_SERVICE();
     }
@@ -288,10 +313,13 @@ namespace snuffbox
     //--------------------------------------------------------------------------
     void Application::Update(float dt)
     {
+      SNUFF_PROFILE_ZONE("Application::Update");
+
       GetService<InputService>()->Flush();
 
       for (size_t i = 0; i < services_.size(); ++i)
       {
+        SNUFF_PROFILE_ZONE(services_.at(i)->name().c_str());
         services_.at(i)->OnUpdate(*this, dt);
       }
 
@@ -327,6 +355,8 @@ namespace snuffbox
       ShutdownServices();
       foundation::Resources::Shutdown();
 
+      foundation::Logger::Stop();
+
       instance_ = nullptr;
     }
 
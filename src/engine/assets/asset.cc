@@ -1,4 +1,5 @@
 #include "engine/assets/asset.h"
+#include "engine/services/metrics_service.h"
 
 #include <foundation/auxiliary/logger.h>
 
@@ -47,6 +48,11 @@ namespace snuffbox
 
       is_loaded_ = LoadImpl(path_);
 
+      if (is_loaded_ == true)
+      {
+        MetricsService::assets_loaded().Add();
+      }
+
       for (size_t i = 0; i < dependencies_.size(); ++i)
       {
         dependencies_.at(i)->Load();
@@ -142,10 +148,12 @@ namespace snuffbox
     void SerializableAsset::SetName(const foundation::String& new_name)
     {
       memset(name, '\0', kMaxPathLength);
+      id = foundation::StringId();
 
       if (new_name.size() > 0)
       {
         memcpy(name, new_name.c_str(), new_name.size());
+        id = foundation::StringId(new_name);
       }
     }
   }
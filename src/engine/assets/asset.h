@@ -176,6 +176,7 @@ namespace snuffbox
 
       compilers::AssetTypes type; //!< The type of the asset
       char name[kMaxPathLength]; //!< The name of the asset
+      foundation::StringId id; //!< The interned name, to look the asset up
       IAsset* handle; //!< The handle to the asset
 
       /**
@@ -224,7 +225,7 @@ namespace snuffbox
       engine::AssetService* as = 
         engine::Application::Instance()->GetService<engine::AssetService>();
 
-      out->handle = as->Get(type, name);
+      out->handle = as->Get(type, out->id);
     }
   }
 }
\ No newline at end of file
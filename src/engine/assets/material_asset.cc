@@ -51,15 +51,13 @@ namespace snuffbox
       size_t len;
       const uint8_t* buffer = c.Data(&len);
 
-      foundation::String src(reinterpret_cast<const char*>(buffer), len);
-
       foundation::LoadArchive archive;
-      if (archive.FromJson(src) == false)
+      if (archive.FromBuffer(buffer, len) == false)
       {
         foundation::Logger::LogVerbosity<1>(
           foundation::LogChannel::kEngine,
           foundation::LogSeverity::kError,
-          "Could not load '{0}', an invalid JSON was provided",
+          "Could not load '{0}', an invalid archive was provided",
           path);
 
         return false;
@@ -52,7 +52,7 @@ namespace snuffbox
       PerNode = [&](Entity* parent, const CompilerNode& node)
       {
         Entity* current = foundation::Memory::Construct<Entity>(
-          &foundation::Memory::default_allocator());
+          &foundation::Memory::pool_allocator<Entity>("Entity"));
 
         current->set_name(node.name);
         current->GetComponent<TransformComponent>()->SetLocalPosition(
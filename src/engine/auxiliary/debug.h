@@ -31,7 +31,7 @@ namespace snuffbox
       static void Log(
         foundation::LogSeverity severity,
         const char* format,
-        Args... args);
+        const Args&... args);
 
       /**
       * @see Debug::Log
@@ -43,7 +43,7 @@ namespace snuffbox
       static void LogVerbosity(
         foundation::LogSeverity severity,
         const char* format,
-        Args... args);
+        const Args&... args);
 
       SCRIPT_FUNC() static void Log(const foundation::String& str);
       SCRIPT_FUNC() static void LogInfo(const foundation::String& str);
@@ -59,9 +59,9 @@ namespace snuffbox
     inline void Debug::Log(
       foundation::LogSeverity severity,
       const char* format,
-      Args... args)
+      const Args&... args)
     {
-      LogVerbosity<1>(severity, format, eastl::forward<Args>(args)...);
+      LogVerbosity<1>(severity, format, args...);
     }
 
     //--------------------------------------------------------------------------
@@ -69,13 +69,13 @@ namespace snuffbox
     inline void Debug::LogVerbosity(
       foundation::LogSeverity severity,
       const char* format,
-      Args... args)
+      const Args&... args)
     {
       foundation::Logger::LogVerbosity<V>(
         foundation::LogChannel::kEngine,
         severity,
         format,
-        eastl::forward<Args>(args)...);
+        args...);
     }
   }
 }
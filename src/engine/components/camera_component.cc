@@ -7,6 +7,7 @@
 
 #include <foundation/serialization/save_archive.h>
 #include <foundation/serialization/load_archive.h>
+#include <foundation/serialization/field_codec.h>
 
 #ifdef near
 #undef near
@@ -22,6 +23,8 @@
 #include <sparsed/camera_component.gen.cc>
 #endif
 
+#include <sparsed/camera_component.fields.cc>
+
 namespace snuffbox
 {
   namespace engine
@@ -158,25 +161,13 @@ namespace snuffbox
     //--------------------------------------------------------------------------
     void CameraComponent::Serialize(foundation::SaveArchive& archive) const
     {
-      archive(
-        SET_ARCHIVE_PROP(near_),
-        SET_ARCHIVE_PROP(far_),
-        SET_ARCHIVE_PROP(fov_),
-        SET_ARCHIVE_PROP(aspect_),
-        SET_ARCHIVE_PROP(orthographic_size_),
-        SET_ARCHIVE_PROP(projection_));
+      foundation::FieldCodec::Save(archive, SerializedFields(), this);
     }
 
     //--------------------------------------------------------------------------
     void CameraComponent::Deserialize(foundation::LoadArchive& archive)
     {
-      archive(
-        GET_ARCHIVE_PROP(near_),
-        GET_ARCHIVE_PROP(far_),
-        GET_ARCHIVE_PROP(fov_),
-        GET_ARCHIVE_PROP(aspect_),
-        GET_ARCHIVE_PROP(orthographic_size_),
-        GET_ARCHIVE_PROP(projection_));
+      foundation::FieldCodec::Load(archive, SerializedFields(), this);
     }
   }
 }
\ No newline at end of file
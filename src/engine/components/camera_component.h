@@ -3,6 +3,8 @@
 #include "engine/ecs/component.h"
 #include "engine/definitions/camera.h"
 
+#include <foundation/definitions/field_table.h>
+
 #include <glm/glm.hpp>
 
 #ifdef near
@@ -31,6 +33,7 @@ namespace snuffbox
     public:
 
       SCRIPT_NAME(CameraComponent);
+      SNUFF_FIELD_TABLE();
 
       /**
       * @see IComponent::IComponent
@@ -149,13 +152,16 @@ namespace snuffbox
 
     private:
 
-      float near_; //!< The near plane of the camera
-      float far_; //!< The far plane of the camera
-      float fov_; //!< The field of view of the camera
-      float aspect_; //!< The aspect ratio of the camera
-      float orthographic_size_; //!< The orthographic size of the camera
+      SNUFF_FIELD() float near_; //!< The near plane of the camera
+      SNUFF_FIELD() float far_; //!< The far plane of the camera
+      SNUFF_FIELD() float fov_; //!< The field of view of the camera
+      SNUFF_FIELD() float aspect_; //!< The aspect ratio of the camera
+      SNUFF_FIELD() float orthographic_size_; //!< The orthographic size
 
-      CameraProjection projection_; //!< The projection mode of the camera
+      /**
+      * @brief The projection mode of the camera
+      */
+      SNUFF_FIELD(enum) CameraProjection projection_;
 
       glm::mat4x4 projection_matrix_; //!< The camera's projection matrix
       glm::mat4x4 view_matrix_; //!< The camera's view matrix
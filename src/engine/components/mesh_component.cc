@@ -1,10 +1,14 @@
 #include "engine/components/mesh_component.h"
 #include "engine/assets/model_asset.h"
 
+#include <foundation/serialization/field_codec.h>
+
 #ifndef SNUFF_NSCRIPTING
 #include <sparsed/mesh_component.gen.cc>
 #endif
 
+#include <sparsed/mesh_component.fields.cc>
+
 namespace snuffbox
 {
   namespace engine
@@ -57,17 +61,15 @@ namespace snuffbox
     //--------------------------------------------------------------------------
     void MeshComponent::Serialize(foundation::SaveArchive& archive) const
     {
-      archive(
-        SET_ARCHIVE_PROP(asset_),
-        SET_ARCHIVE_PROP(scene_index_));
+      foundation::FieldCodec::Save(archive, SerializedFields(), this);
+      archive(SET_ARCHIVE_PROP(asset_));
     }
 
     //--------------------------------------------------------------------------
     void MeshComponent::Deserialize(foundation::LoadArchive& archive)
     {
-      archive(
-        GET_ARCHIVE_PROP(asset_),
-        GET_ARCHIVE_PROP(scene_index_));
+      foundation::FieldCodec::Load(archive, SerializedFields(), this);
+      archive(GET_ARCHIVE_PROP(asset_));
 
       if (asset_.handle != nullptr)
       {
@@ -4,6 +4,8 @@
 #include "engine/assets/asset.h"
 #include "engine/graphics/mesh.h"
 
+#include <foundation/definitions/field_table.h>
+
 namespace snuffbox
 {
   namespace engine
@@ -21,6 +23,7 @@ namespace snuffbox
     public:
 
       SCRIPT_NAME(MeshComponent);
+      SNUFF_FIELD_TABLE();
 
       /**
       * @see IComponent::IComponent
@@ -51,6 +54,9 @@ namespace snuffbox
 
       /**
       * @see ISerializable::Serialize
+      *
+      * @remarks The model asset is a SerializableAsset, which has no field
+      *          type and is archived by hand after the field table
       */
       void Serialize(foundation::SaveArchive& archive) const override;
 
@@ -62,7 +68,7 @@ namespace snuffbox
     private:
 
       SerializableAsset asset_; //!< The model asset
-      int scene_index_; //!< The scene index within the model asset
+      SNUFF_FIELD() int scene_index_; //!< The scene index within the model
 
       Mesh mesh_; //!< The currently set mesh
     };
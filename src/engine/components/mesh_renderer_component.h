@@ -65,6 +65,10 @@ namespace snuffbox
 
       /**
       * @see ISerializable::Serialize
+      *
+      * @remarks This component has no field table, as its only serialized
+      *          member is a list of SerializableAssets, which has no field
+      *          type
       */
       void Serialize(foundation::SaveArchive& archive) const override;
 
@@ -4,11 +4,14 @@
 
 #include <foundation/serialization/save_archive.h>
 #include <foundation/serialization/load_archive.h>
+#include <foundation/serialization/field_codec.h>
 
 #ifndef SNUFF_NSCRIPTING
 #include <sparsed/transform_component.gen.cc>
 #endif
 
+#include <sparsed/transform_component.fields.cc>
+
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/gtx/quaternion.hpp>
 #include <glm/gtc/matrix_transform.hpp>
@@ -521,12 +524,16 @@ namespace snuffbox
     //--------------------------------------------------------------------------
     void TransformComponent::Serialize(foundation::SaveArchive& archive) const
     {
+      const foundation::FieldTable& fields = SerializedFields();
+
+      // The rotation goes between position_ and scale_, to keep the order
+      // of the keys that were written before the field table existed
+      foundation::FieldCodec::Save(archive, fields, this, 0, 1);
+
       glm::vec3 rotation = GetRotationEuler();
+      archive(SET_ARCHIVE_PROP(rotation));
 
-      archive(
-        SET_ARCHIVE_PROP(position_),
-        SET_ARCHIVE_PROP(rotation),
-        SET_ARCHIVE_PROP(scale_));
+      foundation::FieldCodec::Save(archive, fields, this, 1, fields.count);
 
       foundation::Vector<Entity*> children;
       children.resize(children_.size());
@@ -542,19 +549,18 @@ namespace snuffbox
     //--------------------------------------------------------------------------
     void TransformComponent::Deserialize(foundation::LoadArchive& archive)
     {
-      glm::vec3 rotation;
+      foundation::FieldCodec::Load(archive, SerializedFields(), this);
 
-      archive(
-        GET_ARCHIVE_PROP(position_),
-        GET_ARCHIVE_PROP(rotation),
-        GET_ARCHIVE_PROP(scale_));
+      glm::vec3 rotation;
+      archive(GET_ARCHIVE_PROP(rotation));
 
       foundation::Vector<Entity*> children;
       size_t n = archive.GetArraySize("children");
 
       children.resize(n);
 
-      foundation::IAllocator* alloc = &foundation::Memory::default_allocator();
+      foundation::IAllocator* alloc =
+        &foundation::Memory::pool_allocator<Entity>("Entity");
 
       Entity* ent = nullptr;
 
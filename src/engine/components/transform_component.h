@@ -3,6 +3,7 @@
 #include "engine/ecs/component.h"
 
 #include <foundation/containers/vector.h>
+#include <foundation/definitions/field_table.h>
 
 #define GLM_FORCE_RADIANS
 #include <glm/glm.hpp>
@@ -43,6 +44,7 @@ namespace snuffbox
     public:
 
       SCRIPT_NAME(TransformComponent);
+      SNUFF_FIELD_TABLE();
 
       /**
       * @see IComponent::IComponent
@@ -377,10 +379,10 @@ namespace snuffbox
       */
       foundation::Vector<TransformComponent*> children_;
 
-      glm::vec3 position_; //!< The position of this transform component
+      SNUFF_FIELD() glm::vec3 position_; //!< The position of this transform
       glm::quat rotation_; //!< The rotation of this transform component
       glm::vec3 euler_angles_; //!< Euler angles to avoid wrapping around
-      glm::vec3 scale_; //!< The scale of this transform component
+      SNUFF_FIELD() glm::vec3 scale_; //!< The scale of this transform
       glm::mat4x4 local_to_world_; //!< The local to world matrix
       glm::mat4x4 world_to_local_; //!< The world to local matrix
 
@@ -18,7 +18,8 @@ namespace snuffbox
     //--------------------------------------------------------------------------
     CVarValue::CVarValue(const char* name, const char* description) :
       name_(name),
-      description_(description)
+      description_(description),
+      version_(0)
     {
 
     }
@@ -34,6 +35,14 @@ namespace snuffbox
           name_, 
           Usage());
       }
+
+      Changed();
+    }
+
+    //--------------------------------------------------------------------------
+    void CVarValue::Changed()
+    {
+      ++version_;
     }
 
     //--------------------------------------------------------------------------
@@ -48,6 +57,12 @@ namespace snuffbox
       return description_;
     }
 
+    //--------------------------------------------------------------------------
+    uint32_t CVarValue::version() const
+    {
+      return version_;
+    }
+
     //--------------------------------------------------------------------------
     CVarValue::~CVarValue()
     {
@@ -7,6 +7,7 @@
 #include <EASTL/type_traits.h>
 
 #include <cstdlib>
+#include <cinttypes>
 #include <cstring>
 #include <cctype>
 
@@ -101,6 +102,15 @@ namespace snuffbox
       */
       virtual const char* Usage() const = 0;
 
+      /**
+      * @brief Marks the value of this CVar as changed
+      *
+      * @see CVarValue::version
+      */
+      void Changed();
+
+    public:
+
       /**
       * @brief Sets the CVar value based on a string value
       *
@@ -110,8 +120,6 @@ namespace snuffbox
       */
       void Set(const char* value);
 
-    public:
-
       /**
       * @return The name of this CVar value
       */
@@ -122,6 +130,12 @@ namespace snuffbox
       */
       const foundation::String& description() const;
 
+      /**
+      * @return The number of times this CVar value was set, so that users
+      *         can cache the value and only refresh it when this changes
+      */
+      uint32_t version() const;
+
       /**
       * @brief Virtual destructor
       */
@@ -131,6 +145,7 @@ namespace snuffbox
 
       foundation::String name_; //!< The name of this CVar value
       foundation::String description_; //!< The description of this CVar value
+      uint32_t version_; //!< The number of times this CVar value was set
     };
 
     //--------------------------------------------------------------------------
@@ -328,6 +343,7 @@ namespace snuffbox
     inline void CVar<T>::set_value(const T& value)
     {
       value_ = value;
+      CVarValue::Changed();
     }
 
     //--------------------------------------------------------------------------
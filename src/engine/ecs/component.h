@@ -13,7 +13,7 @@ inline snuffbox::engine::IComponent*                                           \
 snuffbox::engine::IComponent::CreateComponent<id>(Entity* entity)              \
 {                                                                              \
   return snuffbox::foundation::Memory::Construct<type>(                        \
-    &snuffbox::foundation::Memory::default_allocator(),                        \
+    &snuffbox::foundation::Memory::pool_allocator<type>(#type),                \
     entity);                                                                   \
 }                                                                              
 
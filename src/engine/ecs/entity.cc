@@ -11,12 +11,15 @@
 
 #include <foundation/serialization/save_archive.h>
 #include <foundation/serialization/load_archive.h>
+#include <foundation/serialization/field_codec.h>
 
 #ifndef SNUFF_NSCRIPTING
 #include "engine/components/script_component.h"
 #include <sparsed/entity.gen.cc>
 #endif
 
+#include <sparsed/entity.fields.cc>
+
 namespace snuffbox
 {
   namespace engine
@@ -408,11 +411,7 @@ namespace snuffbox
     //--------------------------------------------------------------------------
     void Entity::Serialize(foundation::SaveArchive& archive) const
     {
-      archive(
-        SET_ARCHIVE_PROP(name_), 
-        SET_ARCHIVE_PROP(active_),
-        SET_ARCHIVE_PROP(uuid_),
-        SET_ARCHIVE_PROP(sort_index_));
+      foundation::FieldCodec::Save(archive, SerializedFields(), this);
 
       foundation::Vector<SerializedComponent> components;
 
@@ -441,11 +440,7 @@ namespace snuffbox
     //--------------------------------------------------------------------------
     void Entity::Deserialize(foundation::LoadArchive& archive)
     {
-      archive(
-        GET_ARCHIVE_PROP(name_), 
-        GET_ARCHIVE_PROP(active_),
-        GET_ARCHIVE_PROP(uuid_),
-        GET_ARCHIVE_PROP(sort_index_));
+      foundation::FieldCodec::Load(archive, SerializedFields(), this);
 
       foundation::Vector<SerializedComponent> components;
 
@@ -4,6 +4,7 @@
 #include <scripting/script_class.h>
 
 #include <foundation/serialization/serializable.h>
+#include <foundation/definitions/field_table.h>
 #include <foundation/containers/vector.h>
 #include <foundation/memory/memory.h>
 #include <foundation/auxiliary/logger.h>
@@ -48,6 +49,7 @@ namespace snuffbox
       };
 
       SCRIPT_NAME(Entity);
+      SNUFF_FIELD_TABLE();
 
       /**
       * @brief Construct and add a TransformComponent
@@ -461,9 +463,9 @@ namespace snuffbox
       */
       ComponentArray components_[static_cast<size_t>(Components::kCount)];
 
-      foundation::String name_; //!< The name of this entity
+      SNUFF_FIELD() foundation::String name_; //!< The name of this entity
       bool destroyed_; //!< Has this entity been destroyed yet?
-      bool active_; //!< Is this entity active?
+      SNUFF_FIELD() bool active_; //!< Is this entity active?
 
       /**
       * @brief Is this an internal entity?
@@ -478,9 +480,12 @@ namespace snuffbox
       bool is_internal_;
 
       Scene* scene_; //!< The scene this entity was spawned in
-      foundation::UUID uuid_; //!< The UUID of this entity
+      SNUFF_FIELD() foundation::UUID uuid_; //!< The UUID of this entity
 
-      int sort_index_; //!< The sorting index of the entity, used in editor
+      /**
+      * @brief The sorting index of the entity, used in editor
+      */
+      SNUFF_FIELD() int sort_index_;
 
       static const char* kDefaultName_; //!< The default name for entities
     };
@@ -532,13 +537,13 @@ namespace snuffbox
       TypeCheck<T>();
 
       foundation::Vector<T*> result;
-      foundation::Vector<IComponent*> comps = GetComponents(T::type_id);
+      const ComponentArray& arr = GetComponentArray(T::type_id);
 
-      result.resize(comps.size());
+      result.resize(arr.size());
 
-      for (size_t i = 0; i < comps.size(); ++i)
+      for (size_t i = 0; i < arr.size(); ++i)
       {
-        result.at(i) = static_cast<T*>(comps.at(i));
+        result.at(i) = static_cast<T*>(arr.at(i).get());
       }
 
       return result;
@@ -3,12 +3,14 @@
 #include "engine/components/transform_component.h"
 #include "engine/application/application.h"
 #include "engine/services/scene_service.h"
+#include "engine/services/metrics_service.h"
 
 #include "engine/components/camera_component.h"
 #include "engine/components/mesh_renderer_component.h"
 
 #include <foundation/serialization/save_archive.h>
 #include <foundation/serialization/load_archive.h>
+#include <foundation/auxiliary/profiler.h>
 
 namespace snuffbox
 {
@@ -91,9 +93,7 @@ namespace snuffbox
     //--------------------------------------------------------------------------
     void Scene::RemoveNullEntities()
     {
-      foundation::Vector<Entity*> result;
       size_t old_size = entities_.size();
-      result.resize(old_size);
 
       size_t current = 0;
       Entity* entity = nullptr;
@@ -104,13 +104,12 @@ namespace snuffbox
 
         if (entity != nullptr)
         {
-          result.at(current) = entity;
+          entities_.at(current) = entity;
           ++current;
         }
       }
 
-      result.erase(result.begin() + current, result.end());
-      entities_ = eastl::move(result);
+      entities_.erase(entities_.begin() + current, entities_.end());
     }
 
     //--------------------------------------------------------------------------
@@ -126,11 +125,19 @@ namespace snuffbox
     //--------------------------------------------------------------------------
     void Scene::Update(float dt)
     {
-      ForEachEntity([dt](Entity* e)
+      SNUFF_PROFILE_ZONE("Scene::Update");
+
+      uint64_t updated = 0;
+
+      ForEachEntity([dt, &updated](Entity* e)
       {
         e->Update(dt);
+        ++updated;
+
         return true;
       });
+
+      MetricsService::entities_updated().Add(updated);
       
       if (deleted_ == true)
       {
@@ -195,9 +202,10 @@ namespace snuffbox
     }
 
     //--------------------------------------------------------------------------
-    foundation::Vector<TransformComponent*> Scene::TopLevelTransforms() const
+    foundation::FrameVector<TransformComponent*>
+      Scene::TopLevelTransforms() const
     {
-      foundation::Vector<TransformComponent*> result;
+      foundation::FrameVector<TransformComponent*> result;
 
       Entity* e = nullptr;
       TransformComponent* t = nullptr;
@@ -254,7 +262,7 @@ namespace snuffbox
     //--------------------------------------------------------------------------
     void Scene::Serialize(foundation::SaveArchive& archive) const
     {
-      foundation::Vector<TransformComponent*> top = TopLevelTransforms();
+      foundation::FrameVector<TransformComponent*> top = TopLevelTransforms();
 
       foundation::Vector<Entity*> entities;
       entities.resize(top.size());
@@ -277,14 +285,15 @@ namespace snuffbox
       size_t n = archive.GetArraySize("entities");
 
       foundation::Vector<Entity*> entities;
-      foundation::IAllocator* alloc = &foundation::Memory::default_allocator();
+      foundation::IAllocator* alloc =
+        &foundation::Memory::pool_allocator<Entity>("Entity");
 
       for (size_t i = 0; i < n; ++i)
       {
         foundation::Memory::Construct<Entity>(alloc, this);
       }
 
-      foundation::Vector<TransformComponent*> top = TopLevelTransforms();
+      foundation::FrameVector<TransformComponent*> top = TopLevelTransforms();
       entities.resize(top.size());
 
       for (size_t i = 0; i < top.size(); ++i)
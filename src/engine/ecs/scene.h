@@ -123,9 +123,12 @@ namespace snuffbox
       void RenderEntities(float dt);
 
       /**
+      * @remarks The list is allocated from the frame allocator, so it should
+      *          not be kept beyond the current frame
+      *
       * @return The transform hierarchy with the upper-level transforms
       */
-      foundation::Vector<TransformComponent*> TopLevelTransforms() const;
+      foundation::FrameVector<TransformComponent*> TopLevelTransforms() const;
 
       /**
       * @brief Call a function on each entity in the scene
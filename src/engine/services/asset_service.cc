@@ -1,4 +1,5 @@
 #include "engine/services/asset_service.h"
+#include "engine/services/cvar_service.h"
 
 #include "engine/assets/script_asset.h"
 #include "engine/assets/scene_asset.h"
@@ -7,6 +8,8 @@
 #include "engine/assets/model_asset.h"
 
 #include <foundation/io/directory_tree.h>
+#include <foundation/io/resources.h>
+#include <foundation/io/file.h>
 #include <foundation/auxiliary/logger.h>
 
 #ifndef SNUFF_NSCRIPTING
@@ -17,9 +20,16 @@ namespace snuffbox
 {
   namespace engine
   {
+    //--------------------------------------------------------------------------
+    const char* AssetService::kDefaultPack_ = ".build.pack";
+    const char* AssetService::kDefaultBuild_ = ".build/assets";
+
     //--------------------------------------------------------------------------
     AssetService::AssetService() :
-      ServiceBase<AssetService>("AssetService")
+      ServiceBase<AssetService>("AssetService"),
+      mutex_("AssetService"),
+      pack_cvar_(nullptr),
+      build_cvar_(nullptr)
     {
 
     }
@@ -36,6 +46,20 @@ namespace snuffbox
       Clear();
     }
 
+    //--------------------------------------------------------------------------
+    void AssetService::RegisterCVars(CVarService* cvar)
+    {
+      pack_cvar_ = cvar->Register(
+        "ast_pack",
+        "The pack of built assets to mount at startup",
+        foundation::String(kDefaultPack_));
+
+      build_cvar_ = cvar->Register(
+        "ast_build",
+        "The build directory to load assets from if there is no pack",
+        foundation::String(kDefaultBuild_));
+    }
+
     //--------------------------------------------------------------------------
     foundation::Vector<AssetService::AssetFile> AssetService::EnumerateAssets(
       const foundation::Path& dir,
@@ -108,17 +132,71 @@ namespace snuffbox
     }
 
     //--------------------------------------------------------------------------
-    void AssetService::Clear()
+    bool AssetService::Mount(const foundation::Path& path)
+    {
+      if (foundation::Resources::Mount(path) == false)
+      {
+        foundation::Logger::LogVerbosity<1>(
+          foundation::LogChannel::kEngine,
+          foundation::LogSeverity::kError,
+          "Could not mount asset pack '{0}'",
+          path);
+
+        return false;
+      }
+
+      Refresh(foundation::Path::kVirtualPrefix);
+
+      return true;
+    }
+
+    //--------------------------------------------------------------------------
+    void AssetService::MountBuild()
     {
-      AssetMap::iterator it = registered_.begin();
+      if (pack_cvar_ == nullptr || build_cvar_ == nullptr)
+      {
+        return;
+      }
+
+      foundation::Path pack =
+        static_cast<CVar<foundation::String>*>(pack_cvar_)->value();
 
-      while (it != registered_.end())
+      if (foundation::File::Exists(pack) == true && Mount(pack) == true)
       {
-        it->second->Unload();
-        ++it;
+        return;
       }
 
-      registered_.clear();
+      foundation::Path build =
+        static_cast<CVar<foundation::String>*>(build_cvar_)->value();
+
+      foundation::Logger::LogVerbosity<2>(
+        foundation::LogChannel::kEngine,
+        foundation::LogSeverity::kInfo,
+        "No asset pack at '{0}', loading assets from '{1}'",
+        pack,
+        build);
+
+      Refresh(build);
+    }
+
+    //--------------------------------------------------------------------------
+    void AssetService::Clear()
+    {
+      size_t count = static_cast<size_t>(compilers::AssetTypes::kCount);
+
+      for (size_t i = 0; i < count; ++i)
+      {
+        AssetMap& assets = registered_[i];
+        AssetMap::iterator it = assets.begin();
+
+        while (it != assets.end())
+        {
+          it->second->Unload();
+          ++it;
+        }
+
+        assets.clear();
+      }
     }
 
     //--------------------------------------------------------------------------
@@ -126,7 +204,9 @@ namespace snuffbox
       compilers::AssetTypes type, 
       const foundation::String& path)
     {
-      if (Exists(type, path) == false)
+      IAsset* asset = Find(type, path);
+
+      if (asset == nullptr)
       {
         foundation::Logger::LogVerbosity<1>(
           foundation::LogChannel::kEngine,
@@ -138,10 +218,7 @@ namespace snuffbox
         return false;
       }
 
-      foundation::String ext = compilers::AssetTypesToBuildExtension(type);
-      AssetMap::iterator it = registered_.find(path + '.' + ext);
-
-      if (it->second->Load() == false)
+      if (asset->Load() == false)
       {
         foundation::Logger::LogVerbosity<1>(
           foundation::LogChannel::kEngine,
@@ -174,7 +251,7 @@ namespace snuffbox
       compilers::AssetTypes type,
       const foundation::String& path)
     {
-      IAsset* ptr = Get(type, path);
+      IAsset* ptr = Find(type, path);
 
       if (ptr == nullptr || ptr->is_loaded() == false)
       {
@@ -187,22 +264,21 @@ namespace snuffbox
     //--------------------------------------------------------------------------
     bool AssetService::LoadAll(compilers::AssetTypes type)
     {
-      AssetMap::iterator it = registered_.begin();
+      if (type >= compilers::AssetTypes::kCount)
+      {
+        return false;
+      }
+
+      AssetMap& assets = registered_[static_cast<size_t>(type)];
+      AssetMap::iterator it = assets.begin();
 
       bool success = true;
-      foundation::SharedPtr<IAsset> a;
 
-      while (it != registered_.end())
+      while (it != assets.end())
       {
-        a = it->second;
-        if (a->type() == type)
+        if (Load(type, it->first.ToString()) == false)
         {
-          if (
-            Load(type, foundation::Path(it->first).NoExtension().ToString())
-            == false)
-          {
-            success = false;
-          }
+          success = false;
         }
 
         ++it;
@@ -214,14 +290,19 @@ namespace snuffbox
     //--------------------------------------------------------------------------
     void AssetService::UnloadAll(compilers::AssetTypes type)
     {
-      AssetMap::iterator it = registered_.begin();
-      foundation::SharedPtr<IAsset> a;
+      if (type >= compilers::AssetTypes::kCount)
+      {
+        return;
+      }
 
-      while (it != registered_.end())
+      AssetMap& assets = registered_[static_cast<size_t>(type)];
+      AssetMap::iterator it = assets.begin();
+
+      while (it != assets.end())
       {
-        a = it->second;
+        IAsset* a = it->second.get();
 
-        if (a->type() == type && a->is_loaded() == true)
+        if (a->is_loaded() == true)
         {
           a->Unload();
         }
@@ -244,6 +325,30 @@ namespace snuffbox
         compilers::AssetTypes::kCount;
     }
 
+    //--------------------------------------------------------------------------
+    IAsset* AssetService::Find(
+      compilers::AssetTypes type,
+      const foundation::String& path) const
+    {
+      return Find(type, foundation::StringId::Find(path));
+    }
+
+    //--------------------------------------------------------------------------
+    IAsset* AssetService::Find(
+      compilers::AssetTypes type,
+      const foundation::StringId& id) const
+    {
+      if (type >= compilers::AssetTypes::kCount || id.is_valid() == false)
+      {
+        return nullptr;
+      }
+
+      const AssetMap& assets = registered_[static_cast<size_t>(type)];
+      AssetMap::const_iterator it = assets.find(id);
+
+      return it == assets.end() ? nullptr : it->second.get();
+    }
+
     //--------------------------------------------------------------------------
     foundation::String AssetService::NoExtensionToBuildPath(
       compilers::AssetTypes type,
@@ -268,18 +373,17 @@ namespace snuffbox
       compilers::AssetTypes type,
       const foundation::Path& relative_path)
     {
-      std::unique_lock<std::mutex> lock(mutex_);
-
-      foundation::Path no_ext = relative_path.NoExtension();
-      foundation::String no_ext_s = no_ext.ToString();
+      std::unique_lock<foundation::Mutex> lock(mutex_);
 
-      if (Exists(type, no_ext_s) == true)
+      if (type >= compilers::AssetTypes::kCount)
       {
         return;
       }
 
-      if (
-        type == compilers::AssetTypes::kCount)
+      foundation::Path no_ext = relative_path.NoExtension();
+      foundation::String no_ext_s = no_ext.ToString();
+
+      if (Exists(type, no_ext_s) == true)
       {
         return;
       }
@@ -325,10 +429,10 @@ namespace snuffbox
         return;
       }
 
-      registered_.emplace(
-        eastl::pair<foundation::String, foundation::SharedPtr<IAsset>>
+      registered_[static_cast<size_t>(type)].emplace(
+        eastl::pair<foundation::StringId, foundation::SharedPtr<IAsset>>
       {
-        relative_path.ToString(), foundation::Memory::MakeShared(ptr)
+        no_ext_s, foundation::Memory::MakeShared(ptr)
       });
     }
 
@@ -337,11 +441,20 @@ namespace snuffbox
       compilers::AssetTypes type,
       const foundation::Path& relative_path)
     {
-      std::unique_lock<std::mutex> lock(mutex_);
+      std::unique_lock<foundation::Mutex> lock(mutex_);
 
-      AssetMap::iterator it = registered_.find(relative_path.ToString());
+      if (type >= compilers::AssetTypes::kCount)
+      {
+        return;
+      }
+
+      foundation::StringId id =
+        foundation::StringId::Find(relative_path.NoExtension().ToString());
 
-      if (it != registered_.end())
+      AssetMap& assets = registered_[static_cast<size_t>(type)];
+      AssetMap::iterator it = assets.find(id);
+
+      if (it != assets.end())
       {
         IAsset* asset = it->second.get();
         if (asset->is_loaded() == true)
@@ -349,7 +462,7 @@ namespace snuffbox
           asset->Unload();
         }
 
-        registered_.erase(it);
+        assets.erase(it);
       }
     }
 
@@ -358,9 +471,15 @@ namespace snuffbox
       compilers::AssetTypes type,
       const foundation::String& path) const
     {
-      foundation::String p = NoExtensionToBuildPath(type, path);
+      return Find(type, path) != nullptr;
+    }
 
-      return registered_.find(p) != registered_.end();
+    //--------------------------------------------------------------------------
+    bool AssetService::Exists(
+      compilers::AssetTypes type,
+      const foundation::StringId& id) const
+    {
+      return Find(type, id) != nullptr;
     }
 
     //--------------------------------------------------------------------------
@@ -368,9 +487,8 @@ namespace snuffbox
       compilers::AssetTypes type,
       const foundation::String& path) const
     {
-      foundation::String p = NoExtensionToBuildPath(type, path);
-
-      return Exists(type, path) == true && registered_.at(p)->is_loaded();
+      IAsset* asset = Find(type, path);
+      return asset != nullptr && asset->is_loaded() == true;
     }
 
     //--------------------------------------------------------------------------
@@ -378,13 +496,15 @@ namespace snuffbox
       compilers::AssetTypes type,
       const foundation::String& path)
     {
-      if (Exists(type, path) == false)
-      {
-        return nullptr;
-      }
+      return Find(type, path);
+    }
 
-      foundation::String p = NoExtensionToBuildPath(type, path);
-      return registered_.at(p).get();
+    //--------------------------------------------------------------------------
+    IAsset* AssetService::Get(
+      compilers::AssetTypes type,
+      const foundation::StringId& id)
+    {
+      return Find(type, id);
     }
 
     //--------------------------------------------------------------------------
@@ -393,16 +513,19 @@ namespace snuffbox
     {
       foundation::Vector<const IAsset*> result;
 
+      if (type >= compilers::AssetTypes::kCount)
+      {
+        return result;
+      }
+
+      const AssetMap& assets = registered_[static_cast<size_t>(type)];
+
       for (
-        AssetMap::const_iterator it = registered_.begin();
-        it != registered_.end();
+        AssetMap::const_iterator it = assets.begin();
+        it != assets.end();
         ++it)
       {
-        const IAsset* asset = it->second.get();
-        if (asset->type() == type)
-        {
-          result.push_back(asset);
-        }
+        result.push_back(it->second.get());
       }
 
       return result;
@@ -8,15 +8,17 @@
 
 #include <foundation/io/path.h>
 #include <foundation/containers/map.h>
+#include <foundation/containers/string_id.h>
 #include <foundation/memory/memory.h>
-
-#include <mutex>
+#include <foundation/auxiliary/mutex.h>
 
 namespace snuffbox
 {
   namespace engine
   {
     class IAsset;
+    class CVarService;
+    class CVarValue;
 
     /**
     * @brief Used to manage loading and unloading of assets when required
@@ -90,6 +92,29 @@ namespace snuffbox
       */
       static bool IsAsset(const foundation::Path& path);
 
+      /**
+      * @brief Finds a registered asset by type and path
+      *
+      * Paths that were never registered are not interned by this lookup.
+      *
+      * @param[in] type The type of the asset to find
+      * @param[in] path The path to the asset, with no extension
+      *
+      * @return The found asset, or nullptr if it doesn't exist
+      */
+      IAsset* Find(
+        compilers::AssetTypes type,
+        const foundation::String& path) const;
+
+      /**
+      * @see AssetService::Find
+      *
+      * @remarks Id overload, which doesn't hash the path again
+      */
+      IAsset* Find(
+        compilers::AssetTypes type,
+        const foundation::StringId& id) const;
+
       /**
       * @see IService::OnInitialize
       */
@@ -100,6 +125,11 @@ namespace snuffbox
       */
       void OnShutdown(Application& app) override;
 
+      /**
+      * @see IService::RegisterCVars
+      */
+      void RegisterCVars(CVarService* cvar) override;
+
     public:
 
       /**
@@ -112,6 +142,32 @@ namespace snuffbox
       */
       void Refresh(const foundation::Path& path);
 
+      /**
+      * @brief Mounts a pack of built assets and refreshes the asset service
+      *        to register the assets in it
+      *
+      * The assets are loaded from the virtual file system from then on, so
+      * that loading them doesn't touch the file system.
+      *
+      * @see foundation::Resources::Mount
+      *
+      * @param[in] path The path to the pack
+      *
+      * @return Was the pack mounted succesfully?
+      */
+      bool Mount(const foundation::Path& path);
+
+      /**
+      * @brief Mounts the asset pack from the "ast_pack" CVar, or refreshes
+      *        the asset service from the loose files in the build directory
+      *        of the "ast_build" CVar if the pack doesn't exist or could not
+      *        be mounted
+      *
+      * @see AssetService::Mount
+      * @see AssetService::Refresh
+      */
+      void MountBuild();
+
       /**
       * @brief Clears every asset in the asset service and unloads them
       */
@@ -166,6 +222,15 @@ namespace snuffbox
         compilers::AssetTypes type, 
         const foundation::String& path) const;
 
+      /**
+      * @see AssetService::Exists
+      *
+      * @remarks Id overload, for handles that cache the id of their path
+      */
+      bool Exists(
+        compilers::AssetTypes type,
+        const foundation::StringId& id) const;
+
       /**
       * @brief Loads an asset by type and relative path with no extension
       *
@@ -235,6 +300,13 @@ namespace snuffbox
       */
       IAsset* Get(compilers::AssetTypes type, const foundation::String& path);
 
+      /**
+      * @see AssetService::Get
+      *
+      * @remarks Id overload, for handles that cache the id of their path
+      */
+      IAsset* Get(compilers::AssetTypes type, const foundation::StringId& id);
+
       /**
       * @brief Retrieves all registered assets of a specific type
       *
@@ -283,17 +355,30 @@ namespace snuffbox
 
     private:
 
+      /**
+      * @brief Maps the interned relative path of an asset, without an
+      *        extension, to the asset
+      */
       using AssetMap =
-        foundation::UMap<foundation::String, foundation::SharedPtr<IAsset>>;
+        foundation::UMap<foundation::StringId, foundation::SharedPtr<IAsset>>;
 
       /**
-      * @brief The asset map for all known asset types that can be loaded
-      *        and unloaded
+      * @brief The asset maps for all known asset types that can be loaded
+      *        and unloaded, indexed by asset type
       */
-      AssetMap registered_;
+      AssetMap registered_[static_cast<size_t>(compilers::AssetTypes::kCount)];
       foundation::Path build_directory_; //!< The current build directory
 
-      std::mutex mutex_; //!< The mutex for modification of registered assets
+      /**
+      * @brief The mutex for modification of registered assets
+      */
+      foundation::Mutex mutex_;
+
+      CVarValue* pack_cvar_; //!< The "ast_pack" CVar
+      CVarValue* build_cvar_; //!< The "ast_build" CVar
+
+      static const char* kDefaultPack_; //!< The default ast_pack value
+      static const char* kDefaultBuild_; //!< The default ast_build value
     };
   }
 }
\ No newline at end of file
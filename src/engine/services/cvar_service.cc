@@ -143,7 +143,7 @@ namespace snuffbox
         it != registered_.end();
         ++it)
       {
-        values += it->first;
+        values += it->first.c_str();
 
         size_t len = it->first.size();
 
@@ -162,7 +162,7 @@ namespace snuffbox
     }
 
     //--------------------------------------------------------------------------
-    CVarValue* CVarService::GetRaw(const foundation::String& name) const
+    CVarValue* CVarService::GetRaw(const foundation::StringId& name) const
     {
       CVarMap::const_iterator it = registered_.find(name);
 
@@ -175,7 +175,7 @@ namespace snuffbox
     }
 
     //--------------------------------------------------------------------------
-    bool CVarService::Exists(const foundation::String& name) const
+    bool CVarService::Exists(const foundation::StringId& name) const
     {
       return registered_.find(name) != registered_.end();
     }
@@ -6,6 +6,7 @@
 
 #include <foundation/memory/memory.h>
 #include <foundation/containers/map.h>
+#include <foundation/containers/string_id.h>
 
 namespace snuffbox
 {
@@ -149,7 +150,7 @@ namespace snuffbox
       *
       * @return The retrieved CVar, or nullptr if it doesn't exist
       */
-      CVarValue* GetRaw(const foundation::String& name) const;
+      CVarValue* GetRaw(const foundation::StringId& name) const;
 
       /**
       * @brief Retrieves a typed CVar by name
@@ -161,7 +162,7 @@ namespace snuffbox
       * @return The retrieved value, or the default if it doesn't exist
       */
       template <typename T>
-      T Get(const foundation::String& name, const T& def = T()) const;
+      T Get(const foundation::StringId& name, const T& def = T()) const;
 
       /**
       * @brief Checks if a CVar value exists
@@ -170,7 +171,7 @@ namespace snuffbox
       *
       * @return Does the value exist?
       */
-      bool Exists(const foundation::String& name) const;
+      bool Exists(const foundation::StringId& name) const;
 
     protected:
 
@@ -189,10 +190,12 @@ namespace snuffbox
       static const size_t kLogPadding_; //!< The amount of padding for logging
 
       /**
-      * @brief The CVar map, which consists of a string to value relationship
+      * @brief The CVar map, which consists of an interned name to value
+      *        relationship
       */
-      using CVarMap = 
-        foundation::UMap<foundation::String, foundation::UniquePtr<CVarValue>>;
+      using CVarMap = foundation::UMap<
+        foundation::StringId,
+        foundation::UniquePtr<CVarValue>>;
 
       /**
       * @brief The list of registered CVar values
@@ -218,7 +221,7 @@ namespace snuffbox
       CVarValue* ptr = value.get();
 
       registered_.emplace(
-        eastl::pair<foundation::String, foundation::UniquePtr<CVarValue>>
+        eastl::pair<foundation::StringId, foundation::UniquePtr<CVarValue>>
         { 
           name, eastl::move(value) 
         });
@@ -229,7 +232,7 @@ namespace snuffbox
     //--------------------------------------------------------------------------
     template <typename T>
     inline T CVarService::Get(
-      const foundation::String& name, 
+      const foundation::StringId& name, 
       const T& def) const
     {
       CVarValue* v = GetRaw(name);
@@ -245,7 +248,7 @@ namespace snuffbox
     //--------------------------------------------------------------------------
     template <>
     inline int CVarService::Get(
-      const foundation::String& name,
+      const foundation::StringId& name,
       const int& def) const
     {
       return static_cast<int>(Get<double>(name, static_cast<double>(def)));
@@ -254,7 +257,7 @@ namespace snuffbox
     //--------------------------------------------------------------------------
     template <>
     inline unsigned int CVarService::Get(
-      const foundation::String& name,
+      const foundation::StringId& name,
       const unsigned int& def) const
     {
       return 
@@ -264,7 +267,7 @@ namespace snuffbox
     //--------------------------------------------------------------------------
     template <>
     inline float CVarService::Get(
-      const foundation::String& name,
+      const foundation::StringId& name,
       const float& def) const
     {
       return static_cast<float>(Get<double>(name, static_cast<double>(def)));
@@ -0,0 +1,206 @@
+#include "engine/services/memory_service.h"
+#include "engine/services/cvar_service.h"
+
+#include "engine/auxiliary/debug.h"
+
+#include <foundation/memory/allocator_registry.h>
+#include <foundation/memory/heap_profiler.h>
+#include <foundation/io/file.h>
+
+namespace snuffbox
+{
+  namespace engine
+  {
+    //--------------------------------------------------------------------------
+    MemoryService::MemoryService() :
+      ServiceBase<MemoryService>("MemoryService"),
+      cvar_(nullptr)
+    {
+
+    }
+
+    //--------------------------------------------------------------------------
+    foundation::ErrorCodes MemoryService::OnInitialize(Application& app)
+    {
+      UpdateHeapProfiler();
+      return foundation::ErrorCodes::kSuccess;
+    }
+
+    //--------------------------------------------------------------------------
+    void MemoryService::OnUpdate(Application& app, float dt)
+    {
+      if (cvar_ == nullptr)
+      {
+        return;
+      }
+
+      UpdateHeapProfiler();
+
+      if (cvar_->Get<bool>(SNUFF_STRING_ID("mem_dump")) == true)
+      {
+        foundation::AllocatorRegistry::Dump();
+        cvar_->GetRaw(SNUFF_STRING_ID("mem_dump"))->Set("false");
+      }
+
+      foundation::String path =
+        cvar_->Get<foundation::String>(SNUFF_STRING_ID("mem_snapshot"));
+
+      if (path.empty() == false)
+      {
+        WriteSnapshot(path);
+        cvar_->GetRaw(SNUFF_STRING_ID("mem_snapshot"))->Set("");
+      }
+
+      path =
+        cvar_->Get<foundation::String>(SNUFF_STRING_ID("mem_profile_dump"));
+
+      if (path.empty() == false)
+      {
+        WriteHeapProfile(path);
+        cvar_->GetRaw(SNUFF_STRING_ID("mem_profile_dump"))->Set("");
+      }
+    }
+
+    //--------------------------------------------------------------------------
+    void MemoryService::OnShutdown(Application& app)
+    {
+      foundation::HeapProfiler::Stop();
+      cvar_ = nullptr;
+    }
+
+    //--------------------------------------------------------------------------
+    void MemoryService::RegisterCVars(CVarService* cvar)
+    {
+      cvar->Register(
+        "mem_dump",
+        "Logs the allocator statistics at the end of the frame",
+        false);
+
+      cvar->Register(
+        "mem_snapshot",
+        "Writes the allocator statistics as JSON to the specified path",
+        foundation::String(""));
+
+      cvar->Register(
+        "mem_profile",
+        "Should allocations be sampled by the heap profiler?",
+        false);
+
+      CVarValue::Range rate;
+      rate.min = 1.0;
+      rate.has_min = true;
+
+      cvar->Register(
+        "mem_profile_rate",
+        "The average number of bytes between two heap profiler samples",
+        static_cast<double>(foundation::HeapProfiler::kDefaultSampleRate),
+        rate);
+
+      cvar->Register(
+        "mem_profile_dump",
+        "Writes the heap profile to the specified path",
+        foundation::String(""));
+
+      cvar_ = cvar;
+    }
+
+    //--------------------------------------------------------------------------
+    bool MemoryService::WriteSnapshot(const foundation::String& path) const
+    {
+      return WriteText(
+        path,
+        foundation::AllocatorRegistry::ToJson(),
+        "memory snapshot");
+    }
+
+    //--------------------------------------------------------------------------
+    bool MemoryService::WriteHeapProfile(const foundation::String& path) const
+    {
+      if (foundation::HeapProfiler::dropped() > 0)
+      {
+        Debug::LogVerbosity<1>(
+          foundation::LogSeverity::kWarning,
+          "The heap profiler dropped {0} sample(s), consider a higher rate",
+          foundation::HeapProfiler::dropped());
+      }
+
+      bool pprof = WriteText(
+        path,
+        foundation::HeapProfiler::ToPprof(),
+        "heap profile");
+
+      bool folded = WriteText(
+        path + ".folded",
+        foundation::HeapProfiler::ToFolded(),
+        "heap profile flamegraph");
+
+      return pprof == true && folded == true;
+    }
+
+    //--------------------------------------------------------------------------
+    void MemoryService::UpdateHeapProfiler()
+    {
+      if (cvar_ == nullptr)
+      {
+        return;
+      }
+
+      bool enabled = cvar_->Get<bool>(SNUFF_STRING_ID("mem_profile"));
+      size_t rate = static_cast<size_t>(
+        cvar_->Get<double>(SNUFF_STRING_ID("mem_profile_rate")));
+
+      if (enabled == foundation::HeapProfiler::enabled())
+      {
+        return;
+      }
+
+      if (enabled == true)
+      {
+        foundation::HeapProfiler::Start(rate);
+
+        Debug::LogVerbosity<1>(
+          foundation::LogSeverity::kInfo,
+          "Started the heap profiler, sampling every {0} bytes",
+          rate);
+
+        return;
+      }
+
+      foundation::HeapProfiler::Stop();
+
+      Debug::LogVerbosity<1>(
+        foundation::LogSeverity::kInfo,
+        "Stopped the heap profiler");
+    }
+
+    //--------------------------------------------------------------------------
+    bool MemoryService::WriteText(
+      const foundation::String& path,
+      const foundation::String& text,
+      const char* what)
+    {
+      foundation::File file(path, foundation::FileFlags::kWrite);
+
+      if (file.is_ok() == false)
+      {
+        Debug::LogVerbosity<1>(
+          foundation::LogSeverity::kError,
+          "Could not open '{0}' to write the {1} to",
+          path,
+          what);
+
+        return false;
+      }
+
+      file.Write(reinterpret_cast<const uint8_t*>(text.c_str()), text.size());
+
+      Debug::LogVerbosity<1>(
+        foundation::LogSeverity::kSuccess,
+        "Wrote the {0} to '{1}'",
+        what,
+        path);
+
+      return true;
+    }
+  }
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "engine/services/service.h"
+
+namespace snuffbox
+{
+  namespace engine
+  {
+    class CVarService;
+
+    /**
+    * @brief The memory service to expose the allocator statistics of the
+    *        foundation::AllocatorRegistry
+    *
+    * The statistics can be dumped to the log by setting the "mem_dump" CVar,
+    * or written to a JSON file by setting the "mem_snapshot" CVar to a path.
+    * Both CVars are cleared again after they have been handled, so that they
+    * can be set again from the command line at runtime.
+    *
+    * The foundation::HeapProfiler is started and stopped with the
+    * "mem_profile" CVar, sampling at the rate of "mem_profile_rate". Setting
+    * it from the command line profiles startup as well. Setting
+    * "mem_profile_dump" to a path writes the heap profile in the pprof format
+    * to that path, and as collapsed stacks for flamegraph.pl to the same path
+    * with a ".folded" extension appended.
+    *
+    * @author Daniel Konings
+    */
+    class MemoryService : public ServiceBase<MemoryService>
+    {
+
+    public:
+
+      /**
+      * @see IService::IService
+      */
+      MemoryService();
+
+    protected:
+
+      /**
+      * @see IService::OnInitialize
+      */
+      foundation::ErrorCodes OnInitialize(Application& app) override;
+
+      /**
+      * @see IService::OnUpdate
+      */
+      void OnUpdate(Application& app, float dt) override;
+
+      /**
+      * @see IService::OnShutdown
+      */
+      void OnShutdown(Application& app) override;
+
+      /**
+      * @see IService::RegisterCVars
+      */
+      void RegisterCVars(CVarService* cvar) override;
+
+    public:
+
+      /**
+      * @brief Writes a JSON snapshot of the allocator statistics to a file
+      *
+      * @param[in] path The path to write the snapshot to
+      *
+      * @return Was the snapshot written succesfully?
+      */
+      bool WriteSnapshot(const foundation::String& path) const;
+
+      /**
+      * @brief Writes the current heap profile to a file in the pprof format,
+      *        and to a second file as collapsed stacks
+      *
+      * @param[in] path The path to write the pprof profile to, the collapsed
+      *                 stacks are written to the path with ".folded" appended
+      *
+      * @return Were both files written succesfully?
+      */
+      bool WriteHeapProfile(const foundation::String& path) const;
+
+    protected:
+
+      /**
+      * @brief Starts or stops the heap profiler to match the CVars
+      */
+      void UpdateHeapProfiler();
+
+      /**
+      * @brief Writes text to a file, logging the result
+      *
+      * @param[in] path The path to write to
+      * @param[in] text The text to write
+      * @param[in] what A description of the text, for logging
+      *
+      * @return Was the file written succesfully?
+      */
+      static bool WriteText(
+        const foundation::String& path,
+        const foundation::String& text,
+        const char* what);
+
+    private:
+
+      CVarService* cvar_; //!< The CVar service
+    };
+  }
+}
@@ -0,0 +1,262 @@
+#include "engine/services/metrics_service.h"
+#include "engine/services/cvar_service.h"
+
+#include "engine/auxiliary/debug.h"
+
+#include <foundation/memory/allocator_registry.h>
+#include <foundation/io/path.h>
+#include <foundation/io/file.h>
+
+namespace snuffbox
+{
+  namespace engine
+  {
+    //--------------------------------------------------------------------------
+    foundation::MetricHistogram MetricsService::frame_time_("frame_time_ms");
+    foundation::MetricCounter MetricsService::entities_updated_(
+      "entities_updated");
+    foundation::MetricCounter MetricsService::draw_commands_("draw_commands");
+    foundation::MetricCounter MetricsService::assets_loaded_("assets_loaded");
+    foundation::MetricCounter MetricsService::script_callbacks_(
+      "script_callbacks");
+    foundation::MetricGauge MetricsService::frame_allocated_(
+      "frame_allocated_bytes");
+
+    //--------------------------------------------------------------------------
+    MetricsService::MetricsService() :
+      ServiceBase<MetricsService>("MetricsService"),
+      cvar_(nullptr),
+      log_cvar_(nullptr),
+      log_interval_cvar_(nullptr),
+      log_version_(0)
+    {
+
+    }
+
+    //--------------------------------------------------------------------------
+    foundation::ErrorCodes MetricsService::OnInitialize(Application& app)
+    {
+      return foundation::ErrorCodes::kSuccess;
+    }
+
+    //--------------------------------------------------------------------------
+    void MetricsService::OnUpdate(Application& app, float dt)
+    {
+      if (cvar_ == nullptr)
+      {
+        return;
+      }
+
+      if (cvar_->Get<bool>(SNUFF_STRING_ID("met_dump")) == true)
+      {
+        foundation::MetricsRegistry::Dump();
+        cvar_->GetRaw(SNUFF_STRING_ID("met_dump"))->Set("false");
+      }
+
+      foundation::String path =
+        cvar_->Get<foundation::String>(SNUFF_STRING_ID("met_snapshot"));
+
+      if (path.empty() == false)
+      {
+        WriteSnapshot(path);
+        cvar_->GetRaw(SNUFF_STRING_ID("met_snapshot"))->Set("");
+      }
+    }
+
+    //--------------------------------------------------------------------------
+    void MetricsService::OnShutdown(Application& app)
+    {
+      log_.Commit();
+      log_path_.clear();
+
+      cvar_ = nullptr;
+      log_cvar_ = nullptr;
+      log_interval_cvar_ = nullptr;
+      log_version_ = 0;
+    }
+
+    //--------------------------------------------------------------------------
+    void MetricsService::RegisterCVars(CVarService* cvar)
+    {
+      cvar->Register(
+        "met_dump",
+        "Logs the engine metrics at the end of the frame",
+        false);
+
+      cvar->Register(
+        "met_snapshot",
+        "Writes the engine metrics to the specified path, as CSV or JSON",
+        foundation::String(""));
+
+      log_cvar_ = cvar->Register(
+        "met_log",
+        "Writes the engine metrics as CSV rows to the specified path",
+        foundation::String(""));
+
+      CVarValue::Range interval;
+      interval.min = 1.0;
+      interval.has_min = true;
+
+      log_interval_cvar_ = cvar->Register(
+        "met_log_interval",
+        "The number of frames between two rows of the metrics log",
+        60.0,
+        interval);
+
+      cvar_ = cvar;
+    }
+
+    //--------------------------------------------------------------------------
+    void MetricsService::EndFrame(float dt)
+    {
+      frame_time_.Record(static_cast<double>(dt) * 1000.0);
+      frame_allocated_.Set(
+        static_cast<double>(foundation::AllocatorRegistry::frame_allocated()));
+
+      foundation::MetricsRegistry::EndFrame();
+
+      UpdateLog();
+    }
+
+    //--------------------------------------------------------------------------
+    bool MetricsService::WriteSnapshot(const foundation::String& path) const
+    {
+      foundation::File file(path, foundation::FileFlags::kWrite);
+
+      if (file.is_ok() == false)
+      {
+        Debug::LogVerbosity<1>(
+          foundation::LogSeverity::kError,
+          "Could not open '{0}' to write the metrics to",
+          path);
+
+        return false;
+      }
+
+      foundation::String text;
+
+      if (foundation::Path(path).extension() == "csv")
+      {
+        text = foundation::MetricsRegistry::ToCsvHeader() +
+          foundation::MetricsRegistry::ToCsvRow();
+      }
+      else
+      {
+        text = foundation::MetricsRegistry::ToJson();
+      }
+
+      file.Write(reinterpret_cast<const uint8_t*>(text.c_str()), text.size());
+
+      Debug::LogVerbosity<1>(
+        foundation::LogSeverity::kSuccess,
+        "Wrote the metrics to '{0}'",
+        path);
+
+      return true;
+    }
+
+    //--------------------------------------------------------------------------
+    foundation::MetricHistogram& MetricsService::frame_time()
+    {
+      return frame_time_;
+    }
+
+    //--------------------------------------------------------------------------
+    foundation::MetricCounter& MetricsService::entities_updated()
+    {
+      return entities_updated_;
+    }
+
+    //--------------------------------------------------------------------------
+    foundation::MetricCounter& MetricsService::draw_commands()
+    {
+      return draw_commands_;
+    }
+
+    //--------------------------------------------------------------------------
+    foundation::MetricCounter& MetricsService::assets_loaded()
+    {
+      return assets_loaded_;
+    }
+
+    //--------------------------------------------------------------------------
+    foundation::MetricCounter& MetricsService::script_callbacks()
+    {
+      return script_callbacks_;
+    }
+
+    //--------------------------------------------------------------------------
+    foundation::MetricGauge& MetricsService::frame_allocated()
+    {
+      return frame_allocated_;
+    }
+
+    //--------------------------------------------------------------------------
+    void MetricsService::UpdateLog()
+    {
+      if (log_cvar_ == nullptr || log_interval_cvar_ == nullptr)
+      {
+        return;
+      }
+
+      if (log_cvar_->version() != log_version_)
+      {
+        log_version_ = log_cvar_->version();
+
+        const foundation::String& path =
+          static_cast<CVar<foundation::String>*>(log_cvar_)->value();
+
+        if (path != log_path_)
+        {
+          log_.Commit();
+          log_path_ = path;
+
+          if (path.empty() == true)
+          {
+            return;
+          }
+
+          if (log_.Open(path, false) == false)
+          {
+            Debug::LogVerbosity<1>(
+              foundation::LogSeverity::kError,
+              "Could not open '{0}' to log the metrics to",
+              path);
+
+            return;
+          }
+
+          foundation::String header =
+            foundation::MetricsRegistry::ToCsvHeader();
+
+          log_.Write(
+            reinterpret_cast<const uint8_t*>(header.c_str()),
+            header.size());
+          log_.Flush();
+
+          Debug::LogVerbosity<1>(
+            foundation::LogSeverity::kInfo,
+            "Logging the metrics to '{0}'",
+            path);
+        }
+      }
+
+      if (log_.is_ok() == false)
+      {
+        return;
+      }
+
+      uint32_t interval = static_cast<uint32_t>(
+        static_cast<CVar<double>*>(log_interval_cvar_)->value());
+
+      if (interval == 0 || foundation::MetricsRegistry::frame() % interval != 0)
+      {
+        return;
+      }
+
+      foundation::String row = foundation::MetricsRegistry::ToCsvRow();
+      log_.Write(reinterpret_cast<const uint8_t*>(row.c_str()), row.size());
+      log_.Flush();
+    }
+  }
+}
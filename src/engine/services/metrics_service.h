@@ -0,0 +1,142 @@
+#pragma once
+
+#include "engine/services/service.h"
+
+#include <foundation/auxiliary/metrics.h>
+#include <foundation/io/file_writer.h>
+
+namespace snuffbox
+{
+  namespace engine
+  {
+    class CVarService;
+    class CVarValue;
+
+    /**
+    * @brief The metrics service to expose the engine metrics in the
+    *        foundation::MetricsRegistry
+    *
+    * The service owns the metrics of the engine itself: the frame time
+    * percentiles over a rolling window, the number of entities updated, draw
+    * commands queued, assets loaded and script callbacks invoked, and the
+    * number of bytes allocated per frame. Other systems can register their
+    * own metrics with the registry, which are reported along with these.
+    *
+    * The metrics can be dumped to the log by setting the "met_dump" CVar,
+    * or written to a file by setting "met_snapshot" to a path. Paths that end
+    * in ".csv" are written as CSV, any other path as JSON. For long runs,
+    * setting "met_log" to a path writes a CSV row to that path every
+    * "met_log_interval" frames.
+    *
+    * @author Daniel Konings
+    */
+    class MetricsService : public ServiceBase<MetricsService>
+    {
+
+    public:
+
+      /**
+      * @see IService::IService
+      */
+      MetricsService();
+
+    protected:
+
+      /**
+      * @see IService::OnInitialize
+      */
+      foundation::ErrorCodes OnInitialize(Application& app) override;
+
+      /**
+      * @see IService::OnUpdate
+      */
+      void OnUpdate(Application& app, float dt) override;
+
+      /**
+      * @see IService::OnShutdown
+      */
+      void OnShutdown(Application& app) override;
+
+      /**
+      * @see IService::RegisterCVars
+      */
+      void RegisterCVars(CVarService* cvar) override;
+
+    public:
+
+      /**
+      * @brief Ends the current frame, recording the frame time and the
+      *        allocations of the frame
+      *
+      * @remarks This should be called after the allocator frame has ended
+      *
+      * @param[in] dt The duration of the frame, in seconds
+      */
+      void EndFrame(float dt);
+
+      /**
+      * @brief Writes a snapshot of the metrics to a file
+      *
+      * @param[in] path The path to write the snapshot to, as CSV if it ends
+      *                 in ".csv" and as JSON otherwise
+      *
+      * @return Was the snapshot written succesfully?
+      */
+      bool WriteSnapshot(const foundation::String& path) const;
+
+      /**
+      * @return The frame times, in milliseconds
+      */
+      static foundation::MetricHistogram& frame_time();
+
+      /**
+      * @return The number of entities updated
+      */
+      static foundation::MetricCounter& entities_updated();
+
+      /**
+      * @return The number of draw commands queued
+      */
+      static foundation::MetricCounter& draw_commands();
+
+      /**
+      * @return The number of assets loaded
+      */
+      static foundation::MetricCounter& assets_loaded();
+
+      /**
+      * @return The number of script callbacks invoked
+      */
+      static foundation::MetricCounter& script_callbacks();
+
+      /**
+      * @return The number of bytes allocated in the last frame
+      */
+      static foundation::MetricGauge& frame_allocated();
+
+    protected:
+
+      /**
+      * @brief Opens, closes or writes to the CSV log to match the CVars
+      */
+      void UpdateLog();
+
+    private:
+
+      CVarService* cvar_; //!< The CVar service
+      CVarValue* log_cvar_; //!< The "met_log" CVar
+      CVarValue* log_interval_cvar_; //!< The "met_log_interval" CVar
+      uint32_t log_version_; //!< The version of "met_log" that was applied
+
+      foundation::FileWriter log_; //!< The CSV log of long runs
+      foundation::String log_path_; //!< The path of the open CSV log
+
+      static foundation::MetricHistogram frame_time_; //!< The frame times
+      static foundation::MetricCounter entities_updated_; //!< Entity updates
+      static foundation::MetricCounter draw_commands_; //!< Draw commands
+      static foundation::MetricCounter assets_loaded_; //!< Asset loads
+      static foundation::MetricCounter script_callbacks_; //!< Script calls
+      static foundation::MetricGauge frame_allocated_; //!< Frame allocations
+    };
+  }
+}
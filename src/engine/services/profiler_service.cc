@@ -0,0 +1,142 @@
+#include "engine/services/profiler_service.h"
+#include "engine/services/cvar_service.h"
+
+#include "engine/auxiliary/debug.h"
+
+#include <foundation/auxiliary/profiler.h>
+#include <foundation/io/file.h>
+
+namespace snuffbox
+{
+  namespace engine
+  {
+    //--------------------------------------------------------------------------
+    ProfilerService::ProfilerService() :
+      ServiceBase<ProfilerService>("ProfilerService"),
+      cvar_(nullptr),
+      pending_(false)
+    {
+
+    }
+
+    //--------------------------------------------------------------------------
+    foundation::ErrorCodes ProfilerService::OnInitialize(Application& app)
+    {
+      UpdateCapture();
+      return foundation::ErrorCodes::kSuccess;
+    }
+
+    //--------------------------------------------------------------------------
+    void ProfilerService::OnUpdate(Application& app, float dt)
+    {
+      UpdateCapture();
+    }
+
+    //--------------------------------------------------------------------------
+    void ProfilerService::OnShutdown(Application& app)
+    {
+      foundation::Profiler::Stop();
+
+      // The zones of the services are named after them, so the capture is
+      // written while they are still alive
+      if (pending_ == true)
+      {
+        WriteCapture(path_);
+        pending_ = false;
+      }
+
+      cvar_ = nullptr;
+    }
+
+    //--------------------------------------------------------------------------
+    void ProfilerService::RegisterCVars(CVarService* cvar)
+    {
+      CVarValue::Range frames;
+      frames.min = 0.0;
+      frames.has_min = true;
+
+      cvar->Register(
+        "prof_capture",
+        "Captures the profiler zones of the specified number of frames",
+        0.0,
+        frames);
+
+      cvar->Register(
+        "prof_capture_path",
+        "The path to write profiler captures to, in the Chrome Trace format",
+        foundation::String("profile.json"));
+
+      cvar_ = cvar;
+    }
+
+    //--------------------------------------------------------------------------
+    bool ProfilerService::WriteCapture(const foundation::String& path) const
+    {
+      if (foundation::Profiler::dropped() > 0)
+      {
+        Debug::LogVerbosity<1>(
+          foundation::LogSeverity::kWarning,
+          "The profiler dropped {0} event(s), consider capturing fewer frames",
+          foundation::Profiler::dropped());
+      }
+
+      foundation::File file(path, foundation::FileFlags::kWrite);
+
+      if (file.is_ok() == false)
+      {
+        Debug::LogVerbosity<1>(
+          foundation::LogSeverity::kError,
+          "Could not open '{0}' to write the profiler capture to",
+          path);
+
+        return false;
+      }
+
+      foundation::String trace = foundation::Profiler::ToChromeTrace();
+      file.Write(reinterpret_cast<const uint8_t*>(trace.c_str()), trace.size());
+
+      Debug::LogVerbosity<1>(
+        foundation::LogSeverity::kSuccess,
+        "Wrote the profiler capture to '{0}'",
+        path);
+
+      return true;
+    }
+
+    //--------------------------------------------------------------------------
+    void ProfilerService::UpdateCapture()
+    {
+      if (cvar_ == nullptr)
+      {
+        return;
+      }
+
+      uint32_t frames = static_cast<uint32_t>(
+        cvar_->Get<double>(SNUFF_STRING_ID("prof_capture")));
+
+      if (frames > 0)
+      {
+        cvar_->GetRaw(SNUFF_STRING_ID("prof_capture"))->Set("0");
+
+        path_ = cvar_->Get<foundation::String>(
+          SNUFF_STRING_ID("prof_capture_path"));
+        pending_ = true;
+
+        foundation::Profiler::Start(frames);
+
+        Debug::LogVerbosity<1>(
+          foundation::LogSeverity::kInfo,
+          "Started a profiler capture of {0} frame(s)",
+          frames);
+
+        return;
+      }
+
+      if (pending_ == true && foundation::Profiler::capturing() == false)
+      {
+        WriteCapture(path_);
+        pending_ = false;
+      }
+    }
+  }
+}
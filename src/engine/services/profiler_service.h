@@ -0,0 +1,82 @@
+#pragma once
+
+#include "engine/services/service.h"
+
+namespace snuffbox
+{
+  namespace engine
+  {
+    class CVarService;
+
+    /**
+    * @brief The profiler service to capture foundation::Profiler zones from
+    *        the command line
+    *
+    * Setting the "prof_capture" CVar to a number of frames starts a capture
+    * of that many frames. Once the capture has stopped, it is written in the
+    * Chrome Trace Event format to the path in "prof_capture_path". A capture
+    * that is still running when the application shuts down is written as
+    * well, so that setting "prof_capture" at startup profiles a whole run.
+    *
+    * @author Daniel Konings
+    */
+    class ProfilerService : public ServiceBase<ProfilerService>
+    {
+
+    public:
+
+      /**
+      * @see IService::IService
+      */
+      ProfilerService();
+
+    protected:
+
+      /**
+      * @see IService::OnInitialize
+      */
+      foundation::ErrorCodes OnInitialize(Application& app) override;
+
+      /**
+      * @see IService::OnUpdate
+      */
+      void OnUpdate(Application& app, float dt) override;
+
+      /**
+      * @see IService::OnShutdown
+      */
+      void OnShutdown(Application& app) override;
+
+      /**
+      * @see IService::RegisterCVars
+      */
+      void RegisterCVars(CVarService* cvar) override;
+
+    public:
+
+      /**
+      * @brief Writes the last capture to a file in the Chrome Trace Event
+      *        format
+      *
+      * @param[in] path The path to write the capture to
+      *
+      * @return Was the capture written succesfully?
+      */
+      bool WriteCapture(const foundation::String& path) const;
+
+    protected:
+
+      /**
+      * @brief Starts a capture if "prof_capture" is set, and writes the
+      *        capture once it has stopped
+      */
+      void UpdateCapture();
+
+    private:
+
+      CVarService* cvar_; //!< The CVar service
+      bool pending_; //!< Is there a capture that hasn't been written yet?
+      foundation::String path_; //!< The path to write the pending capture to
+    };
+  }
+}
@@ -1,5 +1,6 @@
 #include "engine/services/renderer_service.h"
 #include "engine/services/cvar_service.h"
+#include "engine/services/metrics_service.h"
 
 #include "engine/components/camera_component.h"
 #include "engine/components/mesh_component.h"
@@ -10,6 +11,7 @@
 #include "engine/assets/model_asset.h"
 
 #include <foundation/auxiliary/logger.h>
+#include <foundation/auxiliary/profiler.h>
 
 namespace snuffbox
 {
@@ -43,14 +45,16 @@ namespace snuffbox
     //--------------------------------------------------------------------------
     void RendererService::Render(float dt)
     {
+      SNUFF_PROFILE_ZONE("RendererService::Render");
+
       if (renderer_ == nullptr)
       {
         return;
       }
 
-      bool sync = cvar_->Get<bool>("r_vsync");
-      float w = cvar_->Get<float>("r_width");
-      float h = cvar_->Get<float>("r_height");
+      bool sync = cvar_->Get<bool>(SNUFF_STRING_ID("r_vsync"));
+      float w = cvar_->Get<float>(SNUFF_STRING_ID("r_width"));
+      float h = cvar_->Get<float>(SNUFF_STRING_ID("r_height"));
 
       renderer_->Tick(dt);
       renderer_->SetViewport(graphics::Viewport{ 0.0f, 0.0f, w, h });
@@ -137,6 +141,7 @@ namespace snuffbox
       cmd.mesh = m->IsValid() == true ? m->GetGPUHandle() : nullptr;
 
       renderer_->Queue(cmd);
+      MetricsService::draw_commands().Add();
     }
 
     //--------------------------------------------------------------------------
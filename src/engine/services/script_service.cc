@@ -5,6 +5,7 @@
 #include "engine/definitions/components.h"
 #include "engine/services/input_service.h"
 #include "engine/services/asset_service.h"
+#include "engine/services/metrics_service.h"
 #include "engine/ecs/entity.h"
 #include "engine/graphics/material.h"
 #include "engine/graphics/mesh.h"
@@ -14,6 +15,8 @@
 #include "engine/components/mesh_renderer_component.h"
 #include "engine/components/camera_component.h"
 
+#include <foundation/auxiliary/profiler.h>
+
 #ifndef SNUFF_NSCRIPTING
 #include "engine/components/script_component.h"
 #include <sparsed/keycodes.gen.cc>
@@ -54,36 +57,48 @@ namespace snuffbox
     //--------------------------------------------------------------------------
     void ScriptService::OnStartCallback()
     {
+      SNUFF_PROFILE_ZONE("ScriptService::OnStart");
+      MetricsService::script_callbacks().Add();
       on_start_.Call();
     }
 
     //--------------------------------------------------------------------------
     void ScriptService::OnUpdateCallback(float dt)
     {
+      SNUFF_PROFILE_ZONE("ScriptService::OnUpdate");
+      MetricsService::script_callbacks().Add();
       on_update_.Call(dt);
     }
 
     //--------------------------------------------------------------------------
     void ScriptService::OnFixedUpdateCallback(float time_step)
     {
+      SNUFF_PROFILE_ZONE("ScriptService::OnFixedUpdate");
+      MetricsService::script_callbacks().Add();
       on_fixed_update_.Call(time_step);
     }
 
     //--------------------------------------------------------------------------
     void ScriptService::OnRenderCallback(float dt)
     {
+      SNUFF_PROFILE_ZONE("ScriptService::OnRender");
+      MetricsService::script_callbacks().Add();
       on_render_.Call(dt);
     }
 
     //--------------------------------------------------------------------------
     void ScriptService::OnShutdownCallback()
     {
+      SNUFF_PROFILE_ZONE("ScriptService::OnShutdown");
+      MetricsService::script_callbacks().Add();
       on_shutdown_.Call();
     }
 
     //--------------------------------------------------------------------------
     void ScriptService::OnReloadCallback(const foundation::String& path)
     {
+      SNUFF_PROFILE_ZONE("ScriptService::OnReload");
+      MetricsService::script_callbacks().Add();
       on_reload_.Call(path);
     }
 
@@ -0,0 +1,409 @@
+#include "foundation/auxiliary/log_format.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace snuffbox
+{
+  namespace foundation
+  {
+    //--------------------------------------------------------------------------
+    LogBuffer::LogBuffer() :
+      data_(inline_),
+      capacity_(kInlineSize),
+      size_(0)
+    {
+      inline_[0] = '\0';
+    }
+
+    //--------------------------------------------------------------------------
+    void LogBuffer::Clear()
+    {
+      size_ = 0;
+      data_[0] = '\0';
+    }
+
+    //--------------------------------------------------------------------------
+    void LogBuffer::Append(const char* str, size_t length)
+    {
+      if (Reserve(length) == false)
+      {
+        length = capacity_ - size_ - 1;
+      }
+
+      memcpy(data_ + size_, str, length);
+      size_ += length;
+      data_[size_] = '\0';
+    }
+
+    //--------------------------------------------------------------------------
+    void LogBuffer::Append(char c)
+    {
+      Append(&c, 1);
+    }
+
+    //--------------------------------------------------------------------------
+    void LogBuffer::AppendSigned(int64_t value)
+    {
+      if (value < 0)
+      {
+        Append('-');
+        AppendUnsigned(0 - static_cast<uint64_t>(value));
+        return;
+      }
+
+      AppendUnsigned(static_cast<uint64_t>(value));
+    }
+
+    //--------------------------------------------------------------------------
+    void LogBuffer::AppendUnsigned(uint64_t value)
+    {
+      char digits[20];
+      size_t count = 0;
+
+      do
+      {
+        digits[sizeof(digits) - ++count] = '0' + static_cast<char>(value % 10);
+        value /= 10;
+      } while (value > 0);
+
+      Append(digits + sizeof(digits) - count, count);
+    }
+
+    //--------------------------------------------------------------------------
+    void LogBuffer::AppendFloat(double value)
+    {
+      char formatted[32];
+      int length = snprintf(formatted, sizeof(formatted), "%g", value);
+
+      if (length > 0)
+      {
+        Append(formatted, static_cast<size_t>(length));
+      }
+    }
+
+    //--------------------------------------------------------------------------
+    const char* LogBuffer::data() const
+    {
+      return data_;
+    }
+
+    //--------------------------------------------------------------------------
+    size_t LogBuffer::size() const
+    {
+      return size_;
+    }
+
+    //--------------------------------------------------------------------------
+    bool LogBuffer::Reserve(size_t length)
+    {
+      if (size_ + length + 1 <= capacity_)
+      {
+        return true;
+      }
+
+      size_t capacity = capacity_ * 2;
+
+      while (capacity < size_ + length + 1)
+      {
+        capacity *= 2;
+      }
+
+      // The buffer is shared by every message logged on a thread, including
+      // those logged by the allocators, so it doesn't use them itself
+      char* data = static_cast<char*>(
+        data_ == inline_ ? malloc(capacity) : realloc(data_, capacity));
+
+      if (data == nullptr)
+      {
+        return false;
+      }
+
+      if (data_ == inline_)
+      {
+        memcpy(data, inline_, size_ + 1);
+      }
+
+      data_ = data;
+      capacity_ = capacity;
+
+      return true;
+    }
+
+    //--------------------------------------------------------------------------
+    LogBuffer::~LogBuffer()
+    {
+      if (data_ != inline_)
+      {
+        free(data_);
+      }
+    }
+
+    //--------------------------------------------------------------------------
+    LogArgument::LogArgument() :
+      type(Types::kString)
+    {
+      str.data = "";
+      str.length = 0;
+    }
+
+    //--------------------------------------------------------------------------
+    LogArgument LogArgument::From(bool value)
+    {
+      LogArgument arg;
+      arg.type = Types::kBool;
+      arg.b = value;
+
+      return arg;
+    }
+
+    //--------------------------------------------------------------------------
+    LogArgument LogArgument::From(char value)
+    {
+      LogArgument arg;
+      arg.type = Types::kChar;
+      arg.c = value;
+
+      return arg;
+    }
+
+    //--------------------------------------------------------------------------
+    LogArgument LogArgument::From(signed char value)
+    {
+      return From(static_cast<char>(value));
+    }
+
+    //--------------------------------------------------------------------------
+    LogArgument LogArgument::From(unsigned char value)
+    {
+      return From(static_cast<char>(value));
+    }
+
+    //--------------------------------------------------------------------------
+    LogArgument LogArgument::From(short value)
+    {
+      return From(static_cast<long long>(value));
+    }
+
+    //--------------------------------------------------------------------------
+    LogArgument LogArgument::From(unsigned short value)
+    {
+      return From(static_cast<unsigned long long>(value));
+    }
+
+    //--------------------------------------------------------------------------
+    LogArgument LogArgument::From(int value)
+    {
+      return From(static_cast<long long>(value));
+    }
+
+    //--------------------------------------------------------------------------
+    LogArgument LogArgument::From(unsigned int value)
+    {
+      return From(static_cast<unsigned long long>(value));
+    }
+
+    //--------------------------------------------------------------------------
+    LogArgument LogArgument::From(long value)
+    {
+      return From(static_cast<long long>(value));
+    }
+
+    //--------------------------------------------------------------------------
+    LogArgument LogArgument::From(unsigned long value)
+    {
+      return From(static_cast<unsigned long long>(value));
+    }
+
+    //--------------------------------------------------------------------------
+    LogArgument LogArgument::From(long long value)
+    {
+      LogArgument arg;
+      arg.type = Types::kSigned;
+      arg.i = static_cast<int64_t>(value);
+
+      return arg;
+    }
+
+    //--------------------------------------------------------------------------
+    LogArgument LogArgument::From(unsigned long long value)
+    {
+      LogArgument arg;
+      arg.type = Types::kUnsigned;
+      arg.u = static_cast<uint64_t>(value);
+
+      return arg;
+    }
+
+    //--------------------------------------------------------------------------
+    LogArgument LogArgument::From(float value)
+    {
+      return From(static_cast<double>(value));
+    }
+
+    //--------------------------------------------------------------------------
+    LogArgument LogArgument::From(double value)
+    {
+      LogArgument arg;
+      arg.type = Types::kFloat;
+      arg.f = value;
+
+      return arg;
+    }
+
+    //--------------------------------------------------------------------------
+    LogArgument LogArgument::From(const char* value)
+    {
+      LogArgument arg;
+
+      if (value != nullptr)
+      {
+        arg.str.data = value;
+        arg.str.length = strlen(value);
+      }
+
+      return arg;
+    }
+
+    //--------------------------------------------------------------------------
+    LogArgument LogArgument::From(const String& value)
+    {
+      LogArgument arg;
+      arg.str.data = value.c_str();
+      arg.str.length = value.size();
+
+      return arg;
+    }
+
+    //--------------------------------------------------------------------------
+    LogArgument LogArgument::From(const Path& value)
+    {
+      return From(value.ToString());
+    }
+
+    //--------------------------------------------------------------------------
+    LogArgument LogArgument::From(const glm::vec2& value)
+    {
+      LogArgument arg;
+      arg.type = Types::kCustom;
+      arg.custom.value = &value;
+      arg.custom.format = &FormatVector<glm::vec2>;
+
+      return arg;
+    }
+
+    //--------------------------------------------------------------------------
+    LogArgument LogArgument::From(const glm::vec3& value)
+    {
+      LogArgument arg;
+      arg.type = Types::kCustom;
+      arg.custom.value = &value;
+      arg.custom.format = &FormatVector<glm::vec3>;
+
+      return arg;
+    }
+
+    //--------------------------------------------------------------------------
+    LogArgument LogArgument::From(const glm::vec4& value)
+    {
+      LogArgument arg;
+      arg.type = Types::kCustom;
+      arg.custom.value = &value;
+      arg.custom.format = &FormatVector<glm::vec4>;
+
+      return arg;
+    }
+
+    //--------------------------------------------------------------------------
+    void LogArgument::Write(LogBuffer* buffer) const
+    {
+      switch (type)
+      {
+      case Types::kSigned:
+        buffer->AppendSigned(i);
+        break;
+
+      case Types::kUnsigned:
+        buffer->AppendUnsigned(u);
+        break;
+
+      case Types::kFloat:
+        buffer->AppendFloat(f);
+        break;
+
+      case Types::kBool:
+        b == true ? buffer->Append("true", 4) : buffer->Append("false", 5);
+        break;
+
+      case Types::kChar:
+        buffer->Append(c);
+        break;
+
+      case Types::kString:
+        buffer->Append(str.data, str.length);
+        break;
+
+      case Types::kCustom:
+        custom.format(buffer, custom.value);
+        break;
+      }
+    }
+
+    //--------------------------------------------------------------------------
+    void LogFormatter::Format(
+      LogBuffer* buffer,
+      const char* format,
+      const LogArgument* args,
+      size_t count)
+    {
+      const char* literal = format;
+      const char* it = format;
+
+      while (*it != '\0')
+      {
+        if (*it != '{')
+        {
+          ++it;
+          continue;
+        }
+
+        buffer->Append(literal, static_cast<size_t>(it - literal));
+
+        // A placeholder without digits refers to the first argument, as it
+        // did when the index was parsed with atoi
+        size_t index = 0;
+
+        ++it;
+
+        while (*it >= '0' && *it <= '9')
+        {
+          index = index * 10 + static_cast<size_t>(*it - '0');
+          ++it;
+        }
+
+        while (*it != '}' && *it != '\0')
+        {
+          ++it;
+        }
+
+        if (*it == '}')
+        {
+          ++it;
+        }
+
+        literal = it;
+
+        if (index < count)
+        {
+          args[index].Write(buffer);
+          continue;
+        }
+
+        buffer->Append("<out of bounds>", 15);
+      }
+
+      buffer->Append(literal, static_cast<size_t>(it - literal));
+    }
+  }
+}
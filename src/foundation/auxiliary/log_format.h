@@ -0,0 +1,320 @@
+#pragma once
+
+#include "foundation/auxiliary/string_utils.h"
+
+#include <cinttypes>
+#include <cstddef>
+
+namespace snuffbox
+{
+  namespace foundation
+  {
+    /**
+    * @brief A character buffer that log messages are formatted into
+    *
+    * The buffer starts out with inline storage, so that formatting a message
+    * of a regular length never allocates. Longer messages move the buffer to
+    * the heap, where it stays for subsequent messages.
+    *
+    * @author Daniel Konings
+    */
+    class LogBuffer
+    {
+
+    public:
+
+      /**
+      * @brief The number of characters that are stored inline
+      */
+      static const size_t kInlineSize = 1024;
+
+      /**
+      * @brief Default constructor
+      */
+      LogBuffer();
+
+      /**
+      * @brief Non-copyable
+      */
+      LogBuffer(const LogBuffer&) = delete;
+
+      /**
+      * @brief Non-copyable
+      */
+      LogBuffer& operator=(const LogBuffer&) = delete;
+
+      /**
+      * @brief Empties the buffer, retaining its capacity
+      */
+      void Clear();
+
+      /**
+      * @brief Appends characters to the buffer
+      *
+      * @param[in] str The characters to append
+      * @param[in] length The number of characters to append
+      */
+      void Append(const char* str, size_t length);
+
+      /**
+      * @brief Appends a single character to the buffer
+      *
+      * @param[in] c The character to append
+      */
+      void Append(char c);
+
+      /**
+      * @brief Appends a signed integer in decimal notation
+      *
+      * @param[in] value The value to append
+      */
+      void AppendSigned(int64_t value);
+
+      /**
+      * @brief Appends an unsigned integer in decimal notation
+      *
+      * @param[in] value The value to append
+      */
+      void AppendUnsigned(uint64_t value);
+
+      /**
+      * @brief Appends a floating point value, formatted the same way an
+      *        std::ostream would by default
+      *
+      * @param[in] value The value to append
+      */
+      void AppendFloat(double value);
+
+      /**
+      * @return The null-terminated contents of the buffer
+      */
+      const char* data() const;
+
+      /**
+      * @return The number of characters in the buffer
+      */
+      size_t size() const;
+
+      /**
+      * @brief Releases the heap storage, if any
+      */
+      ~LogBuffer();
+
+    protected:
+
+      /**
+      * @brief Makes sure the buffer can hold a number of additional
+      *        characters, plus the null-terminator
+      *
+      * @param[in] length The number of characters to make room for
+      *
+      * @return Could the buffer make room?
+      */
+      bool Reserve(size_t length);
+
+    private:
+
+      char inline_[kInlineSize]; //!< The inline storage
+      char* data_; //!< The current storage, either inline or on the heap
+      size_t capacity_; //!< The capacity of the current storage
+      size_t size_; //!< The number of characters in the buffer
+    };
+
+    /**
+    * @brief A type-erased reference to a single log argument
+    *
+    * Common types are captured by value and written straight into a
+    * LogBuffer. Any other type is formatted through StringUtils::ToString.
+    *
+    * @author Daniel Konings
+    */
+    struct LogArgument
+    {
+      /**
+      * @brief The types of arguments that can be formatted directly
+      */
+      enum class Types
+      {
+        kSigned,
+        kUnsigned,
+        kFloat,
+        kBool,
+        kChar,
+        kString,
+        kCustom
+      };
+
+      /**
+      * @brief A function that formats a custom argument into a buffer
+      */
+      using FormatFunc = void(*)(LogBuffer*, const void*);
+
+      /**
+      * @brief Construct an empty string argument
+      */
+      LogArgument();
+
+      /**
+      * @brief Captures an argument of any type
+      *
+      * @param[in] value The value to capture, which must outlive the argument
+      *
+      * @return The captured argument
+      */
+      template <typename T>
+      static LogArgument From(const T& value);
+
+      /**
+      * @see LogArgument::From
+      *
+      * @remarks Overloads for the types that are formatted directly
+      */
+      static LogArgument From(bool value);
+      static LogArgument From(char value);
+      static LogArgument From(signed char value);
+      static LogArgument From(unsigned char value);
+      static LogArgument From(short value);
+      static LogArgument From(unsigned short value);
+      static LogArgument From(int value);
+      static LogArgument From(unsigned int value);
+      static LogArgument From(long value);
+      static LogArgument From(unsigned long value);
+      static LogArgument From(long long value);
+      static LogArgument From(unsigned long long value);
+      static LogArgument From(float value);
+      static LogArgument From(double value);
+      static LogArgument From(const char* value);
+      static LogArgument From(const String& value);
+      static LogArgument From(const Path& value);
+      static LogArgument From(const glm::vec2& value);
+      static LogArgument From(const glm::vec3& value);
+      static LogArgument From(const glm::vec4& value);
+
+      /**
+      * @brief Writes the argument into a buffer
+      *
+      * @param[in] buffer The buffer to write into
+      */
+      void Write(LogBuffer* buffer) const;
+
+      /**
+      * @brief Formats a value of any type through StringUtils::ToString
+      *
+      * @param[in] buffer The buffer to write into
+      * @param[in] value The value to format
+      */
+      template <typename T>
+      static void FormatCustom(LogBuffer* buffer, const void* value);
+
+      /**
+      * @brief Formats a vector as [x, y, ...]
+      *
+      * @param[in] buffer The buffer to write into
+      * @param[in] value The vector to format
+      */
+      template <typename T>
+      static void FormatVector(LogBuffer* buffer, const void* value);
+
+      Types type; //!< The type of the argument
+
+      union
+      {
+        int64_t i; //!< The value of a kSigned argument
+        uint64_t u; //!< The value of a kUnsigned argument
+        double f; //!< The value of a kFloat argument
+        bool b; //!< The value of a kBool argument
+        char c; //!< The value of a kChar argument
+
+        /**
+        * @brief The value of a kString argument
+        */
+        struct
+        {
+          const char* data; //!< The characters of the string
+          size_t length; //!< The length of the string
+        } str;
+
+        /**
+        * @brief The value of a kCustom argument
+        */
+        struct
+        {
+          const void* value; //!< The captured value
+          FormatFunc format; //!< The function to format the value with
+        } custom;
+      };
+    };
+
+    /**
+    * @brief Formats log messages C#-style, without intermediate strings
+    *
+    * @author Daniel Konings
+    */
+    class LogFormatter
+    {
+
+    public:
+
+      /**
+      * @brief Formats a message into a buffer
+      *
+      * The arguments are denoted with {n} in the format, where n is the index
+      * of the argument. The format is parsed in a single pass, writing
+      * literal text and arguments directly into the buffer.
+      *
+      * @param[out] buffer The buffer to write to
+      * @param[in] format The format of the message
+      * @param[in] args The arguments to format into the message
+      * @param[in] count The number of arguments
+      */
+      static void Format(
+        LogBuffer* buffer,
+        const char* format,
+        const LogArgument* args,
+        size_t count);
+    };
+
+    //--------------------------------------------------------------------------
+    template <typename T>
+    inline LogArgument LogArgument::From(const T& value)
+    {
+      LogArgument arg;
+      arg.type = Types::kCustom;
+      arg.custom.value = &value;
+      arg.custom.format = &FormatCustom<T>;
+
+      return arg;
+    }
+
+    //--------------------------------------------------------------------------
+    template <typename T>
+    inline void LogArgument::FormatCustom(LogBuffer* buffer, const void* value)
+    {
+      const T& v = *static_cast<const T*>(value);
+      String formatted = StringUtils::ToString<T>(v);
+
+      buffer->Append(formatted.c_str(), formatted.size());
+    }
+
+    //--------------------------------------------------------------------------
+    template <typename T>
+    inline void LogArgument::FormatVector(LogBuffer* buffer, const void* value)
+    {
+      const T& v = *static_cast<const T*>(value);
+
+      buffer->Append('[');
+
+      for (int i = 0; i < static_cast<int>(v.length()); ++i)
+      {
+        if (i > 0)
+        {
+          buffer->Append(", ", 2);
+        }
+
+        buffer->AppendFloat(v[i]);
+      }
+
+      buffer->Append(']');
+    }
+  }
+}
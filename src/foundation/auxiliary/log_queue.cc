@@ -0,0 +1,152 @@
+#include "foundation/auxiliary/log_queue.h"
+
+#include <cstdlib>
+#include <cstring>
+
+namespace snuffbox
+{
+  namespace foundation
+  {
+    //--------------------------------------------------------------------------
+    const char* LogRecord::data() const
+    {
+      return overflow != nullptr ? overflow : message;
+    }
+
+    //--------------------------------------------------------------------------
+    LogQueue::LogQueue() :
+      head_(0),
+      tail_(0)
+    {
+      for (size_t i = 0; i < kCapacity; ++i)
+      {
+        slots_[i].sequence.store(i, std::memory_order_relaxed);
+        slots_[i].record.overflow = nullptr;
+      }
+    }
+
+    //--------------------------------------------------------------------------
+    bool LogQueue::TryPush(
+      LogChannel channel,
+      LogSeverity severity,
+      std::time_t timestamp,
+      const char* message,
+      size_t length)
+    {
+      size_t pos = head_.load(std::memory_order_relaxed);
+      Slot* slot = nullptr;
+
+      for (;;)
+      {
+        slot = &slots_[pos & (kCapacity - 1)];
+        size_t seq = slot->sequence.load(std::memory_order_acquire);
+        intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+
+        if (diff == 0)
+        {
+          if (head_.compare_exchange_weak(
+            pos,
+            pos + 1,
+            std::memory_order_relaxed) == true)
+          {
+            break;
+          }
+        }
+        else if (diff < 0)
+        {
+          return false;
+        }
+        else
+        {
+          pos = head_.load(std::memory_order_relaxed);
+        }
+      }
+
+      LogRecord& record = slot->record;
+      record.channel = channel;
+      record.severity = severity;
+      record.timestamp = timestamp;
+      record.overflow = nullptr;
+
+      char* dest = record.message;
+
+      // Messages that don't fit inline are moved to the heap; if that fails
+      // the message is truncated rather than lost
+      if (length >= LogRecord::kInlineSize)
+      {
+        record.overflow = static_cast<char*>(malloc(length + 1));
+
+        if (record.overflow != nullptr)
+        {
+          dest = record.overflow;
+        }
+        else
+        {
+          length = LogRecord::kInlineSize - 1;
+        }
+      }
+
+      memcpy(dest, message, length);
+      dest[length] = '\0';
+      record.length = length;
+
+      slot->sequence.store(pos + 1, std::memory_order_release);
+
+      return true;
+    }
+
+    //--------------------------------------------------------------------------
+    const LogRecord* LogQueue::Front() const
+    {
+      size_t pos = tail_.load(std::memory_order_relaxed);
+      const Slot& slot = slots_[pos & (kCapacity - 1)];
+
+      if (slot.sequence.load(std::memory_order_acquire) != pos + 1)
+      {
+        return nullptr;
+      }
+
+      return &slot.record;
+    }
+
+    //--------------------------------------------------------------------------
+    void LogQueue::Pop()
+    {
+      size_t pos = tail_.load(std::memory_order_relaxed);
+      Slot& slot = slots_[pos & (kCapacity - 1)];
+
+      free(slot.record.overflow);
+      slot.record.overflow = nullptr;
+
+      slot.sequence.store(pos + kCapacity, std::memory_order_release);
+      tail_.store(pos + 1, std::memory_order_release);
+    }
+
+    //--------------------------------------------------------------------------
+    bool LogQueue::empty() const
+    {
+      return Front() == nullptr;
+    }
+
+    //--------------------------------------------------------------------------
+    size_t LogQueue::pushed() const
+    {
+      return head_.load(std::memory_order_acquire);
+    }
+
+    //--------------------------------------------------------------------------
+    size_t LogQueue::popped() const
+    {
+      return tail_.load(std::memory_order_acquire);
+    }
+
+    //--------------------------------------------------------------------------
+    LogQueue::~LogQueue()
+    {
+      while (Front() != nullptr)
+      {
+        Pop();
+      }
+    }
+  }
+}
@@ -0,0 +1,145 @@
+#pragma once
+
+#include "foundation/definitions/logging.h"
+
+#include <atomic>
+#include <cinttypes>
+#include <cstddef>
+#include <ctime>
+
+namespace snuffbox
+{
+  namespace foundation
+  {
+    /**
+    * @brief A single log message, as captured by the thread that logged it
+    *
+    * Short messages are stored inline. Longer messages are copied to the heap
+    * and released when the record is popped from the queue.
+    *
+    * @author Daniel Konings
+    */
+    struct LogRecord
+    {
+      /**
+      * @brief The number of characters that can be stored inline
+      */
+      static const size_t kInlineSize = 256;
+
+      /**
+      * @return The characters of the message
+      */
+      const char* data() const;
+
+      LogChannel channel; //!< The channel the message was logged to
+      LogSeverity severity; //!< The severity of the message
+      std::time_t timestamp; //!< The time at which the message was logged
+      size_t length; //!< The length of the message
+      char* overflow; //!< The message if it didn't fit inline, or nullptr
+      char message[kInlineSize]; //!< The inline message
+    };
+
+    /**
+    * @brief A bounded, lock-free queue of log records with multiple producers
+    *        and a single consumer
+    *
+    * Every slot carries a sequence number. Producers claim a position with a
+    * compare-and-swap on the head and publish the slot by advancing its
+    * sequence, so the consumer only ever sees fully written records, in the
+    * order in which their positions were claimed.
+    *
+    * @see Logger::Start
+    *
+    * @author Daniel Konings
+    */
+    class LogQueue
+    {
+
+    public:
+
+      /**
+      * @brief The number of records the queue can hold, a power of two
+      */
+      static const size_t kCapacity = 1024;
+
+      /**
+      * @brief Default constructor
+      */
+      LogQueue();
+
+      /**
+      * @brief Releases the messages that were never popped
+      */
+      ~LogQueue();
+
+      /**
+      * @brief Copies a message into the queue
+      *
+      * @remarks This function can be called from any thread
+      *
+      * @param[in] channel The channel of the message
+      * @param[in] severity The severity of the message
+      * @param[in] timestamp The time at which the message was logged
+      * @param[in] message The message to copy
+      * @param[in] length The length of the message
+      *
+      * @return Was there room for the message?
+      */
+      bool TryPush(
+        LogChannel channel,
+        LogSeverity severity,
+        std::time_t timestamp,
+        const char* message,
+        size_t length);
+
+      /**
+      * @brief Retrieves the oldest record in the queue
+      *
+      * @remarks This function should only be called from the consumer
+      *
+      * @return The record, or nullptr if the queue is empty
+      */
+      const LogRecord* Front() const;
+
+      /**
+      * @brief Releases the oldest record in the queue
+      *
+      * @remarks This function should only be called from the consumer, after
+      *          Front returned a record
+      */
+      void Pop();
+
+      /**
+      * @return Are there no records left to pop?
+      */
+      bool empty() const;
+
+      /**
+      * @return The number of positions that were claimed by producers
+      */
+      size_t pushed() const;
+
+      /**
+      * @return The number of records that were popped by the consumer
+      */
+      size_t popped() const;
+
+    private:
+
+      /**
+      * @brief A slot in the ring buffer
+      *
+      * @author Daniel Konings
+      */
+      struct Slot
+      {
+        std::atomic<size_t> sequence; //!< The position this slot is ready for
+        LogRecord record; //!< The record in this slot
+      };
+
+      Slot slots_[kCapacity]; //!< The ring buffer
+      std::atomic<size_t> head_; //!< The next position to push to
+      std::atomic<size_t> tail_; //!< The next position to pop from
+    };
+  }
+}
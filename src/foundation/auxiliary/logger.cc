@@ -3,6 +3,7 @@
 #include <chrono>
 #include <ctime>
 #include <cassert>
+#include <cstring>
 
 #ifdef SNUFF_WIN32
 #define localtime(x, y)   \
@@ -10,8 +11,8 @@ tm x;                     \
 localtime_s(&x, &y);
 #elif defined (SNUFF_LINUX)
 #define localtime(x, y)   \
-tm* temp = localtime(&y); \
-tm x = *temp;
+tm x;                     \
+localtime_r(&y, &x);
 #else
 #error "Unknown compiler platform"
 #endif
@@ -21,12 +22,30 @@ namespace snuffbox
   namespace foundation
   {
     //--------------------------------------------------------------------------
-    Logger::OutputStream Logger::stream_ = nullptr;
-    void* Logger::stream_ud_ = nullptr;
-
     const uint32_t Logger::kDefaultVerbosity_ = 1;
     uint32_t Logger::verbosity_ = Logger::kDefaultVerbosity_;
 
+    const uint32_t Logger::kWakeInterval_ = 50;
+
+    Logger::Sink Logger::sinks_[Logger::kMaxSinks_];
+    FILE* Logger::file_ = nullptr;
+    std::mutex Logger::output_mutex_;
+
+    LogQueue Logger::queue_;
+    LogOverflow Logger::policy_ = LogOverflow::kCoalesce;
+    std::atomic<bool> Logger::running_(false);
+    std::atomic<bool> Logger::sleeping_(false);
+    std::atomic<size_t> Logger::dropped_(0);
+    std::atomic<size_t> Logger::written_(0);
+    size_t Logger::reported_ = 0;
+    std::thread Logger::consumer_;
+
+    std::mutex Logger::wake_mutex_;
+    std::condition_variable Logger::wake_;
+
+    thread_local bool Logger::dispatching_ = false;
+    thread_local LogBuffer Logger::buffer_;
+
     //--------------------------------------------------------------------------
     void Logger::Assert(bool expr, const char* msg)
     {
@@ -48,51 +67,403 @@ namespace snuffbox
     //--------------------------------------------------------------------------
     void Logger::RedirectOutput(OutputStream func, void* ud)
     {
-      stream_ = func;
-      stream_ud_ = ud;
+      std::lock_guard<std::mutex> lock(output_mutex_);
+
+      sinks_[0].func = func;
+      sinks_[0].ud = ud;
     }
 
     //--------------------------------------------------------------------------
-    String Logger::FormatString(const char* format, const Vector<String>& args)
+    bool Logger::AddSink(OutputStream func, void* ud)
     {
-      size_t len = strlen(format);
+      std::lock_guard<std::mutex> lock(output_mutex_);
 
-      String formatted = "";
-      String arg = "";
+      for (size_t i = 1; i < kMaxSinks_; ++i)
+      {
+        if (sinks_[i].func == nullptr)
+        {
+          sinks_[i].func = func;
+          sinks_[i].ud = ud;
 
-      int argc;
+          return true;
+        }
+      }
 
-      for (size_t i = 0; i < len; ++i)
+      return false;
+    }
+
+    //--------------------------------------------------------------------------
+    void Logger::RemoveSink(OutputStream func, void* ud)
+    {
+      std::lock_guard<std::mutex> lock(output_mutex_);
+
+      for (size_t i = 1; i < kMaxSinks_; ++i)
       {
-        if (format[i] == '{')
+        if (sinks_[i].func == func && sinks_[i].ud == ud)
         {
-          ++i;
-          arg = "";
-
-          while (format[i] != '}' && i < len)
-          {
-            arg += format[i];
-            ++i;
-          }
-
-          argc = std::atoi(arg.c_str());
-          
-          if (argc < args.size())
-          {
-            formatted += args.at(argc);
-          }
-          else
-          {
-            formatted += "<out of bounds>";
-          }
+          sinks_[i].func = nullptr;
+          sinks_[i].ud = nullptr;
+        }
+      }
+    }
+
+    //--------------------------------------------------------------------------
+    bool Logger::SetOutputFile(const char* path)
+    {
+      FILE* file = nullptr;
+
+      if (path != nullptr && (file = fopen(path, "w")) == nullptr)
+      {
+        return false;
+      }
+
+      std::lock_guard<std::mutex> lock(output_mutex_);
+
+      if (file_ != nullptr)
+      {
+        fclose(file_);
+      }
+
+      file_ = file;
+
+      return true;
+    }
+
+    //--------------------------------------------------------------------------
+    void Logger::Start(LogOverflow policy)
+    {
+      if (running_.load() == true)
+      {
+        return;
+      }
+
+      policy_ = policy;
+      running_.store(true);
+
+      consumer_ = std::thread(&Logger::Consume);
+    }
+
+    //--------------------------------------------------------------------------
+    void Logger::Stop()
+    {
+      if (running_.exchange(false) == false)
+      {
+        return;
+      }
+
+      Wake();
+      consumer_.join();
+
+      // Producers that raced with stopping could have pushed after the last
+      // drain of the background thread
+      String batch;
+      String line;
+      Drain(&batch, &line);
+    }
+
+    //--------------------------------------------------------------------------
+    void Logger::Flush()
+    {
+      if (
+        running_.load() == false ||
+        std::this_thread::get_id() == consumer_.get_id())
+      {
+        return;
+      }
+
+      size_t target = queue_.pushed();
+
+      while (written_.load() < target && running_.load() == true)
+      {
+        Wake();
+        std::this_thread::yield();
+      }
+    }
+
+    //--------------------------------------------------------------------------
+    size_t Logger::dropped()
+    {
+      return dropped_.load();
+    }
+
+    //--------------------------------------------------------------------------
+    void Logger::Submit(
+      LogChannel channel,
+      LogSeverity severity,
+      const char* message,
+      size_t length)
+    {
+      if (running_.load() == false || dispatching_ == true)
+      {
+        WriteSync(channel, severity, message, length);
+        return;
+      }
+
+      std::time_t now = std::time(nullptr);
+
+      // Errors are never discarded, regardless of the policy
+      bool block =
+        policy_ == LogOverflow::kBlock ||
+        severity == LogSeverity::kError ||
+        severity == LogSeverity::kFatal;
+
+      while (queue_.TryPush(channel, severity, now, message, length) == false)
+      {
+        if (block == false)
+        {
+          dropped_.fetch_add(1);
+          return;
+        }
+
+        if (running_.load() == false)
+        {
+          WriteSync(channel, severity, message, length);
+          return;
+        }
+
+        Wake();
+        std::this_thread::yield();
+      }
+
+      if (sleeping_.load() == true)
+      {
+        Wake();
+      }
+
+      if (severity == LogSeverity::kFatal)
+      {
+        Flush();
+      }
+    }
+
+    //--------------------------------------------------------------------------
+    void Logger::WriteSync(
+      LogChannel channel,
+      LogSeverity severity,
+      const char* message,
+      size_t length)
+    {
+      String line;
+      FormatLine(severity, std::time(nullptr), message, length, &line);
 
+      // A message logged from within a sink is already holding the lock
+      if (dispatching_ == true)
+      {
+        fwrite(line.c_str(), 1, line.size(), stdout);
+        fflush(stdout);
+        return;
+      }
+
+      std::lock_guard<std::mutex> lock(output_mutex_);
+
+      fwrite(line.c_str(), 1, line.size(), stdout);
+      fflush(stdout);
+
+      if (file_ != nullptr)
+      {
+        fwrite(line.c_str(), 1, line.size(), file_);
+        fflush(file_);
+      }
+
+      line.pop_back();
+      Dispatch(channel, severity, line);
+    }
+
+    //--------------------------------------------------------------------------
+    void Logger::FormatLine(
+      LogSeverity severity,
+      std::time_t timestamp,
+      const char* message,
+      size_t length,
+      String* line)
+    {
+      line->clear();
+      line->append("[");
+      line->append(GetTimeStamp(timestamp));
+      line->append("|");
+      line->append(SeverityToString(severity));
+      line->append("] ");
+      line->append(message, length);
+      line->append("\n");
+    }
+
+    //--------------------------------------------------------------------------
+    void Logger::Dispatch(
+      LogChannel channel,
+      LogSeverity severity,
+      const String& line)
+    {
+      dispatching_ = true;
+
+      for (size_t i = 0; i < kMaxSinks_; ++i)
+      {
+        const Sink& sink = sinks_[i];
+
+        if (sink.func != nullptr)
+        {
+          sink.func(sink.ud, channel, severity, line);
+        }
+      }
+
+      dispatching_ = false;
+    }
+
+    //--------------------------------------------------------------------------
+    void Logger::Consume()
+    {
+      String batch;
+      String line;
+
+      for (;;)
+      {
+        if (Drain(&batch, &line) > 0)
+        {
           continue;
         }
 
-        formatted += format[i];
+        if (running_.load() == false)
+        {
+          break;
+        }
+
+        std::unique_lock<std::mutex> lock(wake_mutex_);
+        sleeping_.store(true);
+
+        if (queue_.empty() == true && running_.load() == true)
+        {
+          wake_.wait_for(lock, std::chrono::milliseconds(kWakeInterval_));
+        }
+
+        sleeping_.store(false);
+      }
+
+      Drain(&batch, &line);
+    }
+
+    //--------------------------------------------------------------------------
+    size_t Logger::Drain(String* batch, String* line)
+    {
+      const LogRecord* record = queue_.Front();
+      size_t total = dropped_.load();
+      size_t dropped = total - reported_;
+      reported_ = total;
+
+      if (record == nullptr && dropped == 0)
+      {
+        return 0;
+      }
+
+      std::lock_guard<std::mutex> lock(output_mutex_);
+
+      batch->clear();
+
+      size_t count = 0;
+      size_t repeated = 0;
+
+      String last;
+      LogChannel last_channel = LogChannel::kUnspecified;
+      LogSeverity last_severity = LogSeverity::kDebug;
+      std::time_t last_time = 0;
+
+      auto FlushRepeated = [&]()
+      {
+        if (repeated == 0)
+        {
+          return;
+        }
+
+        String note = "(the previous message was repeated ";
+        note += StringUtils::ToString(repeated);
+        note += " more time(s))";
+
+        FormatLine(last_severity, last_time, note.c_str(), note.size(), line);
+        batch->append(*line);
+
+        line->pop_back();
+        Dispatch(last_channel, last_severity, *line);
+
+        repeated = 0;
+      };
+
+      while (record != nullptr)
+      {
+        bool coalesce =
+          policy_ == LogOverflow::kCoalesce &&
+          count > 0 &&
+          record->channel == last_channel &&
+          record->severity == last_severity &&
+          record->length == last.size() &&
+          memcmp(record->data(), last.c_str(), last.size()) == 0;
+
+        if (coalesce == true)
+        {
+          ++repeated;
+          last_time = record->timestamp;
+        }
+        else
+        {
+          FlushRepeated();
+
+          FormatLine(
+            record->severity,
+            record->timestamp,
+            record->data(),
+            record->length,
+            line);
+
+          batch->append(*line);
+
+          line->pop_back();
+          Dispatch(record->channel, record->severity, *line);
+
+          last.assign(record->data(), record->length);
+          last_channel = record->channel;
+          last_severity = record->severity;
+          last_time = record->timestamp;
+        }
+
+        queue_.Pop();
+        ++count;
+
+        record = queue_.Front();
+      }
+
+      FlushRepeated();
+
+      if (dropped > 0)
+      {
+        String note = StringUtils::ToString(dropped);
+        note += " log message(s) were dropped, the log queue was full";
+
+        FormatLine(
+          LogSeverity::kWarning,
+          std::time(nullptr),
+          note.c_str(),
+          note.size(),
+          line);
+
+        batch->append(*line);
+      }
+
+      fwrite(batch->c_str(), 1, batch->size(), stdout);
+      fflush(stdout);
+
+      if (file_ != nullptr)
+      {
+        fwrite(batch->c_str(), 1, batch->size(), file_);
+        fflush(file_);
       }
 
-      return formatted;
+      written_.store(queue_.popped());
+
+      return count;
+    }
+
+    //--------------------------------------------------------------------------
+    void Logger::Wake()
+    {
+      std::lock_guard<std::mutex> lock(wake_mutex_);
+      wake_.notify_one();
     }
 
     //--------------------------------------------------------------------------
@@ -123,12 +494,8 @@ namespace snuffbox
     }
 
     //--------------------------------------------------------------------------
-    String Logger::GetTimeStamp()
+    String Logger::GetTimeStamp(std::time_t now)
     {
-      std::chrono::time_point<std::chrono::system_clock> tp = 
-        std::chrono::system_clock::now();
-
-      std::time_t now = std::chrono::system_clock::to_time_t(tp);
       localtime(time, now);
 
       auto FormatTime = [](int time)
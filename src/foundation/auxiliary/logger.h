@@ -6,8 +6,26 @@
 #include "foundation/containers/vector.h"
 
 #include "foundation/auxiliary/string_utils.h"
-
-#include <iostream>
+#include "foundation/auxiliary/log_format.h"
+#include "foundation/auxiliary/log_queue.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <ctime>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+
+/**
+* @brief The highest verbosity that log calls are compiled in for
+*
+* Calls to Logger::LogVerbosity with a higher verbosity compile to nothing,
+* their formatting code is not even instantiated.
+*/
+#ifndef SNUFF_MAX_VERBOSITY
+#define SNUFF_MAX_VERBOSITY 0xFFFFFFFF
+#endif
 
 namespace snuffbox
 {
@@ -21,6 +39,12 @@ namespace snuffbox
     * Aside from that there is support for different channels so log messages
     * can be filtered accordingly.
     *
+    * Messages are formatted on the calling thread. Once the logger has been
+    * started, they are handed to a LogQueue and a background thread writes
+    * them in batches to the console, the output file and every sink. Until
+    * then, or after the logger has been stopped, messages are written
+    * synchronously. Fatal messages are always flushed before Log returns.
+    *
     * @author Daniel Konings
     */
     class Logger
@@ -33,6 +57,13 @@ namespace snuffbox
       */
       using OutputStream = void(*)(void*, LogChannel, LogSeverity, const String&);
 
+      /**
+      * @brief The highest verbosity that is compiled in
+      *
+      * @see SNUFF_MAX_VERBOSITY
+      */
+      static const uint32_t kMaxVerbosity = SNUFF_MAX_VERBOSITY;
+
       /**
       * @brief Logs a message to a specified logging stream with a 
       *        specified severity
@@ -52,7 +83,7 @@ namespace snuffbox
         LogChannel channel, 
         LogSeverity severity,
         const char* format, 
-        Args... args);
+        const Args&... args);
 
       /**
       * @see Logger::Log
@@ -61,7 +92,7 @@ namespace snuffbox
       *        with LogSeverity::kDebug severity
       */
       template <typename ... Args>
-      static void Log(const char* format, Args... args);
+      static void Log(const char* format, const Args&... args);
 
       /**
       * @brief An assert that logs a message to the console as well
@@ -82,13 +113,15 @@ namespace snuffbox
       *
       * The log only gets redirected to the output if the verbosity level
       * is above or equal to the currently set verbosity in Logger::verbosity_
+      *
+      * Verbosities above Logger::kMaxVerbosity are compiled out entirely.
       */
       template <uint32_t V, typename ... Args>
       static void LogVerbosity(
         LogChannel channel,
         LogSeverity severity,
         const char* format,
-        Args... args);
+        const Args&... args);
 
       /**
       * @see Logger::LogVerbosity
@@ -97,7 +130,7 @@ namespace snuffbox
       *        but with a verbosity level, using LogSeverity::kDebug severity
       */
       template <uint32_t V, typename ... Args>
-      static void LogVerbosity(const char* format, Args... args);
+      static void LogVerbosity(const char* format, const Args&... args);
 
       /**
       * @brief Sets the verbosity level of the logger
@@ -120,57 +153,167 @@ namespace snuffbox
       */
       static void RedirectOutput(OutputStream func, void* ud);
 
+      /**
+      * @brief Adds an additional sink that receives every formatted message
+      *
+      * @param[in] func The function to send the output to
+      * @param[in] ud The user data to send with the logging function
+      *
+      * @return Was there room for another sink?
+      */
+      static bool AddSink(OutputStream func, void* ud);
+
+      /**
+      * @brief Removes a sink that was added with Logger::AddSink
+      *
+      * When this function returns, the sink is guaranteed to no longer be
+      * called.
+      *
+      * @param[in] func The function of the sink
+      * @param[in] ud The user data of the sink
+      */
+      static void RemoveSink(OutputStream func, void* ud);
+
+      /**
+      * @brief Writes every message to a file, in addition to the console
+      *
+      * @param[in] path The path to the file, or nullptr to close the current
+      *                 output file
+      *
+      * @return Could the file be opened?
+      */
+      static bool SetOutputFile(const char* path);
+
+      /**
+      * @brief Starts the background thread that writes the log messages
+      *
+      * @param[in] policy What to do with messages while the queue is full;
+      *                   errors and fatal messages are never discarded
+      */
+      static void Start(LogOverflow policy = LogOverflow::kCoalesce);
+
+      /**
+      * @brief Writes the remaining messages and stops the background thread,
+      *        after which messages are written synchronously again
+      */
+      static void Stop();
+
+      /**
+      * @brief Waits until every message that was logged before this call
+      *        has been written
+      */
+      static void Flush();
+
+      /**
+      * @return The number of messages that were discarded because the queue
+      *         was full
+      */
+      static size_t dropped();
+
     protected:
 
       /**
-      * @brief Retrieves the string values of each argument in a variadic
-      *        argument list
+      * @brief Hands a formatted message to the queue, or writes it
+      *        synchronously if the logger is not running
       *
-      * This is the first function of the recursive unroll
+      * @param[in] channel The channel to log in
+      * @param[in] severity The severity to log with
+      * @param[in] message The formatted message
+      * @param[in] length The length of the message
+      */
+      static void Submit(
+        LogChannel channel,
+        LogSeverity severity,
+        const char* message,
+        size_t length);
+
+      /**
+      * @brief Writes a message on the calling thread
+      *
+      * @see Logger::Submit
+      */
+      static void WriteSync(
+        LogChannel channel,
+        LogSeverity severity,
+        const char* message,
+        size_t length);
+
+      /**
+      * @brief Formats a message into a full log line, including the
+      *        timestamp and the severity
       *
-      * @tparam T The value to format during this function call
-      * @tparam Args... The arguments to format the string with
+      * @param[in] severity The severity of the message
+      * @param[in] timestamp The time at which the message was logged
+      * @param[in] message The message
+      * @param[in] length The length of the message
+      * @param[out] line The string to write the line to
+      */
+      static void FormatLine(
+        LogSeverity severity,
+        std::time_t timestamp,
+        const char* message,
+        size_t length,
+        String* line);
+
+      /**
+      * @brief Sends a formatted line to every sink
       *
-      * @param[in] stringified The list of strings to append the result to
-      * @param[in] value The value to format
-      * @param[in] args The arguments to format into the string
+      * @remarks This should only be called while holding the sink lock
       *
-      * @return The number of formatted arguments
+      * @param[in] channel The channel of the line
+      * @param[in] severity The severity of the line
+      * @param[in] line The formatted line
       */
-      template <typename T, typename ... Args>
-      static uint32_t GetArguments(
-        Vector<String>& stringified,
-        const T& value, 
-        Args... args);
+      static void Dispatch(
+        LogChannel channel,
+        LogSeverity severity,
+        const String& line);
 
       /**
-      * @brief This is the function that is called when there is only 
-      *        1 argument left
+      * @brief The main loop of the background thread
+      */
+      static void Consume();
+
+      /**
+      * @brief Writes every record that is currently in the queue
+      *
+      * @param[in] batch The buffer to collect the output in
+      * @param[in] line The buffer to format each line in
       *
-      * @see Logger::GetArguments<T, Args...>
+      * @return The number of records that were written
+      */
+      static size_t Drain(String* batch, String* line);
+
+      /**
+      * @brief Wakes up the background thread if it is waiting for messages
       */
-      template <typename T>
-      static uint32_t GetArguments(
-        Vector<String>& stringified,
-        const T& value);
+      static void Wake();
 
       /**
-      * @brief This is the function that is called when there are 
-      *        no arguments left
+      * @brief Logs with a verbosity that is compiled in
       *
-      * @see Logger::GetArguments<T, Args...>
+      * @see Logger::LogVerbosity
       */
-      static uint32_t GetArguments(Vector<String>& args);
+      template <uint32_t V, typename ... Args>
+      static void LogVerbosity(
+        std::true_type,
+        LogChannel channel,
+        LogSeverity severity,
+        const char* format,
+        const Args&... args);
 
       /**
-      * @brief Formats a string C#-style with given string arguments
+      * @brief Logs with a verbosity that is compiled out, which does nothing
       *
-      * @param[in] format The format to format the arguments into
-      * @param[in] args The list of stringified arguments
+      * @see Logger::LogVerbosity
       */
-      static String FormatString(
-        const char* format, 
-        const Vector<String>& args);
+      template <uint32_t V, typename ... Args>
+      static void LogVerbosity(
+        std::false_type,
+        LogChannel channel,
+        LogSeverity severity,
+        const char* format,
+        const Args&... args);
 
       /**
       * @brief Converts a severity to a string value
@@ -182,17 +325,73 @@ namespace snuffbox
       static const char* SeverityToString(LogSeverity verbosity);
 
       /**
-      * @return A timestamp string based on the current system time
+      * @brief Formats a time as a timestamp string
+      *
+      * @param[in] time The time to format
+      *
+      * @return The timestamp, as HH:MM:SS
       */
-      static String GetTimeStamp();
+      static String GetTimeStamp(std::time_t time);
 
     private:
 
-      static OutputStream stream_; //!< The output stream
-      static void* stream_ud_; //!< The user data to pass into the output stream
+      /**
+      * @brief An output stream along with its user data
+      *
+      * @author Daniel Konings
+      */
+      struct Sink
+      {
+        OutputStream func; //!< The output stream
+        void* ud; //!< The user data to pass into the output stream
+      };
 
       static const uint32_t kDefaultVerbosity_; //!< The default verbosity
       static uint32_t verbosity_; //!< The currently set verbosity
+
+      /**
+      * @brief The maximum number of sinks, including the redirected output
+      */
+      static const size_t kMaxSinks_ = 8;
+
+      /**
+      * @brief The maximum time the background thread sleeps before checking
+      *        the queue, in milliseconds
+      */
+      static const uint32_t kWakeInterval_;
+
+      static Sink sinks_[kMaxSinks_]; //!< The sinks, the first is redirected
+      static FILE* file_; //!< The output file, or nullptr if there is none
+
+      /**
+      * @brief The lock around the sinks and the output, held while writing
+      */
+      static std::mutex output_mutex_;
+
+      static LogQueue queue_; //!< The queue of messages to write
+      static LogOverflow policy_; //!< The policy when the queue is full
+      static std::atomic<bool> running_; //!< Is the background thread running?
+      static std::atomic<bool> sleeping_; //!< Is the thread waiting?
+      static std::atomic<size_t> dropped_; //!< The number of dropped messages
+      static std::atomic<size_t> written_; //!< The number of written records
+      static size_t reported_; //!< The number of reported dropped messages
+      static std::thread consumer_; //!< The background thread
+
+      static std::mutex wake_mutex_; //!< The lock for waking up the thread
+      static std::condition_variable wake_; //!< Wakes up the thread
+
+      /**
+      * @brief Is the current thread sending a message to the sinks?
+      *
+      * Messages that are logged from within a sink are only written to the
+      * console, to avoid recursing into the sinks.
+      */
+      static thread_local bool dispatching_;
+
+      /**
+      * @brief The buffer that messages are formatted into on each thread
+      */
+      static thread_local LogBuffer buffer_;
     };
 
     //--------------------------------------------------------------------------
@@ -201,35 +400,31 @@ namespace snuffbox
       LogChannel channel,
       LogSeverity severity,
       const char* format,
-      Args... args)
+      const Args&... args)
     {
-      Vector<String> stringified;
-      GetArguments(stringified, eastl::forward<Args>(args)...);
-
-      String message = 
-        "[" +
-        GetTimeStamp() + "|" +
-        String(SeverityToString(severity)) +
-        "] " +
-        FormatString(format, stringified);
-      
-      std::cout << message.c_str() << std::endl;
-
-      if (stream_ != nullptr)
+      // The trailing argument avoids a zero-sized array without arguments
+      const LogArgument arguments[] =
       {
-        stream_(stream_ud_, channel, severity, message);
-      }
+        LogArgument::From(args)...,
+        LogArgument()
+      };
+
+      LogBuffer& buffer = buffer_;
+      buffer.Clear();
+
+      LogFormatter::Format(&buffer, format, arguments, sizeof...(Args));
+      Submit(channel, severity, buffer.data(), buffer.size());
     }
 
     //--------------------------------------------------------------------------
     template <typename ... Args>
-    inline void Logger::Log(const char* format, Args... args)
+    inline void Logger::Log(const char* format, const Args&... args)
     {
       Log(
         LogChannel::kUnspecified,
         LogSeverity::kDebug,
         format,
-        eastl::forward<Args>(args)...);
+        args...);
     }
 
     //--------------------------------------------------------------------------
@@ -238,52 +433,54 @@ namespace snuffbox
       LogChannel channel,
       LogSeverity severity,
       const char* format,
-      Args... args)
+      const Args&... args)
     {
       static_assert(V != 0, "Logging with a verbosity of 0 is redundant");
 
-      if (V <= verbosity_)
-      {
-        Log(channel, severity, format, eastl::forward<Args>(args)...);
-      }
+      LogVerbosity<V>(
+        std::integral_constant<bool, V <= kMaxVerbosity>(),
+        channel,
+        severity,
+        format,
+        args...);
     }
 
     //--------------------------------------------------------------------------
     template <uint32_t V, typename ... Args>
-    inline void Logger::LogVerbosity(const char* format, Args... args)
+    inline void Logger::LogVerbosity(const char* format, const Args&... args)
     {
-      LogVerbosity<V, Args...>(
+      LogVerbosity<V>(
         LogChannel::kUnspecified,
         LogSeverity::kDebug,
         format,
-        eastl::forward<Args>(args)...);
+        args...);
     }
 
     //--------------------------------------------------------------------------
-    template <typename T, typename ... Args>
-    inline uint32_t Logger::GetArguments(
-      Vector<String>& stringified,
-      const T& value, 
-      Args... args)
+    template <uint32_t V, typename ... Args>
+    inline void Logger::LogVerbosity(
+      std::true_type,
+      LogChannel channel,
+      LogSeverity severity,
+      const char* format,
+      const Args&... args)
     {
-      stringified.push_back(StringUtils::ToString<T>(value));
-      return GetArguments(stringified, eastl::forward<Args>(args)...) + 1;
+      if (V <= verbosity_)
+      {
+        Log(channel, severity, format, args...);
+      }
     }
 
     //--------------------------------------------------------------------------
-    template <typename T>
-    inline uint32_t Logger::GetArguments(
-      Vector<String>& stringified,
-      const T& value)
+    template <uint32_t V, typename ... Args>
+    inline void Logger::LogVerbosity(
+      std::false_type,
+      LogChannel channel,
+      LogSeverity severity,
+      const char* format,
+      const Args&... args)
     {
-      stringified.push_back(StringUtils::ToString<T>(value));
-      return 1;
-    }
 
-    //--------------------------------------------------------------------------
-    inline uint32_t Logger::GetArguments(Vector<String>& formatted)
-    {
-      return 0;
     }
   }
 }
\ No newline at end of file
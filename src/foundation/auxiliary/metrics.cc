@@ -0,0 +1,522 @@
+#include "foundation/auxiliary/metrics.h"
+#include "foundation/auxiliary/logger.h"
+#include "foundation/auxiliary/string_utils.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace snuffbox
+{
+  namespace foundation
+  {
+    //--------------------------------------------------------------------------
+    std::mutex MetricsRegistry::mutex_;
+    IMetric* MetricsRegistry::head_ = nullptr;
+    IMetric* MetricsRegistry::tail_ = nullptr;
+    std::atomic<uint32_t> MetricsRegistry::frame_(0);
+
+    //--------------------------------------------------------------------------
+    IMetric::IMetric(const char* name, Types type) :
+      name_(name),
+      type_(type),
+      prev_(nullptr),
+      next_(nullptr)
+    {
+      MetricsRegistry::Register(this);
+    }
+
+    //--------------------------------------------------------------------------
+    const char* IMetric::name() const
+    {
+      return name_;
+    }
+
+    //--------------------------------------------------------------------------
+    void IMetric::set_name(const char* name)
+    {
+      name_ = name;
+    }
+
+    //--------------------------------------------------------------------------
+    IMetric::Types IMetric::type() const
+    {
+      return type_;
+    }
+
+    //--------------------------------------------------------------------------
+    void IMetric::EndFrame()
+    {
+
+    }
+
+    //--------------------------------------------------------------------------
+    IMetric::Statistics IMetric::BaseStatistics() const
+    {
+      Statistics stats;
+      stats.name = name_;
+      stats.type = type_;
+      stats.value = 0.0;
+      stats.total = 0;
+      stats.min = stats.mean = stats.max = 0.0;
+      stats.p50 = stats.p95 = stats.p99 = 0.0;
+      stats.acquisitions = stats.contended = 0;
+      stats.wait_ms = stats.max_wait_ms = stats.hold_ms = 0.0;
+
+      return stats;
+    }
+
+    //--------------------------------------------------------------------------
+    IMetric::~IMetric()
+    {
+      MetricsRegistry::Unregister(this);
+    }
+
+    //--------------------------------------------------------------------------
+    MetricCounter::MetricCounter(const char* name) :
+      IMetric(name, Types::kCounter),
+      total_(0),
+      last_(0),
+      frame_(0)
+    {
+
+    }
+
+    //--------------------------------------------------------------------------
+    void MetricCounter::Add(uint64_t count)
+    {
+      total_.fetch_add(count, std::memory_order_relaxed);
+    }
+
+    //--------------------------------------------------------------------------
+    IMetric::Statistics MetricCounter::statistics() const
+    {
+      Statistics stats = BaseStatistics();
+      stats.value = static_cast<double>(frame_);
+      stats.total = total_.load(std::memory_order_relaxed);
+
+      return stats;
+    }
+
+    //--------------------------------------------------------------------------
+    void MetricCounter::EndFrame()
+    {
+      uint64_t total = total_.load(std::memory_order_relaxed);
+
+      frame_ = total - last_;
+      last_ = total;
+    }
+
+    //--------------------------------------------------------------------------
+    MetricGauge::MetricGauge(const char* name) :
+      IMetric(name, Types::kGauge),
+      value_(0.0)
+    {
+
+    }
+
+    //--------------------------------------------------------------------------
+    void MetricGauge::Set(double value)
+    {
+      value_.store(value, std::memory_order_relaxed);
+    }
+
+    //--------------------------------------------------------------------------
+    IMetric::Statistics MetricGauge::statistics() const
+    {
+      Statistics stats = BaseStatistics();
+      stats.value = value_.load(std::memory_order_relaxed);
+
+      return stats;
+    }
+
+    //--------------------------------------------------------------------------
+    MetricHistogram::MetricHistogram(const char* name) :
+      IMetric(name, Types::kHistogram),
+      count_(0),
+      next_(0),
+      last_(0.0)
+    {
+
+    }
+
+    //--------------------------------------------------------------------------
+    void MetricHistogram::Record(double value)
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+
+      samples_[next_] = value;
+      next_ = (next_ + 1) % kWindowSize;
+      last_ = value;
+
+      if (count_ < kWindowSize)
+      {
+        ++count_;
+      }
+    }
+
+    //--------------------------------------------------------------------------
+    IMetric::Statistics MetricHistogram::statistics() const
+    {
+      Statistics stats = BaseStatistics();
+
+      double sorted[kWindowSize];
+      size_t count = 0;
+
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        count = count_;
+        stats.value = last_;
+
+        std::copy(samples_, samples_ + count, sorted);
+      }
+
+      stats.total = count;
+
+      if (count == 0)
+      {
+        return stats;
+      }
+
+      std::sort(sorted, sorted + count);
+
+      double sum = 0.0;
+      for (size_t i = 0; i < count; ++i)
+      {
+        sum += sorted[i];
+      }
+
+      stats.min = sorted[0];
+      stats.max = sorted[count - 1];
+      stats.mean = sum / static_cast<double>(count);
+      stats.p50 = Percentile(sorted, count, 50.0);
+      stats.p95 = Percentile(sorted, count, 95.0);
+      stats.p99 = Percentile(sorted, count, 99.0);
+
+      return stats;
+    }
+
+    //--------------------------------------------------------------------------
+    double MetricHistogram::Percentile(
+      const double* sorted,
+      size_t count,
+      double percentile)
+    {
+      double rank = std::ceil(percentile / 100.0 * static_cast<double>(count));
+      size_t index = rank < 1.0 ? 0 : static_cast<size_t>(rank) - 1;
+
+      return sorted[std::min(index, count - 1)];
+    }
+
+    //--------------------------------------------------------------------------
+    void MetricsRegistry::EndFrame()
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+
+      IMetric* current = head_;
+
+      while (current != nullptr)
+      {
+        current->EndFrame();
+        current = current->next_;
+      }
+
+      frame_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    //--------------------------------------------------------------------------
+    uint32_t MetricsRegistry::frame()
+    {
+      return frame_.load(std::memory_order_relaxed);
+    }
+
+    //--------------------------------------------------------------------------
+    Vector<IMetric::Statistics> MetricsRegistry::Snapshot()
+    {
+      Vector<IMetric::Statistics> result;
+
+      std::lock_guard<std::mutex> lock(mutex_);
+
+      IMetric* current = head_;
+
+      while (current != nullptr)
+      {
+        result.push_back(current->statistics());
+        current = current->next_;
+      }
+
+      return result;
+    }
+
+    //--------------------------------------------------------------------------
+    void MetricsRegistry::Dump()
+    {
+      Vector<IMetric::Statistics> snapshot = Snapshot();
+
+      Logger::Log(
+        LogChannel::kUnspecified,
+        LogSeverity::kInfo,
+        "Metrics at frame {0}, {1} metric(s)",
+        frame(),
+        snapshot.size());
+
+      for (size_t i = 0; i < snapshot.size(); ++i)
+      {
+        const IMetric::Statistics& s = snapshot.at(i);
+
+        switch (s.type)
+        {
+        case IMetric::Types::kCounter:
+          Logger::Log(
+            LogChannel::kUnspecified,
+            LogSeverity::kInfo,
+            "  {0}: {1} last frame, {2} in total",
+            s.name,
+            s.value,
+            s.total);
+          break;
+
+        case IMetric::Types::kGauge:
+          Logger::Log(
+            LogChannel::kUnspecified,
+            LogSeverity::kInfo,
+            "  {0}: {1}",
+            s.name,
+            s.value);
+          break;
+
+        case IMetric::Types::kHistogram:
+          Logger::Log(
+            LogChannel::kUnspecified,
+            LogSeverity::kInfo,
+            "  {0}: p50 {1}, p95 {2}, p99 {3}, min {4}, max {5} "
+            "over {6} sample(s)",
+            s.name,
+            s.p50,
+            s.p95,
+            s.p99,
+            s.min,
+            s.max,
+            s.total);
+          break;
+
+        case IMetric::Types::kLock:
+          Logger::Log(
+            LogChannel::kUnspecified,
+            LogSeverity::kInfo,
+            "  {0}: {1} of {2} acquisition(s) contended, waited {3} ms "
+            "(longest {4} ms), held {5} ms",
+            s.name,
+            s.contended,
+            s.acquisitions,
+            s.wait_ms,
+            s.max_wait_ms,
+            s.hold_ms);
+          break;
+        }
+      }
+    }
+
+    //--------------------------------------------------------------------------
+    String MetricsRegistry::ToJson()
+    {
+      Vector<IMetric::Statistics> snapshot = Snapshot();
+
+      String json = "{\"frame\":" + StringUtils::ToString(frame());
+      json += ",\"metrics\":[";
+
+      for (size_t i = 0; i < snapshot.size(); ++i)
+      {
+        const IMetric::Statistics& s = snapshot.at(i);
+
+        json += i > 0 ? ",{" : "{";
+        json += "\"name\":\"" + String(s.name) + "\"";
+
+        switch (s.type)
+        {
+        case IMetric::Types::kCounter:
+          json += ",\"type\":\"counter\"";
+          json += ",\"frame\":" + NumberToString(s.value);
+          json += ",\"total\":" + StringUtils::ToString(s.total);
+          break;
+
+        case IMetric::Types::kGauge:
+          json += ",\"type\":\"gauge\"";
+          json += ",\"value\":" + NumberToString(s.value);
+          break;
+
+        case IMetric::Types::kHistogram:
+          json += ",\"type\":\"histogram\"";
+          json += ",\"samples\":" + StringUtils::ToString(s.total);
+          json += ",\"last\":" + NumberToString(s.value);
+          json += ",\"min\":" + NumberToString(s.min);
+          json += ",\"mean\":" + NumberToString(s.mean);
+          json += ",\"p50\":" + NumberToString(s.p50);
+          json += ",\"p95\":" + NumberToString(s.p95);
+          json += ",\"p99\":" + NumberToString(s.p99);
+          json += ",\"max\":" + NumberToString(s.max);
+          break;
+
+        case IMetric::Types::kLock:
+          json += ",\"type\":\"lock\"";
+          json += ",\"acquisitions\":" + StringUtils::ToString(s.acquisitions);
+          json += ",\"contended\":" + StringUtils::ToString(s.contended);
+          json += ",\"wait_ms\":" + NumberToString(s.wait_ms);
+          json += ",\"max_wait_ms\":" + NumberToString(s.max_wait_ms);
+          json += ",\"hold_ms\":" + NumberToString(s.hold_ms);
+          break;
+        }
+
+        json += "}";
+      }
+
+      json += "]}";
+
+      return json;
+    }
+
+    //--------------------------------------------------------------------------
+    String MetricsRegistry::ToCsvHeader()
+    {
+      Vector<IMetric::Statistics> snapshot = Snapshot();
+
+      String csv = "frame";
+
+      for (size_t i = 0; i < snapshot.size(); ++i)
+      {
+        const IMetric::Statistics& s = snapshot.at(i);
+        String name = s.name;
+
+        switch (s.type)
+        {
+        case IMetric::Types::kCounter:
+          csv += "," + name + "," + name + "_total";
+          break;
+
+        case IMetric::Types::kGauge:
+          csv += "," + name;
+          break;
+
+        case IMetric::Types::kHistogram:
+          csv += "," + name + "_p50," + name + "_p95," + name + "_p99";
+          csv += "," + name + "_max";
+          break;
+
+        case IMetric::Types::kLock:
+          csv += "," + name + "_acquisitions," + name + "_contended";
+          csv += "," + name + "_wait_ms," + name + "_hold_ms";
+          break;
+        }
+      }
+
+      csv += "\n";
+
+      return csv;
+    }
+
+    //--------------------------------------------------------------------------
+    String MetricsRegistry::ToCsvRow()
+    {
+      Vector<IMetric::Statistics> snapshot = Snapshot();
+
+      String csv = StringUtils::ToString(frame());
+
+      for (size_t i = 0; i < snapshot.size(); ++i)
+      {
+        const IMetric::Statistics& s = snapshot.at(i);
+
+        switch (s.type)
+        {
+        case IMetric::Types::kCounter:
+          csv += "," + NumberToString(s.value);
+          csv += "," + StringUtils::ToString(s.total);
+          break;
+
+        case IMetric::Types::kGauge:
+          csv += "," + NumberToString(s.value);
+          break;
+
+        case IMetric::Types::kHistogram:
+          csv += "," + NumberToString(s.p50);
+          csv += "," + NumberToString(s.p95);
+          csv += "," + NumberToString(s.p99);
+          csv += "," + NumberToString(s.max);
+          break;
+
+        case IMetric::Types::kLock:
+          csv += "," + StringUtils::ToString(s.acquisitions);
+          csv += "," + StringUtils::ToString(s.contended);
+          csv += "," + NumberToString(s.wait_ms);
+          csv += "," + NumberToString(s.hold_ms);
+          break;
+        }
+      }
+
+      csv += "\n";
+
+      return csv;
+    }
+
+    //--------------------------------------------------------------------------
+    void MetricsRegistry::Register(IMetric* metric)
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+
+      metric->prev_ = tail_;
+      metric->next_ = nullptr;
+
+      if (tail_ != nullptr)
+      {
+        tail_->next_ = metric;
+      }
+      else
+      {
+        head_ = metric;
+      }
+
+      tail_ = metric;
+    }
+
+    //--------------------------------------------------------------------------
+    void MetricsRegistry::Unregister(IMetric* metric)
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+
+      if (metric->prev_ != nullptr)
+      {
+        metric->prev_->next_ = metric->next_;
+      }
+      else if (head_ == metric)
+      {
+        head_ = metric->next_;
+      }
+
+      if (metric->next_ != nullptr)
+      {
+        metric->next_->prev_ = metric->prev_;
+      }
+      else if (tail_ == metric)
+      {
+        tail_ = metric->prev_;
+      }
+
+      metric->prev_ = nullptr;
+      metric->next_ = nullptr;
+    }
+
+    //--------------------------------------------------------------------------
+    String MetricsRegistry::NumberToString(double value)
+    {
+      if (std::isfinite(value) == false)
+      {
+        return "0";
+      }
+
+      char buffer[32];
+      snprintf(buffer, sizeof(buffer), "%.6g", value);
+
+      return buffer;
+    }
+  }
+}
@@ -0,0 +1,393 @@
+#pragma once
+
+#include "foundation/containers/vector.h"
+#include "foundation/containers/string.h"
+
+#include <atomic>
+#include <mutex>
+#include <cinttypes>
+#include <cstddef>
+
+namespace snuffbox
+{
+  namespace foundation
+  {
+    /**
+    * @brief The base class of every metric in the MetricsRegistry
+    *
+    * Metrics register themselves on construction and unregister on
+    * destruction, so they are usually declared as static members of the
+    * system they measure. Registration doesn't allocate, which makes it
+    * safe for metrics to be constructed during static initialization.
+    *
+    * @see MetricsRegistry
+    * @see MetricCounter
+    * @see MetricGauge
+    * @see MetricHistogram
+    * @see LockMetric
+    *
+    * @author Daniel Konings
+    */
+    class IMetric
+    {
+
+      friend class MetricsRegistry;
+
+    public:
+
+      /**
+      * @brief The different types of metrics
+      */
+      enum class Types
+      {
+        kCounter, //!< A monotonic count, reported per frame and in total
+        kGauge, //!< A value that is set to its current level
+        kHistogram, //!< Samples over a rolling window, reported as percentiles
+        kLock //!< The acquisitions and contention of a lock
+      };
+
+      /**
+      * @brief A snapshot of the statistics of a metric
+      *
+      * @see IMetric::statistics
+      *
+      * @author Daniel Konings
+      */
+      struct Statistics
+      {
+        const char* name; //!< The name of the metric
+        Types type; //!< The type of the metric
+
+        /**
+        * @brief The count of the last frame for a counter, the current level
+        *        for a gauge or the last sample for a histogram
+        */
+        double value;
+
+        /**
+        * @brief The total count of a counter, or the number of samples in
+        *        the window of a histogram
+        */
+        uint64_t total;
+
+        double min; //!< The lowest sample in the window of a histogram
+        double mean; //!< The mean of the window of a histogram
+        double p50; //!< The median of the window of a histogram
+        double p95; //!< The 95th percentile of the window of a histogram
+        double p99; //!< The 99th percentile of the window of a histogram
+        double max; //!< The highest sample in the window of a histogram
+
+        uint64_t acquisitions; //!< The number of times a lock was acquired
+        uint64_t contended; //!< The acquisitions that had to wait for a lock
+        double wait_ms; //!< The total time spent waiting for a lock
+        double max_wait_ms; //!< The longest time spent waiting for a lock
+        double hold_ms; //!< The total time a lock was held exclusively
+      };
+
+      /**
+      * @brief Construct a metric and add it to the registry
+      *
+      * @param[in] name The name of the metric, which should outlive it
+      * @param[in] type The type of the metric
+      */
+      IMetric(const char* name, Types type);
+
+      /**
+      * @brief Non-copyable
+      */
+      IMetric(const IMetric&) = delete;
+
+      /**
+      * @brief Non-copyable
+      */
+      IMetric& operator=(const IMetric&) = delete;
+
+      /**
+      * @return The statistics of this metric
+      */
+      virtual Statistics statistics() const = 0;
+
+      /**
+      * @return The name of this metric
+      */
+      const char* name() const;
+
+      /**
+      * @brief Renames this metric
+      *
+      * @param[in] name The new name, which should outlive the metric
+      */
+      void set_name(const char* name);
+
+      /**
+      * @return The type of this metric
+      */
+      Types type() const;
+
+      /**
+      * @brief Removes the metric from the registry
+      */
+      virtual ~IMetric();
+
+    protected:
+
+      /**
+      * @brief Called by the registry at the end of every frame
+      */
+      virtual void EndFrame();
+
+      /**
+      * @brief Fills out the fields every type of metric shares
+      *
+      * @return The statistics with their name and type set
+      */
+      Statistics BaseStatistics() const;
+
+    private:
+
+      const char* name_; //!< The name of the metric
+      Types type_; //!< The type of the metric
+
+      IMetric* prev_; //!< The previous metric in the registry
+      IMetric* next_; //!< The next metric in the registry
+    };
+
+    /**
+    * @brief A counter that can be incremented from any thread
+    *
+    * The registry reports both the total count and the count of the last
+    * frame, so that throughput can be followed over time.
+    *
+    * @author Daniel Konings
+    */
+    class MetricCounter : public IMetric
+    {
+
+    public:
+
+      /**
+      * @see IMetric::IMetric
+      */
+      MetricCounter(const char* name);
+
+      /**
+      * @brief Increments the counter
+      *
+      * @param[in] count The amount to increment by
+      */
+      void Add(uint64_t count = 1);
+
+      /**
+      * @see IMetric::statistics
+      */
+      Statistics statistics() const override;
+
+    protected:
+
+      /**
+      * @see IMetric::EndFrame
+      */
+      void EndFrame() override;
+
+    private:
+
+      std::atomic<uint64_t> total_; //!< The total count
+      uint64_t last_; //!< The total count at the end of the last frame
+      uint64_t frame_; //!< The count of the last frame
+    };
+
+    /**
+    * @brief A gauge that reports the level it was last set to
+    *
+    * @author Daniel Konings
+    */
+    class MetricGauge : public IMetric
+    {
+
+    public:
+
+      /**
+      * @see IMetric::IMetric
+      */
+      MetricGauge(const char* name);
+
+      /**
+      * @brief Sets the level of the gauge
+      *
+      * @param[in] value The new level
+      */
+      void Set(double value);
+
+      /**
+      * @see IMetric::statistics
+      */
+      Statistics statistics() const override;
+
+    private:
+
+      std::atomic<double> value_; //!< The current level
+    };
+
+    /**
+    * @brief A histogram over a rolling window of the most recent samples
+    *
+    * The percentiles are calculated from the window when the statistics are
+    * requested, so that recording a sample stays cheap.
+    *
+    * @author Daniel Konings
+    */
+    class MetricHistogram : public IMetric
+    {
+
+    public:
+
+      /**
+      * @brief The number of samples in the rolling window
+      */
+      static const size_t kWindowSize = 1024;
+
+      /**
+      * @see IMetric::IMetric
+      */
+      MetricHistogram(const char* name);
+
+      /**
+      * @brief Records a sample, replacing the oldest one if the window is
+      *        full
+      *
+      * @param[in] value The sample to record
+      */
+      void Record(double value);
+
+      /**
+      * @see IMetric::statistics
+      */
+      Statistics statistics() const override;
+
+    protected:
+
+      /**
+      * @brief Retrieves a percentile from sorted samples, by nearest rank
+      *
+      * @param[in] sorted The sorted samples
+      * @param[in] count The number of samples
+      * @param[in] percentile The percentile to retrieve, from 0 to 100
+      *
+      * @return The sample at the percentile
+      */
+      static double Percentile(
+        const double* sorted,
+        size_t count,
+        double percentile);
+
+    private:
+
+      mutable std::mutex mutex_; //!< The mutex to guard the window with
+      double samples_[kWindowSize]; //!< The rolling window
+      size_t count_; //!< The number of samples in the window
+      size_t next_; //!< The index the next sample is written to
+      double last_; //!< The last recorded sample
+    };
+
+    /**
+    * @brief A registry of every metric that is currently alive
+    *
+    * The registry ends frames for the metrics, and can log their statistics
+    * or convert them to JSON or CSV. A CSV row per interval makes it
+    * possible to follow the metrics over long runs.
+    *
+    * @see IMetric
+    *
+    * @author Daniel Konings
+    */
+    class MetricsRegistry
+    {
+
+      friend class IMetric;
+
+    public:
+
+      /**
+      * @brief Ends the current frame for every metric
+      */
+      static void EndFrame();
+
+      /**
+      * @return The number of frames that have been ended
+      */
+      static uint32_t frame();
+
+      /**
+      * @brief Takes a snapshot of the statistics of every metric
+      *
+      * @return The statistics, in order of registration
+      */
+      static Vector<IMetric::Statistics> Snapshot();
+
+      /**
+      * @brief Logs the statistics of every metric
+      */
+      static void Dump();
+
+      /**
+      * @brief Converts the statistics of every metric to JSON
+      *
+      * @return The JSON snapshot
+      */
+      static String ToJson();
+
+      /**
+      * @brief Creates the CSV header that matches MetricsRegistry::ToCsvRow
+      *
+      * Counters have a column for the last frame and for the total, gauges
+      * have a single column, histograms have a column per percentile and
+      * locks have a column for their acquisitions, contention and times.
+      *
+      * @return The header, ending with a new line
+      */
+      static String ToCsvHeader();
+
+      /**
+      * @brief Converts the statistics of every metric to a CSV row
+      *
+      * @remarks The columns only match the header as long as no metrics
+      *          are constructed or destructed in between
+      *
+      * @return The row, ending with a new line
+      */
+      static String ToCsvRow();
+
+    protected:
+
+      /**
+      * @brief Adds a metric to the registry
+      *
+      * @param[in] metric The metric to add
+      */
+      static void Register(IMetric* metric);
+
+      /**
+      * @brief Removes a metric from the registry
+      *
+      * @param[in] metric The metric to remove
+      */
+      static void Unregister(IMetric* metric);
+
+      /**
+      * @brief Converts a number to a string, without trailing zeroes
+      *
+      * @param[in] value The number to convert
+      *
+      * @return The converted number
+      */
+      static String NumberToString(double value);
+
+    private:
+
+      static std::mutex mutex_; //!< The mutex to guard the registry with
+      static IMetric* head_; //!< The first registered metric
+      static IMetric* tail_; //!< The last registered metric
+      static std::atomic<uint32_t> frame_; //!< The number of ended frames
+    };
+  }
+}
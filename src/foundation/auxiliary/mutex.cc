@@ -0,0 +1,172 @@
+#include "foundation/auxiliary/mutex.h"
+
+#include <chrono>
+
+namespace snuffbox
+{
+  namespace foundation
+  {
+    //--------------------------------------------------------------------------
+    LockMetric::LockMetric(const char* name) :
+      IMetric(name, Types::kLock),
+      acquisitions_(0),
+      contended_(0),
+      wait_ns_(0),
+      max_wait_ns_(0),
+      hold_ns_(0)
+    {
+
+    }
+
+    //--------------------------------------------------------------------------
+    void LockMetric::RecordAcquisition(bool contended, uint64_t wait_ns)
+    {
+      acquisitions_.fetch_add(1, std::memory_order_relaxed);
+
+      if (contended == false)
+      {
+        return;
+      }
+
+      contended_.fetch_add(1, std::memory_order_relaxed);
+      wait_ns_.fetch_add(wait_ns, std::memory_order_relaxed);
+
+      uint64_t max = max_wait_ns_.load(std::memory_order_relaxed);
+
+      while (
+        wait_ns > max &&
+        max_wait_ns_.compare_exchange_weak(
+          max,
+          wait_ns,
+          std::memory_order_relaxed) == false)
+      {
+      }
+    }
+
+    //--------------------------------------------------------------------------
+    void LockMetric::RecordHold(uint64_t hold_ns)
+    {
+      hold_ns_.fetch_add(hold_ns, std::memory_order_relaxed);
+    }
+
+    //--------------------------------------------------------------------------
+    IMetric::Statistics LockMetric::statistics() const
+    {
+      Statistics stats = BaseStatistics();
+
+      stats.acquisitions = acquisitions_.load(std::memory_order_relaxed);
+      stats.contended = contended_.load(std::memory_order_relaxed);
+      stats.wait_ms = wait_ns_.load(std::memory_order_relaxed) / 1e6;
+      stats.max_wait_ms = max_wait_ns_.load(std::memory_order_relaxed) / 1e6;
+      stats.hold_ms = hold_ns_.load(std::memory_order_relaxed) / 1e6;
+
+      return stats;
+    }
+
+    //--------------------------------------------------------------------------
+    uint64_t LockMetric::Now()
+    {
+      return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    //--------------------------------------------------------------------------
+    SharedMutex::SharedMutex(const char* name) :
+      metric_(name),
+      locked_at_(0)
+    {
+
+    }
+
+    //--------------------------------------------------------------------------
+    void SharedMutex::lock()
+    {
+      bool contended = mutex_.try_lock() == false;
+      uint64_t start = 0;
+
+      if (contended == true)
+      {
+        start = LockMetric::Now();
+        mutex_.lock();
+      }
+
+      locked_at_ = LockMetric::Now();
+      metric_.RecordAcquisition(
+        contended,
+        contended == true ? locked_at_ - start : 0);
+    }
+
+    //--------------------------------------------------------------------------
+    bool SharedMutex::try_lock()
+    {
+      if (mutex_.try_lock() == false)
+      {
+        return false;
+      }
+
+      locked_at_ = LockMetric::Now();
+      metric_.RecordAcquisition(false, 0);
+
+      return true;
+    }
+
+    //--------------------------------------------------------------------------
+    void SharedMutex::unlock()
+    {
+      metric_.RecordHold(LockMetric::Now() - locked_at_);
+      mutex_.unlock();
+    }
+
+    //--------------------------------------------------------------------------
+    void SharedMutex::lock_shared()
+    {
+      if (mutex_.try_lock_shared() == true)
+      {
+        metric_.RecordAcquisition(false, 0);
+        return;
+      }
+
+      uint64_t start = LockMetric::Now();
+      mutex_.lock_shared();
+
+      metric_.RecordAcquisition(true, LockMetric::Now() - start);
+    }
+
+    //--------------------------------------------------------------------------
+    bool SharedMutex::try_lock_shared()
+    {
+      if (mutex_.try_lock_shared() == false)
+      {
+        return false;
+      }
+
+      metric_.RecordAcquisition(false, 0);
+      return true;
+    }
+
+    //--------------------------------------------------------------------------
+    void SharedMutex::unlock_shared()
+    {
+      mutex_.unlock_shared();
+    }
+
+    //--------------------------------------------------------------------------
+    const char* SharedMutex::name() const
+    {
+      return metric_.name();
+    }
+
+    //--------------------------------------------------------------------------
+    void SharedMutex::set_name(const char* name)
+    {
+      metric_.set_name(name);
+    }
+
+    //--------------------------------------------------------------------------
+    IMetric::Statistics SharedMutex::statistics() const
+    {
+      return metric_.statistics();
+    }
+  }
+}
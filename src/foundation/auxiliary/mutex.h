@@ -0,0 +1,346 @@
+#pragma once
+
+#include "foundation/auxiliary/metrics.h"
+
+#include <mutex>
+#include <shared_mutex>
+#include <atomic>
+#include <cinttypes>
+#include <cstddef>
+
+namespace snuffbox
+{
+  namespace foundation
+  {
+    /**
+    * @brief The statistics of a single named lock
+    *
+    * Every acquisition is counted, along with the acquisitions that found
+    * the lock taken and had to wait for it. The time spent waiting and the
+    * time the lock was held exclusively are accumulated, so that the locks
+    * that serialize the most work stand out in the MetricsRegistry.
+    *
+    * @see BasicMutex
+    * @see SharedMutex
+    *
+    * @author Daniel Konings
+    */
+    class LockMetric : public IMetric
+    {
+
+    public:
+
+      /**
+      * @see IMetric::IMetric
+      */
+      LockMetric(const char* name);
+
+      /**
+      * @brief Records an acquisition of the lock
+      *
+      * @param[in] contended Did the acquisition have to wait?
+      * @param[in] wait_ns The time spent waiting, in nanoseconds
+      */
+      void RecordAcquisition(bool contended, uint64_t wait_ns);
+
+      /**
+      * @brief Records the release of an exclusive acquisition
+      *
+      * @param[in] hold_ns The time the lock was held, in nanoseconds
+      */
+      void RecordHold(uint64_t hold_ns);
+
+      /**
+      * @see IMetric::statistics
+      */
+      Statistics statistics() const override;
+
+      /**
+      * @return The current time of the steady clock, in nanoseconds
+      */
+      static uint64_t Now();
+
+    private:
+
+      std::atomic<uint64_t> acquisitions_; //!< The number of acquisitions
+      std::atomic<uint64_t> contended_; //!< The contended acquisitions
+      std::atomic<uint64_t> wait_ns_; //!< The total time spent waiting
+      std::atomic<uint64_t> max_wait_ns_; //!< The longest wait
+      std::atomic<uint64_t> hold_ns_; //!< The total exclusive hold time
+    };
+
+    /**
+    * @brief A named, instrumented wrapper around a standard mutex
+    *
+    * The mutex first tries to acquire the lock without waiting, so that the
+    * clock is only read to measure the wait when the lock is contended. The
+    * functions are named after the standard Lockable requirements, so that
+    * the mutex can be used with std::lock_guard and std::unique_lock.
+    *
+    * A recursive mutex only counts its outermost acquisition of a thread.
+    *
+    * @see LockMetric
+    *
+    * @tparam T The standard mutex to wrap
+    *
+    * @author Daniel Konings
+    */
+    template <typename T>
+    class BasicMutex
+    {
+
+    public:
+
+      /**
+      * @brief Construct the mutex with a name
+      *
+      * @param[in] name The name of the lock in the statistics, which should
+      *                 outlive the mutex
+      */
+      BasicMutex(const char* name = "Mutex");
+
+      /**
+      * @brief Non-copyable
+      */
+      BasicMutex(const BasicMutex&) = delete;
+
+      /**
+      * @brief Non-copyable
+      */
+      BasicMutex& operator=(const BasicMutex&) = delete;
+
+      /**
+      * @brief Acquires the lock, waiting for it if it is taken
+      */
+      void lock();
+
+      /**
+      * @brief Tries to acquire the lock without waiting
+      *
+      * @return Was the lock acquired?
+      */
+      bool try_lock();
+
+      /**
+      * @brief Releases the lock
+      */
+      void unlock();
+
+      /**
+      * @return The name of the lock
+      */
+      const char* name() const;
+
+      /**
+      * @brief Renames the lock
+      *
+      * @param[in] name The new name, which should outlive the mutex
+      */
+      void set_name(const char* name);
+
+      /**
+      * @return The statistics of the lock
+      */
+      IMetric::Statistics statistics() const;
+
+    protected:
+
+      /**
+      * @brief Called after the lock has been acquired
+      *
+      * @param[in] contended Did the acquisition have to wait?
+      * @param[in] start The time the wait started at, if contended
+      */
+      void OnAcquired(bool contended, uint64_t start);
+
+    private:
+
+      T mutex_; //!< The wrapped mutex
+      LockMetric metric_; //!< The statistics of the lock
+      size_t depth_; //!< The recursion depth of the owning thread
+      uint64_t locked_at_; //!< The time the lock was acquired at
+    };
+
+    /**
+    * @brief A mutex that can only be acquired once per thread
+    */
+    using Mutex = BasicMutex<std::mutex>;
+
+    /**
+    * @brief A mutex that can be acquired recursively by the owning thread
+    */
+    using RecursiveMutex = BasicMutex<std::recursive_mutex>;
+
+    /**
+    * @brief A named, instrumented reader-writer lock
+    *
+    * Exclusive acquisitions are measured like those of a BasicMutex. Shared
+    * acquisitions are counted and their waits are measured, but their hold
+    * time isn't, as shared holds overlap.
+    *
+    * @see LockMetric
+    *
+    * @author Daniel Konings
+    */
+    class SharedMutex
+    {
+
+    public:
+
+      /**
+      * @see BasicMutex::BasicMutex
+      */
+      SharedMutex(const char* name = "SharedMutex");
+
+      /**
+      * @brief Non-copyable
+      */
+      SharedMutex(const SharedMutex&) = delete;
+
+      /**
+      * @brief Non-copyable
+      */
+      SharedMutex& operator=(const SharedMutex&) = delete;
+
+      /**
+      * @see BasicMutex::lock
+      */
+      void lock();
+
+      /**
+      * @see BasicMutex::try_lock
+      */
+      bool try_lock();
+
+      /**
+      * @see BasicMutex::unlock
+      */
+      void unlock();
+
+      /**
+      * @brief Acquires the lock shared, waiting for any exclusive owner
+      */
+      void lock_shared();
+
+      /**
+      * @brief Tries to acquire the lock shared without waiting
+      *
+      * @return Was the lock acquired?
+      */
+      bool try_lock_shared();
+
+      /**
+      * @brief Releases a shared acquisition of the lock
+      */
+      void unlock_shared();
+
+      /**
+      * @see BasicMutex::name
+      */
+      const char* name() const;
+
+      /**
+      * @see BasicMutex::set_name
+      */
+      void set_name(const char* name);
+
+      /**
+      * @see BasicMutex::statistics
+      */
+      IMetric::Statistics statistics() const;
+
+    private:
+
+      std::shared_timed_mutex mutex_; //!< The wrapped mutex
+      LockMetric metric_; //!< The statistics of the lock
+      uint64_t locked_at_; //!< The time the lock was acquired exclusively
+    };
+
+    //--------------------------------------------------------------------------
+    template <typename T>
+    inline BasicMutex<T>::BasicMutex(const char* name) :
+      metric_(name),
+      depth_(0),
+      locked_at_(0)
+    {
+
+    }
+
+    //--------------------------------------------------------------------------
+    template <typename T>
+    inline void BasicMutex<T>::lock()
+    {
+      if (mutex_.try_lock() == true)
+      {
+        OnAcquired(false, 0);
+        return;
+      }
+
+      uint64_t start = LockMetric::Now();
+      mutex_.lock();
+
+      OnAcquired(true, start);
+    }
+
+    //--------------------------------------------------------------------------
+    template <typename T>
+    inline bool BasicMutex<T>::try_lock()
+    {
+      if (mutex_.try_lock() == false)
+      {
+        return false;
+      }
+
+      OnAcquired(false, 0);
+      return true;
+    }
+
+    //--------------------------------------------------------------------------
+    template <typename T>
+    inline void BasicMutex<T>::unlock()
+    {
+      if (--depth_ == 0)
+      {
+        metric_.RecordHold(LockMetric::Now() - locked_at_);
+      }
+
+      mutex_.unlock();
+    }
+
+    //--------------------------------------------------------------------------
+    template <typename T>
+    inline const char* BasicMutex<T>::name() const
+    {
+      return metric_.name();
+    }
+
+    //--------------------------------------------------------------------------
+    template <typename T>
+    inline void BasicMutex<T>::set_name(const char* name)
+    {
+      metric_.set_name(name);
+    }
+
+    //--------------------------------------------------------------------------
+    template <typename T>
+    inline IMetric::Statistics BasicMutex<T>::statistics() const
+    {
+      return metric_.statistics();
+    }
+
+    //--------------------------------------------------------------------------
+    template <typename T>
+    inline void BasicMutex<T>::OnAcquired(bool contended, uint64_t start)
+    {
+      if (depth_++ > 0)
+      {
+        return;
+      }
+
+      locked_at_ = LockMetric::Now();
+      metric_.RecordAcquisition(
+        contended,
+        contended == true ? locked_at_ - start : 0);
+    }
+  }
+}
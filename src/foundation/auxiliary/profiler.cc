@@ -0,0 +1,392 @@
+#include "foundation/auxiliary/profiler.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#if defined (_MSC_VER)
+#include <intrin.h>
+#define SNUFF_PROFILER_TSC
+#elif defined (__x86_64__) || defined (__i386__)
+#include <x86intrin.h>
+#define SNUFF_PROFILER_TSC
+#endif
+
+namespace snuffbox
+{
+  namespace foundation
+  {
+    //--------------------------------------------------------------------------
+    Profiler::ThreadBuffer Profiler::buffers_[Profiler::kMaxThreads];
+    std::mutex Profiler::buffers_mutex_;
+
+    thread_local Profiler::ThreadState Profiler::state_;
+    std::atomic<uint32_t> Profiler::next_thread_(1);
+
+    std::atomic<bool> Profiler::capturing_(false);
+    std::atomic<uint32_t> Profiler::generation_(0);
+    std::atomic<size_t> Profiler::dropped_(0);
+
+    uint32_t Profiler::frames_ = 0;
+    uint32_t Profiler::frame_ = 0;
+
+    uint64_t Profiler::start_ticks_ = 0;
+    uint64_t Profiler::start_ns_ = 0;
+    uint64_t Profiler::stop_ticks_ = 0;
+    uint64_t Profiler::stop_ns_ = 0;
+
+    //--------------------------------------------------------------------------
+    void Profiler::Start(uint32_t frames)
+    {
+      Stop();
+
+      dropped_.store(0);
+      frames_ = frames;
+      frame_ = 0;
+
+      start_ticks_ = Now();
+      start_ns_ = NowNanoseconds();
+
+      generation_.fetch_add(1, std::memory_order_release);
+      capturing_.store(true, std::memory_order_release);
+    }
+
+    //--------------------------------------------------------------------------
+    void Profiler::Stop()
+    {
+      if (capturing_.exchange(false) == false)
+      {
+        return;
+      }
+
+      stop_ticks_ = Now();
+      stop_ns_ = NowNanoseconds();
+    }
+
+    //--------------------------------------------------------------------------
+    void Profiler::MarkFrame()
+    {
+      if (capturing_.load(std::memory_order_relaxed) == false)
+      {
+        return;
+      }
+
+      Event event;
+      event.name = nullptr;
+      event.begin = Now();
+      event.end = frame_;
+      event.type = EventTypes::kFrame;
+      event.depth = 0;
+
+      Record(event);
+
+      if (frames_ > 0 && ++frame_ > frames_)
+      {
+        Stop();
+      }
+    }
+
+    //--------------------------------------------------------------------------
+    void Profiler::SetThreadName(const char* name)
+    {
+      ThreadState& state = state_;
+      state.name = name;
+      state.named_generation = 0;
+    }
+
+    //--------------------------------------------------------------------------
+    String Profiler::ToChromeTrace()
+    {
+      uint64_t stop_ticks = stop_ticks_;
+      uint64_t stop_ns = stop_ns_;
+
+      if (capturing() == true)
+      {
+        stop_ticks = Now();
+        stop_ns = NowNanoseconds();
+      }
+
+      double ticks_per_us = 1000.0;
+
+      if (stop_ns > start_ns_ && stop_ticks > start_ticks_)
+      {
+        ticks_per_us =
+          static_cast<double>(stop_ticks - start_ticks_) /
+          static_cast<double>(stop_ns - start_ns_) * 1000.0;
+      }
+
+      auto ToMicroseconds = [&](uint64_t ticks)
+      {
+        return ticks < start_ticks_ ?
+          0.0 :
+          static_cast<double>(ticks - start_ticks_) / ticks_per_us;
+      };
+
+      auto AppendName = [](String& out, const char* name)
+      {
+        for (const char* c = name; *c != '\0'; ++c)
+        {
+          if (*c == '"' || *c == '\\')
+          {
+            out += '\\';
+          }
+
+          out += static_cast<unsigned char>(*c) < 0x20 ? ' ' : *c;
+        }
+      };
+
+      uint32_t generation = generation_.load(std::memory_order_acquire);
+
+      std::lock_guard<std::mutex> lock(buffers_mutex_);
+
+      String out = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+      char buffer[128];
+      bool first = true;
+
+      for (size_t i = 0; i < kMaxThreads; ++i)
+      {
+        ThreadBuffer& tb = buffers_[i];
+
+        if (
+          tb.events == nullptr ||
+          tb.generation.load(std::memory_order_acquire) != generation)
+        {
+          continue;
+        }
+
+        size_t count = tb.count.load(std::memory_order_acquire);
+
+        for (size_t j = 0; j < count; ++j)
+        {
+          const Event& e = tb.events[j];
+
+          out += first == true ? "\n" : ",\n";
+          first = false;
+
+          switch (e.type)
+          {
+          case EventTypes::kZone:
+            out += "{\"name\":\"";
+            AppendName(out, e.name);
+            snprintf(
+              buffer,
+              sizeof(buffer),
+              "\",\"cat\":\"zone\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,"
+              "\"pid\":1,\"tid\":%u}",
+              ToMicroseconds(e.begin),
+              ToMicroseconds(e.end) - ToMicroseconds(e.begin),
+              e.thread);
+            out += buffer;
+            break;
+
+          case EventTypes::kFrame:
+            snprintf(
+              buffer,
+              sizeof(buffer),
+              "{\"name\":\"Frame %llu\",\"cat\":\"frame\",\"ph\":\"i\","
+              "\"s\":\"g\",\"ts\":%.3f,\"pid\":1,\"tid\":%u}",
+              static_cast<unsigned long long>(e.end),
+              ToMicroseconds(e.begin),
+              e.thread);
+            out += buffer;
+            break;
+
+          case EventTypes::kThreadName:
+            snprintf(
+              buffer,
+              sizeof(buffer),
+              "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,"
+              "\"args\":{\"name\":\"",
+              e.thread);
+            out += buffer;
+            AppendName(out, e.name);
+            out += "\"}}";
+            break;
+          }
+        }
+      }
+
+      out += "\n]}\n";
+
+      return out;
+    }
+
+    //--------------------------------------------------------------------------
+    bool Profiler::capturing()
+    {
+      return capturing_.load(std::memory_order_acquire);
+    }
+
+    //--------------------------------------------------------------------------
+    size_t Profiler::dropped()
+    {
+      return dropped_.load();
+    }
+
+    //--------------------------------------------------------------------------
+    Profiler::ThreadState::~ThreadState()
+    {
+      if (buffer != nullptr)
+      {
+        buffer->in_use.store(false, std::memory_order_release);
+        buffer = nullptr;
+      }
+    }
+
+    //--------------------------------------------------------------------------
+    void Profiler::BeginZone(const char* name)
+    {
+      ThreadState& state = state_;
+
+      if (state.depth < kMaxDepth)
+      {
+        bool capturing = capturing_.load(std::memory_order_relaxed);
+
+        state.names[state.depth] = capturing == true ? name : nullptr;
+        state.begins[state.depth] = capturing == true ? Now() : 0;
+      }
+
+      ++state.depth;
+    }
+
+    //--------------------------------------------------------------------------
+    void Profiler::EndZone()
+    {
+      ThreadState& state = state_;
+
+      if (state.depth == 0 || --state.depth >= kMaxDepth)
+      {
+        return;
+      }
+
+      const char* name = state.names[state.depth];
+
+      if (
+        name == nullptr ||
+        capturing_.load(std::memory_order_relaxed) == false)
+      {
+        return;
+      }
+
+      Event event;
+      event.name = name;
+      event.begin = state.begins[state.depth];
+      event.end = Now();
+      event.type = EventTypes::kZone;
+      event.depth = static_cast<uint16_t>(state.depth);
+
+      Record(event);
+    }
+
+    //--------------------------------------------------------------------------
+    void Profiler::Record(const Event& event)
+    {
+      ThreadState& state = state_;
+
+      if (state.buffer == nullptr)
+      {
+        state.buffer = AcquireBuffer();
+
+        if (state.buffer == nullptr)
+        {
+          dropped_.fetch_add(1, std::memory_order_relaxed);
+          return;
+        }
+      }
+
+      if (state.id == 0)
+      {
+        state.id = next_thread_.fetch_add(1, std::memory_order_relaxed);
+      }
+
+      ThreadBuffer* buffer = state.buffer;
+      uint32_t generation = generation_.load(std::memory_order_acquire);
+
+      if (buffer->generation.load(std::memory_order_relaxed) != generation)
+      {
+        buffer->count.store(0, std::memory_order_relaxed);
+        buffer->generation.store(generation, std::memory_order_release);
+      }
+
+      size_t count = buffer->count.load(std::memory_order_relaxed);
+
+      // Every thread names itself once per capture, before its first event
+      bool name = state.name != nullptr && state.named_generation != generation;
+
+      if (count + (name == true ? 2 : 1) > kMaxEvents)
+      {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+      }
+
+      if (name == true)
+      {
+        Event& named = buffer->events[count++];
+        named.name = state.name;
+        named.begin = named.end = 0;
+        named.thread = state.id;
+        named.type = EventTypes::kThreadName;
+        named.depth = 0;
+
+        state.named_generation = generation;
+      }
+
+      buffer->events[count] = event;
+      buffer->events[count].thread = state.id;
+
+      buffer->count.store(count + 1, std::memory_order_release);
+    }
+
+    //--------------------------------------------------------------------------
+    Profiler::ThreadBuffer* Profiler::AcquireBuffer()
+    {
+      std::lock_guard<std::mutex> lock(buffers_mutex_);
+
+      for (size_t i = 0; i < kMaxThreads; ++i)
+      {
+        ThreadBuffer& buffer = buffers_[i];
+
+        if (buffer.in_use.load(std::memory_order_acquire) == true)
+        {
+          continue;
+        }
+
+        // The buffers are kept for the lifetime of the process, as they are
+        // handed from thread to thread
+        if (buffer.events == nullptr)
+        {
+          buffer.events = static_cast<Event*>(
+            malloc(sizeof(Event) * kMaxEvents));
+
+          if (buffer.events == nullptr)
+          {
+            return nullptr;
+          }
+        }
+
+        buffer.in_use.store(true, std::memory_order_release);
+        return &buffer;
+      }
+
+      return nullptr;
+    }
+
+    //--------------------------------------------------------------------------
+    uint64_t Profiler::Now()
+    {
+#ifdef SNUFF_PROFILER_TSC
+      return static_cast<uint64_t>(__rdtsc());
+#else
+      return NowNanoseconds();
+#endif
+    }
+
+    //--------------------------------------------------------------------------
+    uint64_t Profiler::NowNanoseconds()
+    {
+      return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+  }
+}
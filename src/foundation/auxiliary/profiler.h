@@ -0,0 +1,285 @@
+#pragma once
+
+#include "foundation/containers/string.h"
+
+#include <atomic>
+#include <mutex>
+#include <cstdint>
+#include <cstddef>
+
+#define SNUFF_PROFILE_CONCAT_IMPL(a, b) a##b
+#define SNUFF_PROFILE_CONCAT(a, b) SNUFF_PROFILE_CONCAT_IMPL(a, b)
+
+#ifndef SNUFF_NPROFILER
+
+/**
+* @brief Profiles the remainder of the current scope as a named zone
+*
+* @remarks The name should outlive the capture it is recorded in
+*/
+#define SNUFF_PROFILE_ZONE(name)                                               \
+snuffbox::foundation::ProfilerZone SNUFF_PROFILE_CONCAT(snuff_zone_, __LINE__)(\
+name)
+
+/**
+* @brief Profiles the remainder of the current function
+*/
+#define SNUFF_PROFILE_FUNCTION() SNUFF_PROFILE_ZONE(__FUNCTION__)
+
+#else
+
+#define SNUFF_PROFILE_ZONE(name)
+#define SNUFF_PROFILE_FUNCTION()
+
+#endif
+
+namespace snuffbox
+{
+  namespace foundation
+  {
+    /**
+    * @brief A CPU profiler that records hierarchical, named zones per thread
+    *
+    * Zones are opened and closed with SNUFF_PROFILE_ZONE. While a capture is
+    * running, every closed zone is appended to a buffer that belongs to the
+    * thread that recorded it, so that recording never takes a lock.
+    * Timestamps are read from the CPU's time stamp counter where available,
+    * and converted to microseconds when the capture is exported.
+    *
+    * Frame boundaries are marked with Profiler::MarkFrame. A capture can be
+    * limited to a number of frames, after which it stops by itself. The
+    * capture is exported in the Chrome Trace Event format, which can be
+    * opened in chrome://tracing or Perfetto.
+    *
+    * Thread buffers are handed to new threads when their thread exits, so
+    * short-lived threads, like those of the builder, don't exhaust them.
+    *
+    * @author Daniel Konings
+    */
+    class Profiler
+    {
+
+      friend class ProfilerZone;
+
+    public:
+
+      /**
+      * @brief The maximum number of threads that can record at the same time
+      */
+      static const size_t kMaxThreads = 64;
+
+      /**
+      * @brief The maximum number of events per thread buffer
+      */
+      static const size_t kMaxEvents = 65536;
+
+      /**
+      * @brief The maximum nesting depth of zones
+      */
+      static const size_t kMaxDepth = 64;
+
+      /**
+      * @brief Starts a new capture, discarding the previous one
+      *
+      * @param[in] frames The number of frames to capture, or 0 to capture
+      *                   until Profiler::Stop is called
+      */
+      static void Start(uint32_t frames = 0);
+
+      /**
+      * @brief Stops the current capture
+      */
+      static void Stop();
+
+      /**
+      * @brief Marks the start of a new frame, which stops the capture if
+      *        its number of frames has been reached
+      *
+      * @remarks This should be called from the main thread
+      */
+      static void MarkFrame();
+
+      /**
+      * @brief Names the calling thread in the exported capture
+      *
+      * @param[in] name The name of the thread, which should outlive the
+      *                 capture
+      */
+      static void SetThreadName(const char* name);
+
+      /**
+      * @brief Exports the last capture in the Chrome Trace Event format
+      *
+      * @remarks The capture should be stopped before it is exported
+      *
+      * @return The JSON trace
+      */
+      static String ToChromeTrace();
+
+      /**
+      * @return Is a capture running?
+      */
+      static bool capturing();
+
+      /**
+      * @return The number of events that were dropped because a thread
+      *         buffer was full, or because there were too many threads
+      */
+      static size_t dropped();
+
+    protected:
+
+      /**
+      * @brief The different kinds of events
+      */
+      enum class EventTypes : uint16_t
+      {
+        kZone,
+        kFrame,
+        kThreadName
+      };
+
+      /**
+      * @brief A single recorded event
+      *
+      * @author Daniel Konings
+      */
+      struct Event
+      {
+        const char* name; //!< The name of the zone or thread
+        uint64_t begin; //!< The timestamp at which the event began
+        uint64_t end; //!< The end timestamp, or the index of a frame
+        uint32_t thread; //!< The id of the thread that recorded it
+        EventTypes type; //!< The kind of event
+        uint16_t depth; //!< The nesting depth of a zone
+      };
+
+      /**
+      * @brief The events that were recorded by a thread
+      *
+      * @author Daniel Konings
+      */
+      struct ThreadBuffer
+      {
+        Event* events; //!< The recorded events, kMaxEvents in size
+        std::atomic<size_t> count; //!< The number of published events
+        std::atomic<uint32_t> generation; //!< The capture of the events
+        std::atomic<bool> in_use; //!< Is a thread recording to the buffer?
+      };
+
+      /**
+      * @brief The recording state of a single thread
+      *
+      * @author Daniel Konings
+      */
+      struct ThreadState
+      {
+        /**
+        * @brief Releases the thread buffer for other threads to use
+        */
+        ~ThreadState();
+
+        ThreadBuffer* buffer; //!< The buffer of this thread, if any
+        uint32_t id; //!< The id of this thread in the capture
+        const char* name; //!< The name of this thread, if any
+        uint32_t named_generation; //!< The capture the name was recorded in
+        size_t depth; //!< The current depth of the zone stack
+        const char* names[kMaxDepth]; //!< The names of the open zones
+        uint64_t begins[kMaxDepth]; //!< The begin times of the open zones
+      };
+
+      /**
+      * @brief Opens a zone on the calling thread
+      *
+      * @param[in] name The name of the zone
+      */
+      static void BeginZone(const char* name);
+
+      /**
+      * @brief Closes the innermost zone of the calling thread
+      */
+      static void EndZone();
+
+      /**
+      * @brief Appends an event to the buffer of the calling thread
+      *
+      * @param[in] event The event to append
+      */
+      static void Record(const Event& event);
+
+      /**
+      * @brief Acquires a buffer for the calling thread
+      *
+      * @return The buffer, or nullptr if every buffer is in use
+      */
+      static ThreadBuffer* AcquireBuffer();
+
+      /**
+      * @return The current timestamp, in ticks
+      */
+      static uint64_t Now();
+
+      /**
+      * @return The current time of the steady clock, in nanoseconds
+      */
+      static uint64_t NowNanoseconds();
+
+    private:
+
+      static ThreadBuffer buffers_[kMaxThreads]; //!< The thread buffers
+      static std::mutex buffers_mutex_; //!< The lock to acquire buffers with
+
+      static thread_local ThreadState state_; //!< The state of each thread
+      static std::atomic<uint32_t> next_thread_; //!< The next thread id
+
+      static std::atomic<bool> capturing_; //!< Is a capture running?
+      static std::atomic<uint32_t> generation_; //!< The current capture
+      static std::atomic<size_t> dropped_; //!< The number of dropped events
+
+      static uint32_t frames_; //!< The number of frames to capture
+      static uint32_t frame_; //!< The number of frames captured so far
+
+      static uint64_t start_ticks_; //!< The timestamp at the start
+      static uint64_t start_ns_; //!< The steady clock time at the start
+      static uint64_t stop_ticks_; //!< The timestamp at the stop
+      static uint64_t stop_ns_; //!< The steady clock time at the stop
+    };
+
+    /**
+    * @brief Opens a profiler zone for as long as it is in scope
+    *
+    * @see SNUFF_PROFILE_ZONE
+    *
+    * @author Daniel Konings
+    */
+    class ProfilerZone
+    {
+
+    public:
+
+      /**
+      * @brief Opens the zone
+      *
+      * @param[in] name The name of the zone
+      */
+      ProfilerZone(const char* name);
+
+      /**
+      * @brief Closes the zone
+      */
+      ~ProfilerZone();
+    };
+
+    //--------------------------------------------------------------------------
+    inline ProfilerZone::ProfilerZone(const char* name)
+    {
+      Profiler::BeginZone(name);
+    }
+
+    //--------------------------------------------------------------------------
+    inline ProfilerZone::~ProfilerZone()
+    {
+      Profiler::EndZone();
+    }
+  }
+}
@@ -0,0 +1,474 @@
+#include "foundation/compression/block_compression.h"
+
+#include <cstring>
+
+namespace snuffbox
+{
+  namespace foundation
+  {
+    //--------------------------------------------------------------------------
+    const size_t BlockCompressor::kChunkSize;
+    const size_t BlockCompressor::kChunkHeaderSize;
+    const uint32_t BlockCompressor::kStoredFlag;
+    const size_t BlockCompressor::kHashBits_;
+    const size_t BlockCompressor::kMinMatch_;
+    const size_t BlockCompressor::kLastLiterals_;
+    const size_t BlockCompressor::kMatchLimit_;
+
+    //--------------------------------------------------------------------------
+    size_t BlockCompressor::Bound(size_t size)
+    {
+      size_t chunks = (size + kChunkSize - 1) / kChunkSize;
+      return size + chunks * kChunkHeaderSize;
+    }
+
+    //--------------------------------------------------------------------------
+    size_t BlockCompressor::Compress(
+      const uint8_t* src,
+      size_t size,
+      uint8_t* dst,
+      size_t capacity)
+    {
+      size_t total = 0;
+
+      for (size_t offset = 0; offset < size; offset += kChunkSize)
+      {
+        size_t raw_size = size - offset;
+        raw_size = raw_size < kChunkSize ? raw_size : kChunkSize;
+
+        if (capacity - total < kChunkHeaderSize)
+        {
+          return 0;
+        }
+
+        uint8_t* header = dst + total;
+        uint8_t* out = header + kChunkHeaderSize;
+        size_t room = capacity - total - kChunkHeaderSize;
+
+        size_t compressed = CompressChunk(
+          src + offset,
+          raw_size,
+          out,
+          room < raw_size - 1 ? room : raw_size - 1);
+
+        uint32_t stored_size = static_cast<uint32_t>(compressed);
+
+        if (compressed == 0)
+        {
+          if (room < raw_size)
+          {
+            return 0;
+          }
+
+          memcpy(out, src + offset, raw_size);
+
+          compressed = raw_size;
+          stored_size = static_cast<uint32_t>(raw_size) | kStoredFlag;
+        }
+
+        uint32_t unpacked_size = static_cast<uint32_t>(raw_size);
+
+        memcpy(header, &unpacked_size, sizeof(uint32_t));
+        memcpy(header + sizeof(uint32_t), &stored_size, sizeof(uint32_t));
+
+        total += kChunkHeaderSize + compressed;
+      }
+
+      return total;
+    }
+
+    //--------------------------------------------------------------------------
+    size_t BlockCompressor::CompressChunk(
+      const uint8_t* src,
+      size_t size,
+      uint8_t* dst,
+      size_t capacity)
+    {
+      uint32_t table[1 << kHashBits_];
+      memset(table, 0, sizeof(table));
+
+      const uint8_t* ip = src;
+      const uint8_t* anchor = src;
+      const uint8_t* end = src + size;
+
+      uint8_t* op = dst;
+      uint8_t* op_end = dst + capacity;
+
+      if (size > kMatchLimit_)
+      {
+        const uint8_t* match_start_limit = end - kMatchLimit_;
+        const uint8_t* match_end_limit = end - kLastLiterals_;
+
+        while (ip < match_start_limit)
+        {
+          uint32_t hash = Hash(ip);
+          uint32_t candidate = table[hash];
+
+          table[hash] = static_cast<uint32_t>(ip - src) + 1;
+
+          if (candidate == 0)
+          {
+            ++ip;
+            continue;
+          }
+
+          const uint8_t* ref = src + candidate - 1;
+
+          if (memcmp(ref, ip, kMinMatch_) != 0)
+          {
+            ++ip;
+            continue;
+          }
+
+          const uint8_t* match_end = ip + kMinMatch_;
+          const uint8_t* ref_end = ref + kMinMatch_;
+
+          while (match_end < match_end_limit && *match_end == *ref_end)
+          {
+            ++match_end;
+            ++ref_end;
+          }
+
+          size_t literals = static_cast<size_t>(ip - anchor);
+          size_t match_length =
+            static_cast<size_t>(match_end - ip) - kMinMatch_;
+
+          size_t needed =
+            1 + literals / 255 + 1 + literals + 2 + match_length / 255 + 1;
+
+          if (needed > static_cast<size_t>(op_end - op))
+          {
+            return 0;
+          }
+
+          uint8_t* token = op++;
+          *token = static_cast<uint8_t>((literals < 15 ? literals : 15) << 4);
+
+          if (literals >= 15)
+          {
+            op = WriteLength(literals - 15, op, op_end);
+          }
+
+          memcpy(op, anchor, literals);
+          op += literals;
+
+          uint16_t offset = static_cast<uint16_t>(ip - ref);
+          *op++ = static_cast<uint8_t>(offset & 0xff);
+          *op++ = static_cast<uint8_t>(offset >> 8);
+
+          *token |=
+            static_cast<uint8_t>(match_length < 15 ? match_length : 15);
+
+          if (match_length >= 15)
+          {
+            op = WriteLength(match_length - 15, op, op_end);
+          }
+
+          ip = match_end;
+          anchor = ip;
+        }
+      }
+
+      size_t literals = static_cast<size_t>(end - anchor);
+
+      if (1 + literals / 255 + 1 + literals > static_cast<size_t>(op_end - op))
+      {
+        return 0;
+      }
+
+      uint8_t* token = op++;
+      *token = static_cast<uint8_t>((literals < 15 ? literals : 15) << 4);
+
+      if (literals >= 15)
+      {
+        op = WriteLength(literals - 15, op, op_end);
+      }
+
+      memcpy(op, anchor, literals);
+      op += literals;
+
+      return static_cast<size_t>(op - dst);
+    }
+
+    //--------------------------------------------------------------------------
+    uint8_t* BlockCompressor::WriteLength(
+      size_t length,
+      uint8_t* dst,
+      uint8_t* end)
+    {
+      while (length >= 255)
+      {
+        if (dst == end)
+        {
+          return nullptr;
+        }
+
+        *dst++ = 255;
+        length -= 255;
+      }
+
+      if (dst == end)
+      {
+        return nullptr;
+      }
+
+      *dst++ = static_cast<uint8_t>(length);
+
+      return dst;
+    }
+
+    //--------------------------------------------------------------------------
+    uint32_t BlockCompressor::Hash(const uint8_t* src)
+    {
+      uint32_t value;
+      memcpy(&value, src, sizeof(uint32_t));
+
+      return (value * 2654435761u) >> (32 - kHashBits_);
+    }
+
+    //--------------------------------------------------------------------------
+    BlockDecompressor::BlockDecompressor(const uint8_t* src, size_t size) :
+      src_(src),
+      end_(src + size)
+    {
+
+    }
+
+    //--------------------------------------------------------------------------
+    bool BlockDecompressor::Next(uint8_t* dst, size_t capacity, size_t* written)
+    {
+      *written = 0;
+
+      size_t remaining = static_cast<size_t>(end_ - src_);
+
+      if (remaining < BlockCompressor::kChunkHeaderSize)
+      {
+        return false;
+      }
+
+      uint32_t unpacked_size, stored_size;
+      memcpy(&unpacked_size, src_, sizeof(uint32_t));
+      memcpy(&stored_size, src_ + sizeof(uint32_t), sizeof(uint32_t));
+
+      bool is_stored = (stored_size & BlockCompressor::kStoredFlag) != 0;
+
+      size_t size = stored_size & ~BlockCompressor::kStoredFlag;
+      remaining -= BlockCompressor::kChunkHeaderSize;
+
+      if (
+        unpacked_size > capacity ||
+        unpacked_size > BlockCompressor::kChunkSize ||
+        size > remaining)
+      {
+        return false;
+      }
+
+      const uint8_t* chunk = src_ + BlockCompressor::kChunkHeaderSize;
+
+      if (is_stored == true)
+      {
+        if (size != unpacked_size)
+        {
+          return false;
+        }
+
+        memcpy(dst, chunk, size);
+      }
+      else if (DecompressChunk(chunk, size, dst, unpacked_size) == false)
+      {
+        return false;
+      }
+
+      src_ = chunk + size;
+      *written = unpacked_size;
+
+      return true;
+    }
+
+    //--------------------------------------------------------------------------
+    bool BlockDecompressor::finished() const
+    {
+      return src_ == end_;
+    }
+
+    //--------------------------------------------------------------------------
+    bool BlockDecompressor::Decompress(
+      const uint8_t* src,
+      size_t size,
+      uint8_t* dst,
+      size_t decompressed_size)
+    {
+      BlockDecompressor decompressor(src, size);
+
+      size_t total = 0;
+      size_t written = 0;
+
+      while (decompressor.finished() == false)
+      {
+        if (
+          decompressor.Next(
+            dst + total,
+            decompressed_size - total,
+            &written) == false)
+        {
+          return false;
+        }
+
+        total += written;
+      }
+
+      return total == decompressed_size;
+    }
+
+    //--------------------------------------------------------------------------
+    bool BlockDecompressor::DecompressedSize(
+      const uint8_t* src,
+      size_t size,
+      size_t* decompressed_size)
+    {
+      *decompressed_size = 0;
+
+      size_t total = 0;
+      size_t remaining = size;
+
+      while (remaining > 0)
+      {
+        if (remaining < BlockCompressor::kChunkHeaderSize)
+        {
+          return false;
+        }
+
+        uint32_t unpacked_size, stored_size;
+        memcpy(&unpacked_size, src, sizeof(uint32_t));
+        memcpy(&stored_size, src + sizeof(uint32_t), sizeof(uint32_t));
+
+        bool is_stored = (stored_size & BlockCompressor::kStoredFlag) != 0;
+
+        size_t chunk_size = stored_size & ~BlockCompressor::kStoredFlag;
+        remaining -= BlockCompressor::kChunkHeaderSize;
+
+        if (
+          unpacked_size > BlockCompressor::kChunkSize ||
+          chunk_size > remaining ||
+          (is_stored == true && chunk_size != unpacked_size))
+        {
+          return false;
+        }
+
+        src += BlockCompressor::kChunkHeaderSize + chunk_size;
+        remaining -= chunk_size;
+        total += unpacked_size;
+      }
+
+      *decompressed_size = total;
+
+      return true;
+    }
+
+    //--------------------------------------------------------------------------
+    bool BlockDecompressor::DecompressChunk(
+      const uint8_t* src,
+      size_t size,
+      uint8_t* dst,
+      size_t capacity)
+    {
+      const uint8_t* ip = src;
+      const uint8_t* end = src + size;
+
+      uint8_t* op = dst;
+      uint8_t* op_end = dst + capacity;
+
+      while (ip < end)
+      {
+        uint8_t token = *ip++;
+        size_t literals = token >> 4;
+
+        if (literals == 15 && ReadLength(&ip, end, &literals) == false)
+        {
+          return false;
+        }
+
+        if (
+          literals > static_cast<size_t>(end - ip) ||
+          literals > static_cast<size_t>(op_end - op))
+        {
+          return false;
+        }
+
+        memcpy(op, ip, literals);
+        ip += literals;
+        op += literals;
+
+        if (ip == end)
+        {
+          break;
+        }
+
+        if (end - ip < 2)
+        {
+          return false;
+        }
+
+        size_t offset = static_cast<size_t>(ip[0]) |
+          (static_cast<size_t>(ip[1]) << 8);
+
+        ip += 2;
+
+        size_t match_length = token & 15;
+
+        if (match_length == 15 && ReadLength(&ip, end, &match_length) == false)
+        {
+          return false;
+        }
+
+        match_length += 4;
+
+        if (
+          offset == 0 ||
+          offset > static_cast<size_t>(op - dst) ||
+          match_length > static_cast<size_t>(op_end - op))
+        {
+          return false;
+        }
+
+        const uint8_t* ref = op - offset;
+
+        if (offset >= match_length)
+        {
+          memcpy(op, ref, match_length);
+          op += match_length;
+          continue;
+        }
+
+        for (size_t i = 0; i < match_length; ++i)
+        {
+          *op++ = *ref++;
+        }
+      }
+
+      return op == op_end;
+    }
+
+    //--------------------------------------------------------------------------
+    bool BlockDecompressor::ReadLength(
+      const uint8_t** src,
+      const uint8_t* end,
+      size_t* length)
+    {
+      uint8_t value;
+
+      do
+      {
+        if (*src == end)
+        {
+          return false;
+        }
+
+        value = *(*src)++;
+        *length += value;
+      } while (value == 255);
+
+      return true;
+    }
+  }
+}
@@ -0,0 +1,238 @@
+#pragma once
+
+#include <cinttypes>
+#include <cstddef>
+
+namespace snuffbox
+{
+  namespace foundation
+  {
+    /**
+    * @brief A fast LZ77 compressor in the style of LZ4, for data that is
+    *        written once and read many times
+    *
+    * The data is split into chunks of BlockCompressor::kChunkSize, which are
+    * compressed independently. Every chunk starts with its unpacked size and
+    * its stored size. A chunk that doesn't get any smaller is stored as is,
+    * so the output is never much larger than the input.
+    *
+    * Within a chunk, sequences of literals are followed by a match of at
+    * least 4 bytes with an offset of up to 64 KB. The last bytes of a chunk
+    * are always literals. Matches are found greedily with a single hash
+    * table, which favours speed over the compression ratio.
+    *
+    * @see BlockDecompressor
+    *
+    * @author Daniel Konings
+    */
+    class BlockCompressor
+    {
+
+    public:
+
+      /**
+      * @brief The size of the chunks that are compressed independently
+      */
+      static const size_t kChunkSize = 64 * 1024;
+
+      /**
+      * @brief The size of the header in front of every chunk
+      */
+      static const size_t kChunkHeaderSize = 2 * sizeof(uint32_t);
+
+      /**
+      * @brief Set in the stored size of a chunk that is stored as is
+      */
+      static const uint32_t kStoredFlag = 0x80000000;
+
+      /**
+      * @brief Calculates the maximum size of compressed data
+      *
+      * @param[in] size The size of the data to compress
+      *
+      * @return The maximum size of the compressed data
+      */
+      static size_t Bound(size_t size);
+
+      /**
+      * @brief Compresses data into a buffer
+      *
+      * @param[in] src The data to compress
+      * @param[in] size The size of the data
+      * @param[out] dst The buffer to compress into
+      * @param[in] capacity The capacity of the buffer, at least
+      *                     BlockCompressor::Bound to always succeed
+      *
+      * @return The size of the compressed data, or 0 if it didn't fit
+      */
+      static size_t Compress(
+        const uint8_t* src,
+        size_t size,
+        uint8_t* dst,
+        size_t capacity);
+
+    protected:
+
+      /**
+      * @brief Compresses a single chunk
+      *
+      * @param[in] src The chunk to compress
+      * @param[in] size The size of the chunk, at most kChunkSize
+      * @param[out] dst The buffer to compress into
+      * @param[in] capacity The capacity of the buffer
+      *
+      * @return The size of the compressed chunk, or 0 if it didn't fit
+      */
+      static size_t CompressChunk(
+        const uint8_t* src,
+        size_t size,
+        uint8_t* dst,
+        size_t capacity);
+
+      /**
+      * @brief Writes a length that didn't fit in the token of a sequence
+      *
+      * @param[in] length The remaining length, after the token
+      * @param[out] dst The buffer to write to
+      * @param[in] end The end of the buffer
+      *
+      * @return The position after the length, or nullptr if it didn't fit
+      */
+      static uint8_t* WriteLength(size_t length, uint8_t* dst, uint8_t* end);
+
+      /**
+      * @brief Hashes the next 4 bytes of data
+      *
+      * @param[in] src The data to hash
+      *
+      * @return The index into the hash table
+      */
+      static uint32_t Hash(const uint8_t* src);
+
+    private:
+
+      static const size_t kHashBits_ = 12; //!< The size of the hash table
+      static const size_t kMinMatch_ = 4; //!< The shortest match
+      static const size_t kLastLiterals_ = 5; //!< Literals at the end
+      static const size_t kMatchLimit_ = 12; //!< No matches this near the end
+    };
+
+    /**
+    * @brief Decompresses data compressed by a BlockCompressor, chunk by
+    *        chunk
+    *
+    * Every call to BlockDecompressor::Next decompresses a single chunk into
+    * the destination, so that a large buffer can be decompressed as its
+    * compressed data comes in, or straight into its final location. Every
+    * read and write is bounds checked, so corrupt data fails to decompress
+    * instead of overrunning the buffers.
+    *
+    * @see BlockCompressor
+    *
+    * @author Daniel Konings
+    */
+    class BlockDecompressor
+    {
+
+    public:
+
+      /**
+      * @brief Starts decompressing compressed data
+      *
+      * @param[in] src The compressed data, which should outlive the
+      *                decompressor
+      * @param[in] size The size of the compressed data
+      */
+      BlockDecompressor(const uint8_t* src, size_t size);
+
+      /**
+      * @brief Decompresses the next chunk
+      *
+      * @param[out] dst The buffer to decompress into
+      * @param[in] capacity The capacity of the buffer, which should be at
+      *                     least BlockCompressor::kChunkSize to fit any chunk
+      * @param[out] written The size of the decompressed chunk
+      *
+      * @return Was the chunk decompressed succesfully? False when finished.
+      */
+      bool Next(uint8_t* dst, size_t capacity, size_t* written);
+
+      /**
+      * @return Has every chunk been decompressed?
+      */
+      bool finished() const;
+
+      /**
+      * @brief Decompresses all data into a buffer of its exact size
+      *
+      * @param[in] src The compressed data
+      * @param[in] size The size of the compressed data
+      * @param[out] dst The buffer to decompress into
+      * @param[in] decompressed_size The size of the decompressed data
+      *
+      * @return Was the data decompressed succesfully to exactly the
+      *         expected size?
+      */
+      static bool Decompress(
+        const uint8_t* src,
+        size_t size,
+        uint8_t* dst,
+        size_t decompressed_size);
+
+      /**
+      * @brief Walks the chunk headers of compressed data without
+      *        decompressing it, to validate untrusted data before a buffer
+      *        is allocated for it
+      *
+      * @param[in] src The compressed data
+      * @param[in] size The size of the compressed data
+      * @param[out] decompressed_size The sum of the unpacked sizes of the
+      *                               chunks
+      *
+      * @return Does every chunk fit in the compressed data, with a valid
+      *         unpacked size?
+      */
+      static bool DecompressedSize(
+        const uint8_t* src,
+        size_t size,
+        size_t* decompressed_size);
+
+    protected:
+
+      /**
+      * @brief Decompresses the sequences of a single chunk
+      *
+      * @param[in] src The compressed chunk
+      * @param[in] size The size of the compressed chunk
+      * @param[out] dst The buffer to decompress into
+      * @param[in] capacity The unpacked size of the chunk
+      *
+      * @return Was the chunk decompressed to exactly its unpacked size?
+      */
+      static bool DecompressChunk(
+        const uint8_t* src,
+        size_t size,
+        uint8_t* dst,
+        size_t capacity);
+
+      /**
+      * @brief Reads a length that didn't fit in the token of a sequence
+      *
+      * @param[in|out] src The position to read from, moved past the length
+      * @param[in] end The end of the compressed chunk
+      * @param[out] length The length to add the read length to
+      *
+      * @return Was the length read succesfully?
+      */
+      static bool ReadLength(
+        const uint8_t** src,
+        const uint8_t* end,
+        size_t* length);
+
+    private:
+
+      const uint8_t* src_; //!< The position in the compressed data
+      const uint8_t* end_; //!< The end of the compressed data
+    };
+  }
+}
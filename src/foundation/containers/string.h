@@ -16,5 +16,12 @@ namespace snuffbox
     * @brief An EASTL string with a custom allocator
     */
     using String = eastl::basic_string<char, EASTLAllocator>;
+
+    /**
+    * @brief An EASTL string that allocates from the frame allocator
+    *
+    * @see FrameEASTLAllocator
+    */
+    using FrameString = eastl::basic_string<char, FrameEASTLAllocator>;
   }
 }
\ No newline at end of file
@@ -0,0 +1,274 @@
+#include "foundation/containers/string_id.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+namespace snuffbox
+{
+  namespace foundation
+  {
+    //--------------------------------------------------------------------------
+    const size_t StringId::kInitialCapacity_ = 1024;
+
+    //--------------------------------------------------------------------------
+    std::mutex StringId::mutex_;
+    std::atomic<const StringId::Table*> StringId::table_(nullptr);
+    size_t StringId::count_ = 0;
+
+    //--------------------------------------------------------------------------
+    StringId::StringId() :
+      entry_(nullptr)
+    {
+
+    }
+
+    //--------------------------------------------------------------------------
+    StringId::StringId(const char* str) :
+      StringId(str, strlen(str), Hash(str, strlen(str)))
+    {
+
+    }
+
+    //--------------------------------------------------------------------------
+    StringId::StringId(const String& str) :
+      StringId(str.c_str(), str.size(), Hash(str.c_str(), str.size()))
+    {
+
+    }
+
+    //--------------------------------------------------------------------------
+    StringId::StringId(const char* str, size_t length, uint64_t hash) :
+      entry_(Intern(str, length, hash, true))
+    {
+
+    }
+
+    //--------------------------------------------------------------------------
+    StringId StringId::Find(const char* str, size_t length)
+    {
+      return StringId(Intern(str, length, Hash(str, length), false));
+    }
+
+    //--------------------------------------------------------------------------
+    StringId StringId::Find(const String& str)
+    {
+      return Find(str.c_str(), str.size());
+    }
+
+    //--------------------------------------------------------------------------
+    bool StringId::operator==(const StringId& other) const
+    {
+      return entry_ == other.entry_;
+    }
+
+    //--------------------------------------------------------------------------
+    bool StringId::operator!=(const StringId& other) const
+    {
+      return entry_ != other.entry_;
+    }
+
+    //--------------------------------------------------------------------------
+    bool StringId::is_valid() const
+    {
+      return entry_ != nullptr;
+    }
+
+    //--------------------------------------------------------------------------
+    uint64_t StringId::hash() const
+    {
+      return entry_ == nullptr ? 0 : entry_->hash;
+    }
+
+    //--------------------------------------------------------------------------
+    const char* StringId::c_str() const
+    {
+      if (entry_ == nullptr)
+      {
+        return "";
+      }
+
+      return reinterpret_cast<const char*>(entry_ + 1);
+    }
+
+    //--------------------------------------------------------------------------
+    size_t StringId::size() const
+    {
+      return entry_ == nullptr ? 0 : entry_->length;
+    }
+
+    //--------------------------------------------------------------------------
+    String StringId::ToString() const
+    {
+      return String(c_str(), size());
+    }
+
+    //--------------------------------------------------------------------------
+    size_t StringId::num_interned()
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      return count_;
+    }
+
+    //--------------------------------------------------------------------------
+    const StringId::Entry* StringId::Probe(
+      const Table* table,
+      const char* str,
+      size_t length,
+      uint64_t hash)
+    {
+      if (table == nullptr)
+      {
+        return nullptr;
+      }
+
+      size_t mask = table->capacity - 1;
+      size_t slot = static_cast<size_t>(hash) & mask;
+
+      const Entry* entry = nullptr;
+
+      while (
+        (entry = table->slots[slot].load(std::memory_order_acquire)) !=
+        nullptr)
+      {
+        if (
+          entry->hash == hash &&
+          entry->length == length &&
+          memcmp(entry + 1, str, length) == 0)
+        {
+          return entry;
+        }
+
+        slot = (slot + 1) & mask;
+      }
+
+      return nullptr;
+    }
+
+    //--------------------------------------------------------------------------
+    const StringId::Entry* StringId::Intern(
+      const char* str,
+      size_t length,
+      uint64_t hash,
+      bool insert)
+    {
+      const Entry* found =
+        Probe(table_.load(std::memory_order_acquire), str, length, hash);
+
+      if (found != nullptr || insert == false)
+      {
+        return found;
+      }
+
+      std::lock_guard<std::mutex> lock(mutex_);
+
+      const Table* table = table_.load(std::memory_order_relaxed);
+
+      if ((found = Probe(table, str, length, hash)) != nullptr)
+      {
+        return found;
+      }
+
+      size_t capacity = table == nullptr ? 0 : table->capacity;
+
+      if ((count_ + 1) * 2 > capacity)
+      {
+        if (Grow() == false)
+        {
+          return nullptr;
+        }
+
+        table = table_.load(std::memory_order_relaxed);
+      }
+
+      // The interning table outlives every allocator, as ids can be held by
+      // statics; it is allocated with malloc and never released
+      Entry* entry =
+        static_cast<Entry*>(malloc(sizeof(Entry) + length + 1));
+
+      if (entry == nullptr)
+      {
+        return nullptr;
+      }
+
+      entry->hash = hash;
+      entry->length = length;
+
+      char* chars = reinterpret_cast<char*>(entry + 1);
+      memcpy(chars, str, length);
+      chars[length] = '\0';
+
+      size_t mask = table->capacity - 1;
+      size_t slot = static_cast<size_t>(hash) & mask;
+
+      while (table->slots[slot].load(std::memory_order_relaxed) != nullptr)
+      {
+        slot = (slot + 1) & mask;
+      }
+
+      table->slots[slot].store(entry, std::memory_order_release);
+      ++count_;
+
+      return entry;
+    }
+
+    //--------------------------------------------------------------------------
+    bool StringId::Grow()
+    {
+      const Table* old = table_.load(std::memory_order_relaxed);
+      size_t capacity = old == nullptr ? kInitialCapacity_ : old->capacity * 2;
+
+      Table* table = static_cast<Table*>(malloc(
+        sizeof(Table) + capacity * sizeof(std::atomic<const Entry*>)));
+
+      if (table == nullptr)
+      {
+        return false;
+      }
+
+      table->capacity = capacity;
+      table->slots = reinterpret_cast<std::atomic<const Entry*>*>(table + 1);
+
+      for (size_t i = 0; i < capacity; ++i)
+      {
+        new (&table->slots[i]) std::atomic<const Entry*>(nullptr);
+      }
+
+      size_t mask = capacity - 1;
+      size_t old_capacity = old == nullptr ? 0 : old->capacity;
+
+      for (size_t i = 0; i < old_capacity; ++i)
+      {
+        const Entry* entry = old->slots[i].load(std::memory_order_relaxed);
+
+        if (entry == nullptr)
+        {
+          continue;
+        }
+
+        size_t slot = static_cast<size_t>(entry->hash) & mask;
+
+        while (table->slots[slot].load(std::memory_order_relaxed) != nullptr)
+        {
+          slot = (slot + 1) & mask;
+        }
+
+        table->slots[slot].store(entry, std::memory_order_relaxed);
+      }
+
+      // The old table is never released, lock-free readers might still be
+      // probing it; as the capacity doubles, all retired tables together are
+      // never larger than the current one
+      table_.store(table, std::memory_order_release);
+
+      return true;
+    }
+
+    //--------------------------------------------------------------------------
+    StringId::StringId(const Entry* entry) :
+      entry_(entry)
+    {
+
+    }
+  }
+}
@@ -0,0 +1,275 @@
+#pragma once
+
+#ifndef EASTL_USER_CONFIG_HEADER
+#define EASTL_USER_CONFIG_HEADER "foundation/memory/eastl_config.h"
+#endif
+
+#include "foundation/containers/string.h"
+
+#include <EASTL/functional.h>
+
+#include <cinttypes>
+#include <cstddef>
+#include <atomic>
+#include <mutex>
+#include <type_traits>
+
+/**
+* @brief Creates a StringId from a string literal, hashing the literal at
+*        compile time
+*/
+#define SNUFF_STRING_ID(str)                                                   \
+snuffbox::foundation::StringId(str, sizeof(str) - 1, std::integral_constant<   \
+uint64_t, snuffbox::foundation::StringId::Hash(str, sizeof(str) - 1)>::value)
+
+namespace snuffbox
+{
+  namespace foundation
+  {
+    /**
+    * @brief An interned string that can be compared and hashed in constant
+    *        time
+    *
+    * Every unique string is stored exactly once in a global, thread-safe
+    * interning table, along with its precomputed hash. A StringId only holds
+    * a pointer to that entry, which means that copying, comparing and hashing
+    * ids never touches the characters of the string.
+    *
+    * Strings that were interned before are looked up without taking a lock,
+    * as entries are immutable once they are published in the table. Only
+    * interning a new string locks, to insert it or to grow the table.
+    *
+    * Creating an id from a string hashes the string once. String literals can
+    * be hashed at compile time using SNUFF_STRING_ID. Lookups with strings of
+    * unknown origin should use StringId::Find, which does not grow the table.
+    *
+    * @remarks Interned strings are never released
+    *
+    * @author Daniel Konings
+    */
+    class StringId
+    {
+
+    public:
+
+      /**
+      * @brief Construct an invalid id
+      */
+      StringId();
+
+      /**
+      * @brief Construct an id by interning a null-terminated string
+      *
+      * @param[in] str The string to intern
+      */
+      StringId(const char* str);
+
+      /**
+      * @see StringId::StringId
+      *
+      * @remarks String overload
+      */
+      StringId(const String& str);
+
+      /**
+      * @brief Construct an id by interning a string with a precomputed hash
+      *
+      * @param[in] str The string to intern
+      * @param[in] length The length of the string
+      * @param[in] hash The hash of the string, see StringId::Hash
+      */
+      StringId(const char* str, size_t length, uint64_t hash);
+
+      /**
+      * @brief Finds the id of a string, without interning it if it doesn't
+      *        exist yet
+      *
+      * @param[in] str The string to find
+      * @param[in] length The length of the string
+      *
+      * @return The id, or an invalid id if the string was never interned
+      */
+      static StringId Find(const char* str, size_t length);
+
+      /**
+      * @see StringId::Find
+      *
+      * @remarks String overload
+      */
+      static StringId Find(const String& str);
+
+      /**
+      * @brief Hashes a string using 64-bit FNV-1a
+      *
+      * @param[in] str The string to hash
+      * @param[in] length The length of the string
+      *
+      * @return The hash of the string
+      */
+      static constexpr uint64_t Hash(const char* str, size_t length);
+
+      /**
+      * @return Are the strings of both ids equal?
+      */
+      bool operator==(const StringId& other) const;
+
+      /**
+      * @return Are the strings of both ids not equal?
+      */
+      bool operator!=(const StringId& other) const;
+
+      /**
+      * @return Does this id refer to an interned string?
+      */
+      bool is_valid() const;
+
+      /**
+      * @return The precomputed hash of the string, or 0 if this id is invalid
+      */
+      uint64_t hash() const;
+
+      /**
+      * @return The interned string, or an empty string if this id is invalid
+      */
+      const char* c_str() const;
+
+      /**
+      * @return The length of the string
+      */
+      size_t size() const;
+
+      /**
+      * @return A copy of the interned string
+      */
+      String ToString() const;
+
+      /**
+      * @return The number of unique strings that were interned
+      */
+      static size_t num_interned();
+
+    protected:
+
+      /**
+      * @brief An interned string, the characters are stored directly after
+      *        the entry
+      *
+      * @author Daniel Konings
+      */
+      struct Entry
+      {
+        uint64_t hash; //!< The hash of the string
+        size_t length; //!< The length of the string
+      };
+
+      /**
+      * @brief An open-addressed interning table, the slots are stored
+      *        directly after the table
+      *
+      * @remarks Tables are never released, as lock-free readers might still
+      *          be probing a table after it was replaced by a larger one
+      *
+      * @author Daniel Konings
+      */
+      struct Table
+      {
+        size_t capacity; //!< The number of slots, a power of two
+        std::atomic<const Entry*>* slots; //!< The slots, nullptr if empty
+      };
+
+      /**
+      * @brief Probes a table for a string, without taking the lock
+      *
+      * @param[in] table The table to probe, can be nullptr
+      * @param[in] str The string to look up
+      * @param[in] length The length of the string
+      * @param[in] hash The hash of the string
+      *
+      * @return The entry of the string, or nullptr if it was not found
+      */
+      static const Entry* Probe(
+        const Table* table,
+        const char* str,
+        size_t length,
+        uint64_t hash);
+
+      /**
+      * @brief Looks up a string in the interning table
+      *
+      * @param[in] str The string to look up
+      * @param[in] length The length of the string
+      * @param[in] hash The hash of the string
+      * @param[in] insert Should the string be interned if it doesn't exist?
+      *
+      * @return The entry of the string, or nullptr if it was not found and
+      *         not inserted
+      */
+      static const Entry* Intern(
+        const char* str,
+        size_t length,
+        uint64_t hash,
+        bool insert);
+
+      /**
+      * @brief Publishes a copy of the interning table with double its
+      *        capacity
+      *
+      * @remarks This should only be called while holding the lock
+      *
+      * @return Was the table grown succesfully?
+      */
+      static bool Grow();
+
+      /**
+      * @brief Construct an id from an interned entry
+      *
+      * @param[in] entry The entry to refer to
+      */
+      explicit StringId(const Entry* entry);
+
+      /**
+      * @brief The initial capacity of the interning table
+      */
+      static const size_t kInitialCapacity_;
+
+      static const uint64_t kOffsetBasis_ = 14695981039346656037ull; //!< FNV
+      static const uint64_t kPrime_ = 1099511628211ull; //!< FNV
+
+    private:
+
+      const Entry* entry_; //!< The interned entry, nullptr if invalid
+
+      static std::mutex mutex_; //!< The lock around inserting strings
+      static std::atomic<const Table*> table_; //!< The current table
+      static size_t count_; //!< The number of interned strings
+    };
+
+    //--------------------------------------------------------------------------
+    inline constexpr uint64_t StringId::Hash(const char* str, size_t length)
+    {
+      uint64_t hash = kOffsetBasis_;
+
+      for (size_t i = 0; i < length; ++i)
+      {
+        hash = (hash ^ static_cast<uint8_t>(str[i])) * kPrime_;
+      }
+
+      return hash;
+    }
+  }
+}
+
+namespace eastl
+{
+  /**
+  * @brief Hashes a StringId using its precomputed hash
+  */
+  template <>
+  struct hash<snuffbox::foundation::StringId>
+  {
+    size_t operator()(const snuffbox::foundation::StringId& id) const
+    {
+      return static_cast<size_t>(id.hash());
+    }
+  };
+}
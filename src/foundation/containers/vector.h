@@ -17,5 +17,15 @@ namespace snuffbox
     */
     template <typename T>
     using Vector = eastl::vector<T, EASTLAllocator>;
+
+    /**
+    * @brief An EASTL vector that allocates from the frame allocator
+    *
+    * @tparam T The type contained within the vector
+    *
+    * @see FrameEASTLAllocator
+    */
+    template <typename T>
+    using FrameVector = eastl::vector<T, FrameEASTLAllocator>;
   }
 }
\ No newline at end of file
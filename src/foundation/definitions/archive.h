@@ -2,14 +2,44 @@
 
 #include "foundation/serialization/serializable.h"
 #include "foundation/auxiliary/type_traits.h"
+#include "foundation/containers/string_id.h"
 
-#define SET_ARCHIVE_PROP(x) snuffbox::foundation::ArchiveName{ #x }, x
-#define GET_ARCHIVE_PROP(x) snuffbox::foundation::ArchiveName{ #x }, &x
+#include <cinttypes>
+#include <cstddef>
+#include <type_traits>
+
+/**
+* @brief Creates an ArchiveName from a property, hashing its name at
+*        compile time
+*/
+#define SNUFF_ARCHIVE_NAME(x)                                                  \
+snuffbox::foundation::ArchiveName{ #x, std::integral_constant<uint32_t,        \
+snuffbox::foundation::ArchiveName::Hash(#x, sizeof(#x) - 1)>::value }
+
+#define SET_ARCHIVE_PROP(x) SNUFF_ARCHIVE_NAME(x), x
+#define GET_ARCHIVE_PROP(x) SNUFF_ARCHIVE_NAME(x), &x
 
 namespace snuffbox
 {
   namespace foundation
   {
+    /**
+    * @brief Common identifiers to represent what type of value is followed
+    *        in a SaveArchive's buffer and the type of a value in a
+    *        BinaryArchive
+    */
+    enum class ArchiveIdentifiers : uint8_t
+    {
+      kName,
+      kNumber,
+      kBoolean,
+      kString,
+      kArray,
+      kObjectStart,
+      kObjectEnd,
+      kNull //!< Only found in hand-written JSON, never archived
+    };
+
     /**
     * @brief Used as a unique type to store property names
     *
@@ -18,8 +48,26 @@ namespace snuffbox
     struct ArchiveName
     {
       const char* name; //!< The name of the property
+      uint32_t hash; //!< The hash of the name, see ArchiveName::Hash
+
+      /**
+      * @brief Hashes a property name, to look it up in a BinaryArchive
+      *
+      * @param[in] str The name to hash
+      * @param[in] length The length of the name
+      *
+      * @return The 64-bit FNV-1a hash of the name, folded to 32 bits
+      */
+      static constexpr uint32_t Hash(const char* str, size_t length);
     };
 
+    //--------------------------------------------------------------------------
+    inline constexpr uint32_t ArchiveName::Hash(const char* str, size_t length)
+    {
+      uint64_t hash = StringId::Hash(str, length);
+      return static_cast<uint32_t>(hash ^ (hash >> 32));
+    }
+
     /**
     * @brief Used to check if a type derives from ISerializable
     *
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "foundation/definitions/archive.h"
+
+#include <cinttypes>
+#include <cstddef>
+
+/**
+* @brief Marks a member variable to be added to the field table of its class
+*
+* The 'sparse' tool generates a FieldDescriptor for every marked member.
+* Enumerators should be marked with SNUFF_FIELD(enum), as their type can't
+* be deduced from their name.
+*/
+#define SNUFF_FIELD(...)
+
+/**
+* @brief Declares the accessor of the field table that 'sparse' generates
+*        for a class, in the class body
+*/
+#define SNUFF_FIELD_TABLE()                                                    \
+static const snuffbox::foundation::FieldTable& SerializedFields()
+
+namespace snuffbox
+{
+  namespace foundation
+  {
+    /**
+    * @brief The types of values a FieldDescriptor can describe
+    */
+    enum class FieldType : uint8_t
+    {
+      kBool,
+      kInt32,
+      kUInt32,
+      kFloat,
+      kDouble,
+      kEnum, //!< An enumerator with the size of an int
+      kString,
+      kUUID,
+      kVec2,
+      kVec3,
+      kVec4,
+      kQuat
+    };
+
+    /**
+    * @brief Describes a single serialized member variable of a class
+    *
+    * @author Daniel Konings
+    */
+    struct FieldDescriptor
+    {
+      const char* name; //!< The name of the field
+      uint32_t length; //!< The length of the name
+      uint32_t hash; //!< The hash of the name, see ArchiveName::Hash
+      uint32_t offset; //!< The offset of the field within its class
+      FieldType type; //!< The type of the field
+    };
+
+    /**
+    * @brief The serialized member variables of a class, as generated by
+    *        'sparse' from the SNUFF_FIELD markers in its header
+    *
+    * @see FieldCodec
+    *
+    * @author Daniel Konings
+    */
+    struct FieldTable
+    {
+      const char* name; //!< The name of the class
+      const FieldDescriptor* fields; //!< The fields, in declaration order
+      size_t count; //!< The number of fields
+    };
+  }
+}
@@ -17,7 +17,22 @@ namespace snuffbox
     enum FileFlags : int32_t
     {
       kRead = 1 << 0, //!< Read only
-      kWrite = 1 << 1 //!< Write only
+      kWrite = 1 << 1, //!< Write only
+      kMapped = 1 << 2 //!< Map read only files into memory where supported
+    };
+
+    /**
+    * @brief The kinds of changes the directory listeners report
+    *
+    * Moves are reported as a removal of the old path and a creation of the
+    * new path.
+    */
+    enum class DirectoryEvent : int32_t
+    {
+      kCreated, //!< The file or directory was created
+      kModified, //!< The contents of the file were changed
+      kRemoved, //!< The file or directory was removed
+      kUnknown //!< Anything under the path might have changed
     };
 
     /**
@@ -28,7 +43,9 @@ namespace snuffbox
     * @see LinuxDirectoryListener
     *
     * @param[in] path The path to the file or directory that changed
+    * @param[in] evt The kind of change
     */
-    using OnDirectoryChanged = Function<void(const Path& path)>;
+    using OnDirectoryChanged = 
+      Function<void(const Path& path, DirectoryEvent evt)>;
   }
 }
\ No newline at end of file
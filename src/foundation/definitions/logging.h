@@ -30,5 +30,18 @@ namespace snuffbox
       kBuilder,
       kNumChannels
     };
+
+    /**
+    * @brief What the asynchronous logger does with a message when its queue
+    *        is full
+    *
+    * @see Logger::Start
+    */
+    enum class LogOverflow
+    {
+      kDrop, //!< Discard the message and report the number of dropped ones
+      kBlock, //!< Wait for the consumer to make room for the message
+      kCoalesce //!< Like kDrop, but also collapses repeated messages
+    };
   }
 }
\ No newline at end of file
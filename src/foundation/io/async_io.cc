@@ -0,0 +1,294 @@
+#include "foundation/io/async_io.h"
+#include "foundation/io/file_writer.h"
+#include "foundation/memory/memory.h"
+#include "foundation/auxiliary/profiler.h"
+
+namespace snuffbox
+{
+  namespace foundation
+  {
+    //--------------------------------------------------------------------------
+    AsyncIO::AsyncIO(size_t num_threads) :
+      next_id_(1),
+      in_flight_(0),
+      stopping_(false),
+      mutex_("AsyncIO")
+    {
+      num_threads = num_threads == 0 ? 1 : num_threads;
+
+      for (size_t i = 0; i < num_threads; ++i)
+      {
+        threads_.push_back(std::thread([this]()
+        {
+          ThreadLoop();
+        }));
+      }
+    }
+
+    //--------------------------------------------------------------------------
+    uint64_t AsyncIO::Read(
+      const Path& path,
+      const OnCompleted& on_completed,
+      Priority priority,
+      Delivery delivery)
+    {
+      Request* request = CreateRequest(
+        Operations::kRead,
+        path,
+        nullptr,
+        0,
+        on_completed,
+        priority,
+        delivery);
+
+      return request->completion.id;
+    }
+
+    //--------------------------------------------------------------------------
+    uint64_t AsyncIO::Write(
+      const Path& path,
+      const uint8_t* buffer,
+      size_t size,
+      const OnCompleted& on_completed,
+      Priority priority,
+      Delivery delivery)
+    {
+      Request* request = CreateRequest(
+        Operations::kWrite,
+        path,
+        buffer,
+        size,
+        on_completed,
+        priority,
+        delivery);
+
+      return request->completion.id;
+    }
+
+    //--------------------------------------------------------------------------
+    void AsyncIO::Submit()
+    {
+      {
+        std::lock_guard<Mutex> lock(mutex_);
+
+        if (batch_.empty() == true)
+        {
+          return;
+        }
+
+        for (size_t i = 0; i < batch_.size(); ++i)
+        {
+          submitted_.push(batch_.at(i));
+        }
+
+        in_flight_ += batch_.size();
+        batch_.clear();
+      }
+
+      wake_.notify_all();
+    }
+
+    //--------------------------------------------------------------------------
+    size_t AsyncIO::Poll(size_t max_completions)
+    {
+      size_t delivered = 0;
+      Request* request = nullptr;
+
+      while (max_completions == 0 || delivered < max_completions)
+      {
+        {
+          std::lock_guard<Mutex> lock(mutex_);
+
+          if (completed_.empty() == true)
+          {
+            break;
+          }
+
+          request = completed_.front();
+          completed_.pop();
+        }
+
+        Deliver(request);
+        ++delivered;
+      }
+
+      return delivered;
+    }
+
+    //--------------------------------------------------------------------------
+    void AsyncIO::Wait()
+    {
+      std::unique_lock<Mutex> lock(mutex_);
+      idle_.wait(lock, [this]() { return in_flight_ == 0; });
+    }
+
+    //--------------------------------------------------------------------------
+    size_t AsyncIO::pending() const
+    {
+      std::lock_guard<Mutex> lock(mutex_);
+      return batch_.size() + in_flight_;
+    }
+
+    //--------------------------------------------------------------------------
+    bool AsyncIO::RequestOrder::operator()(
+      const Request* a,
+      const Request* b) const
+    {
+      if (a->priority != b->priority)
+      {
+        return a->priority < b->priority;
+      }
+
+      return a->completion.id > b->completion.id;
+    }
+
+    //--------------------------------------------------------------------------
+    AsyncIO::Request* AsyncIO::CreateRequest(
+      Operations operation,
+      const Path& path,
+      const uint8_t* buffer,
+      size_t size,
+      const OnCompleted& on_completed,
+      Priority priority,
+      Delivery delivery)
+    {
+      Request* request =
+        Memory::Construct<Request>(&Memory::default_allocator());
+
+      request->completion.operation = operation;
+      request->completion.path = path;
+      request->completion.success = false;
+      request->completion.buffer = nullptr;
+      request->completion.length = 0;
+      request->priority = priority;
+      request->delivery = delivery;
+      request->on_completed = on_completed;
+
+      if (buffer != nullptr)
+      {
+        request->data.assign(buffer, buffer + size);
+      }
+
+      std::lock_guard<Mutex> lock(mutex_);
+
+      request->completion.id = next_id_++;
+      batch_.push_back(request);
+
+      return request;
+    }
+
+    //--------------------------------------------------------------------------
+    void AsyncIO::ThreadLoop()
+    {
+      Profiler::SetThreadName("IO");
+
+      Request* request = nullptr;
+
+      while (true)
+      {
+        {
+          std::unique_lock<Mutex> lock(mutex_);
+          wake_.wait(lock, [this]()
+          {
+            return stopping_ == true || submitted_.empty() == false;
+          });
+
+          if (submitted_.empty() == true)
+          {
+            return;
+          }
+
+          request = submitted_.top();
+          submitted_.pop();
+        }
+
+        Execute(request);
+
+        bool queued = request->delivery == Delivery::kQueued;
+
+        if (queued == false)
+        {
+          Deliver(request);
+        }
+
+        {
+          std::lock_guard<Mutex> lock(mutex_);
+
+          if (queued == true)
+          {
+            completed_.push(request);
+          }
+
+          if (--in_flight_ == 0)
+          {
+            idle_.notify_all();
+          }
+        }
+      }
+    }
+
+    //--------------------------------------------------------------------------
+    void AsyncIO::Execute(Request* request)
+    {
+      SNUFF_PROFILE_ZONE("AsyncIO::Execute");
+
+      Completion& completion = request->completion;
+
+      if (completion.operation == Operations::kRead)
+      {
+        if (request->file.Open(completion.path, FileFlags::kRead) == false)
+        {
+          return;
+        }
+
+        completion.buffer = request->file.ReadBuffer(&completion.length);
+        completion.success = completion.buffer != nullptr;
+
+        return;
+      }
+
+      size_t size = request->data.size();
+      FileWriter writer(completion.path, true, size);
+
+      writer.Write(request->data.data(), size);
+
+      completion.length = size;
+      completion.success = writer.Commit();
+    }
+
+    //--------------------------------------------------------------------------
+    void AsyncIO::Deliver(Request* request)
+    {
+      if (request->on_completed != nullptr)
+      {
+        request->on_completed(request->completion);
+      }
+
+      Memory::Destruct(request);
+    }
+
+    //--------------------------------------------------------------------------
+    AsyncIO::~AsyncIO()
+    {
+      Submit();
+
+      {
+        std::lock_guard<Mutex> lock(mutex_);
+        stopping_ = true;
+      }
+
+      wake_.notify_all();
+
+      for (size_t i = 0; i < threads_.size(); ++i)
+      {
+        threads_.at(i).join();
+      }
+
+      while (completed_.empty() == false)
+      {
+        Memory::Destruct(completed_.front());
+        completed_.pop();
+      }
+    }
+  }
+}
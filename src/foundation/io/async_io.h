@@ -0,0 +1,289 @@
+#pragma once
+
+#include "foundation/io/file.h"
+#include "foundation/io/path.h"
+#include "foundation/containers/function.h"
+#include "foundation/containers/vector.h"
+#include "foundation/containers/queue.h"
+#include "foundation/auxiliary/mutex.h"
+
+#include <thread>
+#include <condition_variable>
+#include <cinttypes>
+#include <cstddef>
+
+namespace snuffbox
+{
+  namespace foundation
+  {
+    /**
+    * @brief Reads and writes files on a pool of I/O threads, so that the
+    *        calling thread doesn't have to wait for the disk
+    *
+    * Requests are collected in a batch until AsyncIO::Submit is called, so
+    * that a batch of requests only wakes the I/O threads once. Submitted
+    * requests are started in order of their priority, and in the order they
+    * were made within the same priority.
+    *
+    * The completion of a request is either delivered on the I/O thread that
+    * completed it, or queued until the owner of the AsyncIO drains the
+    * queue with AsyncIO::Poll, usually once per frame on the main thread.
+    *
+    * @author Daniel Konings
+    */
+    class AsyncIO
+    {
+
+    public:
+
+      /**
+      * @brief The operations that can be requested
+      */
+      enum class Operations
+      {
+        kRead, //!< Reads a file into memory
+        kWrite //!< Replaces the contents of a file atomically
+      };
+
+      /**
+      * @brief The priorities of requests, requests with a higher priority
+      *        are started first
+      */
+      enum class Priority
+      {
+        kLow, //!< Background work, like prefetching
+        kNormal, //!< The default priority
+        kHigh //!< Work that something is waiting for
+      };
+
+      /**
+      * @brief Where the completion of a request is delivered
+      */
+      enum class Delivery
+      {
+        kQueued, //!< Queued until AsyncIO::Poll is called
+        kImmediate //!< On the I/O thread that completed the request
+      };
+
+      /**
+      * @brief The result of a completed request
+      *
+      * @author Daniel Konings
+      */
+      struct Completion
+      {
+        uint64_t id; //!< The ID that was returned when making the request
+        Operations operation; //!< The requested operation
+        Path path; //!< The path of the file
+        bool success; //!< Was the request completed succesfully?
+
+        /**
+        * @brief The contents of a read file, only valid for the duration of
+        *        the completion callback
+        */
+        const uint8_t* buffer;
+
+        size_t length; //!< The number of bytes read or written
+      };
+
+      /**
+      * @brief The callback to deliver completions to
+      */
+      using OnCompleted = Function<void(const Completion&)>;
+
+      /**
+      * @brief The default number of I/O threads
+      */
+      static const size_t kDefaultThreads = 2;
+
+      /**
+      * @brief Starts the I/O threads
+      *
+      * @param[in] num_threads The number of I/O threads, at least one
+      */
+      AsyncIO(size_t num_threads = kDefaultThreads);
+
+      /**
+      * @brief Non-copyable
+      */
+      AsyncIO(const AsyncIO&) = delete;
+
+      /**
+      * @brief Non-copyable
+      */
+      AsyncIO& operator=(const AsyncIO&) = delete;
+
+      /**
+      * @brief Requests a file to be read into memory
+      *
+      * @param[in] path The path of the file to read
+      * @param[in] on_completed The callback to deliver the contents to
+      * @param[in] priority The priority of the request
+      * @param[in] delivery Where the completion should be delivered
+      *
+      * @return The ID of the request
+      */
+      uint64_t Read(
+        const Path& path,
+        const OnCompleted& on_completed,
+        Priority priority = Priority::kNormal,
+        Delivery delivery = Delivery::kQueued);
+
+      /**
+      * @brief Requests a buffer to be written to a file
+      *
+      * The buffer is copied, so it doesn't have to outlive the request.
+      *
+      * @param[in] path The path of the file to write
+      * @param[in] buffer The buffer to write
+      * @param[in] size The size of the buffer
+      * @param[in] on_completed The callback to deliver the completion to,
+      *                         can be nullptr
+      * @param[in] priority The priority of the request
+      * @param[in] delivery Where the completion should be delivered
+      *
+      * @return The ID of the request
+      */
+      uint64_t Write(
+        const Path& path,
+        const uint8_t* buffer,
+        size_t size,
+        const OnCompleted& on_completed = nullptr,
+        Priority priority = Priority::kNormal,
+        Delivery delivery = Delivery::kQueued);
+
+      /**
+      * @brief Submits the current batch of requests to the I/O threads
+      */
+      void Submit();
+
+      /**
+      * @brief Delivers the queued completions on the calling thread
+      *
+      * @param[in] max_completions The maximum number of completions to
+      *                            deliver, or 0 to deliver all of them
+      *
+      * @return The number of completions that were delivered
+      */
+      size_t Poll(size_t max_completions = 0);
+
+      /**
+      * @brief Waits until every submitted request has been completed
+      *
+      * @remarks Queued completions are not delivered, call AsyncIO::Poll
+      *          afterwards to deliver them
+      */
+      void Wait();
+
+      /**
+      * @return The number of requests that are batched or in flight
+      */
+      size_t pending() const;
+
+      /**
+      * @brief Completes every request and joins the I/O threads
+      *
+      * @remarks Completions that are still queued are discarded
+      */
+      ~AsyncIO();
+
+    protected:
+
+      /**
+      * @brief A request and, once it has been completed, its completion
+      *
+      * @author Daniel Konings
+      */
+      struct Request
+      {
+        Completion completion; //!< The completion of the request
+        Priority priority; //!< The priority of the request
+        Delivery delivery; //!< Where the completion should be delivered
+        OnCompleted on_completed; //!< The callback to deliver to
+        Vector<uint8_t> data; //!< The buffer to write
+        File file; //!< The file that was read, owning the read buffer
+      };
+
+      /**
+      * @brief Orders requests by priority first and by ID second
+      *
+      * @author Daniel Konings
+      */
+      struct RequestOrder
+      {
+        /**
+        * @brief Is a request started after another request?
+        *
+        * @param[in] a The first request
+        * @param[in] b The second request
+        *
+        * @return Should b be started before a?
+        */
+        bool operator()(const Request* a, const Request* b) const;
+      };
+
+      /**
+      * @brief Creates a request and adds it to the current batch
+      *
+      * @param[in] operation The operation to request
+      * @param[in] path The path of the file
+      * @param[in] buffer The buffer to write, or nullptr for a read
+      * @param[in] size The size of the buffer
+      * @param[in] on_completed The callback to deliver to
+      * @param[in] priority The priority of the request
+      * @param[in] delivery Where the completion should be delivered
+      *
+      * @return The created request
+      */
+      Request* CreateRequest(
+        Operations operation,
+        const Path& path,
+        const uint8_t* buffer,
+        size_t size,
+        const OnCompleted& on_completed,
+        Priority priority,
+        Delivery delivery);
+
+      /**
+      * @brief The loop of an I/O thread, which processes requests until the
+      *        AsyncIO is destructed
+      */
+      void ThreadLoop();
+
+      /**
+      * @brief Executes the operation of a request
+      *
+      * @param[in] request The request to execute
+      */
+      static void Execute(Request* request);
+
+      /**
+      * @brief Delivers the completion of a request and destructs it
+      *
+      * @param[in] request The request to deliver
+      */
+      static void Deliver(Request* request);
+
+    private:
+
+      Vector<std::thread> threads_; //!< The I/O threads
+      uint64_t next_id_; //!< The ID of the next request
+
+      Vector<Request*> batch_; //!< The requests that haven't been submitted
+
+      /**
+      * @brief The submitted requests that haven't been started yet
+      */
+      PriorityQueue<Request*, RequestOrder> submitted_;
+
+      Queue<Request*> completed_; //!< The completions to deliver on a poll
+
+      size_t in_flight_; //!< The number of submitted, incomplete requests
+      bool stopping_; //!< Should the I/O threads stop?
+
+      mutable Mutex mutex_; //!< The mutex to guard the queues with
+      std::condition_variable_any wake_; //!< Wakes the I/O threads
+      std::condition_variable_any idle_; //!< Signals that nothing is in flight
+    };
+  }
+}
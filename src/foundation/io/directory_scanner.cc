@@ -0,0 +1,602 @@
+#include "foundation/io/directory_scanner.h"
+#include "foundation/io/directory.h"
+#include "foundation/io/metadata_cache.h"
+
+#include <algorithm>
+#include <thread>
+#include <cstring>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#ifdef SNUFF_LINUX
+#include <sys/syscall.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace snuffbox
+{
+  namespace foundation
+  {
+    //--------------------------------------------------------------------------
+    const uint32_t DirectoryScanner::kInvalidIndex;
+    const size_t DirectoryScanner::kDefaultThreads;
+
+    //--------------------------------------------------------------------------
+    DirectoryScanner::DirectoryScanner(size_t num_threads) :
+      root_(""),
+      num_threads_(num_threads == 0 ? 1 : num_threads),
+      root_fd_(-1),
+      mutex_("DirectoryScanner"),
+      active_(0)
+    {
+
+    }
+
+    //--------------------------------------------------------------------------
+    bool DirectoryScanner::Scan(const Path& root)
+    {
+      Path scanned = root;
+
+      root_ = scanned;
+      root_string_ = scanned.ToString();
+
+      entries_.clear();
+      paths_.clear();
+
+      Vector<Listing> listings;
+
+      if (ListTree("", &listings) == false)
+      {
+        return false;
+      }
+
+      Flatten(listings, 0, kInvalidIndex, 0, &entries_);
+      StoreMetadata(0, static_cast<uint32_t>(entries_.size()));
+
+      return true;
+    }
+
+    //--------------------------------------------------------------------------
+    bool DirectoryScanner::Rescan(const Path& path, uint32_t* changed)
+    {
+      String relative;
+
+      if (ToRelative(path, &relative) == false)
+      {
+        return false;
+      }
+
+      if (relative.empty() == true)
+      {
+        if (changed != nullptr)
+        {
+          *changed = kInvalidIndex;
+        }
+
+        return Scan(root_);
+      }
+
+      uint32_t index = FindRelative(relative);
+
+      if (index == kInvalidIndex || entries_.at(index).is_directory == false)
+      {
+        size_t slash = relative.find_last_of('/');
+
+        if (slash == String::npos)
+        {
+          return Rescan(root_, changed);
+        }
+
+        return Rescan(root_ / relative.substr(0, slash), changed);
+      }
+
+      Vector<Listing> listings;
+      Vector<Entry> scanned;
+
+      bool exists = ListTree(relative, &listings);
+
+      if (changed != nullptr)
+      {
+        *changed = exists == true ? index : entries_.at(index).parent;
+      }
+
+      uint32_t first = exists == true ? index + 1 : index;
+      uint32_t last = entries_.at(index).end;
+
+      if (exists == true)
+      {
+        Flatten(listings, 0, index, first, &scanned);
+      }
+
+      int64_t delta =
+        static_cast<int64_t>(scanned.size()) -
+        static_cast<int64_t>(last - first);
+
+      entries_.erase(entries_.begin() + first, entries_.begin() + last);
+      entries_.insert(entries_.begin() + first, scanned.begin(), scanned.end());
+
+      for (uint32_t i = 0; i < first; ++i)
+      {
+        Entry& entry = entries_.at(i);
+
+        if (entry.end >= last)
+        {
+          entry.end = static_cast<uint32_t>(entry.end + delta);
+        }
+      }
+
+      uint32_t after = first + static_cast<uint32_t>(scanned.size());
+
+      for (uint32_t i = after; i < entries_.size(); ++i)
+      {
+        Entry& entry = entries_.at(i);
+
+        if (entry.parent != kInvalidIndex && entry.parent >= last)
+        {
+          entry.parent = static_cast<uint32_t>(entry.parent + delta);
+        }
+
+        entry.end = static_cast<uint32_t>(entry.end + delta);
+      }
+
+      MetadataCache::Invalidate(path);
+      StoreMetadata(exists == true ? index : first, after);
+
+      CompactPaths();
+
+      return exists;
+    }
+
+    //--------------------------------------------------------------------------
+    bool DirectoryScanner::Contains(const Path& path) const
+    {
+      String relative;
+      return root_string_.empty() == false && ToRelative(path, &relative);
+    }
+
+    //--------------------------------------------------------------------------
+    uint32_t DirectoryScanner::Find(const Path& path) const
+    {
+      String relative;
+
+      if (ToRelative(path, &relative) == false)
+      {
+        return kInvalidIndex;
+      }
+
+      return FindRelative(relative);
+    }
+
+    //--------------------------------------------------------------------------
+    String DirectoryScanner::RelativePath(const Entry& entry) const
+    {
+      return paths_.substr(entry.path_offset, entry.path_length);
+    }
+
+    //--------------------------------------------------------------------------
+    Path DirectoryScanner::FullPath(const Entry& entry) const
+    {
+      return root_ / RelativePath(entry);
+    }
+
+    //--------------------------------------------------------------------------
+    const Vector<DirectoryScanner::Entry>& DirectoryScanner::entries() const
+    {
+      return entries_;
+    }
+
+    //--------------------------------------------------------------------------
+    const Path& DirectoryScanner::root() const
+    {
+      return root_;
+    }
+
+    //--------------------------------------------------------------------------
+    bool DirectoryScanner::ListTree(
+      const String& relative,
+      Vector<Listing>* listings)
+    {
+      listings->clear();
+      listings->push_back(Listing{ relative, Vector<FoundEntry>() });
+
+#ifdef SNUFF_LINUX
+      root_fd_ = open(
+        root_string_.c_str(),
+        O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+
+      if (root_fd_ == -1)
+      {
+        return false;
+      }
+#endif
+
+      Vector<FoundEntry> root_entries;
+      bool success = ListDirectory(relative, &root_entries);
+
+      if (success == true)
+      {
+        jobs_.clear();
+        active_ = 0;
+
+        for (size_t i = 0; i < root_entries.size(); ++i)
+        {
+          FoundEntry& found = root_entries.at(i);
+
+          if (found.is_directory == false)
+          {
+            continue;
+          }
+
+          found.listing = listings->size();
+          jobs_.push_back(found.listing);
+
+          listings->push_back(Listing
+          {
+            relative.empty() == true ?
+              found.name :
+              relative + '/' + found.name,
+            Vector<FoundEntry>()
+          });
+        }
+
+        listings->at(0).entries.swap(root_entries);
+
+        size_t num_threads = std::min<size_t>(
+          num_threads_,
+          std::max<size_t>(std::thread::hardware_concurrency(), 1));
+
+        Vector<std::thread> threads;
+
+        for (size_t i = 1; i < num_threads && jobs_.empty() == false; ++i)
+        {
+          threads.push_back(std::thread([this, listings]()
+          {
+            WorkerLoop(listings);
+          }));
+        }
+
+        WorkerLoop(listings);
+
+        for (size_t i = 0; i < threads.size(); ++i)
+        {
+          threads.at(i).join();
+        }
+      }
+
+#ifdef SNUFF_LINUX
+      close(root_fd_);
+      root_fd_ = -1;
+#endif
+
+      return success;
+    }
+
+    //--------------------------------------------------------------------------
+    void DirectoryScanner::WorkerLoop(Vector<Listing>* listings)
+    {
+      size_t index;
+      String relative;
+      Vector<FoundEntry> found;
+
+      while (true)
+      {
+        {
+          std::unique_lock<Mutex> lock(mutex_);
+          wake_.wait(lock, [this]()
+          {
+            return jobs_.empty() == false || active_ == 0;
+          });
+
+          if (jobs_.empty() == true)
+          {
+            return;
+          }
+
+          index = jobs_.back();
+          jobs_.pop_back();
+          ++active_;
+
+          relative = listings->at(index).relative;
+        }
+
+        found.clear();
+        ListDirectory(relative, &found);
+
+        {
+          std::lock_guard<Mutex> lock(mutex_);
+
+          for (size_t i = 0; i < found.size(); ++i)
+          {
+            FoundEntry& entry = found.at(i);
+
+            if (entry.is_directory == false)
+            {
+              continue;
+            }
+
+            entry.listing = listings->size();
+            jobs_.push_back(entry.listing);
+
+            listings->push_back(Listing
+            {
+              relative + '/' + entry.name,
+              Vector<FoundEntry>()
+            });
+          }
+
+          listings->at(index).entries.swap(found);
+          --active_;
+        }
+
+        wake_.notify_all();
+      }
+    }
+
+    //--------------------------------------------------------------------------
+    bool DirectoryScanner::ListDirectory(
+      const String& relative,
+      Vector<FoundEntry>* entries)
+    {
+      FoundEntry found;
+      found.listing = 0;
+
+#ifdef SNUFF_LINUX
+      int fd = openat(
+        root_fd_,
+        relative.empty() == true ? "." : relative.c_str(),
+        O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+
+      if (fd == -1)
+      {
+        return false;
+      }
+
+      alignas(struct dirent64) char buffer[16 * 1024];
+      struct stat st;
+
+      while (true)
+      {
+        long bytes = syscall(SYS_getdents64, fd, buffer, sizeof(buffer));
+
+        if (bytes <= 0)
+        {
+          break;
+        }
+
+        for (long offset = 0; offset < bytes;)
+        {
+          const struct dirent64* dirent =
+            reinterpret_cast<const struct dirent64*>(buffer + offset);
+
+          offset += dirent->d_reclen;
+
+          const char* name = dirent->d_name;
+
+          if (
+            strcmp(name, ".") == 0 ||
+            strcmp(name, "..") == 0 ||
+            fstatat(fd, name, &st, 0) != 0)
+          {
+            continue;
+          }
+
+          found.name = name;
+          found.is_directory = S_ISDIR(st.st_mode);
+          found.size = found.is_directory == true ? 0 : st.st_size;
+          found.last_modified = st.st_mtime;
+
+          entries->push_back(found);
+        }
+      }
+
+      close(fd);
+#else
+      Path dir = relative.empty() == true ? root_ : root_ / relative;
+
+      if (Directory::Exists(dir) == false)
+      {
+        return false;
+      }
+
+      Directory d(dir);
+      const Vector<Path>& children = d.children();
+
+      struct stat st;
+
+      for (size_t i = 0; i < children.size(); ++i)
+      {
+        const String& child = children.at(i).ToString();
+
+        if (stat(child.c_str(), &st) != 0)
+        {
+          continue;
+        }
+
+        found.name = child.substr(child.find_last_of('/') + 1);
+        found.is_directory = (st.st_mode & S_IFDIR) != 0;
+        found.size = found.is_directory == true ? 0 : st.st_size;
+        found.last_modified = st.st_mtime;
+
+        entries->push_back(found);
+      }
+#endif
+
+      std::sort(entries->begin(), entries->end(),
+        [](const FoundEntry& a, const FoundEntry& b)
+      {
+        return a.name < b.name;
+      });
+
+      return true;
+    }
+
+    //--------------------------------------------------------------------------
+    void DirectoryScanner::Flatten(
+      const Vector<Listing>& listings,
+      size_t index,
+      uint32_t parent,
+      uint32_t base,
+      Vector<Entry>* out)
+    {
+      const Listing& listing = listings.at(index);
+
+      for (size_t i = 0; i < listing.entries.size(); ++i)
+      {
+        const FoundEntry& found = listing.entries.at(i);
+
+        size_t current = out->size();
+        uint32_t current_index = base + static_cast<uint32_t>(current);
+
+        Entry entry;
+        entry.path_offset = static_cast<uint32_t>(paths_.size());
+        entry.parent = parent;
+        entry.end = current_index + 1;
+        entry.size = found.size;
+        entry.last_modified = found.last_modified;
+        entry.is_directory = found.is_directory;
+
+        if (listing.relative.empty() == false)
+        {
+          paths_ += listing.relative;
+          paths_ += '/';
+        }
+
+        paths_ += found.name;
+
+        entry.path_length =
+          static_cast<uint32_t>(paths_.size()) - entry.path_offset;
+
+        out->push_back(entry);
+
+        if (found.is_directory == true)
+        {
+          Flatten(listings, found.listing, current_index, base, out);
+          out->at(current).end = base + static_cast<uint32_t>(out->size());
+        }
+      }
+    }
+
+    //--------------------------------------------------------------------------
+    void DirectoryScanner::StoreMetadata(uint32_t first, uint32_t last) const
+    {
+      for (uint32_t i = first; i < last; ++i)
+      {
+        const Entry& entry = entries_.at(i);
+        MetadataCache::Store(FullPath(entry), entry.is_directory);
+      }
+    }
+
+    //--------------------------------------------------------------------------
+    bool DirectoryScanner::ToRelative(const Path& path, String* relative) const
+    {
+      const String& p = path.ToString();
+
+      if (
+        p.size() < root_string_.size() ||
+        p.compare(0, root_string_.size(), root_string_) != 0)
+      {
+        return false;
+      }
+
+      if (p.size() == root_string_.size())
+      {
+        *relative = "";
+        return true;
+      }
+
+      if (p.at(root_string_.size()) != '/')
+      {
+        return false;
+      }
+
+      *relative = p.substr(root_string_.size() + 1);
+
+      return true;
+    }
+
+    //--------------------------------------------------------------------------
+    uint32_t DirectoryScanner::FindRelative(const String& relative) const
+    {
+      const char* pool = paths_.c_str();
+
+      uint32_t first = 0;
+      uint32_t last = static_cast<uint32_t>(entries_.size());
+      size_t length = 0;
+
+      while (length < relative.size())
+      {
+        length = relative.find('/', length + 1);
+
+        if (length == String::npos)
+        {
+          length = relative.size();
+        }
+
+        uint32_t i = first;
+
+        while (i < last)
+        {
+          const Entry& entry = entries_.at(i);
+
+          if (
+            entry.path_length == length &&
+            memcmp(pool + entry.path_offset, relative.c_str(), length) == 0)
+          {
+            break;
+          }
+
+          i = entry.end;
+        }
+
+        if (i >= last)
+        {
+          return kInvalidIndex;
+        }
+
+        if (length == relative.size())
+        {
+          return i;
+        }
+
+        first = i + 1;
+        last = entries_.at(i).end;
+      }
+
+      return kInvalidIndex;
+    }
+
+    //--------------------------------------------------------------------------
+    void DirectoryScanner::CompactPaths()
+    {
+      size_t used = 0;
+
+      for (size_t i = 0; i < entries_.size(); ++i)
+      {
+        used += entries_.at(i).path_length;
+      }
+
+      if (paths_.size() <= used * 2)
+      {
+        return;
+      }
+
+      String compacted;
+      compacted.reserve(used);
+
+      for (size_t i = 0; i < entries_.size(); ++i)
+      {
+        Entry& entry = entries_.at(i);
+
+        uint32_t offset = static_cast<uint32_t>(compacted.size());
+        compacted.append(paths_, entry.path_offset, entry.path_length);
+
+        entry.path_offset = offset;
+      }
+
+      paths_.swap(compacted);
+    }
+  }
+}
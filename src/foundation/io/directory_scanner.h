@@ -0,0 +1,279 @@
+#pragma once
+
+#include "foundation/io/path.h"
+#include "foundation/containers/string.h"
+#include "foundation/containers/vector.h"
+#include "foundation/auxiliary/mutex.h"
+
+#include <condition_variable>
+#include <ctime>
+#include <cinttypes>
+#include <cstddef>
+
+namespace snuffbox
+{
+  namespace foundation
+  {
+    /**
+    * @brief Scans a directory tree into a flat list of entries, with the
+    *        metadata of every entry filled in
+    *
+    * Every directory is listed as a separate job, so that subdirectories
+    * are fanned out over a pool of worker threads. On Linux a directory is
+    * listed with getdents64 and its entries are queried with fstatat,
+    * relative to the file descriptor of the directory, so that no full
+    * paths are resolved or allocated while scanning.
+    *
+    * The entries are stored in depth-first order, sorted by name within
+    * a directory. Every directory knows where its subtree ends, which makes
+    * a subtree a contiguous range of entries. The paths of the entries are
+    * stored relative to the root in a single string pool.
+    *
+    * A subtree can be rescanned on its own with DirectoryScanner::Rescan,
+    * for instance when a directory listener reports changes in it.
+    *
+    * Every scanned path is stored in the MetadataCache, so that
+    * Path::is_directory doesn't query the file system again.
+    *
+    * @author Daniel Konings
+    */
+    class DirectoryScanner
+    {
+
+    public:
+
+      /**
+      * @brief The index of an entry that doesn't exist
+      */
+      static const uint32_t kInvalidIndex = 0xffffffff;
+
+      /**
+      * @brief The default maximum number of worker threads
+      */
+      static const size_t kDefaultThreads = 4;
+
+      /**
+      * @brief A file or directory that was found while scanning
+      *
+      * @author Daniel Konings
+      */
+      struct Entry
+      {
+        uint32_t path_offset; //!< The offset of the relative path in the pool
+        uint32_t path_length; //!< The length of the relative path
+        uint32_t parent; //!< The parent directory, or kInvalidIndex
+        uint32_t end; //!< One past the last entry in the subtree
+        uint64_t size; //!< The size of a file in bytes
+        time_t last_modified; //!< When was the entry last modified?
+        bool is_directory; //!< Is this entry a directory?
+      };
+
+      /**
+      * @brief Creates a scanner without any entries
+      *
+      * @param[in] num_threads The maximum number of worker threads, the
+      *                        scanner never uses more than the number
+      *                        of hardware threads
+      */
+      DirectoryScanner(size_t num_threads = kDefaultThreads);
+
+      /**
+      * @brief Scans a directory tree, replacing all previous entries
+      *
+      * @param[in] root The root directory to scan
+      *
+      * @return Was the root directory scanned succesfully?
+      */
+      bool Scan(const Path& root);
+
+      /**
+      * @brief Rescans a subtree of the scanned directory tree, replacing
+      *        only the entries of that subtree
+      *
+      * If the path was removed, its entries are removed. If the path wasn't
+      * scanned before, its closest scanned parent directory is rescanned.
+      *
+      * @param[in] path The path of the directory to rescan, which should be
+      *                 inside of the root directory
+      * @param[out] changed The index of the directory of which the entries
+      *                     were replaced, or kInvalidIndex if all entries
+      *                     were replaced, default = nullptr
+      *
+      * @return Was the subtree rescanned succesfully?
+      */
+      bool Rescan(const Path& path, uint32_t* changed = nullptr);
+
+      /**
+      * @brief Checks if a path is the root directory or inside of it
+      *
+      * @param[in] path The path to check
+      *
+      * @return Is the path inside of the scanned directory tree?
+      */
+      bool Contains(const Path& path) const;
+
+      /**
+      * @brief Finds an entry by its path
+      *
+      * The path is looked up one directory at a time, skipping the subtrees
+      * of the entries that don't match, so only the entries along the path
+      * and their siblings are compared.
+      *
+      * @param[in] path The path of the entry
+      *
+      * @return The index of the entry, or kInvalidIndex if it wasn't found
+      */
+      uint32_t Find(const Path& path) const;
+
+      /**
+      * @brief Retrieves the path of an entry relative to the root
+      *
+      * @param[in] entry The entry to retrieve the path of
+      *
+      * @return The relative path
+      */
+      String RelativePath(const Entry& entry) const;
+
+      /**
+      * @brief Retrieves the full path of an entry
+      *
+      * @param[in] entry The entry to retrieve the path of
+      *
+      * @return The root path, followed by the relative path
+      */
+      Path FullPath(const Entry& entry) const;
+
+      /**
+      * @return The scanned entries, in depth-first order
+      */
+      const Vector<Entry>& entries() const;
+
+      /**
+      * @return The root directory that was scanned
+      */
+      const Path& root() const;
+
+    protected:
+
+      /**
+      * @brief An entry that is found by a worker, before the entries are
+      *        sorted into depth-first order
+      *
+      * @author Daniel Konings
+      */
+      struct FoundEntry
+      {
+        String name; //!< The name of the entry within its directory
+        uint64_t size; //!< The size of a file in bytes
+        time_t last_modified; //!< When was the entry last modified?
+        bool is_directory; //!< Is this entry a directory?
+        size_t listing; //!< The listing of a directory's contents
+      };
+
+      /**
+      * @brief The contents of a single directory, listed by a single job
+      *
+      * @author Daniel Konings
+      */
+      struct Listing
+      {
+        String relative; //!< The path of the directory relative to the root
+        Vector<FoundEntry> entries; //!< The entries in the directory
+      };
+
+      /**
+      * @brief Lists a subtree of the root directory on the worker threads
+      *
+      * @param[in] relative The path of the subtree relative to the root
+      * @param[out] listings The listing of every directory in the subtree,
+      *                      where the first listing is the subtree itself
+      *
+      * @return Could the subtree be listed?
+      */
+      bool ListTree(const String& relative, Vector<Listing>* listings);
+
+      /**
+      * @brief Runs listing jobs until there are no more jobs left
+      *
+      * @param[in|out] listings The listings that are being filled
+      */
+      void WorkerLoop(Vector<Listing>* listings);
+
+      /**
+      * @brief Lists the entries of a single directory
+      *
+      * @param[in] relative The path of the directory relative to the root
+      * @param[out] entries The entries in the directory
+      *
+      * @return Could the directory be opened?
+      */
+      bool ListDirectory(const String& relative, Vector<FoundEntry>* entries);
+
+      /**
+      * @brief Appends the entries of a listing and all of its descendants
+      *        in depth-first order
+      *
+      * @param[in] listings All listings of the tree
+      * @param[in] index The listing to append
+      * @param[in] parent The index of the parent entry, or kInvalidIndex
+      * @param[in] base The index the first entry in the output will get
+      * @param[out] out The entries to append to
+      */
+      void Flatten(
+        const Vector<Listing>& listings,
+        size_t index,
+        uint32_t parent,
+        uint32_t base,
+        Vector<Entry>* out);
+
+      /**
+      * @brief Stores the scanned entries in a range in the MetadataCache
+      *
+      * @param[in] first The first entry to store
+      * @param[in] last One past the last entry to store
+      */
+      void StoreMetadata(uint32_t first, uint32_t last) const;
+
+      /**
+      * @brief Converts a path to a path relative to the root
+      *
+      * @param[in] path The path to convert
+      * @param[out] relative The relative path, empty for the root itself
+      *
+      * @return Is the path inside of the root?
+      */
+      bool ToRelative(const Path& path, String* relative) const;
+
+      /**
+      * @brief Finds an entry by its path relative to the root
+      *
+      * @param[in] relative The relative path of the entry
+      *
+      * @return The index of the entry, or kInvalidIndex if it wasn't found
+      */
+      uint32_t FindRelative(const String& relative) const;
+
+      /**
+      * @brief Removes the paths of entries that were replaced by a rescan
+      *        from the string pool, once they take up most of it
+      */
+      void CompactPaths();
+
+    private:
+
+      Path root_; //!< The root directory that was scanned
+      String root_string_; //!< The root directory as a string
+      size_t num_threads_; //!< The maximum number of worker threads
+
+      Vector<Entry> entries_; //!< The scanned entries
+      String paths_; //!< The pool of relative paths
+
+      int root_fd_; //!< The open root directory during a scan, on Linux
+
+      Mutex mutex_; //!< The lock around the jobs of a scan
+      std::condition_variable_any wake_; //!< Signals new jobs or completion
+      Vector<size_t> jobs_; //!< The listings that still need to be listed
+      size_t active_; //!< The number of jobs being listed
+    };
+  }
+}
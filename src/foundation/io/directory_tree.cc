@@ -1,4 +1,5 @@
 #include "foundation/io/directory_tree.h"
+#include "foundation/io/resources.h"
 
 namespace snuffbox
 {
@@ -7,7 +8,9 @@ namespace snuffbox
     //--------------------------------------------------------------------------
     DirectoryTreeItem::DirectoryTreeItem(const Path& path) :
       path_(path),
-      is_directory_(path.is_directory())
+      is_directory_(path.is_directory()),
+      size_(0),
+      last_modified_(0)
     {
       if (is_directory_ == true)
       {
@@ -15,6 +18,28 @@ namespace snuffbox
       }
     }
 
+    //--------------------------------------------------------------------------
+    DirectoryTreeItem::DirectoryTreeItem(const Path& path, bool is_directory) :
+      path_(path),
+      is_directory_(is_directory),
+      size_(0),
+      last_modified_(0)
+    {
+
+    }
+
+    //--------------------------------------------------------------------------
+    DirectoryTreeItem::DirectoryTreeItem(
+      const Path& path,
+      const DirectoryScanner::Entry& entry) :
+      path_(path),
+      is_directory_(entry.is_directory),
+      size_(entry.size),
+      last_modified_(entry.last_modified)
+    {
+
+    }
+
     //--------------------------------------------------------------------------
     const Path& DirectoryTreeItem::path() const
     {
@@ -27,6 +52,18 @@ namespace snuffbox
       return is_directory_;
     }
 
+    //--------------------------------------------------------------------------
+    uint64_t DirectoryTreeItem::size() const
+    {
+      return size_;
+    }
+
+    //--------------------------------------------------------------------------
+    time_t DirectoryTreeItem::last_modified() const
+    {
+      return last_modified_;
+    }
+
     //--------------------------------------------------------------------------
     const Vector<DirectoryTreeItem>& DirectoryTreeItem::children() const
     {
@@ -41,6 +78,18 @@ namespace snuffbox
         return;
       }
 
+      if (dir.is_virtual() == true)
+      {
+        Vector<Path> children = Resources::Children(dir);
+
+        for (size_t i = 0; i < children.size(); ++i)
+        {
+          children_.push_back(DirectoryTreeItem(children.at(i)));
+        }
+
+        return;
+      }
+
       Directory d(dir);
 
       if (d.is_ok() == false)
@@ -73,17 +122,70 @@ namespace snuffbox
     {
       if (path.is_virtual() == true)
       {
+        AddItems(Resources::Children(path));
         return;
       }
 
-      Directory root_dir(path);
+      items_.clear();
+
+      if (Directory::Exists(path) == false)
+      {
+        Directory root_dir(path);
+        return;
+      }
 
-      if (root_dir.is_ok() == false)
+      if (scanner_.Scan(path) == false)
       {
         return;
       }
 
-      AddItems(root_dir.children());
+      AddScannedItems(
+        scanner_, 
+        0, 
+        static_cast<uint32_t>(scanner_.entries().size()), 
+        &items_);
+    }
+
+    //--------------------------------------------------------------------------
+    bool DirectoryTree::Rescan(const Path& path)
+    {
+      if (scanner_.Contains(path) == false)
+      {
+        return false;
+      }
+
+      uint32_t changed;
+      bool exists = scanner_.Rescan(path, &changed);
+
+      const Vector<DirectoryScanner::Entry>& entries = scanner_.entries();
+
+      Vector<DirectoryTreeItem>* items = &items_;
+      uint32_t first = 0;
+      uint32_t last = static_cast<uint32_t>(entries.size());
+
+      if (changed != DirectoryScanner::kInvalidIndex)
+      {
+        const DirectoryScanner::Entry& entry = entries.at(changed);
+        DirectoryTreeItem* item = FindItem(scanner_.FullPath(entry));
+
+        if (item != nullptr)
+        {
+          items = &item->children_;
+          first = changed + 1;
+          last = entry.end;
+        }
+      }
+
+      items->clear();
+      AddScannedItems(scanner_, first, last, items);
+
+      return exists;
+    }
+
+    //--------------------------------------------------------------------------
+    const DirectoryTreeItem* DirectoryTree::Find(const Path& path) const
+    {
+      return const_cast<DirectoryTree*>(this)->FindItem(path);
     }
 
     //--------------------------------------------------------------------------
@@ -102,5 +204,64 @@ namespace snuffbox
         items_.push_back(items.at(i));
       }
     }
+
+    //--------------------------------------------------------------------------
+    void DirectoryTree::AddScannedItems(
+      const DirectoryScanner& scanner,
+      uint32_t first,
+      uint32_t last,
+      Vector<DirectoryTreeItem>* items)
+    {
+      const Vector<DirectoryScanner::Entry>& entries = scanner.entries();
+
+      for (uint32_t i = first; i < last; i = entries.at(i).end)
+      {
+        const DirectoryScanner::Entry& entry = entries.at(i);
+
+        items->push_back(DirectoryTreeItem(scanner.FullPath(entry), entry));
+
+        if (entry.is_directory == true)
+        {
+          AddScannedItems(scanner, i + 1, entry.end, &items->back().children_);
+        }
+      }
+    }
+
+    //--------------------------------------------------------------------------
+    DirectoryTreeItem* DirectoryTree::FindItem(const Path& path)
+    {
+      const String& p = path.ToString();
+      Vector<DirectoryTreeItem>* items = &items_;
+
+      size_t i = 0;
+
+      while (i < items->size())
+      {
+        DirectoryTreeItem& item = items->at(i);
+        const String& item_path = item.path_.ToString();
+
+        ++i;
+
+        if (
+          p.size() < item_path.size() ||
+          p.compare(0, item_path.size(), item_path) != 0)
+        {
+          continue;
+        }
+
+        if (p.size() == item_path.size())
+        {
+          return &item;
+        }
+
+        if (item.is_directory_ == true && p.at(item_path.size()) == '/')
+        {
+          items = &item.children_;
+          i = 0;
+        }
+      }
+
+      return nullptr;
+    }
   }
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include "foundation/io/path.h"
 #include "foundation/io/directory.h"
+#include "foundation/io/directory_scanner.h"
 #include "foundation/containers/vector.h"
 
 namespace snuffbox
@@ -38,6 +39,24 @@ namespace snuffbox
       */
       DirectoryTreeItem(const Path& path);
 
+      /**
+      * @brief Constructs a directory tree item of which it is already known
+      *        whether it is a directory, without adding any children
+      *
+      * @param[in] path The path to a file or directory
+      * @param[in] is_directory Is the path a directory?
+      */
+      DirectoryTreeItem(const Path& path, bool is_directory);
+
+      /**
+      * @brief Constructs a directory tree item from a scanned entry, without
+      *        adding any children
+      *
+      * @param[in] path The full path of the entry
+      * @param[in] entry The scanned entry
+      */
+      DirectoryTreeItem(const Path& path, const DirectoryScanner::Entry& entry);
+
     public:
 
       /**
@@ -50,6 +69,20 @@ namespace snuffbox
       */
       bool is_directory() const;
 
+      /**
+      * @return The size of a file in bytes, as it was scanned
+      *
+      * @remarks This is 0 for directories and items that were not scanned
+      */
+      uint64_t size() const;
+
+      /**
+      * @return When the item was last modified, as it was scanned
+      *
+      * @remarks This is 0 for items that were not scanned
+      */
+      time_t last_modified() const;
+
       /**
       * @return The children items of this item
       */
@@ -69,6 +102,8 @@ namespace snuffbox
 
       Path path_; //!< The path of this directory tree item
       bool is_directory_; //!< Is this item a directory?
+      uint64_t size_; //!< The size of a file in bytes
+      time_t last_modified_; //!< When was the item last modified?
 
       Vector<DirectoryTreeItem> children_; //!< The children items of this item
     };
@@ -98,10 +133,34 @@ namespace snuffbox
       * @brief Opens a directory tree and lists all its items and their
       *        children
       *
+      * Directories on disk are scanned in parallel by a DirectoryScanner,
+      * which already knows which items are directories.
+      *
       * @param[in] path The root path of the directory tree
       */
       void Open(const Path& path);
 
+      /**
+      * @brief Rescans a directory in the tree after it was changed on disk,
+      *        only replacing the items of the affected subtree
+      *
+      * @see DirectoryScanner::Rescan
+      *
+      * @param[in] path The path of the directory that changed
+      *
+      * @return Does the directory still exist?
+      */
+      bool Rescan(const Path& path);
+
+      /**
+      * @brief Finds an item in the tree by its path
+      *
+      * @param[in] path The path of the item
+      *
+      * @return The found item, or nullptr if it isn't in the tree
+      */
+      const DirectoryTreeItem* Find(const Path& path) const;
+
       /**
       * @return The root items of this directory tree
       */
@@ -122,12 +181,41 @@ namespace snuffbox
       */
       void AddItems(const Vector<Path>& items);
 
+      /**
+      * @brief Adds a range of scanned entries and their children as items
+      *
+      * @param[in] scanner The scanner that scanned the entries
+      * @param[in] first The first entry to add
+      * @param[in] last One past the last entry to add
+      * @param[out] items The items to add to
+      */
+      static void AddScannedItems(
+        const DirectoryScanner& scanner,
+        uint32_t first,
+        uint32_t last,
+        Vector<DirectoryTreeItem>* items);
+
+      /**
+      * @brief Finds an item in the tree by its path, descending only into
+      *        the directories that contain the path
+      *
+      * @param[in] path The path of the item
+      *
+      * @return The found item, or nullptr if it isn't in the tree
+      */
+      DirectoryTreeItem* FindItem(const Path& path);
+
     private:
 
       /**
       * @brief The root items of this directory tree
       */
       Vector<DirectoryTreeItem> items_;
+
+      /**
+      * @brief The scanner of the tree on disk, kept to rescan subtrees
+      */
+      DirectoryScanner scanner_;
     };
   }
 }
\ No newline at end of file
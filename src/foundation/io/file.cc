@@ -2,11 +2,15 @@
 #include "foundation/memory/memory.h"
 #include "foundation/auxiliary/pointer_math.h"
 #include "foundation/io/resources.h"
+#include "foundation/io/metadata_cache.h"
 
 #include <cstdio>
 
 #ifdef SNUFF_LINUX
 #include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
 #endif
 
 namespace snuffbox
@@ -18,6 +22,7 @@ namespace snuffbox
       is_ok_(false),
       virtual_buffer_(nullptr),
       buffer_(nullptr),
+      mapped_(nullptr),
       length_(0)
     {
 
@@ -29,6 +34,7 @@ namespace snuffbox
       path_(""),
       virtual_buffer_(nullptr),
       buffer_(nullptr),
+      mapped_(nullptr),
       length_(0)
     {
       Open(path, mode);
@@ -62,6 +68,16 @@ namespace snuffbox
         buffer_ = nullptr;
       }
 
+#ifdef SNUFF_LINUX
+      if (mapped_ != nullptr)
+      {
+        munmap(const_cast<uint8_t*>(mapped_), length_);
+        mapped_ = nullptr;
+      }
+#endif
+
+      virtual_buffer_ = nullptr;
+
       stream_.close();
       is_ok_ = false;
     }
@@ -88,13 +104,35 @@ namespace snuffbox
 
       size_t len = length_ + (is_string == true ? 1 : 0);
 
+#ifdef SNUFF_LINUX
+      if (mapped_ != nullptr && buffer_ == nullptr)
+      {
+        size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+
+        // The remainder of the last page of a mapping is zero-filled, which
+        // terminates the string, unless the file ends exactly on a page
+        if (is_string == false || length_ % page_size != 0)
+        {
+          *length = len;
+          return mapped_;
+        }
+      }
+#endif
+
       if (buffer_ == nullptr)
       {
         buffer_ = reinterpret_cast<uint8_t*>(Memory::Allocate(len));
 
-        stream_.seekg(std::ios_base::beg);
-        stream_.read(reinterpret_cast<char*>(buffer_), length_);
-        
+        if (mapped_ != nullptr)
+        {
+          memcpy(buffer_, mapped_, length_);
+        }
+        else
+        {
+          stream_.seekg(std::ios_base::beg);
+          stream_.read(reinterpret_cast<char*>(buffer_), length_);
+        }
+
         if (is_string == true)
         {
           void* block = PointerMath::Offset(buffer_, length_);
@@ -115,13 +153,13 @@ namespace snuffbox
       }
 
       stream_.write(reinterpret_cast<const char*>(buffer), size);
-      stream_.flush();
     }
 
     //--------------------------------------------------------------------------
     void File::Remove(const Path& path)
     {
       remove(path.ToString().c_str());
+      MetadataCache::Invalidate(path);
     }
 
     //--------------------------------------------------------------------------
@@ -166,17 +204,17 @@ namespace snuffbox
     {
       path_ = path;
 
-      const Resources::ResourceData* d = 
-        Resources::GetResource(path.StripPath(Path::kVirtualPrefix));
+      Resources::ResourceData d;
+      Path stripped = path.StripPath(Path::kVirtualPrefix);
 
-      if (d == nullptr)
+      if (Resources::GetResource(stripped, &d) == false)
       {
         length_ = 0;
         return false;
       }
 
-      virtual_buffer_ = d->buffer;
-      length_ = d->size;
+      virtual_buffer_ = d.buffer;
+      length_ = d.size;
 
       return true;
     }
@@ -186,6 +224,16 @@ namespace snuffbox
     {
       path_ = path;
 
+      bool read_only =
+        (mode & (FileFlags::kRead | FileFlags::kWrite)) == FileFlags::kRead;
+
+      if (read_only == true && 
+        (mode & FileFlags::kMapped) == FileFlags::kMapped &&
+        OpenMapped(path) == true)
+      {
+        return true;
+      }
+
       const char* cpath = path.ToString().c_str();
 
       stream_ = std::fstream(
@@ -209,6 +257,50 @@ namespace snuffbox
       return true;
     }
 
+    //--------------------------------------------------------------------------
+    bool File::OpenMapped(const Path& path)
+    {
+#ifdef SNUFF_LINUX
+      const char* cpath = path.ToString().c_str();
+
+      int fd = open(cpath, O_RDONLY);
+
+      if (fd < 0)
+      {
+        return false;
+      }
+
+      struct stat attributes;
+
+      if (fstat(fd, &attributes) != 0 || attributes.st_size <= 0)
+      {
+        close(fd);
+        return false;
+      }
+
+      size_t length = static_cast<size_t>(attributes.st_size);
+      void* view = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+
+      close(fd);
+
+      if (view == MAP_FAILED)
+      {
+        return false;
+      }
+
+      madvise(view, length, MADV_SEQUENTIAL);
+      madvise(view, length, MADV_WILLNEED);
+
+      mapped_ = reinterpret_cast<const uint8_t*>(view);
+      length_ = length;
+      last_modified_ = attributes.st_mtime;
+
+      return true;
+#else
+      return false;
+#endif
+    }
+
     //--------------------------------------------------------------------------
     std::ios::openmode File::FileFlagsToOpenMode(FileFlags flags)
     {
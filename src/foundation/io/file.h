@@ -20,6 +20,16 @@ namespace snuffbox
     * Files are opened at their construction and closed at their destruction.
     * If files are supposed to stay opened, keep this in mind.
     *
+    * Files that are opened read only with FileFlags::kMapped are mapped into
+    * memory on Linux, so that their buffer is a read-only view into the page
+    * cache instead of a copy. If the file can't be mapped, or on other
+    * platforms, the file is read through a stream like any other file.
+    *
+    * Only map files that nothing else writes to while they are open, like
+    * build outputs and packs. Reading a mapped page of a file that was
+    * truncated in the meantime raises SIGBUS, so source files that are
+    * edited by the user should always be read through a stream.
+    *
     * @author Daniel Konings
     */
     class File
@@ -63,11 +73,11 @@ namespace snuffbox
       /**
       * @brief Reads the file's buffer into memory
       *
-      * The buffer is only read into memory if the file is non-virtual, if
-      * the file is virtual there's a direct mapping to the buffer in memory.
-      * The buffer should not be deleted by the user, the buffer's lifetime
-      * is either managed by the file for non-virtual data, or by the resource
-      * system for virtual data.
+      * The buffer is only read into memory if the file is non-virtual and
+      * not mapped, if the file is virtual or mapped there's a direct mapping
+      * to the buffer in memory. The buffer should not be deleted by the user,
+      * the buffer's lifetime is either managed by the file for non-virtual
+      * data, or by the resource system for virtual data.
       *
       * @param[out] length The length of the file
       * @param[in] is_string Should a null-terminator character be appended?
@@ -84,6 +94,10 @@ namespace snuffbox
       /**
       * @brief Writes data to an opened file
       *
+      * The data is written through the stream's buffer and is flushed when
+      * the file is closed. Use a FileWriter to write large files, or files
+      * that should be replaced atomically.
+      *
       * @param[in] buffer The buffer to write
       * @param[in] size The size of the buffer
       */
@@ -158,6 +172,18 @@ namespace snuffbox
       */
       bool OpenFile(const Path& path, FileOpenMode mode);
 
+      /**
+      * @brief Used to map a file from the system's file system into memory
+      *
+      * The kernel is advised that the mapping will be read sequentially and
+      * soon, so that it can read ahead. Empty files are never mapped.
+      *
+      * @param[in] path The path to the file to map
+      *
+      * @return Was the file mapped correctly?
+      */
+      bool OpenMapped(const Path& path);
+
       /**
       * @brief Converts Snuffbox's file flags to an std::ios::openmode
       *
@@ -175,6 +201,7 @@ namespace snuffbox
 
       const uint8_t* virtual_buffer_; //!< The virtual buffer of this file
       uint8_t* buffer_; //!< The buffer of this file
+      const uint8_t* mapped_; //!< The memory mapped view of this file
       size_t length_; //!< The file length
 
       time_t last_modified_; //!< When was the file last modified?
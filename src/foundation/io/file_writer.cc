@@ -0,0 +1,371 @@
+#include "foundation/io/file_writer.h"
+#include "foundation/io/metadata_cache.h"
+
+#include <cstdio>
+#include <cstring>
+
+#ifdef SNUFF_LINUX
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <limits.h>
+#include <errno.h>
+#endif
+
+namespace snuffbox
+{
+  namespace foundation
+  {
+    //--------------------------------------------------------------------------
+    const size_t FileWriter::kDefaultBufferSize;
+    std::atomic<uint32_t> FileWriter::next_temporary_(0);
+
+    //--------------------------------------------------------------------------
+    FileWriter::FileWriter(size_t buffer_size) :
+      path_(""),
+      temp_path_(""),
+      is_open_(false),
+      is_ok_(false),
+      is_atomic_(false),
+      fd_(-1),
+      buffer_size_(buffer_size),
+      capacity_(buffer_size),
+      written_(0),
+      preallocated_(0)
+    {
+
+    }
+
+    //--------------------------------------------------------------------------
+    FileWriter::FileWriter(
+      const Path& path,
+      bool atomic,
+      size_t preallocate,
+      size_t buffer_size) :
+      FileWriter(buffer_size)
+    {
+      Open(path, atomic, preallocate);
+    }
+
+    //--------------------------------------------------------------------------
+    bool FileWriter::Open(const Path& path, bool atomic, size_t preallocate)
+    {
+      Discard();
+
+      path_ = path;
+      temp_path_ = atomic == true ? TemporaryPath(path) : path;
+      is_atomic_ = atomic;
+
+      is_ok_ = false;
+      written_ = 0;
+      preallocated_ = 0;
+
+      buffer_.clear();
+      capacity_ =
+        preallocate > 0 && preallocate < buffer_size_ ?
+        preallocate :
+        buffer_size_;
+
+      if (path.is_virtual() == true)
+      {
+        return false;
+      }
+
+#ifdef SNUFF_LINUX
+      fd_ = open(
+        temp_path_.ToString().c_str(),
+        O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC,
+        0644);
+
+      if (fd_ == -1)
+      {
+        return false;
+      }
+
+      if (preallocate > 0 && fallocate(fd_, 0, 0, preallocate) == 0)
+      {
+        preallocated_ = preallocate;
+      }
+#else
+      stream_.open(
+        temp_path_.ToString().c_str(),
+        std::ios::out | std::ios::binary | std::ios::trunc);
+
+      if (stream_.is_open() == false)
+      {
+        return false;
+      }
+#endif
+
+      is_open_ = true;
+      is_ok_ = true;
+
+      return true;
+    }
+
+    //--------------------------------------------------------------------------
+    bool FileWriter::Write(const uint8_t* data, size_t size)
+    {
+      if (is_ok_ == false)
+      {
+        return false;
+      }
+
+      written_ += size;
+
+      if (size <= capacity_ - buffer_.size())
+      {
+        buffer_.insert(buffer_.end(), data, data + size);
+        return true;
+      }
+
+      Buffer buffers[] =
+      {
+        { buffer_.data(), buffer_.size() },
+        { data, size }
+      };
+
+      is_ok_ = WriteBuffers(buffers, 2);
+      buffer_.clear();
+
+      return is_ok_;
+    }
+
+    //--------------------------------------------------------------------------
+    bool FileWriter::Write(const Buffer* buffers, size_t count)
+    {
+      if (is_ok_ == false)
+      {
+        return false;
+      }
+
+      Vector<Buffer> all;
+      all.reserve(count + 1);
+
+      all.push_back(Buffer{ buffer_.data(), buffer_.size() });
+
+      for (size_t i = 0; i < count; ++i)
+      {
+        all.push_back(buffers[i]);
+        written_ += buffers[i].size;
+      }
+
+      is_ok_ = WriteBuffers(all.data(), all.size());
+      buffer_.clear();
+
+      return is_ok_;
+    }
+
+    //--------------------------------------------------------------------------
+    bool FileWriter::Flush()
+    {
+      if (is_ok_ == false)
+      {
+        return false;
+      }
+
+      Buffer buffer = { buffer_.data(), buffer_.size() };
+
+      is_ok_ = WriteBuffers(&buffer, 1);
+      buffer_.clear();
+
+      return is_ok_;
+    }
+
+    //--------------------------------------------------------------------------
+    bool FileWriter::Commit(bool durable)
+    {
+      if (is_open_ == false)
+      {
+        return false;
+      }
+
+      bool success = Flush();
+
+#ifdef SNUFF_LINUX
+      if (success == true && preallocated_ > written_)
+      {
+        success = ftruncate(fd_, static_cast<off_t>(written_)) == 0;
+      }
+
+      if (success == true && durable == true)
+      {
+        success = fdatasync(fd_) == 0;
+      }
+#endif
+
+      success = CloseFile() == true && success == true;
+
+      if (is_atomic_ == false)
+      {
+        return success;
+      }
+
+      const char* temp = temp_path_.ToString().c_str();
+
+      if (success == false)
+      {
+        remove(temp);
+        return false;
+      }
+
+#ifndef SNUFF_LINUX
+      remove(path_.ToString().c_str());
+#endif
+
+      if (rename(temp, path_.ToString().c_str()) != 0)
+      {
+        remove(temp);
+        return false;
+      }
+
+      MetadataCache::Store(path_, false);
+
+      return true;
+    }
+
+    //--------------------------------------------------------------------------
+    void FileWriter::Discard()
+    {
+      if (is_open_ == false)
+      {
+        return;
+      }
+
+      CloseFile();
+
+      if (is_atomic_ == true)
+      {
+        remove(temp_path_.ToString().c_str());
+      }
+    }
+
+    //--------------------------------------------------------------------------
+    bool FileWriter::is_ok() const
+    {
+      return is_ok_;
+    }
+
+    //--------------------------------------------------------------------------
+    const Path& FileWriter::path() const
+    {
+      return path_;
+    }
+
+    //--------------------------------------------------------------------------
+    size_t FileWriter::written() const
+    {
+      return written_;
+    }
+
+    //--------------------------------------------------------------------------
+    bool FileWriter::WriteBuffers(const Buffer* buffers, size_t count)
+    {
+#ifdef SNUFF_LINUX
+      Vector<struct iovec> iov;
+      iov.reserve(count);
+
+      for (size_t i = 0; i < count; ++i)
+      {
+        if (buffers[i].size == 0)
+        {
+          continue;
+        }
+
+        struct iovec vec;
+        vec.iov_base = const_cast<uint8_t*>(buffers[i].data);
+        vec.iov_len = buffers[i].size;
+
+        iov.push_back(vec);
+      }
+
+      size_t index = 0;
+
+      while (index < iov.size())
+      {
+        size_t batch = iov.size() - index;
+        batch = batch < IOV_MAX ? batch : IOV_MAX;
+
+        ssize_t result = writev(fd_, &iov.at(index), static_cast<int>(batch));
+
+        if (result < 0)
+        {
+          if (errno == EINTR)
+          {
+            continue;
+          }
+
+          return false;
+        }
+
+        size_t left = static_cast<size_t>(result);
+
+        while (left > 0 && index < iov.size())
+        {
+          struct iovec& vec = iov.at(index);
+
+          if (left >= vec.iov_len)
+          {
+            left -= vec.iov_len;
+            ++index;
+            continue;
+          }
+
+          vec.iov_base = static_cast<uint8_t*>(vec.iov_base) + left;
+          vec.iov_len -= left;
+          left = 0;
+        }
+      }
+
+      return true;
+#else
+      for (size_t i = 0; i < count; ++i)
+      {
+        stream_.write(
+          reinterpret_cast<const char*>(buffers[i].data),
+          buffers[i].size);
+      }
+
+      return stream_.fail() == false;
+#endif
+    }
+
+    //--------------------------------------------------------------------------
+    bool FileWriter::CloseFile()
+    {
+      if (is_open_ == false)
+      {
+        return true;
+      }
+
+      is_open_ = false;
+
+#ifdef SNUFF_LINUX
+      bool success = close(fd_) == 0;
+      fd_ = -1;
+
+      return success;
+#else
+      stream_.close();
+      return stream_.fail() == false;
+#endif
+    }
+
+    //--------------------------------------------------------------------------
+    Path FileWriter::TemporaryPath(const Path& path)
+    {
+      char suffix[32];
+      snprintf(suffix, sizeof(suffix), ".%u.tmp", next_temporary_++);
+
+      return path + suffix;
+    }
+
+    //--------------------------------------------------------------------------
+    FileWriter::~FileWriter()
+    {
+      Discard();
+    }
+  }
+}
@@ -0,0 +1,223 @@
+#pragma once
+
+#include "foundation/io/path.h"
+#include "foundation/containers/vector.h"
+
+#include <fstream>
+#include <atomic>
+#include <cinttypes>
+#include <cstddef>
+
+namespace snuffbox
+{
+  namespace foundation
+  {
+    /**
+    * @brief A buffered writer to write files with in few system calls,
+    *        without ever leaving half-written files behind
+    *
+    * Small writes are collected in a buffer, which is written together with
+    * the next write that doesn't fit anymore in a single vectored write.
+    * Large writes bypass the buffer altogether. The buffer is only allocated
+    * once something is buffered, grows with the buffered data and never
+    * exceeds the expected size of the file, so short writes don't pay for
+    * a full buffer.
+    *
+    * Atomic writers write to a temporary file next to the target, which
+    * replaces the target with a rename when the writer is committed. Readers
+    * of the target either see the old or the new file, never a partial one.
+    * A writer that is destructed without being committed removes its
+    * temporary file.
+    *
+    * On Linux the file is written with write and writev and space can be
+    * preallocated with fallocate, other platforms write through a stream.
+    *
+    * @author Daniel Konings
+    */
+    class FileWriter
+    {
+
+    public:
+
+      /**
+      * @brief The default maximum size of the write buffer
+      */
+      static const size_t kDefaultBufferSize = 64 * 1024;
+
+      /**
+      * @brief A buffer to write, for vectored writes
+      *
+      * @author Daniel Konings
+      */
+      struct Buffer
+      {
+        const uint8_t* data; //!< The data to write
+        size_t size; //!< The size of the data
+      };
+
+      /**
+      * @brief Creates a writer that isn't open
+      *
+      * @param[in] buffer_size The maximum size of the write buffer
+      */
+      FileWriter(size_t buffer_size = kDefaultBufferSize);
+
+      /**
+      * @see FileWriter::Open
+      */
+      FileWriter(
+        const Path& path,
+        bool atomic = true,
+        size_t preallocate = 0,
+        size_t buffer_size = kDefaultBufferSize);
+
+      /**
+      * @brief Non-copyable
+      */
+      FileWriter(const FileWriter&) = delete;
+
+      /**
+      * @brief Non-copyable
+      */
+      FileWriter& operator=(const FileWriter&) = delete;
+
+      /**
+      * @brief Opens a file for writing, replacing its contents
+      *
+      * @param[in] path The path to the file to write
+      * @param[in] atomic Should the file only be replaced once the writer
+      *                   is committed?
+      * @param[in] preallocate The expected size of the file, to preallocate
+      *                        on disk, or 0 to not preallocate
+      *
+      * @return Was the file opened succesfully?
+      */
+      bool Open(const Path& path, bool atomic = true, size_t preallocate = 0);
+
+      /**
+      * @brief Writes data to the file, through the buffer if it fits
+      *
+      * @param[in] data The data to write
+      * @param[in] size The size of the data
+      *
+      * @return Was the data written or buffered succesfully?
+      */
+      bool Write(const uint8_t* data, size_t size);
+
+      /**
+      * @brief Writes multiple buffers to the file in a single vectored write,
+      *        after any data that is still buffered
+      *
+      * @param[in] buffers The buffers to write
+      * @param[in] count The number of buffers
+      *
+      * @return Were the buffers written succesfully?
+      */
+      bool Write(const Buffer* buffers, size_t count);
+
+      /**
+      * @brief Writes the buffered data to the file
+      *
+      * @return Was the buffered data written succesfully?
+      */
+      bool Flush();
+
+      /**
+      * @brief Flushes and closes the file, and replaces the target with the
+      *        temporary file for atomic writers
+      *
+      * On Linux, durable commits sync the data to disk before the file is
+      * closed and renamed, so a crash can't leave an empty target behind.
+      * This costs a disk flush, so it's only worth it for files that can't
+      * be recreated, like user-authored scenes.
+      *
+      * @remarks If any write failed, the target is left untouched
+      *
+      * @param[in] durable Should the data be synced to disk before the
+      *                    target is replaced?
+      *
+      * @return Was the file written and committed succesfully?
+      */
+      bool Commit(bool durable = false);
+
+      /**
+      * @brief Closes the file without committing it, removing the temporary
+      *        file of an atomic writer
+      */
+      void Discard();
+
+      /**
+      * @return Is the file open and have all writes succeeded so far?
+      */
+      bool is_ok() const;
+
+      /**
+      * @return The path of the file that is written
+      */
+      const Path& path() const;
+
+      /**
+      * @return The number of bytes that were written, including buffered
+      *         data
+      */
+      size_t written() const;
+
+      /**
+      * @brief Discards the file if it wasn't committed
+      *
+      * @see FileWriter::Discard
+      */
+      ~FileWriter();
+
+    protected:
+
+      /**
+      * @brief Writes buffers to the file directly, retrying partial writes
+      *
+      * @param[in] buffers The buffers to write
+      * @param[in] count The number of buffers
+      *
+      * @return Were all buffers written succesfully?
+      */
+      bool WriteBuffers(const Buffer* buffers, size_t count);
+
+      /**
+      * @brief Closes the file descriptor or stream, if it is open
+      *
+      * @return Was the file closed without errors?
+      */
+      bool CloseFile();
+
+      /**
+      * @brief Creates a unique path for a temporary file next to a target
+      *
+      * @param[in] path The path of the target
+      *
+      * @return The path of the temporary file
+      */
+      static Path TemporaryPath(const Path& path);
+
+    private:
+
+      Path path_; //!< The path of the target file
+      Path temp_path_; //!< The path of the file that is actually written
+      bool is_open_; //!< Is a file open?
+      bool is_ok_; //!< Have all writes succeeded so far?
+      bool is_atomic_; //!< Is the target replaced at the commit?
+
+      int fd_; //!< The file descriptor on Linux
+      std::ofstream stream_; //!< The file stream on other platforms
+
+      Vector<uint8_t> buffer_; //!< The write buffer, with the buffered data
+      size_t buffer_size_; //!< The maximum size of the write buffer
+      size_t capacity_; //!< The maximum size of the buffer for this file
+      size_t written_; //!< The number of bytes written in total
+      size_t preallocated_; //!< The number of bytes preallocated on disk
+
+      /**
+      * @brief Makes the temporary files of all writers unique
+      */
+      static std::atomic<uint32_t> next_temporary_;
+    };
+  }
+}
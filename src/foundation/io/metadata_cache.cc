@@ -0,0 +1,78 @@
+#include "foundation/io/metadata_cache.h"
+#include "foundation/io/path.h"
+
+namespace snuffbox
+{
+  namespace foundation
+  {
+    //--------------------------------------------------------------------------
+    SharedMutex MetadataCache::mutex_("MetadataCache");
+    Map<String, bool> MetadataCache::entries_;
+
+    //--------------------------------------------------------------------------
+    void MetadataCache::Store(const Path& path, bool is_directory)
+    {
+      if (path.is_virtual() == true)
+      {
+        return;
+      }
+
+      std::lock_guard<SharedMutex> lock(mutex_);
+      entries_[path.ToString()] = is_directory;
+    }
+
+    //--------------------------------------------------------------------------
+    bool MetadataCache::Find(const Path& path, bool* is_directory)
+    {
+      std::shared_lock<SharedMutex> lock(mutex_);
+
+      Map<String, bool>::const_iterator it = entries_.find(path.ToString());
+
+      if (it == entries_.end())
+      {
+        return false;
+      }
+
+      *is_directory = it->second;
+
+      return true;
+    }
+
+    //--------------------------------------------------------------------------
+    void MetadataCache::Invalidate(const Path& path)
+    {
+      const String& root = path.ToString();
+      String prefix = root + "/";
+
+      std::lock_guard<SharedMutex> lock(mutex_);
+
+      entries_.erase(root);
+
+      Map<String, bool>::iterator first = entries_.lower_bound(prefix);
+      Map<String, bool>::iterator last = first;
+
+      while (
+        last != entries_.end() &&
+        last->first.compare(0, prefix.size(), prefix) == 0)
+      {
+        ++last;
+      }
+
+      entries_.erase(first, last);
+    }
+
+    //--------------------------------------------------------------------------
+    void MetadataCache::Clear()
+    {
+      std::lock_guard<SharedMutex> lock(mutex_);
+      entries_.clear();
+    }
+
+    //--------------------------------------------------------------------------
+    size_t MetadataCache::size()
+    {
+      std::shared_lock<SharedMutex> lock(mutex_);
+      return entries_.size();
+    }
+  }
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "foundation/containers/string.h"
+#include "foundation/containers/map.h"
+#include "foundation/auxiliary/mutex.h"
+
+#include <mutex>
+
+namespace snuffbox
+{
+  namespace foundation
+  {
+    class Path;
+
+    /**
+    * @brief A process-wide cache of file system metadata, keyed by path
+    *
+    * Directory enumerations already know whether each child is a directory,
+    * so they store it here in bulk. Path::is_directory then finds it without
+    * querying the file system again. Paths that are not in the cache fall
+    * back to querying the file system.
+    *
+    * The cache reflects the file system as it was when a path was last
+    * enumerated. Removing files or directories through File::Remove or
+    * Directory::Remove invalidates their entries. Changes made outside of the
+    * engine should be invalidated explicitly, like the builder does for the
+    * changes its directory listener reports.
+    *
+    * The paths are kept in order, so that the paths below a directory are a
+    * contiguous range that is invalidated without visiting other paths.
+    *
+    * @remarks All functions are thread-safe
+    *
+    * @author Daniel Konings
+    */
+    class MetadataCache
+    {
+
+    public:
+
+      /**
+      * @brief Stores the metadata of a path
+      *
+      * @param[in] path The path to store the metadata of
+      * @param[in] is_directory Is the path a directory?
+      */
+      static void Store(const Path& path, bool is_directory);
+
+      /**
+      * @brief Finds the metadata of a path
+      *
+      * @param[in] path The path to find the metadata of
+      * @param[out] is_directory Is the path a directory? Only set if found.
+      *
+      * @return Was the path in the cache?
+      */
+      static bool Find(const Path& path, bool* is_directory);
+
+      /**
+      * @brief Removes a path from the cache, along with every path below it
+      *
+      * @param[in] path The path to invalidate
+      */
+      static void Invalidate(const Path& path);
+
+      /**
+      * @brief Removes every path from the cache
+      */
+      static void Clear();
+
+      /**
+      * @return The number of paths in the cache
+      */
+      static size_t size();
+
+    private:
+
+      static SharedMutex mutex_; //!< The lock around the entries
+      static Map<String, bool> entries_; //!< Is each path a directory?
+    };
+  }
+}
@@ -0,0 +1,397 @@
+#include "foundation/io/pack.h"
+#include "foundation/io/file_writer.h"
+#include "foundation/containers/string_id.h"
+#include "foundation/compression/block_compression.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace snuffbox
+{
+  namespace foundation
+  {
+    //--------------------------------------------------------------------------
+    Pack::Pack() :
+      data_(nullptr),
+      length_(0),
+      entries_(nullptr),
+      num_entries_(0),
+      names_(nullptr),
+      mutex_("Pack")
+    {
+
+    }
+
+    //--------------------------------------------------------------------------
+    bool Pack::Open(const Path& path)
+    {
+      Close();
+
+      if (file_.Open(path, FileFlags::kRead | FileFlags::kMapped) == false)
+      {
+        return false;
+      }
+
+      data_ = file_.ReadBuffer(&length_);
+
+      if (Validate() == false)
+      {
+        Close();
+        return false;
+      }
+
+      return true;
+    }
+
+    //--------------------------------------------------------------------------
+    void Pack::Close()
+    {
+      file_.Close();
+
+      data_ = nullptr;
+      length_ = 0;
+      entries_ = nullptr;
+      num_entries_ = 0;
+      names_ = nullptr;
+
+      std::lock_guard<Mutex> lock(mutex_);
+      unpacked_.clear();
+    }
+
+    //--------------------------------------------------------------------------
+    const Pack::Entry* Pack::Find(const String& name) const
+    {
+      if (entries_ == nullptr)
+      {
+        return nullptr;
+      }
+
+      uint64_t hash = StringId::Hash(name.c_str(), name.size());
+
+      const Entry* end = entries_ + num_entries_;
+      const Entry* it = std::lower_bound(entries_, end, hash,
+        [](const Entry& entry, uint64_t h)
+      {
+        return entry.hash < h;
+      });
+
+      for (; it != end && it->hash == hash; ++it)
+      {
+        if (
+          it->name_length == name.size() &&
+          memcmp(names_ + it->name_offset, name.c_str(), name.size()) == 0)
+        {
+          return it;
+        }
+      }
+
+      return nullptr;
+    }
+
+    //--------------------------------------------------------------------------
+    const uint8_t* Pack::Data(const Entry* entry) const
+    {
+      if (entry->compression == Compression::kNone)
+      {
+        return data_ + entry->offset;
+      }
+
+      size_t index = static_cast<size_t>(entry - entries_);
+
+      std::lock_guard<Mutex> lock(mutex_);
+
+      UMap<size_t, Vector<uint8_t>>::iterator it = unpacked_.find(index);
+
+      if (it != unpacked_.end())
+      {
+        return it->second.data();
+      }
+
+      const uint8_t* stored = data_ + entry->offset;
+      size_t stored_size = static_cast<size_t>(entry->stored_size);
+      size_t unpacked_size = 0;
+
+      if (
+        BlockDecompressor::DecompressedSize(
+          stored,
+          stored_size,
+          &unpacked_size) == false ||
+        unpacked_size != entry->size)
+      {
+        return nullptr;
+      }
+
+      Vector<uint8_t>& unpacked = unpacked_[index];
+      unpacked.resize(unpacked_size);
+
+      if (
+        BlockDecompressor::Decompress(
+          stored,
+          stored_size,
+          unpacked.data(),
+          unpacked.size()) == false)
+      {
+        unpacked_.erase(index);
+        return nullptr;
+      }
+
+      return unpacked.data();
+    }
+
+    //--------------------------------------------------------------------------
+    String Pack::Name(const Entry* entry) const
+    {
+      return String(names_ + entry->name_offset, entry->name_length);
+    }
+
+    //--------------------------------------------------------------------------
+    size_t Pack::num_entries() const
+    {
+      return num_entries_;
+    }
+
+    //--------------------------------------------------------------------------
+    const Pack::Entry* Pack::entry(size_t index) const
+    {
+      return entries_ + index;
+    }
+
+    //--------------------------------------------------------------------------
+    bool Pack::is_ok() const
+    {
+      return data_ != nullptr;
+    }
+
+    //--------------------------------------------------------------------------
+    const Path& Pack::path() const
+    {
+      return file_.path();
+    }
+
+    //--------------------------------------------------------------------------
+    bool Pack::Validate()
+    {
+      if (data_ == nullptr || length_ < sizeof(Header))
+      {
+        return false;
+      }
+
+      const Header* header = reinterpret_cast<const Header*>(data_);
+
+      if (
+        header->magic != kMagic ||
+        header->version != kVersion ||
+        header->alignment != kAlignment)
+      {
+        return false;
+      }
+
+      uint64_t index_size =
+        static_cast<uint64_t>(header->num_entries) * sizeof(Entry);
+
+      if (
+        header->index_offset % alignof(Entry) != 0 ||
+        header->index_offset > length_ ||
+        index_size > length_ - header->index_offset ||
+        header->names_offset > length_)
+      {
+        return false;
+      }
+
+      entries_ = reinterpret_cast<const Entry*>(data_ + header->index_offset);
+      num_entries_ = header->num_entries;
+      names_ = reinterpret_cast<const char*>(data_ + header->names_offset);
+
+      size_t names_length = length_ - header->names_offset;
+
+      for (size_t i = 0; i < num_entries_; ++i)
+      {
+        const Entry& e = entries_[i];
+
+        bool stored = e.compression == Compression::kNone;
+
+        if (
+          (stored == false && e.compression != Compression::kBlock) ||
+          (stored == true && e.stored_size != e.size) ||
+          e.offset > length_ ||
+          e.stored_size > length_ - e.offset ||
+          e.name_offset > names_length ||
+          e.name_length > names_length - e.name_offset ||
+          (i > 0 && entries_[i - 1].hash > e.hash))
+        {
+          return false;
+        }
+      }
+
+      return true;
+    }
+
+    //--------------------------------------------------------------------------
+    void PackWriter::Add(
+      const String& name,
+      const uint8_t* data,
+      size_t size,
+      uint32_t type,
+      bool compress)
+    {
+      entries_.push_back(PendingEntry());
+
+      PendingEntry& entry = entries_.back();
+      entry.name = name;
+      entry.hash = StringId::Hash(name.c_str(), name.size());
+      entry.type = type;
+      entry.size = size;
+      entry.compression = Pack::Compression::kNone;
+
+      if (compress == true && size > 0)
+      {
+        entry.data.resize(BlockCompressor::Bound(size));
+
+        size_t compressed = BlockCompressor::Compress(
+          data,
+          size,
+          entry.data.data(),
+          entry.data.size());
+
+        if (compressed > 0 && compressed < size)
+        {
+          entry.data.resize(compressed);
+          entry.compression = Pack::Compression::kBlock;
+
+          return;
+        }
+      }
+
+      entry.data.assign(data, data + size);
+    }
+
+    //--------------------------------------------------------------------------
+    bool PackWriter::Write(const Path& path) const
+    {
+      Vector<const PendingEntry*> sorted;
+      sorted.resize(entries_.size());
+
+      for (size_t i = 0; i < entries_.size(); ++i)
+      {
+        sorted.at(i) = &entries_.at(i);
+      }
+
+      std::stable_sort(sorted.begin(), sorted.end(),
+        [](const PendingEntry* a, const PendingEntry* b)
+      {
+        return a->hash < b->hash;
+      });
+
+      Vector<Pack::Entry> index;
+      index.resize(sorted.size());
+
+      String names;
+      uint64_t offset = Align(sizeof(Pack::Header));
+
+      for (size_t i = 0; i < sorted.size(); ++i)
+      {
+        const PendingEntry* pending = sorted.at(i);
+        Pack::Entry& entry = index.at(i);
+
+        memset(&entry, 0, sizeof(Pack::Entry));
+
+        entry.hash = pending->hash;
+        entry.offset = offset;
+        entry.size = pending->size;
+        entry.stored_size = pending->data.size();
+        entry.name_offset = static_cast<uint32_t>(names.size());
+        entry.name_length = static_cast<uint32_t>(pending->name.size());
+        entry.type = pending->type;
+        entry.compression = pending->compression;
+
+        names += pending->name;
+        offset = Align(offset + entry.stored_size);
+      }
+
+      Pack::Header header;
+      memset(&header, 0, sizeof(Pack::Header));
+
+      header.magic = Pack::kMagic;
+      header.version = Pack::kVersion;
+      header.alignment = Pack::kAlignment;
+      header.num_entries = static_cast<uint32_t>(index.size());
+      header.index_offset = offset;
+      header.names_offset = offset + index.size() * sizeof(Pack::Entry);
+
+      size_t index_size = index.size() * sizeof(Pack::Entry);
+      size_t total =
+        static_cast<size_t>(header.names_offset) + names.size();
+
+      FileWriter writer(path, true, total);
+
+      if (writer.is_ok() == false)
+      {
+        return false;
+      }
+
+      uint8_t padding[Pack::kAlignment];
+      memset(padding, 0, sizeof(padding));
+
+      Vector<FileWriter::Buffer> buffers;
+      buffers.reserve(sorted.size() * 2 + 4);
+
+      uint64_t written = sizeof(Pack::Header);
+      buffers.push_back(FileWriter::Buffer
+      {
+        reinterpret_cast<const uint8_t*>(&header),
+        sizeof(Pack::Header)
+      });
+
+      for (size_t i = 0; i < sorted.size(); ++i)
+      {
+        const Pack::Entry& entry = index.at(i);
+        const Vector<uint8_t>& data = sorted.at(i)->data;
+
+        buffers.push_back(FileWriter::Buffer
+        {
+          padding,
+          static_cast<size_t>(entry.offset - written)
+        });
+
+        buffers.push_back(FileWriter::Buffer{ data.data(), data.size() });
+
+        written = entry.offset + entry.stored_size;
+      }
+
+      buffers.push_back(FileWriter::Buffer
+      {
+        padding,
+        static_cast<size_t>(header.index_offset - written)
+      });
+
+      buffers.push_back(FileWriter::Buffer
+      {
+        reinterpret_cast<const uint8_t*>(index.data()),
+        index_size
+      });
+
+      buffers.push_back(FileWriter::Buffer
+      {
+        reinterpret_cast<const uint8_t*>(names.c_str()),
+        names.size()
+      });
+
+      writer.Write(buffers.data(), buffers.size());
+
+      return writer.Commit();
+    }
+
+    //--------------------------------------------------------------------------
+    size_t PackWriter::size() const
+    {
+      return entries_.size();
+    }
+
+    //--------------------------------------------------------------------------
+    uint64_t PackWriter::Align(uint64_t offset)
+    {
+      return (offset + Pack::kAlignment - 1) & ~(
+        static_cast<uint64_t>(Pack::kAlignment) - 1);
+    }
+  }
+}
@@ -0,0 +1,290 @@
+#pragma once
+
+#include "foundation/io/file.h"
+#include "foundation/io/path.h"
+#include "foundation/containers/string.h"
+#include "foundation/containers/vector.h"
+#include "foundation/containers/map.h"
+#include "foundation/auxiliary/mutex.h"
+
+#include <cinttypes>
+#include <cstddef>
+
+namespace snuffbox
+{
+  namespace foundation
+  {
+    /**
+    * @brief A read-only archive of files packed into a single file
+    *
+    * A pack starts with a header, followed by the data of every entry,
+    * aligned to Pack::kAlignment. The index that follows is sorted by the
+    * hash of the entry names, so that an entry can be found with a binary
+    * search. The names are stored last.
+    *
+    * The pack is mapped into memory when it is opened, which makes every
+    * entry that is stored as is a pointer into the mapping. Entries that are
+    * compressed with a BlockCompressor are decompressed the first time their
+    * data is retrieved, and are kept until the pack is closed.
+    *
+    * Packs are usually mounted in the virtual file system with
+    * Resources::Mount, so that their entries can be opened as virtual files.
+    *
+    * @see PackWriter
+    * @see Resources
+    *
+    * @author Daniel Konings
+    */
+    class Pack
+    {
+
+    public:
+
+      /**
+      * @brief The magic number at the start of every pack, 'SPAK'
+      */
+      static const uint32_t kMagic = 0x4b415053;
+
+      /**
+      * @brief The version of the pack format
+      */
+      static const uint32_t kVersion = 1;
+
+      /**
+      * @brief The alignment of the data of every entry, in bytes
+      */
+      static const uint32_t kAlignment = 16;
+
+      /**
+      * @brief The compression of the data of an entry
+      */
+      enum class Compression : uint8_t
+      {
+        kNone, //!< The data is stored as is
+        kBlock //!< The data is compressed by a BlockCompressor
+      };
+
+      /**
+      * @brief The header at the start of a pack
+      *
+      * @author Daniel Konings
+      */
+      struct Header
+      {
+        uint32_t magic; //!< Should be Pack::kMagic
+        uint32_t version; //!< Should be Pack::kVersion
+        uint32_t alignment; //!< The alignment of the entry data
+        uint32_t num_entries; //!< The number of entries in the index
+        uint64_t index_offset; //!< The offset of the index in the pack
+        uint64_t names_offset; //!< The offset of the names in the pack
+      };
+
+      /**
+      * @brief An entry in the index of a pack
+      *
+      * @author Daniel Konings
+      */
+      struct Entry
+      {
+        uint64_t hash; //!< The hash of the name, see StringId::Hash
+        uint64_t offset; //!< The offset of the data in the pack
+        uint64_t size; //!< The size of the data when it is unpacked
+        uint64_t stored_size; //!< The size of the data in the pack
+        uint32_t name_offset; //!< The offset of the name in the names
+        uint32_t name_length; //!< The length of the name
+        uint32_t type; //!< The type of the entry, defined by the packer
+        Compression compression; //!< The compression of the data
+        uint8_t padding[3]; //!< Padding to keep the index 8-byte aligned
+      };
+
+      /**
+      * @brief Default constructor, creates a pack that isn't open
+      */
+      Pack();
+
+      /**
+      * @brief Non-copyable
+      */
+      Pack(const Pack&) = delete;
+
+      /**
+      * @brief Non-copyable
+      */
+      Pack& operator=(const Pack&) = delete;
+
+      /**
+      * @brief Opens a pack and validates its header and index
+      *
+      * @param[in] path The path to the pack
+      *
+      * @return Was the pack opened succesfully?
+      */
+      bool Open(const Path& path);
+
+      /**
+      * @brief Closes the pack, after which none of its data can be used
+      */
+      void Close();
+
+      /**
+      * @brief Finds an entry by name
+      *
+      * @param[in] name The name of the entry, relative to the root of the
+      *                 pack and with forward slashes
+      *
+      * @return The entry, or nullptr if there is no such entry
+      */
+      const Entry* Find(const String& name) const;
+
+      /**
+      * @brief Retrieves the data of an entry, decompressing it if it is
+      *        compressed
+      *
+      * @remarks This function is thread-safe
+      *
+      * @param[in] entry The entry to retrieve the data of
+      *
+      * @return The data of Entry::size bytes, which lives as long as the
+      *         pack is open, or nullptr if it could not be decompressed
+      */
+      const uint8_t* Data(const Entry* entry) const;
+
+      /**
+      * @brief Retrieves the name of an entry
+      *
+      * @param[in] entry The entry to retrieve the name of
+      *
+      * @return The name
+      */
+      String Name(const Entry* entry) const;
+
+      /**
+      * @return The number of entries in the pack
+      */
+      size_t num_entries() const;
+
+      /**
+      * @brief Retrieves an entry by index, in order of their hash
+      *
+      * @param[in] index The index of the entry
+      *
+      * @return The entry
+      */
+      const Entry* entry(size_t index) const;
+
+      /**
+      * @return Is the pack open and valid?
+      */
+      bool is_ok() const;
+
+      /**
+      * @return The path the pack was opened from
+      */
+      const Path& path() const;
+
+    protected:
+
+      /**
+      * @brief Checks whether the header and index of the open file describe
+      *        a valid pack
+      *
+      * @return Is the pack valid?
+      */
+      bool Validate();
+
+    private:
+
+      File file_; //!< The mapped pack file
+      const uint8_t* data_; //!< The contents of the pack file
+      size_t length_; //!< The length of the pack file
+
+      const Entry* entries_; //!< The index of the pack
+      size_t num_entries_; //!< The number of entries in the index
+      const char* names_; //!< The names of the entries
+
+      /**
+      * @brief The decompressed data of the compressed entries that have
+      *        been retrieved, by the index of their entry
+      */
+      mutable UMap<size_t, Vector<uint8_t>> unpacked_;
+
+      mutable Mutex mutex_; //!< The lock around the decompressed data
+    };
+
+    /**
+    * @brief Creates a pack from files that are added in memory
+    *
+    * @see Pack
+    *
+    * @author Daniel Konings
+    */
+    class PackWriter
+    {
+
+    public:
+
+      /**
+      * @brief Adds a file to the pack, copying its data
+      *
+      * @param[in] name The name of the entry, see Pack::Find
+      * @param[in] data The data of the file
+      * @param[in] size The size of the data
+      * @param[in] type The type of the entry
+      * @param[in] compress Should the data be compressed? It is stored as is
+      *                     if compressing doesn't make it any smaller,
+      *                     default = false
+      */
+      void Add(
+        const String& name,
+        const uint8_t* data,
+        size_t size,
+        uint32_t type = 0,
+        bool compress = false);
+
+      /**
+      * @brief Writes the pack to disk in a single vectored write, replacing
+      *        any existing pack atomically
+      *
+      * @param[in] path The path to write the pack to
+      *
+      * @return Was the pack written succesfully?
+      */
+      bool Write(const Path& path) const;
+
+      /**
+      * @return The number of files added to the pack
+      */
+      size_t size() const;
+
+    protected:
+
+      /**
+      * @brief A file that has been added to the pack
+      *
+      * @author Daniel Konings
+      */
+      struct PendingEntry
+      {
+        String name; //!< The name of the entry
+        uint64_t hash; //!< The hash of the name
+        uint32_t type; //!< The type of the entry
+        uint64_t size; //!< The size of the data when it is unpacked
+        Pack::Compression compression; //!< The compression of the data
+        Vector<uint8_t> data; //!< The stored data of the entry
+      };
+
+      /**
+      * @brief Rounds an offset up to the alignment of the entry data
+      *
+      * @param[in] offset The offset to align
+      *
+      * @return The aligned offset
+      */
+      static uint64_t Align(uint64_t offset);
+
+    private:
+
+      Vector<PendingEntry> entries_; //!< The files in the pack
+    };
+  }
+}
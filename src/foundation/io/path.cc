@@ -1,6 +1,7 @@
 #include "foundation/io/path.h"
 #include "foundation/auxiliary/string_utils.h"
 #include "foundation/io/directory.h"
+#include "foundation/io/metadata_cache.h"
 
 #include <cstring>
 #include <cstddef>
@@ -17,7 +18,9 @@ namespace snuffbox
       path_(""),
       extension_(""),
       is_virtual_(false),
-      is_directory_(true)
+      is_directory_(true),
+      has_metadata_(false),
+      has_extension_(false)
     {
 
     }
@@ -27,20 +30,17 @@ namespace snuffbox
       path_(ConvertSlashes(path)),
       extension_(""),
       is_virtual_(false),
-      is_directory_(true)
+      is_directory_(true),
+      has_metadata_(false),
+      has_extension_(false)
     {
       is_virtual_ = IsVirtualPath(path_);
 
       if (is_virtual_ == true)
       {
-        return;
-      }
-
-      is_directory_ = Directory::Exists(*this);
-
-      if (is_directory_ == false)
-      {
-        GetExtension(path_, &extension_);
+        is_directory_ = GetExtension(path_, &extension_) == false;
+        has_metadata_ = true;
+        has_extension_ = true;
       }
     }
 
@@ -127,15 +127,17 @@ namespace snuffbox
     }
 
     //--------------------------------------------------------------------------
-    Path Path::operator=(const String& other)
+    Path& Path::operator=(const String& other)
     {
-      return Path(other);
+      *this = Path(other);
+      return *this;
     }
 
     //--------------------------------------------------------------------------
-    Path Path::operator=(const char* other)
+    Path& Path::operator=(const char* other)
     {
-      return Path(other);
+      *this = Path(other);
+      return *this;
     }
 
     //--------------------------------------------------------------------------
@@ -220,7 +222,7 @@ namespace snuffbox
     //--------------------------------------------------------------------------
     Path Path::NoExtension() const
     {
-      if (extension_.size() == 0)
+      if (extension().size() == 0)
       {
         return path_;
       }
@@ -326,15 +328,50 @@ namespace snuffbox
       return is_virtual_;
     }
 
+    //--------------------------------------------------------------------------
+    void Path::set_is_directory(bool is_directory)
+    {
+      if (is_virtual_ == true)
+      {
+        return;
+      }
+
+      is_directory_ = is_directory;
+      has_metadata_ = true;
+      has_extension_ = false;
+    }
+
     //--------------------------------------------------------------------------
     bool Path::is_directory() const
     {
+      if (has_metadata_ == false)
+      {
+        if (MetadataCache::Find(*this, &is_directory_) == false)
+        {
+          is_directory_ = Directory::Exists(*this);
+        }
+
+        has_metadata_ = true;
+      }
+
       return is_directory_;
     }
 
     //--------------------------------------------------------------------------
     const String& Path::extension() const
     {
+      if (has_extension_ == false)
+      {
+        extension_.clear();
+
+        if (GetExtension(path_, &extension_) == true && is_directory() == true)
+        {
+          extension_.clear();
+        }
+
+        has_extension_ = true;
+      }
+
       return extension_;
     }
 
@@ -16,6 +16,14 @@ namespace snuffbox
     *
     * If there is a slash at the end of the path, it is implicitly removed
     *
+    * Constructing and combining paths never touches the file system. Whether
+    * a path is a directory is only resolved when Path::is_directory or
+    * Path::extension is first called, from the MetadataCache if possible.
+    * The result is then cached in the path itself.
+    *
+    * @remarks As the lazily resolved values are cached, a single path should
+    *          not be queried from multiple threads at once
+    *
     * @author Daniel Konings
     */
     class Path
@@ -123,16 +131,16 @@ namespace snuffbox
       *
       * @see Path::Path
       *
-      * @return The new path
+      * @return This path
       */
-      Path operator=(const String& other);
+      Path& operator=(const String& other);
 
       /**
       * @see Path::operator=
       *
       * @remarks const char* overload
       */
-      Path operator=(const char* other);
+      Path& operator=(const char* other);
 
       /**
       * @brief Checks if a path and string are equal
@@ -224,14 +232,28 @@ namespace snuffbox
       */
       bool is_virtual() const;
 
+      /**
+      * @brief Sets whether this path is a directory, for when this is already
+      *        known and the file system does not have to be queried
+      *
+      * @param[in] is_directory Is this path a directory?
+      */
+      void set_is_directory(bool is_directory);
+
       /**
       * @return Is this path a path to a directory?
+      *
+      * @remarks This is looked up in the MetadataCache, or queried from the
+      *          file system if the path is not in there, on first use only
       */
       bool is_directory() const;
 
       /**
       * @return The extension of this path if it is a file, else this is
       *         an empty string
+      *
+      * @remarks Only paths that look like they have an extension need to
+      *          check whether they are a directory
       */
       const String& extension() const;
 
@@ -282,10 +304,12 @@ namespace snuffbox
     private:
 
       String path_; //!< The stringified path
-      String extension_; //!< The extension of the path if the path is a file
+      mutable String extension_; //!< The extension if the path is a file
 
       bool is_virtual_; //!< Is this a virtual path to the virtual file system?
-      bool is_directory_; //!< Is this path a directory or a file?
+      mutable bool is_directory_; //!< Is this path a directory or a file?
+      mutable bool has_metadata_; //!< Was is_directory_ resolved yet?
+      mutable bool has_extension_; //!< Was extension_ resolved yet?
 
     public:
 
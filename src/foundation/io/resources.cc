@@ -1,11 +1,16 @@
 #include "foundation/io/resources.h"
+#include "foundation/io/pack.h"
+#include "foundation/memory/memory.h"
 
 namespace snuffbox
 {
   namespace foundation
   {
     //--------------------------------------------------------------------------
-    UMap<String, Resources::ResourceData> Resources::resources_;
+    UMap<StringId, Resources::ResourceData> Resources::resources_;
+    Vector<Pack*> Resources::packs_;
+    UMap<String, Vector<String>> Resources::children_;
+    HashSet<String> Resources::indexed_;
 
     //--------------------------------------------------------------------------
     void Resources::Register(
@@ -13,30 +18,129 @@ namespace snuffbox
       size_t size, 
       const Path& path)
     {
-      resources_.emplace(eastl::pair<String, ResourceData>
+      resources_.emplace(eastl::pair<StringId, ResourceData>
       {
         path.ToString(), ResourceData{ buffer, size }
       });
     }
 
+    //--------------------------------------------------------------------------
+    bool Resources::Mount(const Path& path)
+    {
+      Pack* pack = Memory::Construct<Pack>(&Memory::default_allocator());
+
+      if (pack->Open(path) == false)
+      {
+        Memory::Destruct(pack);
+        return false;
+      }
+
+      packs_.push_back(pack);
+
+      for (size_t i = 0; i < pack->num_entries(); ++i)
+      {
+        AddToIndex(pack->Name(pack->entry(i)));
+      }
+
+      return true;
+    }
+
+    //--------------------------------------------------------------------------
+    Vector<Path> Resources::Children(const Path& path)
+    {
+      String dir = path.StripPath(Path::kVirtualPrefix).ToString();
+      Vector<Path> children;
+
+      UMap<String, Vector<String>>::const_iterator it = children_.find(dir);
+
+      if (it == children_.end())
+      {
+        return children;
+      }
+
+      Path root = Path::kVirtualPrefix;
+      const Vector<String>& names = it->second;
+
+      children.reserve(names.size());
+
+      for (size_t i = 0; i < names.size(); ++i)
+      {
+        children.push_back(root / names.at(i));
+      }
+
+      return children;
+    }
+
     //--------------------------------------------------------------------------
     void Resources::Shutdown()
     {
       resources_.clear();
+
+      for (size_t i = 0; i < packs_.size(); ++i)
+      {
+        Memory::Destruct(packs_.at(i));
+      }
+
+      packs_.clear();
+
+      children_.clear();
+      indexed_.clear();
     }
 
     //--------------------------------------------------------------------------
-    const Resources::ResourceData* Resources::GetResource(const Path& path)
+    bool Resources::GetResource(const Path& path, ResourceData* data)
     {
-      UMap<String, ResourceData>::const_iterator it = 
-        resources_.find(path.ToString());
+      StringId id = StringId::Find(path.ToString());
+
+      if (id.is_valid() == true)
+      {
+        UMap<StringId, ResourceData>::const_iterator it = resources_.find(id);
 
-      if (it == resources_.end())
+        if (it != resources_.end())
+        {
+          *data = it->second;
+          return true;
+        }
+      }
+
+      for (size_t i = packs_.size(); i > 0; --i)
       {
-        return nullptr;
+        const Pack* pack = packs_.at(i - 1);
+        const Pack::Entry* entry = pack->Find(path.ToString());
+
+        if (entry != nullptr)
+        {
+          data->buffer = pack->Data(entry);
+          data->size = static_cast<size_t>(entry->size);
+
+          return data->buffer != nullptr;
+        }
       }
 
-      return &it->second;
+      return false;
+    }
+
+    //--------------------------------------------------------------------------
+    void Resources::AddToIndex(const String& name)
+    {
+      String child = name;
+
+      while (indexed_.find(child) == indexed_.end())
+      {
+        indexed_.insert(child);
+
+        size_t slash = child.find_last_of('/');
+        String parent = slash == String::npos ? "" : child.substr(0, slash);
+
+        children_[parent].push_back(child);
+
+        if (slash == String::npos)
+        {
+          break;
+        }
+
+        child = parent;
+      }
     }
   }
-}
\ No newline at end of file
+}
@@ -2,6 +2,8 @@
 
 #include "foundation/io/path.h"
 #include "foundation/containers/map.h"
+#include "foundation/containers/vector.h"
+#include "foundation/containers/string_id.h"
 
 #include <cinttypes>
 
@@ -13,6 +15,8 @@ namespace snuffbox
 {
   namespace foundation
   {
+    class Pack;
+
     /**
     * @brief Used as a virtual file system to store binary data 
     *        in the executable
@@ -26,7 +30,12 @@ namespace snuffbox
     * is a direct 'file' to pointer mapping, so no memory needs to be
     * copied.
     *
+    * Packs can be mounted to serve their entries through the same virtual
+    * paths. Resources that are registered directly take precedence, after
+    * which the packs are searched from the last mounted to the first.
+    *
     * @see File
+    * @see Pack
     *
     * @author Daniel Konings
     */
@@ -50,9 +59,35 @@ namespace snuffbox
         size_t size, 
         const Path& path);
 
+      /**
+      * @brief Mounts a pack, serving its entries as virtual files
+      *
+      * The directories of every entry are added to an index of the mounted
+      * directories, so that they can be listed without going through the
+      * entries again.
+      *
+      * @param[in] path The path to the pack
+      *
+      * @return Was the pack opened succesfully?
+      */
+      static bool Mount(const Path& path);
+
+      /**
+      * @brief Lists the files and directories in a directory of the mounted
+      *        packs
+      *
+      * @param[in] path The virtual path to the directory, with the virtual
+      *                 prefix
+      *
+      * @return The virtual paths of the direct children of the directory
+      */
+      static Vector<Path> Children(const Path& path);
+
       /**
       * @brief Make sure all memory of the resources system is cleared
       *        before the memory allocators get shut down
+      *
+      * @remarks This unmounts every pack
       */
       static void Shutdown();
 
@@ -74,17 +109,39 @@ namespace snuffbox
       *
       * @param[in] path The virtual path to load the resource from, without
       *                 the virtual prefix
+      * @param[out] data The resource data, if it exists
+      *
+      * @return Does the resource exist?
+      */
+      static bool GetResource(const Path& path, ResourceData* data);
+
+      /**
+      * @brief Adds an entry of a mounted pack and its parent directories
+      *        to the index of the mounted directories
       *
-      * @return The resource data, or nullptr if it doesn't exist
+      * @param[in] name The name of the entry
       */
-      static const ResourceData* GetResource(const Path& path);
+      static void AddToIndex(const String& name);
 
     private:
 
       /**
-      * @brief A mapping from a file path to a resource
+      * @brief A mapping from an interned file path to a resource
+      */
+      static UMap<StringId, ResourceData> resources_;
+
+      static Vector<Pack*> packs_; //!< The mounted packs
+
+      /**
+      * @brief The names of the direct children of every mounted directory,
+      *        by the name of the directory, where the root is empty
+      */
+      static UMap<String, Vector<String>> children_;
+
+      /**
+      * @brief Every entry and directory that is in the index
       */
-      static UMap<String, ResourceData> resources_;
+      static HashSet<String> indexed_;
     };
   }
 }
\ No newline at end of file
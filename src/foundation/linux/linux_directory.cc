@@ -1,4 +1,5 @@
 #include "foundation/linux/linux_directory.h"
+#include "foundation/io/metadata_cache.h"
 
 #include <sys/types.h>
 #include <sys/stat.h>
@@ -90,6 +91,7 @@ namespace snuffbox
       }
 
       rmdir(start_at);
+      MetadataCache::Invalidate(path);
     }
 
     //--------------------------------------------------------------------------
@@ -134,7 +136,14 @@ namespace snuffbox
         }
       }
 
-      return Create(path);
+      if (Create(path) == false)
+      {
+        return false;
+      }
+
+      MetadataCache::Store(path, true);
+
+      return true;
     }
 
     //--------------------------------------------------------------------------
@@ -164,6 +173,14 @@ namespace snuffbox
         }
 
         result.push_back(start_at / entry->d_name);
+
+        if (entry->d_type == DT_DIR || entry->d_type == DT_REG)
+        {
+          Path& child = result.back();
+          child.set_is_directory(entry->d_type == DT_DIR);
+
+          MetadataCache::Store(child, child.is_directory());
+        }
       } while ((entry = readdir(dp)) != nullptr);
 
       closedir(dp);
@@ -2,21 +2,26 @@
 #include "foundation/io/directory.h"
 
 #include <sys/inotify.h>
+#include <poll.h>
 #include <unistd.h>
+#include <errno.h>
 
 namespace snuffbox
 {
   namespace foundation
   {
     //--------------------------------------------------------------------------
-    const uint32_t LinuxDirectoryListener::kTimeout_ = 500;
-    const size_t LinuxDirectoryListener::kEventSize_ = 4096;
+    const int LinuxDirectoryListener::kTimeout_ = 500;
+    const int LinuxDirectoryListener::kDebounce_ = 100;
+    const int LinuxDirectoryListener::kMaxLatency_ = 1000;
+    const size_t LinuxDirectoryListener::kBufferSize_;
 
     //--------------------------------------------------------------------------
     LinuxDirectoryListener::LinuxDirectoryListener() :
       path_(""),
       is_ok_(false),
       should_exit_(false),
+      fd_(-1),
       on_directory_changed_(nullptr),
       on_file_changed_(nullptr)
     {
@@ -34,38 +39,62 @@ namespace snuffbox
     //--------------------------------------------------------------------------
     void LinuxDirectoryListener::Listen(const Path& root)
     {
+      Stop();
+      Close();
+
       path_ = root;
       is_ok_ = Initialize(path_);
 
       if (is_ok_ == false)
       {
+        Close();
         return;
       }
 
       should_exit_ = false;
 
-      thread_ = std::thread([&]()
+      thread_ = std::thread([this]()
       {
+        struct pollfd pfd;
+        pfd.fd = fd_;
+        pfd.events = POLLIN;
+
         while (should_exit_ == false)
         {
-          Vector<struct pollfd>& pfds = data_.pfds;
-          int ret = poll(pfds.data(), pfds.size(), kTimeout_);
+          int timeout = pending_.empty() == true ? kTimeout_ : kDebounce_;
+
+          pfd.revents = 0;
+          int ret = poll(&pfd, 1, timeout);
+
           if (ret < 0)
           {
-              should_exit_ = true;
+            if (errno == EINTR)
+            {
+              continue;
+            }
+
+            should_exit_ = true;
           }
-          else if (ret > 0)
+          else if (ret > 0 && (pfd.revents & POLLIN) == POLLIN)
           {
-            for (size_t i = 0; i < pfds.size(); ++i)
+            if (ReadEvents() == false)
             {
-              struct pollfd& pfd = pfds.at(i);
-              if ((pfd.revents & POLLIN) == POLLIN)
-              {
-                HandleEvent(pfd, i);
-                break;
-              }
+              should_exit_ = true;
             }
           }
+
+          if (pending_.empty() == true)
+          {
+            continue;
+          }
+
+          int64_t waited = std::chrono::duration_cast<
+            std::chrono::milliseconds>(Clock::now() - first_pending_).count();
+
+          if (ret == 0 || waited >= kMaxLatency_)
+          {
+            Flush();
+          }
         }
       });
     }
@@ -100,186 +129,285 @@ namespace snuffbox
         return false;
       }
 
-      Function<bool(const Path&)> recurse = [&](const Path& current)
+      fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+
+      if (fd_ == -1)
+      {
+        return false;
+      }
+
+      return AddDirectory(root);
+    }
+
+    //--------------------------------------------------------------------------
+    bool LinuxDirectoryListener::AddDirectory(const Path& path)
+    {
+      uint32_t mask =
+        IN_CREATE |
+        IN_DELETE |
+        IN_MODIFY |
+        IN_CLOSE_WRITE |
+        IN_MOVED_FROM |
+        IN_MOVED_TO |
+        IN_DELETE_SELF |
+        IN_MOVE_SELF |
+        IN_ONLYDIR;
+
+      int wd = inotify_add_watch(fd_, path.ToString().c_str(), mask);
+
+      if (wd == -1)
+      {
+        return false;
+      }
+
+      watches_[wd] = path;
+
+      if (Directory::Exists(path) == false)
       {
-        Directory dir(current);
+        return true;
+      }
+
+      Directory dir(path);
+      bool success = true;
 
-        const Vector<Path>& children = dir.children();
-        for (size_t i = 0; i < children.size(); ++i)
+      const Vector<Path>& children = dir.children();
+      for (size_t i = 0; i < children.size(); ++i)
+      {
+        const Path& child = children.at(i);
+        if (child.is_directory() == true && AddDirectory(child) == false)
         {
-          const Path& child = children.at(i);
-          if (child.is_directory() == true)
-          {
-            if (recurse(child) == false)
-            {
-              return false;
-            }
-          }
+          success = false;
         }
+      }
 
-        return AddDirectory(current.ToString().c_str());
-      };
-
-      return recurse(root);
+      return success;
     }
 
     //--------------------------------------------------------------------------
-    bool LinuxDirectoryListener::AddDirectory(const char* path)
+    void LinuxDirectoryListener::RemoveDirectory(const Path& path)
     {
-      struct pollfd pfd;
-      pfd.fd = inotify_init();
-      pfd.events = POLLIN;
-      pfd.revents = 0;
+      const String& removed = path.ToString();
+
+      UMap<int, Path>::iterator it = watches_.begin();
 
-      if (pfd.fd == -1)
+      while (it != watches_.end())
       {
-        return false;
+        const String& watched = it->second.ToString();
+
+        bool is_child =
+          watched.size() > removed.size() &&
+          watched.compare(0, removed.size(), removed) == 0 &&
+          watched.at(removed.size()) == '/';
+
+        if (watched != removed && is_child == false)
+        {
+          ++it;
+          continue;
+        }
+
+        inotify_rm_watch(fd_, it->first);
+        it = watches_.erase(it);
       }
+    }
+
+    //--------------------------------------------------------------------------
+    bool LinuxDirectoryListener::ReadEvents()
+    {
+      alignas(struct inotify_event) uint8_t buffer[kBufferSize_];
 
-      int wd = inotify_add_watch(pfd.fd, path, IN_ALL_EVENTS);
+      ssize_t len = read(fd_, buffer, kBufferSize_);
 
-      if (wd == -1)
+      if (len < 0)
       {
-        close(pfd.fd);
-        return false;
+        return errno == EAGAIN || errno == EINTR;
       }
 
-      data_.pfds.push_back(pfd);
-      data_.wds.push_back(wd);
-      data_.paths.push_back(path);
+      const uint8_t* ptr = buffer;
+      const uint8_t* end = buffer + len;
+
+      while (ptr < end)
+      {
+        const struct inotify_event* evt =
+          reinterpret_cast<const struct inotify_event*>(ptr);
+
+        HandleEvent(evt);
+        ptr += sizeof(struct inotify_event) + evt->len;
+      }
 
       return true;
     }
 
     //--------------------------------------------------------------------------
-    void LinuxDirectoryListener::HandleEvent(struct pollfd& pfd, size_t i)
+    void LinuxDirectoryListener::HandleEvent(const struct inotify_event* evt)
     {
-      uint8_t buffer[kEventSize_];
-      int ret = read(pfd.fd, buffer, kEventSize_);
+      uint32_t m = evt->mask;
+
+      if ((m & IN_Q_OVERFLOW) != 0)
+      {
+        QueueChange(path_, DirectoryEvent::kUnknown, true);
+        return;
+      }
 
-      pfd.revents = 0;
-      pfd.events = POLLIN;
+      UMap<int, Path>::iterator it = watches_.find(evt->wd);
 
-      if (ret < 0)
+      if (it == watches_.end())
       {
-        RemoveEvent(i);
         return;
       }
 
-      struct inotify_event* evt =
-          reinterpret_cast<struct inotify_event*>(buffer);
+      if ((m & IN_IGNORED) != 0)
+      {
+        watches_.erase(it);
+        return;
+      }
 
-      uint32_t m = evt->mask;
-      bool is_dir = (m & IN_ISDIR) > 0;
+      Path dir = it->second;
 
-      auto DoCallback = [=](const OnDirectoryChanged& cb)
+      if ((m & IN_DELETE_SELF) != 0 || (m & IN_MOVE_SELF) != 0)
       {
-        if (cb != nullptr)
+        if (dir == path_)
         {
-          cb(path_);
+          QueueChange(path_, DirectoryEvent::kUnknown, true);
         }
-      };
 
-      if ((m & IN_DELETE_SELF) > 0)
+        return;
+      }
+
+      if (evt->len == 0)
       {
-        RemoveEvent(i);
-        DoCallback(on_directory_changed_);
+        return;
       }
-      else if (
-        (m & IN_MODIFY) > 0 ||
-        (m & IN_MOVE) > 0 ||
-        (m & IN_CREATE) > 0)
+
+      Path path = dir / evt->name;
+      bool is_dir = (m & IN_ISDIR) != 0;
+
+      if ((m & IN_CREATE) != 0 || (m & IN_MOVED_TO) != 0)
       {
         if (is_dir == true)
         {
-          Path p = data_.paths.at(i) / evt->name;
+          AddDirectory(path);
+        }
 
-          if ((m & IN_CREATE) > 0)
-          {
-            AddDirectory(p.ToString().c_str());
-          }
-          else if ((m & IN_MOVED_FROM) > 0)
-          {
-            RemoveEvent(p);
-          }
+        QueueChange(path, DirectoryEvent::kCreated, is_dir);
+      }
+      else if ((m & IN_DELETE) != 0 || (m & IN_MOVED_FROM) != 0)
+      {
+        if (is_dir == true)
+        {
+          RemoveDirectory(path);
         }
 
-        DoCallback(on_directory_changed_);
-        DoCallback(on_file_changed_);
+        QueueChange(path, DirectoryEvent::kRemoved, is_dir);
+      }
+      else if (
+        is_dir == false &&
+        ((m & IN_MODIFY) != 0 || (m & IN_CLOSE_WRITE) != 0))
+      {
+        QueueChange(path, DirectoryEvent::kModified, false);
       }
     }
 
     //--------------------------------------------------------------------------
-    void LinuxDirectoryListener::RemoveEvent(size_t i)
+    void LinuxDirectoryListener::QueueChange(
+      const Path& path,
+      DirectoryEvent evt,
+      bool is_directory)
     {
-      if (i >= data_.pfds.size())
+      if (pending_.empty() == true)
       {
-        return;
+        first_pending_ = Clock::now();
       }
 
-      struct pollfd pfd = data_.pfds.at(i);
-      int wd = data_.wds.at(i);
-      int fd = pfd.fd;
+      const String& key = path.ToString();
+      UMap<String, size_t>::iterator it = pending_index_.find(key);
 
-      if (fd != -1)
+      if (it == pending_index_.end())
       {
-        if (wd != -1)
-        {
-          inotify_rm_watch(fd, wd);
-        }
+        pending_index_.emplace(key, pending_.size());
+        pending_.push_back(PendingChange{ path, evt, is_directory, false });
 
-        close(fd);
+        return;
       }
 
-      data_.pfds.erase(data_.pfds.begin() + i);
-      data_.wds.erase(data_.wds.begin() + i);
-      data_.paths.erase(data_.paths.begin() + i);
+      PendingChange& change = pending_.at(it->second);
+      DirectoryEvent previous = change.evt;
+
+      change.is_directory = is_directory;
 
-      for (int i = static_cast<int>(data_.paths.size()) - 1; i >= 0; --i)
+      if (change.is_cancelled == true)
       {
-        if (Directory::Exists(data_.paths.at(i)) == false)
-        {
-          RemoveEvent(i);
-        }
+        change.evt = evt;
+        change.is_cancelled = false;
+      }
+      else if (
+        previous == DirectoryEvent::kUnknown ||
+        evt == DirectoryEvent::kUnknown)
+      {
+        change.evt = DirectoryEvent::kUnknown;
+      }
+      else if (previous == DirectoryEvent::kCreated)
+      {
+        change.is_cancelled = evt == DirectoryEvent::kRemoved;
+      }
+      else if (
+        previous == DirectoryEvent::kRemoved &&
+        evt == DirectoryEvent::kCreated)
+      {
+        change.evt = is_directory == true ?
+          DirectoryEvent::kCreated :
+          DirectoryEvent::kModified;
+      }
+      else
+      {
+        change.evt = evt;
       }
     }
 
     //--------------------------------------------------------------------------
-    void LinuxDirectoryListener::RemoveEvent(const Path& path)
+    void LinuxDirectoryListener::Flush()
     {
-      size_t idx = 0;
-      bool found = false;
+      Vector<PendingChange> changes;
+      changes.swap(pending_);
+      pending_index_.clear();
 
-      for (size_t i = 0; i < data_.paths.size(); ++i)
+      for (size_t i = 0; i < changes.size(); ++i)
       {
-        if (data_.paths.at(i) == path)
+        const PendingChange& change = changes.at(i);
+
+        if (change.is_cancelled == true)
         {
-          found = true;
-          idx = i;
-          break;
+          continue;
         }
-      }
 
-      if (found == false)
-      {
-        return;
-      }
+        const OnDirectoryChanged& cb = change.is_directory == true ?
+          on_directory_changed_ :
+          on_file_changed_;
 
-      RemoveEvent(idx);
+        if (cb != nullptr)
+        {
+          cb(change.path, change.evt);
+        }
+      }
     }
 
     //--------------------------------------------------------------------------
     void LinuxDirectoryListener::Close()
     {
-      for (int i = static_cast<int>(data_.pfds.size() - 1); i >= 0; --i)
+      if (fd_ != -1)
       {
-        RemoveEvent(i);
+        close(fd_);
+        fd_ = -1;
       }
+
+      watches_.clear();
+      pending_.clear();
+      pending_index_.clear();
     }
 
     //--------------------------------------------------------------------------
     LinuxDirectoryListener::~LinuxDirectoryListener()
     {
+      Stop();
       Close();
     }
   }
@@ -2,9 +2,14 @@
 
 #include "foundation/definitions/io.h"
 #include "foundation/io/path.h"
+#include "foundation/containers/map.h"
+#include "foundation/containers/vector.h"
 
 #include <thread>
-#include <poll.h>
+#include <atomic>
+#include <chrono>
+
+struct inotify_event;
 
 namespace snuffbox
 {
@@ -20,10 +25,19 @@ namespace snuffbox
     * The listener should be used thread safe so that it can run on
     * a different thread and not block the main thread.
     *
-    * The listener only tells the user the root directory or its subdirectories
-    * have changed. There is however a distinction between tree changes and
-    * file changes, for which there are different callbacks. The listener
-    * doesn't specifically list which file or directory has changed.
+    * Every directory in the tree is watched from a single inotify instance,
+    * which maps the watch descriptors back to their paths. Every event is
+    * reported with the exact path that changed and the kind of change, with
+    * different callbacks for tree changes and file changes.
+    *
+    * Editors tend to generate a burst of events for a single save, so
+    * events are coalesced per path and only delivered once no new events
+    * came in for LinuxDirectoryListener::kDebounce_ milliseconds. When the
+    * kernel drops events, the root is reported as DirectoryEvent::kUnknown
+    * so that the user can rescan everything.
+    *
+    * A directory that is created or moved into the tree is reported, but
+    * its contents are not; the user should scan the new directory itself.
     *
     * @author Daniel Konings
     */
@@ -33,19 +47,23 @@ namespace snuffbox
     protected:
 
       /**
-      * @brief The data used by the directory listener to remove and add
-      *        watches accordingly using inotify
+      * @brief A change that is waiting for the debounce window to pass
       *
-      * @remarks This structure is used as a struct of arrays for a better
-      *          memory access pattern
+      * @author Daniel Konings
       */
-      struct PollData
+      struct PendingChange
       {
-        Vector<struct pollfd> pfds; //!< The polling data used by inotify
-        Vector<int> wds; //!< The watch descriptors created from the inotify
-        Vector<Path> paths; //!< The paths that are being watched currently
+        Path path; //!< The path that changed
+        DirectoryEvent evt; //!< The coalesced kind of change
+        bool is_directory; //!< Is the path a directory?
+        bool is_cancelled; //!< Was the change undone within the window?
       };
 
+      /**
+      * @brief The clock used for the debounce window
+      */
+      using Clock = std::chrono::steady_clock;
+
     public:
 
       /**
@@ -91,63 +109,73 @@ namespace snuffbox
     protected:
 
       /**
-      * @brief Initializes the directory listener by setting up the change
-      *        handles on the root directory
+      * @brief Initializes the directory listener by creating the inotify
+      *        instance and watching the root directory
       *
       * @param[in] root The root directory to listen on
       */
       bool Initialize(const Path& root);
 
       /**
-      * @brief Adds a directory for watching by path
+      * @brief Watches a directory and all of its subdirectories
       *
       * @param[in] path The path to the existing directory
       *
-      * @return Was both the file and watch descriptor initialized properly?
+      * @return Were all directories watched succesfully?
       */
-      bool AddDirectory(const char* path);
+      bool AddDirectory(const Path& path);
 
       /**
-      * @brief Handles a poll event for a file descriptor
+      * @brief Stops watching a directory and all of its subdirectories
       *
-      * @param[in] pfd The poll event file descriptor to handle
-      * @param[in] i The index of the event in the
-      *              LinuxDirectoryListener::pfds_ array
+      * @param[in] path The path to the directory
       */
-      void HandleEvent(struct pollfd& pfd, size_t i);
+      void RemoveDirectory(const Path& path);
 
       /**
-      * @brief Removes an event at a provided index
+      * @brief Reads as many events as fit in the buffer from the inotify
+      *        instance and handles every one of them
       *
-      * @param[in] i The index of the event to remove
-      *
-      * @remarks This function verifies that underlying paths still exist,
-      *          if they do not, they're removed as well.
+      * @return Were the events read succesfully?
       */
-      void RemoveEvent(size_t i);
+      bool ReadEvents();
 
       /**
-      * @brief Removes an event by path instead of index
+      * @brief Handles a single inotify event
       *
-      * @param[in] path The path to a registered event
+      * @param[in] evt The event to handle
+      */
+      void HandleEvent(const struct inotify_event* evt);
+
+      /**
+      * @brief Queues a change, coalescing it with a pending change of the
+      *        same path
       *
-      * @see LinuxDirectoryListener::RemoveEvent
+      * @param[in] path The path that changed
+      * @param[in] evt The kind of change
+      * @param[in] is_directory Is the path a directory?
       */
-      void RemoveEvent(const Path& path);
+      void QueueChange(const Path& path, DirectoryEvent evt, bool is_directory);
 
       /**
-      * @brief Closes the file descriptors, also when an error has occured
-      *        during initialization
+      * @brief Delivers all pending changes to the callbacks
+      */
+      void Flush();
+
+      /**
+      * @brief Closes the inotify instance, which also removes all of
+      *        its watches
       *
-      * @remarks This function checks if the file descriptors were opened
-      *          first, before closing them
+      * @remarks This function checks if the instance was opened first,
+      *          before closing it
       */
       void Close();
 
     public:
 
       /**
-      * @brief Closes the inotify file descriptors if they were initialized
+      * @brief Stops listening and closes the inotify instance if it was
+      *        initialized
       *
       * @see LinuxDirectoryListener::Close
       */
@@ -157,12 +185,18 @@ namespace snuffbox
 
       Path path_; //!< The root path of the listener
       bool is_ok_; //!< Is the directory listener available for use?
-      bool should_exit_; //!< Should the directory listener stop listening?
 
       /**
-      * @brief The different poll file descriptors per directory
+      * @brief Should the directory listener stop listening?
       */
-      PollData data_;
+      std::atomic<bool> should_exit_;
+
+      int fd_; //!< The inotify instance
+      UMap<int, Path> watches_; //!< The watched directories by descriptor
+
+      Vector<PendingChange> pending_; //!< The changes in the current window
+      UMap<String, size_t> pending_index_; //!< Indices into the changes
+      Clock::time_point first_pending_; //!< When the window was opened
 
       /**
       * @brief The callback when a directory or its contents have changed
@@ -182,12 +216,25 @@ namespace snuffbox
       * @remarks After this period the listener checks again if it should exit
       *          and if not; continues the listening events
       */
-      static const uint32_t kTimeout_;
+      static const int kTimeout_;
+
+      /**
+      * @brief The quiet period in milliseconds after which pending changes
+      *        are delivered
+      */
+      static const int kDebounce_;
+
+      /**
+      * @brief The longest a change can be pending in milliseconds, so that
+      *        a constant stream of events can't hold back delivery
+      */
+      static const int kMaxLatency_;
 
       /**
-      * @brief The event size of an inotify_event, including the name
+      * @brief The size of the buffer to read events into, which fits many
+      *        events including their names
       */
-      static const size_t kEventSize_;
+      static const size_t kBufferSize_ = 16 * 1024;
     };
   }
 }
@@ -0,0 +1,241 @@
+#include "foundation/memory/allocator_registry.h"
+
+#include "foundation/auxiliary/logger.h"
+#include "foundation/auxiliary/string_utils.h"
+
+namespace snuffbox
+{
+  namespace foundation
+  {
+    //--------------------------------------------------------------------------
+    std::mutex AllocatorRegistry::mutex_;
+    IAllocator* AllocatorRegistry::head_ = nullptr;
+    IAllocator* AllocatorRegistry::tail_ = nullptr;
+    std::atomic<uint32_t> AllocatorRegistry::frame_(0);
+    std::atomic<uint64_t> AllocatorRegistry::frame_allocated_(0);
+
+    //--------------------------------------------------------------------------
+    void AllocatorRegistry::EndFrame()
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+
+      IAllocator* current = head_;
+      uint64_t frame_allocated = 0;
+
+      while (current != nullptr)
+      {
+        IAllocator::Statistics stats = current->statistics();
+        IAllocator::FrameStatistics& frame = current->frame_;
+
+        frame.allocations = stats.allocations - frame.last_allocations;
+        frame.allocated = stats.allocated_total - frame.last_allocated;
+        frame.last_allocations = stats.allocations;
+        frame.last_allocated = stats.allocated_total;
+
+        if (frame.allocations > frame.peak_allocations)
+        {
+          frame.peak_allocations = frame.allocations;
+        }
+
+        if (frame.allocated > frame.peak_allocated)
+        {
+          frame.peak_allocated = frame.allocated;
+        }
+
+        frame.peak_usage = stats.peak_allocated;
+        frame_allocated += frame.allocated;
+
+        current = current->next_;
+      }
+
+      frame_allocated_.store(frame_allocated, std::memory_order_relaxed);
+      frame_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    //--------------------------------------------------------------------------
+    uint32_t AllocatorRegistry::frame()
+    {
+      return frame_.load(std::memory_order_relaxed);
+    }
+
+    //--------------------------------------------------------------------------
+    uint64_t AllocatorRegistry::frame_allocated()
+    {
+      return frame_allocated_.load(std::memory_order_relaxed);
+    }
+
+    //--------------------------------------------------------------------------
+    Vector<IAllocator::Statistics> AllocatorRegistry::Snapshot()
+    {
+      Vector<IAllocator::Statistics> result;
+
+      std::lock_guard<std::mutex> lock(mutex_);
+
+      IAllocator* current = head_;
+
+      while (current != nullptr)
+      {
+        result.push_back(current->statistics());
+        current = current->next_;
+      }
+
+      return result;
+    }
+
+    //--------------------------------------------------------------------------
+    void AllocatorRegistry::Dump()
+    {
+      Vector<IAllocator::Statistics> snapshot = Snapshot();
+
+      Logger::Log(
+        LogChannel::kUnspecified,
+        LogSeverity::kInfo,
+        "Allocator statistics at frame {0}, {1} allocator(s)",
+        frame(),
+        snapshot.size());
+
+      for (size_t i = 0; i < snapshot.size(); ++i)
+      {
+        const IAllocator::Statistics& stats = snapshot.at(i);
+
+        Logger::Log(
+          LogChannel::kUnspecified,
+          LogSeverity::kInfo,
+          "  {0}: {1} bytes in {2} allocation(s) (peak {3}), "
+          "{4} bytes reserved (peak {5})",
+          stats.name,
+          stats.allocated,
+          stats.open_allocations,
+          stats.peak_allocated,
+          stats.reserved,
+          stats.peak_reserved);
+
+        Logger::Log(
+          LogChannel::kUnspecified,
+          LogSeverity::kInfo,
+          "    {0} allocation(s) totalling {1} bytes, "
+          "last frame {2} allocation(s) of {3} bytes (peak {4})",
+          stats.allocations,
+          stats.allocated_total,
+          stats.frame_allocations,
+          stats.frame_allocated,
+          stats.peak_frame_allocations);
+      }
+    }
+
+    //--------------------------------------------------------------------------
+    String AllocatorRegistry::ToJson()
+    {
+      Vector<IAllocator::Statistics> snapshot = Snapshot();
+
+      String json = "{\"frame\":" + StringUtils::ToString(frame());
+
+      json += ",\"size_buckets\":[";
+      for (size_t i = 0; i < AllocatorCounters::kNumSizeBuckets; ++i)
+      {
+        json += (i > 0 ? "," : "") +
+          StringUtils::ToString(AllocatorCounters::SizeBucketBound(i));
+      }
+
+      json += "],\"lifetime_buckets\":[";
+      for (size_t i = 0; i < AllocatorCounters::kNumLifetimeBuckets; ++i)
+      {
+        json += (i > 0 ? "," : "") +
+          StringUtils::ToString(AllocatorCounters::LifetimeBucketBound(i));
+      }
+
+      json += "],\"allocators\":[";
+
+      for (size_t i = 0; i < snapshot.size(); ++i)
+      {
+        const IAllocator::Statistics& s = snapshot.at(i);
+
+        json += i > 0 ? ",{" : "{";
+        json += "\"name\":\"" + String(s.name) + "\"";
+        json += ",\"open_allocations\":" +
+          StringUtils::ToString(s.open_allocations);
+        json += ",\"allocated\":" + StringUtils::ToString(s.allocated);
+        json += ",\"reserved\":" + StringUtils::ToString(s.reserved);
+        json += ",\"peak_allocated\":" +
+          StringUtils::ToString(s.peak_allocated);
+        json += ",\"peak_reserved\":" + StringUtils::ToString(s.peak_reserved);
+        json += ",\"allocations\":" + StringUtils::ToString(s.allocations);
+        json += ",\"allocated_total\":" +
+          StringUtils::ToString(s.allocated_total);
+        json += ",\"frame_allocations\":" +
+          StringUtils::ToString(s.frame_allocations);
+        json += ",\"frame_allocated\":" +
+          StringUtils::ToString(s.frame_allocated);
+        json += ",\"peak_frame_allocations\":" +
+          StringUtils::ToString(s.peak_frame_allocations);
+        json += ",\"peak_frame_allocated\":" +
+          StringUtils::ToString(s.peak_frame_allocated);
+
+        json += ",\"sizes\":[";
+        for (size_t j = 0; j < AllocatorCounters::kNumSizeBuckets; ++j)
+        {
+          json += (j > 0 ? "," : "") + StringUtils::ToString(s.sizes[j]);
+        }
+
+        json += "],\"lifetimes\":[";
+        for (size_t j = 0; j < AllocatorCounters::kNumLifetimeBuckets; ++j)
+        {
+          json += (j > 0 ? "," : "") + StringUtils::ToString(s.lifetimes[j]);
+        }
+
+        json += "]}";
+      }
+
+      json += "]}";
+
+      return json;
+    }
+
+    //--------------------------------------------------------------------------
+    void AllocatorRegistry::Register(IAllocator* allocator)
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+
+      allocator->prev_ = tail_;
+      allocator->next_ = nullptr;
+
+      if (tail_ != nullptr)
+      {
+        tail_->next_ = allocator;
+      }
+      else
+      {
+        head_ = allocator;
+      }
+
+      tail_ = allocator;
+    }
+
+    //--------------------------------------------------------------------------
+    void AllocatorRegistry::Unregister(IAllocator* allocator)
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+
+      if (allocator->prev_ != nullptr)
+      {
+        allocator->prev_->next_ = allocator->next_;
+      }
+      else if (head_ == allocator)
+      {
+        head_ = allocator->next_;
+      }
+
+      if (allocator->next_ != nullptr)
+      {
+        allocator->next_->prev_ = allocator->prev_;
+      }
+      else if (tail_ == allocator)
+      {
+        tail_ = allocator->prev_;
+      }
+
+      allocator->prev_ = nullptr;
+      allocator->next_ = nullptr;
+    }
+  }
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "foundation/memory/allocators/allocator.h"
+
+#include "foundation/containers/vector.h"
+#include "foundation/containers/string.h"
+
+#include <mutex>
+
+namespace snuffbox
+{
+  namespace foundation
+  {
+    /**
+    * @brief A registry of every allocator that is currently alive
+    *
+    * Allocators register themselves on construction, after which their
+    * statistics can be inspected through the registry. The registry also
+    * keeps the frame counter that is used to measure the lifetime of
+    * allocations and to calculate the allocation rate per frame.
+    *
+    * @see IAllocator
+    *
+    * @author Daniel Konings
+    */
+    class AllocatorRegistry
+    {
+
+      friend class IAllocator;
+
+    public:
+
+      /**
+      * @brief Ends the current frame, updating the frame statistics and
+      *        the peak usage of every allocator
+      */
+      static void EndFrame();
+
+      /**
+      * @return The current frame index
+      */
+      static uint32_t frame();
+
+      /**
+      * @return The number of bytes allocated in the last frame, summed over
+      *         every allocator
+      *
+      * @remarks Allocators that draw from other allocators are counted
+      *          along with the allocator they draw from
+      */
+      static uint64_t frame_allocated();
+
+      /**
+      * @brief Takes a snapshot of the statistics of every allocator
+      *
+      * @return The statistics, in order of registration
+      */
+      static Vector<IAllocator::Statistics> Snapshot();
+
+      /**
+      * @brief Logs the statistics of every allocator
+      */
+      static void Dump();
+
+      /**
+      * @brief Converts the statistics of every allocator to JSON
+      *
+      * The size and lifetime histograms are written as arrays, the bounds
+      * of the buckets are written once in the root object.
+      *
+      * @return The JSON snapshot
+      */
+      static String ToJson();
+
+    protected:
+
+      /**
+      * @brief Adds an allocator to the registry
+      *
+      * @param[in] allocator The allocator to add
+      */
+      static void Register(IAllocator* allocator);
+
+      /**
+      * @brief Removes an allocator from the registry
+      *
+      * @param[in] allocator The allocator to remove
+      */
+      static void Unregister(IAllocator* allocator);
+
+    private:
+
+      static std::mutex mutex_; //!< The mutex to guard the registry with
+      static IAllocator* head_; //!< The first registered allocator
+      static IAllocator* tail_; //!< The last registered allocator
+      static std::atomic<uint32_t> frame_; //!< The current frame index
+      static std::atomic<uint64_t> frame_allocated_; //!< Allocated last frame
+    };
+  }
+}
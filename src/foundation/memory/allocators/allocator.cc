@@ -1,73 +1,573 @@
 #include "foundation/memory/allocators/allocator.h"
+#include "foundation/memory/allocator_registry.h"
 #include "foundation/auxiliary/logger.h"
 
+#include <cstdlib>
+#include <new>
+
 namespace snuffbox
 {
   namespace foundation
   {
     //--------------------------------------------------------------------------
-    IAllocator::IAllocator(size_t max_size) :
+    std::atomic<uint64_t> IAllocator::next_id_(1);
+
+    //--------------------------------------------------------------------------
+    IAllocator::IAllocator(size_t max_size, bool thread_cached) :
+      name_("Allocator"),
       max_size_(max_size),
-      open_allocations_(0),
-      allocated_(0)
+      thread_cached_(thread_cached),
+      id_(next_id_.fetch_add(1)),
+      reserved_(0),
+      peak_reserved_(0),
+      counters_(nullptr),
+      frame_(),
+      prev_(nullptr),
+      next_(nullptr),
+      mutex_("Allocator")
     {
+      for (size_t i = 0; i < ThreadCache::kNumSizeClasses; ++i)
+      {
+        depot_[i].head = nullptr;
+        depot_[i].count = 0;
+      }
+
+      AllocatorRegistry::Register(this);
+    }
 
+    //--------------------------------------------------------------------------
+    const char* IAllocator::name() const
+    {
+      return name_;
+    }
+
+    //--------------------------------------------------------------------------
+    void IAllocator::set_name(const char* name)
+    {
+      name_ = name;
+      mutex_.set_name(name);
     }
 
     //--------------------------------------------------------------------------
     size_t IAllocator::open_allocations() const
     {
-      return open_allocations_;
+      int64_t open = shared_.open_allocations.load(std::memory_order_relaxed);
+
+      AllocatorCounters* c = counters_.load(std::memory_order_acquire);
+      while (c != nullptr)
+      {
+        open += c->open_allocations.load(std::memory_order_relaxed);
+        c = c->next;
+      }
+
+      return open < 0 ? 0 : static_cast<size_t>(open);
     }
 
     //--------------------------------------------------------------------------
     size_t IAllocator::allocated() const
     {
-      return allocated_;
+      int64_t allocated = shared_.allocated.load(std::memory_order_relaxed);
+
+      AllocatorCounters* c = counters_.load(std::memory_order_acquire);
+      while (c != nullptr)
+      {
+        allocated += c->allocated.load(std::memory_order_relaxed);
+        c = c->next;
+      }
+
+      return allocated < 0 ? 0 : static_cast<size_t>(allocated);
+    }
+
+    //--------------------------------------------------------------------------
+    size_t IAllocator::reserved() const
+    {
+      return reserved_.load(std::memory_order_relaxed);
+    }
+
+    //--------------------------------------------------------------------------
+    bool IAllocator::thread_cached() const
+    {
+      return thread_cached_;
+    }
+
+    //--------------------------------------------------------------------------
+    size_t IAllocator::peak_reserved() const
+    {
+      return peak_reserved_.load(std::memory_order_relaxed);
+    }
+
+    //--------------------------------------------------------------------------
+    IAllocator::Statistics IAllocator::statistics() const
+    {
+      Statistics stats;
+
+      stats.name = name_;
+      stats.open_allocations = open_allocations();
+      stats.allocated = allocated();
+      stats.reserved = reserved();
+      stats.peak_allocated = frame_.peak_usage;
+      stats.peak_reserved = peak_reserved();
+      stats.allocations = 0;
+      stats.allocated_total = 0;
+      stats.frame_allocations = frame_.allocations;
+      stats.frame_allocated = frame_.allocated;
+      stats.peak_frame_allocations = frame_.peak_allocations;
+      stats.peak_frame_allocated = frame_.peak_allocated;
+
+      for (size_t i = 0; i < AllocatorCounters::kNumSizeBuckets; ++i)
+      {
+        stats.sizes[i] = 0;
+      }
+
+      for (size_t i = 0; i < AllocatorCounters::kNumLifetimeBuckets; ++i)
+      {
+        stats.lifetimes[i] = 0;
+      }
+
+      const AllocatorCounters* c = &shared_;
+      AllocatorCounters* next = counters_.load(std::memory_order_acquire);
+
+      while (c != nullptr)
+      {
+        stats.allocations += c->allocations.load(std::memory_order_relaxed);
+        stats.allocated_total +=
+          c->allocated_total.load(std::memory_order_relaxed);
+
+        for (size_t i = 0; i < AllocatorCounters::kNumSizeBuckets; ++i)
+        {
+          stats.sizes[i] += c->sizes[i].load(std::memory_order_relaxed);
+        }
+
+        for (size_t i = 0; i < AllocatorCounters::kNumLifetimeBuckets; ++i)
+        {
+          stats.lifetimes[i] +=
+            c->lifetimes[i].load(std::memory_order_relaxed);
+        }
+
+        c = next;
+        next = c != nullptr ? c->next : nullptr;
+      }
+
+      if (stats.allocated > stats.peak_allocated)
+      {
+        stats.peak_allocated = stats.allocated;
+      }
+
+      return stats;
     }
 
     //--------------------------------------------------------------------------
     IAllocator::~IAllocator()
     {
-      assert(open_allocations_ == 0 && allocated_ == 0 &&
+      AllocatorRegistry::Unregister(this);
+
+      assert(open_allocations() == 0 && allocated() == 0 &&
         "Memory leak detected in an allocator");
+
+      assert(reserved() == 0 &&
+        "Blocks are still reserved, derived allocators should call Trim");
+
+      AllocatorCounters* c = counters_.load(std::memory_order_acquire);
+      AllocatorCounters* next = nullptr;
+
+      while (c != nullptr)
+      {
+        next = c->next;
+        c->~AllocatorCounters();
+        free(c);
+        c = next;
+      }
     }
 
     //--------------------------------------------------------------------------
     void* IAllocator::Allocate(size_t size, size_t align)
     {
-      std::lock_guard<std::recursive_mutex> lock(mutex_);
+      bool cached = thread_cached_ == true && ThreadCache::IsCached(size);
+      size_t size_class = cached == true ? ThreadCache::SizeClass(size) : 0;
+
+      ThreadCache* cache = nullptr;
+      ThreadCache::Slot* slot = nullptr;
+
+      if (
+        thread_cached_ == true &&
+        (cache = ThreadCache::Get()) != nullptr &&
+        (slot = cache->Find(this)) != nullptr)
+      {
+        void* ptr = nullptr;
+
+        if (cached == true)
+        {
+          ThreadCache::FreeList& list = slot->lists[size_class];
+
+          if (list.head == nullptr)
+          {
+            Refill(list, size_class);
+          }
+
+          ptr = list.Pop();
+        }
+        else
+        {
+          ptr = AllocateBlock(size, align);
+        }
+
+        if (ptr == nullptr)
+        {
+          return nullptr;
+        }
+
+        slot->counters->RecordAllocation(size, true);
+
+        return ptr;
+      }
+
+      void* ptr = AllocateBlock(
+        cached == true ? ThreadCache::ClassSize(size_class) : size,
+        align);
+
+      if (ptr == nullptr)
+      {
+        return nullptr;
+      }
+
+      shared_.RecordAllocation(size, false);
+
+      return ptr;
+    }
+
+    //--------------------------------------------------------------------------
+    void IAllocator::Deallocate(void* ptr, size_t size, uint32_t lifetime)
+    {
+      bool cached = thread_cached_ == true && ThreadCache::IsCached(size);
+      size_t size_class = cached == true ? ThreadCache::SizeClass(size) : 0;
+
+      ThreadCache* cache = nullptr;
+      ThreadCache::Slot* slot = nullptr;
+
+      if (
+        thread_cached_ == true &&
+        (cache = ThreadCache::Get()) != nullptr &&
+        (slot = cache->Find(this)) != nullptr)
+      {
+        slot->counters->RecordDeallocation(size, lifetime, true);
+
+        if (cached == false)
+        {
+          DeallocateBlock(ptr, size);
+          return;
+        }
+
+        ThreadCache::FreeList& list = slot->lists[size_class];
+        list.Push(ptr);
+
+        if (list.count >= ThreadCache::kBatchSize * 2)
+        {
+          Flush(list, size_class, ThreadCache::kBatchSize);
+        }
+
+        return;
+      }
+
+      shared_.RecordDeallocation(size, lifetime, false);
+
+      DeallocateBlock(
+        ptr,
+        cached == true ? ThreadCache::ClassSize(size_class) : size);
+    }
+
+    //--------------------------------------------------------------------------
+    void* IAllocator::Reallocate(
+      void* ptr,
+      size_t old_size,
+      size_t new_size,
+      size_t align)
+    {
+      bool old_cached =
+        thread_cached_ == true && ThreadCache::IsCached(old_size);
+
+      bool new_cached =
+        thread_cached_ == true && ThreadCache::IsCached(new_size);
+
+      void* block = nullptr;
 
-      if (allocated_ + size > max_size_)
+      if (old_cached == true || new_cached == true)
       {
+        if (
+          old_cached == false ||
+          new_cached == false ||
+          ThreadCache::SizeClass(old_size) != ThreadCache::SizeClass(new_size))
+        {
+          return nullptr;
+        }
+
+        block = ptr;
+      }
+      else
+      {
+        if (new_size > old_size)
+        {
+          size_t grow = new_size - old_size;
+          size_t reserved =
+            reserved_.fetch_add(grow, std::memory_order_relaxed);
+
+          if (reserved + grow > max_size_)
+          {
+            reserved_.fetch_sub(grow, std::memory_order_relaxed);
+            Logger::Assert(false, "Buffer overflow in allocator");
+            return nullptr;
+          }
+
+          reserved += grow;
+          size_t peak = peak_reserved_.load(std::memory_order_relaxed);
+
+          while (
+            reserved > peak &&
+            peak_reserved_.compare_exchange_weak(
+              peak,
+              reserved,
+              std::memory_order_relaxed) == false)
+          {
+          }
+        }
+
+        if (IsThreadSafe() == true)
+        {
+          block = ReallocateImpl(ptr, old_size, new_size, align);
+        }
+        else
+        {
+          std::lock_guard<RecursiveMutex> lock(mutex_);
+          block = ReallocateImpl(ptr, old_size, new_size, align);
+        }
+
+        if (block == nullptr)
+        {
+          if (new_size > old_size)
+          {
+            reserved_.fetch_sub(new_size - old_size, std::memory_order_relaxed);
+          }
+
+          return nullptr;
+        }
+
+        if (new_size < old_size)
+        {
+          reserved_.fetch_sub(old_size - new_size, std::memory_order_relaxed);
+        }
+      }
+
+      ThreadCache* cache = nullptr;
+      ThreadCache::Slot* slot = nullptr;
+
+      if (
+        thread_cached_ == true &&
+        (cache = ThreadCache::Get()) != nullptr &&
+        (slot = cache->Find(this)) != nullptr)
+      {
+        slot->counters->RecordReallocation(old_size, new_size, true);
+      }
+      else
+      {
+        shared_.RecordReallocation(old_size, new_size, false);
+      }
+
+      return block;
+    }
+
+    //--------------------------------------------------------------------------
+    void* IAllocator::ReallocateImpl(
+      void* /*ptr*/,
+      size_t /*old_size*/,
+      size_t /*new_size*/,
+      size_t /*align*/)
+    {
+      return nullptr;
+    }
+
+    //--------------------------------------------------------------------------
+    bool IAllocator::IsThreadSafe() const
+    {
+      return false;
+    }
+
+    //--------------------------------------------------------------------------
+    void* IAllocator::AllocateBlock(size_t size, size_t align)
+    {
+      size_t reserved = reserved_.fetch_add(size, std::memory_order_relaxed);
+
+      if (reserved + size > max_size_)
+      {
+        reserved_.fetch_sub(size, std::memory_order_relaxed);
         Logger::Assert(false, "Buffer overflow in allocator");
         return nullptr;
       }
 
-      allocated_ += size;
-      ++open_allocations_;
+      reserved += size;
+      size_t peak = peak_reserved_.load(std::memory_order_relaxed);
+
+      while (
+        reserved > peak &&
+        peak_reserved_.compare_exchange_weak(
+          peak,
+          reserved,
+          std::memory_order_relaxed) == false)
+      {
+      }
+
+      void* ptr = nullptr;
+
+      if (IsThreadSafe() == true)
+      {
+        ptr = AllocateImpl(size, align);
+      }
+      else
+      {
+        std::lock_guard<RecursiveMutex> lock(mutex_);
+        ptr = AllocateImpl(size, align);
+      }
+
+      if (ptr == nullptr)
+      {
+        reserved_.fetch_sub(size, std::memory_order_relaxed);
+      }
 
-      return AllocateImpl(size, align);
+      return ptr;
     }
 
     //--------------------------------------------------------------------------
-    size_t IAllocator::Deallocate(void* ptr)
+    void IAllocator::DeallocateBlock(void* ptr, size_t size)
     {
-      std::lock_guard<std::recursive_mutex> lock(mutex_);
+      size_t deallocated = 0;
 
-      size_t deallocated = DeallocateImpl(ptr);
+      if (IsThreadSafe() == true)
+      {
+        deallocated = DeallocateImpl(ptr);
+      }
+      else
+      {
+        std::lock_guard<RecursiveMutex> lock(mutex_);
+        deallocated = DeallocateImpl(ptr);
+      }
 
       if (max_size_ < deallocated)
       {
-        Logger::Assert(false, 
+        Logger::Assert(false,
           "Attempted to deallocate more than was ever allocated");
-        return 0;
+        return;
       }
 
-      allocated_ -= deallocated;
-      --open_allocations_;
+      reserved_.fetch_sub(size, std::memory_order_relaxed);
+    }
+
+    //--------------------------------------------------------------------------
+    void IAllocator::Refill(ThreadCache::FreeList& list, size_t size_class)
+    {
+      std::lock_guard<RecursiveMutex> lock(mutex_);
+
+      ThreadCache::FreeList& depot = depot_[size_class];
+      size_t block_size = ThreadCache::ClassSize(size_class);
+
+      void* block = nullptr;
+
+      while (list.count < ThreadCache::kBatchSize)
+      {
+        if ((block = depot.Pop()) == nullptr)
+        {
+          block = AllocateBlock(block_size, block_size);
+        }
+
+        if (block == nullptr)
+        {
+          return;
+        }
+
+        list.Push(block);
+      }
+    }
+
+    //--------------------------------------------------------------------------
+    void IAllocator::Flush(
+      ThreadCache::FreeList& list,
+      size_t size_class,
+      size_t keep)
+    {
+      std::lock_guard<RecursiveMutex> lock(mutex_);
+
+      ThreadCache::FreeList& depot = depot_[size_class];
+
+      while (list.count > keep)
+      {
+        depot.Push(list.Pop());
+      }
+    }
+
+    //--------------------------------------------------------------------------
+    void IAllocator::Trim()
+    {
+      ThreadCache* cache = ThreadCache::current_;
+
+      if (cache != nullptr)
+      {
+        cache->Evict(this);
+      }
+
+      std::lock_guard<RecursiveMutex> lock(mutex_);
+
+      void* block = nullptr;
+
+      for (size_t i = 0; i < ThreadCache::kNumSizeClasses; ++i)
+      {
+        ThreadCache::FreeList& depot = depot_[i];
+        while ((block = depot.Pop()) != nullptr)
+        {
+          DeallocateBlock(block, ThreadCache::ClassSize(i));
+        }
+      }
+    }
+
+    //--------------------------------------------------------------------------
+    AllocatorCounters* IAllocator::AcquireCounters()
+    {
+      AllocatorCounters* c = counters_.load(std::memory_order_acquire);
+
+      bool expected = false;
+      while (c != nullptr)
+      {
+        expected = false;
+        if (c->in_use.compare_exchange_strong(
+          expected,
+          true,
+          std::memory_order_acquire) == true)
+        {
+          return c;
+        }
+
+        c = c->next;
+      }
+
+      void* block = malloc(sizeof(AllocatorCounters));
+
+      if (block == nullptr)
+      {
+        return nullptr;
+      }
+
+      c = new (block) AllocatorCounters();
+      c->in_use.store(true, std::memory_order_relaxed);
+
+      AllocatorCounters* head = counters_.load(std::memory_order_relaxed);
+
+      do
+      {
+        c->next = head;
+      }
+      while (counters_.compare_exchange_weak(
+        head,
+        c,
+        std::memory_order_release,
+        std::memory_order_relaxed) == false);
 
-      return deallocated;
+      return c;
     }
   }
 }
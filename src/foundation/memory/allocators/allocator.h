@@ -1,8 +1,12 @@
 #pragma once
 
+#include "foundation/memory/allocators/thread_cache.h"
+#include "foundation/auxiliary/mutex.h"
+
 #include <cinttypes>
 #include <cstddef>
 #include <mutex>
+#include <atomic>
 
 namespace snuffbox
 {
@@ -13,16 +17,29 @@ namespace snuffbox
 
     /**
     * @brief The base class for every allocator to inherit from
-    * 
+    *
     * This allocator does tracking of the memory size allocated and how much
     * open allocations there are. It will check for any memory leaks on shutdown
     * of the application. This however means that the application needs to be
     * shutdown properly.
     *
-    * Allocators are thread-safe as there is a mutex that locks the allocator
-    * for both Allocator::Allocate and Allocator::Deallocate
+    * Allocators are thread-safe. The bookkeeping is done with atomics and
+    * calls into the underlying implementation are locked with a mutex, unless
+    * the implementation reports that it is thread-safe by itself through
+    * IAllocator::IsThreadSafe.
+    *
+    * Allocators can be constructed as thread-cached. Small blocks are then
+    * served from per-thread free lists in a ThreadCache, and the counters are
+    * kept per thread and summed when they are requested. The mutex is only
+    * taken when blocks are handed between a thread and the allocator in
+    * batches.
+    *
+    * Every allocator registers itself in the AllocatorRegistry, which can
+    * be used to inspect the statistics of all allocators at once.
     *
     * @see Memory
+    * @see ThreadCache
+    * @see AllocatorRegistry
     *
     * @author Daniel Konings
     */
@@ -30,15 +47,58 @@ namespace snuffbox
     {
 
       friend class Memory;
+      friend class ThreadCache;
+      friend class AllocatorRegistry;
 
     public:
 
+      /**
+      * @brief A snapshot of the statistics of an allocator
+      *
+      * @see IAllocator::statistics
+      *
+      * @author Daniel Konings
+      */
+      struct Statistics
+      {
+        const char* name; //!< The name of the allocator
+        size_t open_allocations; //!< The number of open allocations
+        size_t allocated; //!< The currently allocated size
+        size_t reserved; //!< The size drawn from the implementation
+        size_t peak_allocated; //!< The highest allocated size seen
+        size_t peak_reserved; //!< The highest reserved size
+        uint64_t allocations; //!< The total number of allocations
+        uint64_t allocated_total; //!< The total allocated size
+        uint64_t frame_allocations; //!< The allocations of the last frame
+        uint64_t frame_allocated; //!< The size allocated in the last frame
+        uint64_t peak_frame_allocations; //!< The most allocations in a frame
+        uint64_t peak_frame_allocated; //!< The most allocated in a frame
+
+        /**
+        * @brief The number of allocations per size bucket
+        *
+        * @see AllocatorCounters::SizeBucket
+        */
+        uint64_t sizes[AllocatorCounters::kNumSizeBuckets];
+
+        /**
+        * @brief The number of deallocations per lifetime bucket
+        *
+        * @see AllocatorCounters::LifetimeBucket
+        */
+        uint64_t lifetimes[AllocatorCounters::kNumLifetimeBuckets];
+      };
+
       /**
       * @brief Construct the allocator with a maximum size
       *
       * @param[in] max_size The maximum size that can be allocated
+      * @param[in] thread_cached Should small blocks be cached per thread?
+      *
+      * @remarks A thread-cached allocator should outlive every thread that
+      *          allocates through it
       */
-      IAllocator(size_t max_size);
+      IAllocator(size_t max_size, bool thread_cached = false);
 
       /**
       * @brief Delete the copy constructor
@@ -51,18 +111,63 @@ namespace snuffbox
       IAllocator(const IAllocator&& other) = delete;
 
       /**
-      * @return The number of open allocations in this allocator 
+      * @return The name of this allocator
+      */
+      const char* name() const;
+
+      /**
+      * @brief Sets the name of this allocator, as shown in the statistics
+      *
+      * @param[in] name The name to set, this string should outlive
+      *                 the allocator
+      */
+      void set_name(const char* name);
+
+      /**
+      * @return The number of open allocations in this allocator
+      *
+      * @remarks For thread-cached allocators this sums the counters of every
+      *          thread, which makes this a relatively slow call
       */
       size_t open_allocations() const;
 
       /**
       * @return The amount of memory that is currently allocated
+      *
+      * @see IAllocator::open_allocations
       */
       size_t allocated() const;
 
+      /**
+      * @return The amount of memory that is currently drawn from the
+      *         underlying implementation, including the thread caches
+      */
+      size_t reserved() const;
+
+      /**
+      * @return Are small blocks cached per thread in this allocator?
+      */
+      bool thread_cached() const;
+
+      /**
+      * @return The highest amount of memory that was drawn from the
+      *         underlying implementation at once
+      */
+      size_t peak_reserved() const;
+
+      /**
+      * @brief Sums the counters of this allocator into a snapshot
+      *
+      * @remarks The frame statistics and the peak allocated size are only
+      *          updated by AllocatorRegistry::EndFrame
+      *
+      * @return The statistics of this allocator
+      */
+      Statistics statistics() const;
+
       /**
       * @brief Default destructor
-      * 
+      *
       * Checks for any leaks in the allocator
       */
       virtual ~IAllocator();
@@ -74,10 +179,11 @@ namespace snuffbox
       *
       * This function calls the underlying implementation of the allocator that
       * derived from this Allocator base. (Allocator::AllocateImpl)
-      * Calling allocations through these functions guarantee 
+      * Calling allocations through these functions guarantee
       * memory bookmarking.
       *
-      * @remarks This function locks the Allocator::mutex_ mutex
+      * @remarks Small allocations of a thread-cached allocator are served
+      *          from the ThreadCache of the calling thread
       *
       * @param[in] size The size of the allocation
       * @param[in] align The alignment of the allocation
@@ -91,16 +197,36 @@ namespace snuffbox
       *
       * This function calls the underlying implementation of the allocator that
       * derived from this Allocator base. (Allocator::DeallocateImpl)
-      * Calling allocations through these functions guarantee 
+      * Calling allocations through these functions guarantee
       * memory bookmarking.
       *
-      * @remarks This function locks the Allocator::mutex_ mutex
-      *
       * @param[in] ptr The pointer to the memory chunk to deallocate
+      * @param[in] size The size that was passed to IAllocator::Allocate
+      * @param[in] lifetime The number of frames the memory was alive
+      */
+      void Deallocate(void* ptr, size_t size, uint32_t lifetime = 0);
+
+      /**
+      * @brief Resizes a previously allocated chunk of memory, preserving
+      *        its contents
+      *
+      * Blocks that stay within the same size class of a thread cache are
+      * resized without touching the underlying implementation, other blocks
+      * are resized through IAllocator::ReallocateImpl.
+      *
+      * @param[in] ptr The pointer to the memory chunk to resize
+      * @param[in] old_size The size that was passed to IAllocator::Allocate
+      * @param[in] new_size The new size of the chunk
+      * @param[in] align The alignment of the allocation
       *
-      * @return The size that was freed during the allocation
+      * @return The resized chunk, or nullptr if the chunk could not be
+      *         resized; the original chunk is then left untouched
       */
-      size_t Deallocate(void* ptr);
+      void* Reallocate(
+        void* ptr,
+        size_t old_size,
+        size_t new_size,
+        size_t align);
 
       /**
       * @see Allocator::Allocate
@@ -112,13 +238,149 @@ namespace snuffbox
       */
       virtual size_t DeallocateImpl(void* ptr) = 0;
 
+      /**
+      * @brief Resizes a block of the underlying implementation
+      *
+      * The block may be grown or shrunk in place, or be moved to a new
+      * address as long as its contents are preserved.
+      *
+      * @remarks The base implementation does not support reallocation and
+      *          always returns nullptr
+      *
+      * @see Allocator::Reallocate
+      *
+      * @return The resized block, or nullptr if the block could not be
+      *         resized; the original block should then be left untouched
+      */
+      virtual void* ReallocateImpl(
+        void* ptr,
+        size_t old_size,
+        size_t new_size,
+        size_t align);
+
+      /**
+      * @brief Can the underlying implementation be called from multiple
+      *        threads at once without locking?
+      *
+      * @remarks The base implementation returns false
+      *
+      * @return Is the implementation thread-safe?
+      */
+      virtual bool IsThreadSafe() const;
+
+      /**
+      * @brief Draws a block from the underlying implementation, checking
+      *        the maximum size of the allocator
+      *
+      * @param[in] size The size of the block
+      * @param[in] align The alignment of the block
+      *
+      * @return The block, or nullptr if the allocator is out of memory
+      */
+      void* AllocateBlock(size_t size, size_t align);
+
+      /**
+      * @brief Returns a block to the underlying implementation
+      *
+      * @param[in] ptr The block to return
+      * @param[in] size The size the block was drawn with
+      */
+      void DeallocateBlock(void* ptr, size_t size);
+
+      /**
+      * @brief Refills a thread's free list from the depot of this allocator,
+      *        drawing new blocks if the depot is empty
+      *
+      * @param[in] list The free list to refill
+      * @param[in] size_class The size class of the list
+      */
+      void Refill(ThreadCache::FreeList& list, size_t size_class);
+
+      /**
+      * @brief Hands blocks of a thread's free list back to the depot of
+      *        this allocator
+      *
+      * @param[in] list The free list to flush
+      * @param[in] size_class The size class of the list
+      * @param[in] keep The number of blocks to keep in the thread's list
+      */
+      void Flush(ThreadCache::FreeList& list, size_t size_class, size_t keep);
+
+      /**
+      * @brief Returns the blocks cached by the calling thread and the depot
+      *        to the underlying implementation
+      *
+      * @remarks Derived allocators should call this from their destructor,
+      *          as the implementation is no longer available in the
+      *          destructor of IAllocator
+      */
+      void Trim();
+
+      /**
+      * @brief Claims a set of per-thread counters, re-using the counters of
+      *        an exited thread where possible
+      *
+      * @return The claimed counters
+      */
+      AllocatorCounters* AcquireCounters();
+
     private:
 
+      const char* name_; //!< The name of this allocator
       size_t max_size_; //!< The maximum size that can be allocated
-      size_t open_allocations_; //!< The number of open allocations
-      size_t allocated_; //!< The amount of memory that is currently allocated
+      bool thread_cached_; //!< Are small blocks cached per thread?
+      uint64_t id_; //!< The unique ID of this allocator
+
+      /**
+      * @brief The counters of allocations that were not counted by
+      *        a thread cache
+      */
+      AllocatorCounters shared_;
+
+      /**
+      * @brief The amount of memory drawn from the underlying implementation
+      */
+      std::atomic<size_t> reserved_;
+
+      std::atomic<size_t> peak_reserved_; //!< The highest reserved size
+
+      /**
+      * @brief The per-thread counters of every thread that used this
+      *        allocator through a thread cache
+      */
+      std::atomic<AllocatorCounters*> counters_;
+
+      /**
+      * @brief The statistics that are updated once per frame
+      *
+      * @see AllocatorRegistry::EndFrame
+      */
+      struct FrameStatistics
+      {
+        uint64_t last_allocations; //!< The total allocations at frame start
+        uint64_t last_allocated; //!< The total allocated at frame start
+        uint64_t allocations; //!< The allocations of the last frame
+        uint64_t allocated; //!< The size allocated in the last frame
+        uint64_t peak_allocations; //!< The most allocations in a frame
+        uint64_t peak_allocated; //!< The most allocated in a frame
+        size_t peak_usage; //!< The highest allocated size seen
+      };
+
+      FrameStatistics frame_; //!< The frame statistics, guarded by the registry
+
+      IAllocator* prev_; //!< The previous allocator in the registry
+      IAllocator* next_; //!< The next allocator in the registry
+
+      /**
+      * @brief The blocks that were handed back by threads, per size class
+      *
+      * @remarks Guarded by IAllocator::mutex_
+      */
+      ThreadCache::FreeList depot_[ThreadCache::kNumSizeClasses];
+
+      RecursiveMutex mutex_; //!< The mutex for thread-safe allocations
 
-      std::recursive_mutex mutex_; //!< The mutex for thread-safe allocations
+      static std::atomic<uint64_t> next_id_; //!< The next allocator ID
     };
   }
 }
@@ -0,0 +1,118 @@
+#include "foundation/memory/allocators/allocator_counters.h"
+
+namespace snuffbox
+{
+  namespace foundation
+  {
+    //--------------------------------------------------------------------------
+    const size_t AllocatorCounters::kNumSizeBuckets;
+    const size_t AllocatorCounters::kNumLifetimeBuckets;
+
+    //--------------------------------------------------------------------------
+    AllocatorCounters::AllocatorCounters() :
+      open_allocations(0),
+      allocated(0),
+      allocations(0),
+      allocated_total(0),
+      in_use(false),
+      next(nullptr)
+    {
+      for (size_t i = 0; i < kNumSizeBuckets; ++i)
+      {
+        sizes[i].store(0, std::memory_order_relaxed);
+      }
+
+      for (size_t i = 0; i < kNumLifetimeBuckets; ++i)
+      {
+        lifetimes[i].store(0, std::memory_order_relaxed);
+      }
+    }
+
+    //--------------------------------------------------------------------------
+    void AllocatorCounters::RecordAllocation(size_t size, bool exclusive)
+    {
+      Add<int64_t>(open_allocations, 1, exclusive);
+      Add<int64_t>(allocated, static_cast<int64_t>(size), exclusive);
+      Add<uint64_t>(allocations, 1, exclusive);
+      Add<uint64_t>(allocated_total, size, exclusive);
+      Add<uint64_t>(sizes[SizeBucket(size)], 1, exclusive);
+    }
+
+    //--------------------------------------------------------------------------
+    void AllocatorCounters::RecordDeallocation(
+      size_t size,
+      uint32_t lifetime,
+      bool exclusive)
+    {
+      Add<int64_t>(open_allocations, -1, exclusive);
+      Add<int64_t>(allocated, -static_cast<int64_t>(size), exclusive);
+      Add<uint64_t>(lifetimes[LifetimeBucket(lifetime)], 1, exclusive);
+    }
+
+    //--------------------------------------------------------------------------
+    void AllocatorCounters::RecordReallocation(
+      size_t old_size,
+      size_t new_size,
+      bool exclusive)
+    {
+      int64_t delta =
+        static_cast<int64_t>(new_size) - static_cast<int64_t>(old_size);
+
+      Add<int64_t>(allocated, delta, exclusive);
+      Add<uint64_t>(allocations, 1, exclusive);
+      Add<uint64_t>(allocated_total, new_size, exclusive);
+      Add<uint64_t>(sizes[SizeBucket(new_size)], 1, exclusive);
+    }
+
+    //--------------------------------------------------------------------------
+    size_t AllocatorCounters::SizeBucket(size_t size)
+    {
+      size_t bucket = 0;
+      size_t bound = SizeBucketBound(0);
+
+      while (bound < size && bucket < kNumSizeBuckets - 1)
+      {
+        bound <<= 1;
+        ++bucket;
+      }
+
+      return bucket;
+    }
+
+    //--------------------------------------------------------------------------
+    size_t AllocatorCounters::SizeBucketBound(size_t bucket)
+    {
+      if (bucket >= kNumSizeBuckets - 1)
+      {
+        return 0;
+      }
+
+      return static_cast<size_t>(16) << bucket;
+    }
+
+    //--------------------------------------------------------------------------
+    size_t AllocatorCounters::LifetimeBucket(uint32_t lifetime)
+    {
+      size_t bucket = 0;
+
+      while (lifetime > 0 && bucket < kNumLifetimeBuckets - 1)
+      {
+        lifetime >>= 1;
+        ++bucket;
+      }
+
+      return bucket;
+    }
+
+    //--------------------------------------------------------------------------
+    uint32_t AllocatorCounters::LifetimeBucketBound(size_t bucket)
+    {
+      if (bucket == 0)
+      {
+        return 0;
+      }
+
+      return static_cast<uint32_t>(1) << (bucket - 1);
+    }
+  }
+}
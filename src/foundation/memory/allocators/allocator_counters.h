@@ -0,0 +1,165 @@
+#pragma once
+
+#include <cinttypes>
+#include <cstddef>
+#include <atomic>
+
+namespace snuffbox
+{
+  namespace foundation
+  {
+    /**
+    * @brief The allocation counters of an allocator, or of a single thread
+    *        in a thread-cached allocator
+    *
+    * Next to the open allocations and allocated size, the counters keep
+    * monotonic totals and histograms of the allocation sizes and lifetimes.
+    * Lifetimes are measured in frames, see AllocatorRegistry::EndFrame.
+    *
+    * Counters that are owned by a single thread are updated without atomic
+    * read-modify-write operations, shared counters use atomic additions.
+    * As memory can be freed on a different thread than the one it was
+    * allocated on, the open allocations and allocated size are signed.
+    *
+    * @see IAllocator
+    * @see ThreadCache
+    *
+    * @author Daniel Konings
+    */
+    struct AllocatorCounters
+    {
+      /**
+      * @brief The number of size buckets, starting at 16 bytes and doubling
+      *        with every bucket, the last bucket contains all larger sizes
+      */
+      static const size_t kNumSizeBuckets = 16;
+
+      /**
+      * @brief The number of lifetime buckets, the first bucket contains the
+      *        allocations freed in the same frame, the next buckets double
+      *        in frame count and the last bucket contains all the rest
+      */
+      static const size_t kNumLifetimeBuckets = 12;
+
+      /**
+      * @brief Zero-initializes all counters
+      */
+      AllocatorCounters();
+
+      /**
+      * @brief Records an allocation
+      *
+      * @param[in] size The size of the allocation
+      * @param[in] exclusive Is only the calling thread writing the counters?
+      */
+      void RecordAllocation(size_t size, bool exclusive);
+
+      /**
+      * @brief Records a deallocation
+      *
+      * @param[in] size The size of the allocation
+      * @param[in] lifetime The number of frames the allocation was alive
+      * @param[in] exclusive Is only the calling thread writing the counters?
+      */
+      void RecordDeallocation(size_t size, uint32_t lifetime, bool exclusive);
+
+      /**
+      * @brief Records a reallocation, which counts as an allocation of the
+      *        new size without opening a new allocation
+      *
+      * @param[in] old_size The previous size of the allocation
+      * @param[in] new_size The new size of the allocation
+      * @param[in] exclusive Is only the calling thread writing the counters?
+      */
+      void RecordReallocation(
+        size_t old_size,
+        size_t new_size,
+        bool exclusive);
+
+      /**
+      * @brief Retrieves the size bucket an allocation size falls into
+      *
+      * @param[in] size The size of the allocation
+      *
+      * @return The bucket index
+      */
+      static size_t SizeBucket(size_t size);
+
+      /**
+      * @brief Retrieves the upper bound of a size bucket
+      *
+      * @param[in] bucket The bucket index
+      *
+      * @return The maximum size in the bucket, or 0 for the last bucket
+      */
+      static size_t SizeBucketBound(size_t bucket);
+
+      /**
+      * @brief Retrieves the lifetime bucket a number of frames falls into
+      *
+      * @param[in] lifetime The lifetime in frames
+      *
+      * @return The bucket index
+      */
+      static size_t LifetimeBucket(uint32_t lifetime);
+
+      /**
+      * @brief Retrieves the lower bound of a lifetime bucket
+      *
+      * @param[in] bucket The bucket index
+      *
+      * @return The minimum lifetime in frames in the bucket
+      */
+      static uint32_t LifetimeBucketBound(size_t bucket);
+
+      /**
+      * @brief Adds a value to a counter
+      *
+      * @tparam T The value type of the counter
+      *
+      * @param[in] counter The counter to add to
+      * @param[in] value The value to add
+      * @param[in] exclusive Is only the calling thread writing the counter?
+      */
+      template <typename T>
+      static void Add(std::atomic<T>& counter, T value, bool exclusive);
+
+      std::atomic<int64_t> open_allocations; //!< The open allocations
+      std::atomic<int64_t> allocated; //!< The allocated size
+      std::atomic<uint64_t> allocations; //!< The total number of allocations
+      std::atomic<uint64_t> allocated_total; //!< The total allocated size
+
+      /**
+      * @brief The number of allocations per size bucket
+      */
+      std::atomic<uint64_t> sizes[kNumSizeBuckets];
+
+      /**
+      * @brief The number of deallocations per lifetime bucket
+      */
+      std::atomic<uint64_t> lifetimes[kNumLifetimeBuckets];
+
+      std::atomic<bool> in_use; //!< Is a thread using these counters?
+      AllocatorCounters* next; //!< The next counters in the allocator
+    };
+
+    //--------------------------------------------------------------------------
+    template <typename T>
+    inline void AllocatorCounters::Add(
+      std::atomic<T>& counter,
+      T value,
+      bool exclusive)
+    {
+      if (exclusive == true)
+      {
+        counter.store(
+          counter.load(std::memory_order_relaxed) + value,
+          std::memory_order_relaxed);
+
+        return;
+      }
+
+      counter.fetch_add(value, std::memory_order_relaxed);
+    }
+  }
+}
@@ -25,6 +25,15 @@ namespace snuffbox
 #endif
     }
 
+    //--------------------------------------------------------------------------
+    EASTLAllocator::EASTLAllocator(IAllocator& allocator, const char* pName) :
+      allocator_(allocator)
+    {
+#if EASTL_NAME_ENABLED
+      mpName = pName ? pName : EASTL_ALLOCATOR_DEFAULT_NAME;
+#endif
+    }
+
     //--------------------------------------------------------------------------
     EASTLAllocator::~EASTLAllocator()
     {
@@ -40,13 +49,13 @@ namespace snuffbox
     //--------------------------------------------------------------------------
     bool EASTLAllocator::operator==(const EASTLAllocator& x)
     {
-      return true;
+      return &allocator_ == &x.allocator_;
     }
 
     //--------------------------------------------------------------------------
     bool EASTLAllocator::operator!=(const EASTLAllocator& x)
     {
-      return false;
+      return &allocator_ != &x.allocator_;
     }
 
     //--------------------------------------------------------------------------
@@ -85,5 +94,21 @@ namespace snuffbox
       return "Custom EASTL allocator";
 #endif
     }
+
+    //--------------------------------------------------------------------------
+    FrameEASTLAllocator::FrameEASTLAllocator(const char* pName) :
+      EASTLAllocator(Memory::frame_allocator(), pName)
+    {
+
+    }
+
+    //--------------------------------------------------------------------------
+    FrameEASTLAllocator::FrameEASTLAllocator(
+      const eastl::allocator& x,
+      const char* pName) :
+      EASTLAllocator(Memory::frame_allocator(), pName)
+    {
+
+    }
   }
 }
\ No newline at end of file
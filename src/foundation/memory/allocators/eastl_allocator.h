@@ -52,16 +52,16 @@ namespace snuffbox
       EASTLAllocator& operator=(const EASTLAllocator& x);
 
       /**
-      * @brief Comparison operator, always returns true
+      * @brief Comparison operator
       *
       * @param[in] x The allocator to compare against
       *
-      * @return Always true, as there is only 1 EASTLAllocator
+      * @return Do both allocators use the same underlying IAllocator?
       */
       bool operator==(const EASTLAllocator& x);
 
       /**
-      * @brief Comparison operator, always returns false
+      * @brief Inverse comparison operator
       *
       * @see EASTLAllocator::operator==
       */
@@ -115,8 +115,48 @@ namespace snuffbox
 
     protected:
 
+      /**
+      * @brief Construct an EASTL allocator that uses a specific IAllocator
+      *
+      * @param[in] allocator The underlying allocator to use
+      * @param[in] pName The name for debugging
+      */
+      EASTLAllocator(IAllocator& allocator, const char* pName);
+
       const char* mpName; //!< The debug name of this allocator
       IAllocator& allocator_; //!< A reference to the underlying IAllocator
     };
+
+    /**
+    * @brief An EASTL allocator that allocates from the frame allocator
+    *
+    * Containers using this allocator should not outlive the frame they
+    * were created in, as the frame allocator is reset every frame.
+    *
+    * @see Memory::frame_allocator
+    *
+    * @author Daniel Konings
+    */
+    class FrameEASTLAllocator : public EASTLAllocator
+    {
+    public:
+
+      /**
+      * @brief Construct a frame EASTL allocator with a name
+      *
+      * @param[in] pName The name for debugging
+      */
+      FrameEASTLAllocator(const char* pName = "FrameEASTLAllocator");
+
+      /**
+      * @brief Copy constructor
+      *
+      * @param[in] x The allocator to copy from
+      * @param[in] pName The name for debugging
+      */
+      FrameEASTLAllocator(
+        const eastl::allocator& x,
+        const char* pName = "FrameEASTLAllocator");
+    };
   }
 }
\ No newline at end of file
@@ -0,0 +1,264 @@
+#include "foundation/memory/allocators/linear_allocator.h"
+#include "foundation/auxiliary/pointer_math.h"
+#include "foundation/auxiliary/logger.h"
+
+#include <cstdlib>
+
+namespace snuffbox
+{
+  namespace foundation
+  {
+    //--------------------------------------------------------------------------
+    const size_t LinearAllocator::kMaxBuffers_;
+
+    //--------------------------------------------------------------------------
+    LinearAllocator::LinearAllocator(size_t buffer_size, const char* name) :
+      LinearAllocator(buffer_size, 1, name)
+    {
+
+    }
+
+    //--------------------------------------------------------------------------
+    LinearAllocator::LinearAllocator(
+      size_t buffer_size,
+      size_t num_buffers,
+      const char* name) :
+      IAllocator(~static_cast<size_t>(0)),
+      buffer_size_(buffer_size),
+      num_buffers_(num_buffers),
+      current_(0),
+      overflow_(0)
+    {
+      set_name(name);
+
+      Logger::Assert(
+        num_buffers_ > 0 && num_buffers_ <= kMaxBuffers_,
+        "Invalid number of buffers for a linear allocator");
+
+      for (size_t i = 0; i < kMaxBuffers_; ++i)
+      {
+        Buffer& buffer = buffers_[i];
+
+        buffer.block = i < num_buffers_ ?
+          static_cast<uint8_t*>(malloc(buffer_size_)) :
+          nullptr;
+
+        buffer.offset.store(0, std::memory_order_relaxed);
+        buffer.open_allocations.store(0, std::memory_order_relaxed);
+      }
+    }
+
+    //--------------------------------------------------------------------------
+    LinearAllocator::~LinearAllocator()
+    {
+      for (size_t i = 0; i < kMaxBuffers_; ++i)
+      {
+        free(buffers_[i].block);
+        buffers_[i].block = nullptr;
+      }
+    }
+
+    //--------------------------------------------------------------------------
+    void LinearAllocator::Reset()
+    {
+      size_t next = (current_.load(std::memory_order_relaxed) + 1) %
+        num_buffers_;
+
+      Buffer& buffer = buffers_[next];
+
+      Logger::Assert(
+        buffer.open_allocations.load(std::memory_order_acquire) == 0,
+        "Linear allocations outlived the buffer they were allocated from");
+
+      size_t overflow = overflow_.exchange(0, std::memory_order_relaxed);
+
+      if (overflow > 0)
+      {
+        Logger::LogVerbosity<1>(
+          LogChannel::kUnspecified,
+          LogSeverity::kWarning,
+          "A linear allocator of {0} bytes overflowed by {1} bytes",
+          buffer_size_,
+          overflow);
+      }
+
+      buffer.offset.store(0, std::memory_order_relaxed);
+      current_.store(next, std::memory_order_release);
+    }
+
+    //--------------------------------------------------------------------------
+    size_t LinearAllocator::used() const
+    {
+      return buffers_[current_.load(std::memory_order_acquire)].offset.load(
+        std::memory_order_relaxed);
+    }
+
+    //--------------------------------------------------------------------------
+    size_t LinearAllocator::buffer_size() const
+    {
+      return buffer_size_;
+    }
+
+    //--------------------------------------------------------------------------
+    void* LinearAllocator::AllocateImpl(size_t size, size_t align)
+    {
+      Buffer& buffer = buffers_[current_.load(std::memory_order_acquire)];
+      size_t header_size = sizeof(AllocationHeader);
+
+      size_t offset = buffer.offset.load(std::memory_order_relaxed);
+      size_t start = 0;
+      size_t end = 0;
+
+      bool fits = buffer.block != nullptr;
+
+      while (fits == true)
+      {
+        start = offset + PointerMath::AlignDelta(
+          buffer.block + offset + header_size,
+          align);
+
+        end = start + header_size + size;
+
+        if (end > buffer_size_)
+        {
+          fits = false;
+          break;
+        }
+
+        if (buffer.offset.compare_exchange_weak(
+          offset,
+          end,
+          std::memory_order_relaxed) == true)
+        {
+          break;
+        }
+      }
+
+      AllocationHeader* header = nullptr;
+
+      if (fits == true)
+      {
+        buffer.open_allocations.fetch_add(1, std::memory_order_relaxed);
+        header = reinterpret_cast<AllocationHeader*>(buffer.block + start);
+      }
+      else
+      {
+        overflow_.fetch_add(size, std::memory_order_relaxed);
+        header = static_cast<AllocationHeader*>(malloc(size + header_size));
+
+        if (header == nullptr)
+        {
+          return nullptr;
+        }
+      }
+
+      header->size = size;
+
+      return PointerMath::Offset(header, header_size);
+    }
+
+    //--------------------------------------------------------------------------
+    size_t LinearAllocator::DeallocateImpl(void* ptr)
+    {
+      intptr_t header_size = static_cast<intptr_t>(sizeof(AllocationHeader));
+
+      AllocationHeader* header = reinterpret_cast<AllocationHeader*>(
+        PointerMath::Offset(ptr, -header_size));
+
+      size_t size = header->size;
+
+      Buffer* buffer = FindBuffer(header);
+
+      if (buffer == nullptr)
+      {
+        free(header);
+        return size;
+      }
+
+      buffer->open_allocations.fetch_sub(1, std::memory_order_release);
+
+      return size;
+    }
+
+    //--------------------------------------------------------------------------
+    void* LinearAllocator::ReallocateImpl(
+      void* ptr,
+      size_t old_size,
+      size_t new_size,
+      size_t /*align*/)
+    {
+      intptr_t header_size = static_cast<intptr_t>(sizeof(AllocationHeader));
+
+      AllocationHeader* header = reinterpret_cast<AllocationHeader*>(
+        PointerMath::Offset(ptr, -header_size));
+
+      Buffer* buffer = FindBuffer(header);
+
+      if (buffer == nullptr)
+      {
+        return nullptr;
+      }
+
+      if (new_size <= old_size)
+      {
+        header->size = new_size;
+        return ptr;
+      }
+
+      size_t start = static_cast<uint8_t*>(ptr) - buffer->block;
+      size_t end = start + old_size;
+      size_t grown = start + new_size;
+
+      if (
+        buffer != &buffers_[current_.load(std::memory_order_acquire)] ||
+        grown > buffer_size_ ||
+        buffer->offset.compare_exchange_strong(
+          end,
+          grown,
+          std::memory_order_relaxed) == false)
+      {
+        return nullptr;
+      }
+
+      header->size = new_size;
+
+      return ptr;
+    }
+
+    //--------------------------------------------------------------------------
+    bool LinearAllocator::IsThreadSafe() const
+    {
+      return true;
+    }
+
+    //--------------------------------------------------------------------------
+    LinearAllocator::Buffer* LinearAllocator::FindBuffer(void* ptr)
+    {
+      uint8_t* p = static_cast<uint8_t*>(ptr);
+
+      for (size_t i = 0; i < num_buffers_; ++i)
+      {
+        Buffer& buffer = buffers_[i];
+
+        if (
+          buffer.block != nullptr &&
+          p >= buffer.block &&
+          p < buffer.block + buffer_size_)
+        {
+          return &buffer;
+        }
+      }
+
+      return nullptr;
+    }
+
+    //--------------------------------------------------------------------------
+    DoubleBufferedAllocator::DoubleBufferedAllocator(
+      size_t buffer_size,
+      const char* name) :
+      LinearAllocator(buffer_size, 2, name)
+    {
+
+    }
+  }
+}
@@ -0,0 +1,175 @@
+#pragma once
+
+#include "foundation/memory/allocators/allocator.h"
+
+namespace snuffbox
+{
+  namespace foundation
+  {
+    /**
+    * @brief A linear allocator that hands out memory from a pre-allocated
+    *        block by bumping an offset
+    *
+    * Deallocations do not return any memory to the block, instead the whole
+    * block is rewound at once with LinearAllocator::Reset. This makes the
+    * allocator suited for transient data that only lives for a single frame,
+    * such as scratch containers.
+    *
+    * The allocator can contain multiple buffers, where every reset moves on
+    * to the next buffer. Allocations are then valid until the allocator was
+    * reset once for every buffer. See DoubleBufferedAllocator.
+    *
+    * Allocation is lock-free. When the current buffer is exhausted, memory
+    * is drawn from malloc instead and a warning is logged on reset.
+    *
+    * @author Daniel Konings
+    */
+    class LinearAllocator : public IAllocator
+    {
+
+    public:
+
+      /**
+      * @brief Construct the allocator with a single buffer
+      *
+      * @param[in] buffer_size The size of the buffer in bytes
+      * @param[in] name The name of this allocator
+      */
+      LinearAllocator(size_t buffer_size, const char* name = "linear");
+
+      /**
+      * @brief Releases all buffers
+      */
+      ~LinearAllocator();
+
+      /**
+      * @brief Moves on to the next buffer and rewinds it
+      *
+      * Every allocation in the rewound buffer should have been deallocated
+      * before calling this function.
+      *
+      * @remarks This should not be called while other threads allocate
+      *          from this allocator
+      */
+      void Reset();
+
+      /**
+      * @return The number of bytes used in the current buffer
+      */
+      size_t used() const;
+
+      /**
+      * @return The size of a single buffer in bytes
+      */
+      size_t buffer_size() const;
+
+    protected:
+
+      /**
+      * @brief Construct the allocator with a number of buffers
+      *
+      * @param[in] buffer_size The size of every buffer in bytes
+      * @param[in] num_buffers The number of buffers to cycle through
+      * @param[in] name The name of this allocator
+      */
+      LinearAllocator(
+        size_t buffer_size,
+        size_t num_buffers,
+        const char* name);
+
+      /**
+      * @brief Used to keep track of an allocation done with this allocator
+      */
+      struct AllocationHeader
+      {
+        size_t size; //!< The size of the allocation
+      };
+
+      /**
+      * @brief A single buffer to allocate from
+      *
+      * @author Daniel Konings
+      */
+      struct Buffer
+      {
+        uint8_t* block; //!< The memory block of this buffer
+        std::atomic<size_t> offset; //!< The current offset in the block
+        std::atomic<int64_t> open_allocations; //!< The open allocations
+      };
+
+      /**
+      * @see IAllocator::Allocate
+      */
+      void* AllocateImpl(size_t size, size_t align) override;
+
+      /**
+      * @see IAllocator::Deallocate
+      */
+      size_t DeallocateImpl(void* ptr) override;
+
+      /**
+      * @see IAllocator::ReallocateImpl
+      *
+      * Blocks can always be shrunk in place, but can only be grown in place
+      * if they are the last allocation in the current buffer
+      */
+      void* ReallocateImpl(
+        void* ptr,
+        size_t old_size,
+        size_t new_size,
+        size_t align) override;
+
+      /**
+      * @see IAllocator::IsThreadSafe
+      */
+      bool IsThreadSafe() const override;
+
+      /**
+      * @brief Finds the buffer a pointer was allocated from
+      *
+      * @param[in] ptr The pointer to find the buffer of
+      *
+      * @return The buffer, or nullptr if the pointer was allocated with
+      *         the malloc fallback
+      */
+      Buffer* FindBuffer(void* ptr);
+
+      /**
+      * @brief The maximum number of buffers an allocator can contain
+      */
+      static const size_t kMaxBuffers_ = 2;
+
+    private:
+
+      size_t buffer_size_; //!< The size of a single buffer
+      size_t num_buffers_; //!< The number of buffers in use
+      Buffer buffers_[kMaxBuffers_]; //!< The buffers
+      std::atomic<size_t> current_; //!< The index of the current buffer
+      std::atomic<size_t> overflow_; //!< The bytes drawn from the fallback
+    };
+
+    /**
+    * @brief A linear allocator with two buffers, for transient data that
+    *        should stay alive for one extra frame
+    *
+    * @see LinearAllocator
+    *
+    * @author Daniel Konings
+    */
+    class DoubleBufferedAllocator : public LinearAllocator
+    {
+
+    public:
+
+      /**
+      * @brief Construct the allocator with two buffers
+      *
+      * @param[in] buffer_size The size of each buffer in bytes
+      * @param[in] name The name of this allocator
+      */
+      DoubleBufferedAllocator(
+        size_t buffer_size,
+        const char* name = "double_buffered");
+    };
+  }
+}
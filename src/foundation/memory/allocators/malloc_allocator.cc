@@ -9,10 +9,19 @@ namespace snuffbox
   namespace foundation
   {
     //--------------------------------------------------------------------------
-    MallocAllocator::MallocAllocator(size_t max_size) :
-      IAllocator(max_size)
+    MallocAllocator::MallocAllocator(
+      size_t max_size,
+      bool thread_cached,
+      const char* name) :
+      IAllocator(max_size, thread_cached)
     {
+      set_name(name);
+    }
 
+    //--------------------------------------------------------------------------
+    MallocAllocator::~MallocAllocator()
+    {
+      Trim();
     }
 
     //--------------------------------------------------------------------------
@@ -23,6 +32,11 @@ namespace snuffbox
       size_t total_size = size + header_size;
       void* base_addr = malloc(total_size);
 
+      if (base_addr == nullptr)
+      {
+        return nullptr;
+      }
+
       AllocationHeader header;
       header.size = size;
 
@@ -46,6 +60,36 @@ namespace snuffbox
       return size;
     }
 
+    //--------------------------------------------------------------------------
+    void* MallocAllocator::ReallocateImpl(
+      void* ptr,
+      size_t /*old_size*/,
+      size_t new_size,
+      size_t /*align*/)
+    {
+      intptr_t header_size = static_cast<intptr_t>(sizeof(AllocationHeader));
+
+      void* base_addr = realloc(
+        PointerMath::Offset(ptr, -header_size),
+        new_size + sizeof(AllocationHeader));
+
+      if (base_addr == nullptr)
+      {
+        return nullptr;
+      }
+
+      AllocationHeader* header = reinterpret_cast<AllocationHeader*>(base_addr);
+      header->size = new_size;
+
+      return PointerMath::Offset(base_addr, header_size);
+    }
+
+    //--------------------------------------------------------------------------
+    bool MallocAllocator::IsThreadSafe() const
+    {
+      return true;
+    }
+
     //--------------------------------------------------------------------------
     size_t MallocAllocator::GetSize(void* ptr)
     {
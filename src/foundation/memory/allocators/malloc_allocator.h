@@ -25,8 +25,20 @@ namespace snuffbox
       * @brief Initializes this allocator for use
       * 
       * @param[in] max_size The maximum size of this allocator
+      * @param[in] thread_cached Should small blocks be cached per thread?
+      * @param[in] name The name of this allocator
       */
-      MallocAllocator(size_t max_size);
+      MallocAllocator(
+        size_t max_size,
+        bool thread_cached = false,
+        const char* name = "malloc");
+
+      /**
+      * @brief Returns all cached blocks to the system
+      *
+      * @see IAllocator::Trim
+      */
+      ~MallocAllocator();
 
     protected:
 
@@ -50,6 +62,25 @@ namespace snuffbox
       */
       size_t DeallocateImpl(void* ptr) override;
 
+      /**
+      * @see IAllocator::ReallocateImpl
+      *
+      * Uses realloc, which can grow blocks in place and remaps large blocks
+      * instead of copying them
+      */
+      void* ReallocateImpl(
+        void* ptr,
+        size_t old_size,
+        size_t new_size,
+        size_t align) override;
+
+      /**
+      * @see IAllocator::IsThreadSafe
+      *
+      * Malloc and free are thread-safe, so no locking is required
+      */
+      bool IsThreadSafe() const override;
+
       /**
       * @brief Retrieves the size of the memory block at a pointer from
       *        the allocation header
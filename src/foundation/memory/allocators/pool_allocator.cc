@@ -0,0 +1,136 @@
+#include "foundation/memory/allocators/pool_allocator.h"
+#include "foundation/auxiliary/pointer_math.h"
+#include "foundation/auxiliary/logger.h"
+
+#include <cstdlib>
+
+namespace snuffbox
+{
+  namespace foundation
+  {
+    //--------------------------------------------------------------------------
+    const size_t PoolAllocator::kDefaultBlocksPerSlab_ = 256;
+    const size_t PoolAllocator::kBlockAlignment_ = 16;
+
+    //--------------------------------------------------------------------------
+    PoolAllocator::PoolAllocator(
+      size_t block_size,
+      const char* name,
+      size_t blocks_per_slab) :
+      IAllocator(~static_cast<size_t>(0)),
+      block_size_(block_size),
+      blocks_per_slab_(blocks_per_slab > 0 ? blocks_per_slab : 1),
+      num_slabs_(0),
+      slabs_(nullptr),
+      free_(nullptr)
+    {
+      set_name(name);
+
+      if (block_size_ < sizeof(void*))
+      {
+        block_size_ = sizeof(void*);
+      }
+
+      block_size_ += PointerMath::AlignDelta(
+        reinterpret_cast<void*>(block_size_),
+        kBlockAlignment_);
+    }
+
+    //--------------------------------------------------------------------------
+    PoolAllocator::~PoolAllocator()
+    {
+      void* slab = slabs_;
+      void* next = nullptr;
+
+      while (slab != nullptr)
+      {
+        next = *reinterpret_cast<void**>(slab);
+        free(slab);
+        slab = next;
+      }
+
+      slabs_ = nullptr;
+      free_ = nullptr;
+    }
+
+    //--------------------------------------------------------------------------
+    size_t PoolAllocator::block_size() const
+    {
+      return block_size_;
+    }
+
+    //--------------------------------------------------------------------------
+    size_t PoolAllocator::num_slabs() const
+    {
+      return num_slabs_;
+    }
+
+    //--------------------------------------------------------------------------
+    void* PoolAllocator::AllocateImpl(size_t size, size_t /*align*/)
+    {
+      if (size > block_size_)
+      {
+        Logger::Assert(false,
+          "Attempted to allocate more than the block size of a pool");
+        return nullptr;
+      }
+
+      if (free_ == nullptr && AllocateSlab() == false)
+      {
+        return nullptr;
+      }
+
+      void* block = free_;
+      free_ = *reinterpret_cast<void**>(block);
+
+      return block;
+    }
+
+    //--------------------------------------------------------------------------
+    size_t PoolAllocator::DeallocateImpl(void* ptr)
+    {
+      *reinterpret_cast<void**>(ptr) = free_;
+      free_ = ptr;
+
+      return block_size_;
+    }
+
+    //--------------------------------------------------------------------------
+    void* PoolAllocator::ReallocateImpl(
+      void* ptr,
+      size_t /*old_size*/,
+      size_t new_size,
+      size_t /*align*/)
+    {
+      return new_size <= block_size_ ? ptr : nullptr;
+    }
+
+    //--------------------------------------------------------------------------
+    bool PoolAllocator::AllocateSlab()
+    {
+      size_t header_size = kBlockAlignment_;
+      void* slab = malloc(header_size + block_size_ * blocks_per_slab_);
+
+      if (slab == nullptr)
+      {
+        return false;
+      }
+
+      *reinterpret_cast<void**>(slab) = slabs_;
+      slabs_ = slab;
+
+      uint8_t* blocks = static_cast<uint8_t*>(slab) + header_size;
+
+      for (size_t i = blocks_per_slab_; i > 0; --i)
+      {
+        void* block = blocks + (i - 1) * block_size_;
+        *reinterpret_cast<void**>(block) = free_;
+        free_ = block;
+      }
+
+      ++num_slabs_;
+
+      return true;
+    }
+  }
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "foundation/memory/allocators/allocator.h"
+
+namespace snuffbox
+{
+  namespace foundation
+  {
+    /**
+    * @brief A pool allocator that hands out fixed-size blocks from slabs
+    *
+    * Slabs are allocated with a fixed number of blocks each, and free blocks
+    * are kept in an intrusive free list. Deallocated blocks are re-used by
+    * the next allocation, so creating and destroying many objects of the
+    * same type does not fragment the heap and keeps them close together in
+    * memory. Slabs are only released when the allocator is destructed.
+    *
+    * @remarks Allocations larger than the block size are not supported
+    *
+    * @see Memory::pool_allocator
+    *
+    * @author Daniel Konings
+    */
+    class PoolAllocator : public IAllocator
+    {
+
+    public:
+
+      /**
+      * @brief Construct the allocator with a block size
+      *
+      * @param[in] block_size The size of a single block in bytes
+      * @param[in] name The name of this allocator
+      * @param[in] blocks_per_slab The number of blocks in a slab
+      */
+      PoolAllocator(
+        size_t block_size,
+        const char* name = "pool",
+        size_t blocks_per_slab = kDefaultBlocksPerSlab_);
+
+      /**
+      * @brief Releases all slabs
+      */
+      ~PoolAllocator();
+
+      /**
+      * @return The size of a single block in bytes
+      */
+      size_t block_size() const;
+
+      /**
+      * @return The number of slabs that were allocated
+      */
+      size_t num_slabs() const;
+
+    protected:
+
+      /**
+      * @see IAllocator::Allocate
+      */
+      void* AllocateImpl(size_t size, size_t align) override;
+
+      /**
+      * @see IAllocator::Deallocate
+      */
+      size_t DeallocateImpl(void* ptr) override;
+
+      /**
+      * @see IAllocator::ReallocateImpl
+      *
+      * Blocks can be resized in place as long as they fit the block size
+      */
+      void* ReallocateImpl(
+        void* ptr,
+        size_t old_size,
+        size_t new_size,
+        size_t align) override;
+
+      /**
+      * @brief Allocates a new slab and adds its blocks to the free list
+      *
+      * @return Was the slab allocated succesfully?
+      */
+      bool AllocateSlab();
+
+      /**
+      * @brief The default number of blocks in a slab
+      */
+      static const size_t kDefaultBlocksPerSlab_;
+
+      /**
+      * @brief The alignment of every block in the pool
+      */
+      static const size_t kBlockAlignment_;
+
+    private:
+
+      size_t block_size_; //!< The size of a single block
+      size_t blocks_per_slab_; //!< The number of blocks in a slab
+      size_t num_slabs_; //!< The number of allocated slabs
+
+      void* slabs_; //!< The list of allocated slabs
+      void* free_; //!< The first free block
+    };
+  }
+}
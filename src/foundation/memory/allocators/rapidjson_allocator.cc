@@ -10,7 +10,7 @@ namespace snuffbox
 
     //--------------------------------------------------------------------------
     RapidJsonStackAllocator::RapidJsonStackAllocator(size_t size) :
-      Memory::DefaultAllocator(size)
+      Memory::DefaultAllocator(size, false, "rapidjson")
     {
 
     }
@@ -24,24 +24,10 @@ namespace snuffbox
     //--------------------------------------------------------------------------
     void* RapidJsonStackAllocator::Realloc(
       void* original,
-      size_t original_size,
+      size_t /*original_size*/,
       size_t new_size)
     {
-      size_t old_size = GetSize(original);
-      void* block = Memory::Allocate(new_size, this);
-
-      if (new_size >= old_size)
-      {
-        memcpy(block, original, old_size);
-      }
-      else
-      {
-        memcpy(block, original, new_size);
-      }
-
-      Memory::Deallocate(original);
-
-      return block;
+      return Memory::Reallocate(original, new_size, this);
     }
 
     //--------------------------------------------------------------------------
@@ -0,0 +1,187 @@
+#include "foundation/memory/allocators/thread_cache.h"
+#include "foundation/memory/allocators/allocator.h"
+
+namespace snuffbox
+{
+  namespace foundation
+  {
+    //--------------------------------------------------------------------------
+    const size_t ThreadCache::kBatchSize = 32;
+
+    //--------------------------------------------------------------------------
+    thread_local ThreadCache* ThreadCache::current_ = nullptr;
+    thread_local bool ThreadCache::destroyed_ = false;
+
+    //--------------------------------------------------------------------------
+    void ThreadCache::FreeList::Push(void* block)
+    {
+      *reinterpret_cast<void**>(block) = head;
+      head = block;
+      ++count;
+    }
+
+    //--------------------------------------------------------------------------
+    void* ThreadCache::FreeList::Pop()
+    {
+      if (head == nullptr)
+      {
+        return nullptr;
+      }
+
+      void* block = head;
+      head = *reinterpret_cast<void**>(block);
+      --count;
+
+      return block;
+    }
+
+    //--------------------------------------------------------------------------
+    ThreadCache* ThreadCache::Get()
+    {
+      if (current_ != nullptr)
+      {
+        return current_;
+      }
+
+      if (destroyed_ == true)
+      {
+        return nullptr;
+      }
+
+      static thread_local ThreadCache cache;
+      return &cache;
+    }
+
+    //--------------------------------------------------------------------------
+    ThreadCache::Slot* ThreadCache::Find(IAllocator* allocator)
+    {
+      Slot* free_slot = nullptr;
+
+      for (size_t i = 0; i < kMaxSlots; ++i)
+      {
+        Slot& slot = slots_[i];
+
+        if (slot.id == allocator->id_)
+        {
+          return &slot;
+        }
+
+        if (slot.id == 0 && free_slot == nullptr)
+        {
+          free_slot = &slot;
+        }
+      }
+
+      if (free_slot == nullptr)
+      {
+        return nullptr;
+      }
+
+      AllocatorCounters* counters = allocator->AcquireCounters();
+
+      if (counters == nullptr)
+      {
+        return nullptr;
+      }
+
+      free_slot->id = allocator->id_;
+      free_slot->allocator = allocator;
+      free_slot->counters = counters;
+
+      return free_slot;
+    }
+
+    //--------------------------------------------------------------------------
+    void ThreadCache::Evict(IAllocator* allocator)
+    {
+      for (size_t i = 0; i < kMaxSlots; ++i)
+      {
+        if (slots_[i].id == allocator->id_)
+        {
+          Release(&slots_[i]);
+          return;
+        }
+      }
+    }
+
+    //--------------------------------------------------------------------------
+    size_t ThreadCache::SizeClass(size_t size)
+    {
+      size_t size_class = 0;
+      size_t class_size = ClassSize(0);
+
+      while (class_size < size)
+      {
+        class_size <<= 1;
+        ++size_class;
+      }
+
+      return size_class;
+    }
+
+    //--------------------------------------------------------------------------
+    size_t ThreadCache::ClassSize(size_t size_class)
+    {
+      return static_cast<size_t>(16) << size_class;
+    }
+
+    //--------------------------------------------------------------------------
+    bool ThreadCache::IsCached(size_t size)
+    {
+      return size <= ClassSize(kNumSizeClasses - 1);
+    }
+
+    //--------------------------------------------------------------------------
+    ThreadCache::ThreadCache()
+    {
+      for (size_t i = 0; i < kMaxSlots; ++i)
+      {
+        Slot& slot = slots_[i];
+
+        slot.id = 0;
+        slot.allocator = nullptr;
+        slot.counters = nullptr;
+
+        for (size_t j = 0; j < kNumSizeClasses; ++j)
+        {
+          slot.lists[j].head = nullptr;
+          slot.lists[j].count = 0;
+        }
+      }
+
+      current_ = this;
+    }
+
+    //--------------------------------------------------------------------------
+    void ThreadCache::Release(Slot* slot)
+    {
+      IAllocator* allocator = slot->allocator;
+
+      for (size_t i = 0; i < kNumSizeClasses; ++i)
+      {
+        allocator->Flush(slot->lists[i], i, 0);
+      }
+
+      slot->counters->in_use.store(false, std::memory_order_release);
+
+      slot->id = 0;
+      slot->allocator = nullptr;
+      slot->counters = nullptr;
+    }
+
+    //--------------------------------------------------------------------------
+    ThreadCache::~ThreadCache()
+    {
+      for (size_t i = 0; i < kMaxSlots; ++i)
+      {
+        if (slots_[i].id != 0)
+        {
+          Release(&slots_[i]);
+        }
+      }
+
+      destroyed_ = true;
+      current_ = nullptr;
+    }
+  }
+}
@@ -0,0 +1,176 @@
+#pragma once
+
+#include "foundation/memory/allocators/allocator_counters.h"
+
+namespace snuffbox
+{
+  namespace foundation
+  {
+    class IAllocator;
+
+    /**
+    * @brief A per-thread cache of small memory blocks for thread-cached
+    *        allocators
+    *
+    * Every thread that allocates through a thread-cached IAllocator receives
+    * a cache slot for that allocator. The slot contains a free list per size
+    * class and the thread's own allocation counters. Allocating and
+    * deallocating small blocks only touches these thread-local lists, the
+    * owning allocator is only locked when a list needs to be refilled or
+    * when it grew too large, in which case blocks are handed off in batches.
+    *
+    * When a thread exits, its cached blocks are returned to the depot of the
+    * owning allocators. This means that a thread-cached allocator should
+    * outlive every thread that allocates through it.
+    *
+    * @see IAllocator
+    *
+    * @author Daniel Konings
+    */
+    class ThreadCache
+    {
+
+      friend class IAllocator;
+
+    public:
+
+      /**
+      * @brief The number of size classes, starting at 16 bytes and doubling
+      *        with every class
+      */
+      static const size_t kNumSizeClasses = 8;
+
+      /**
+      * @brief The maximum number of allocators a single thread can cache
+      *        blocks for
+      */
+      static const size_t kMaxSlots = 8;
+
+      /**
+      * @brief An intrusive list of free blocks, the first bytes of each
+      *        block contain the pointer to the next block
+      *
+      * @author Daniel Konings
+      */
+      struct FreeList
+      {
+        void* head; //!< The first free block in the list
+        size_t count; //!< The number of blocks in the list
+
+        /**
+        * @brief Pushes a block to the front of the list
+        *
+        * @param[in] block The block to push
+        */
+        void Push(void* block);
+
+        /**
+        * @brief Pops a block from the front of the list
+        *
+        * @return The popped block, or nullptr if the list is empty
+        */
+        void* Pop();
+      };
+
+      /**
+      * @brief The per-thread data of a single thread-cached allocator
+      *
+      * @author Daniel Konings
+      */
+      struct Slot
+      {
+        uint64_t id; //!< The unique ID of the allocator, 0 if unused
+        IAllocator* allocator; //!< The allocator this slot caches for
+        AllocatorCounters* counters; //!< The per-thread counters
+        FreeList lists[kNumSizeClasses]; //!< The free lists per size class
+      };
+
+      /**
+      * @brief Retrieves the cache of the calling thread, constructing it on
+      *        first use
+      *
+      * @return The thread's cache, or nullptr if the cache was already
+      *         destroyed during thread exit
+      */
+      static ThreadCache* Get();
+
+      /**
+      * @brief Finds the slot of an allocator, or claims a new slot if this
+      *        thread didn't use the allocator before
+      *
+      * @param[in] allocator The allocator to find the slot for
+      *
+      * @return The slot, or nullptr if every slot is already in use
+      */
+      Slot* Find(IAllocator* allocator);
+
+      /**
+      * @brief Returns every cached block of an allocator to its depot and
+      *        releases the slot
+      *
+      * @param[in] allocator The allocator to evict
+      */
+      void Evict(IAllocator* allocator);
+
+      /**
+      * @brief Retrieves the size class a block size falls into
+      *
+      * @param[in] size The size of the block
+      *
+      * @return The size class index
+      */
+      static size_t SizeClass(size_t size);
+
+      /**
+      * @brief Retrieves the block size of a size class
+      *
+      * @param[in] size_class The size class index
+      *
+      * @return The size of every block in the size class
+      */
+      static size_t ClassSize(size_t size_class);
+
+      /**
+      * @return Is a block of the provided size served from the cache?
+      */
+      static bool IsCached(size_t size);
+
+      /**
+      * @brief Releases all slots
+      *
+      * @see ThreadCache::Evict
+      */
+      ~ThreadCache();
+
+    protected:
+
+      /**
+      * @brief Creates an empty cache and registers it as the cache of the
+      *        current thread
+      */
+      ThreadCache();
+
+      /**
+      * @brief Releases a slot, returning all of its blocks
+      *
+      * @param[in] slot The slot to release
+      */
+      void Release(Slot* slot);
+
+    public:
+
+      /**
+      * @brief The number of blocks that are handed between a thread and the
+      *        owning allocator at once
+      */
+      static const size_t kBatchSize;
+
+    private:
+
+      Slot slots_[kMaxSlots]; //!< The slots of this thread
+
+      static thread_local ThreadCache* current_; //!< The current thread cache
+      static thread_local bool destroyed_; //!< Was the cache destroyed?
+    };
+  }
+}
@@ -0,0 +1,526 @@
+#include "foundation/memory/heap_profiler.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#if defined (SNUFF_WIN32)
+#include "foundation/win32/win32_include.h"
+#elif defined (SNUFF_LINUX) || defined (SNUFF_OSX)
+#include <execinfo.h>
+#include <dlfcn.h>
+#include <cxxabi.h>
+#endif
+
+namespace snuffbox
+{
+  namespace foundation
+  {
+    //--------------------------------------------------------------------------
+    const size_t HeapProfiler::kDefaultSampleRate;
+    const size_t HeapProfiler::kMaxFrames;
+    const size_t HeapProfiler::kMaxSites;
+    const size_t HeapProfiler::kMaxSamples;
+    const uint32_t HeapProfiler::kSkipFrames_ = 2;
+
+    //--------------------------------------------------------------------------
+    std::mutex HeapProfiler::mutex_;
+    std::atomic<bool> HeapProfiler::enabled_(false);
+    std::atomic<size_t> HeapProfiler::sample_rate_(kDefaultSampleRate);
+    size_t HeapProfiler::num_sites_ = 0;
+    size_t HeapProfiler::num_samples_ = 0;
+    size_t HeapProfiler::dropped_ = 0;
+    HeapProfiler::Site HeapProfiler::sites_[kMaxSites];
+    HeapProfiler::LiveSample HeapProfiler::samples_[kMaxSamples];
+
+    thread_local int64_t HeapProfiler::bytes_until_sample_ = 0;
+    thread_local uint64_t HeapProfiler::seed_ = 0;
+    thread_local bool HeapProfiler::busy_ = false;
+
+    //--------------------------------------------------------------------------
+    void HeapProfiler::Start(size_t sample_rate)
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+
+      memset(sites_, 0, sizeof(sites_));
+      memset(samples_, 0, sizeof(samples_));
+
+      num_sites_ = 0;
+      num_samples_ = 0;
+      dropped_ = 0;
+
+      sample_rate_.store(
+        sample_rate > 0 ? sample_rate : 1,
+        std::memory_order_relaxed);
+
+      enabled_.store(true, std::memory_order_release);
+    }
+
+    //--------------------------------------------------------------------------
+    void HeapProfiler::Stop()
+    {
+      enabled_.store(false, std::memory_order_release);
+    }
+
+    //--------------------------------------------------------------------------
+    bool HeapProfiler::enabled()
+    {
+      return enabled_.load(std::memory_order_relaxed);
+    }
+
+    //--------------------------------------------------------------------------
+    size_t HeapProfiler::sample_rate()
+    {
+      return sample_rate_.load(std::memory_order_relaxed);
+    }
+
+    //--------------------------------------------------------------------------
+    size_t HeapProfiler::dropped()
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      return dropped_;
+    }
+
+    //--------------------------------------------------------------------------
+    String HeapProfiler::ToPprof()
+    {
+      busy_ = true;
+
+      String result;
+      char line[64];
+
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        size_t live_count = 0;
+        size_t live_bytes = 0;
+        size_t total_count = 0;
+        size_t total_bytes = 0;
+
+        for (size_t i = 0; i < kMaxSites; ++i)
+        {
+          live_count += sites_[i].live_count;
+          live_bytes += sites_[i].live_bytes;
+          total_count += sites_[i].total_count;
+          total_bytes += sites_[i].total_bytes;
+        }
+
+        snprintf(line, sizeof(line), "heap profile: %zu: %zu [%zu: %zu]",
+          live_count, live_bytes, total_count, total_bytes);
+
+        result += line;
+
+        snprintf(line, sizeof(line), " @ heap_v2/%zu\n", sample_rate());
+        result += line;
+
+        for (size_t i = 0; i < kMaxSites; ++i)
+        {
+          const Site& site = sites_[i];
+
+          if (site.num_frames == 0 || site.total_count == 0)
+          {
+            continue;
+          }
+
+          snprintf(line, sizeof(line), "%zu: %zu [%zu: %zu] @",
+            site.live_count,
+            site.live_bytes,
+            site.total_count,
+            site.total_bytes);
+
+          result += line;
+
+          for (uint32_t j = 0; j < site.num_frames; ++j)
+          {
+            snprintf(line, sizeof(line), " 0x%llx",
+              static_cast<unsigned long long>(
+                reinterpret_cast<uintptr_t>(site.frames[j])));
+
+            result += line;
+          }
+
+          result += "\n";
+        }
+      }
+
+      result += "\nMAPPED_LIBRARIES:\n";
+
+#if defined (SNUFF_LINUX)
+      FILE* maps = fopen("/proc/self/maps", "r");
+
+      if (maps != nullptr)
+      {
+        char buffer[4096];
+        size_t read = 0;
+
+        while ((read = fread(buffer, 1, sizeof(buffer), maps)) > 0)
+        {
+          result.append(buffer, buffer + read);
+        }
+
+        fclose(maps);
+      }
+#endif
+
+      busy_ = false;
+
+      return result;
+    }
+
+    //--------------------------------------------------------------------------
+    String HeapProfiler::ToFolded(bool live)
+    {
+      busy_ = true;
+
+      String result;
+      char value[32];
+
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        for (size_t i = 0; i < kMaxSites; ++i)
+        {
+          const Site& site = sites_[i];
+
+          size_t count = live == true ? site.live_count : site.total_count;
+          size_t bytes = live == true ? site.live_bytes : site.total_bytes;
+
+          if (site.num_frames == 0 || count == 0)
+          {
+            continue;
+          }
+
+          for (uint32_t j = site.num_frames; j > 0; --j)
+          {
+            AppendFrame(site.frames[j - 1], &result);
+            result += j > 1 ? ";" : "";
+          }
+
+          snprintf(value, sizeof(value), " %zu\n", Unsample(count, bytes));
+          result += value;
+        }
+      }
+
+      busy_ = false;
+
+      return result;
+    }
+
+    //--------------------------------------------------------------------------
+    bool HeapProfiler::Sample(size_t size)
+    {
+      int64_t remaining = bytes_until_sample_ - static_cast<int64_t>(size);
+
+      if (remaining > 0)
+      {
+        bytes_until_sample_ = remaining;
+        return false;
+      }
+
+      if (busy_ == true)
+      {
+        return false;
+      }
+
+      if (seed_ == 0)
+      {
+        seed_ = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(&seed_)) ^
+          0x9e3779b97f4a7c15ull;
+
+        remaining += NextInterval();
+
+        if (remaining > 0)
+        {
+          bytes_until_sample_ = remaining;
+          return false;
+        }
+      }
+
+      bytes_until_sample_ = NextInterval();
+
+      return true;
+    }
+
+    //--------------------------------------------------------------------------
+    bool HeapProfiler::RecordAllocation(void* ptr, size_t size)
+    {
+      void* frames[kMaxFrames];
+      uint32_t num_frames = CaptureBacktrace(frames, kMaxFrames);
+
+      std::lock_guard<std::mutex> lock(mutex_);
+
+      uint32_t index = FindSite(frames, num_frames);
+
+      if (index == kMaxSites || num_samples_ >= kMaxSamples / 4 * 3)
+      {
+        ++dropped_;
+        return false;
+      }
+
+      LiveSample& sample = samples_[FindSample(ptr)];
+
+      if (sample.ptr == nullptr)
+      {
+        ++num_samples_;
+      }
+
+      sample.ptr = ptr;
+      sample.site = index;
+      sample.size = size;
+
+      Site& site = sites_[index];
+
+      ++site.live_count;
+      site.live_bytes += size;
+      ++site.total_count;
+      site.total_bytes += size;
+
+      return true;
+    }
+
+    //--------------------------------------------------------------------------
+    void HeapProfiler::RecordDeallocation(void* ptr)
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+
+      size_t slot = FindSample(ptr);
+      const LiveSample& sample = samples_[slot];
+
+      if (sample.ptr == nullptr)
+      {
+        return;
+      }
+
+      Site& site = sites_[sample.site];
+
+      --site.live_count;
+      site.live_bytes -= sample.size;
+
+      RemoveSample(slot);
+    }
+
+    //--------------------------------------------------------------------------
+    bool HeapProfiler::RecordReallocation(
+      void* old_ptr,
+      void* new_ptr,
+      size_t size)
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+
+      size_t slot = FindSample(old_ptr);
+
+      if (samples_[slot].ptr == nullptr)
+      {
+        return false;
+      }
+
+      LiveSample moved = samples_[slot];
+      RemoveSample(slot);
+
+      Site& site = sites_[moved.site];
+      site.live_bytes = site.live_bytes - moved.size + size;
+
+      if (size > moved.size)
+      {
+        site.total_bytes += size - moved.size;
+      }
+
+      moved.ptr = new_ptr;
+      moved.size = size;
+
+      samples_[FindSample(new_ptr)] = moved;
+      ++num_samples_;
+
+      return true;
+    }
+
+    //--------------------------------------------------------------------------
+    uint32_t HeapProfiler::CaptureBacktrace(void** frames, uint32_t max_frames)
+    {
+      uint32_t num_frames = 0;
+
+#if defined (SNUFF_WIN32)
+      num_frames = CaptureStackBackTrace(
+        kSkipFrames_,
+        max_frames,
+        frames,
+        nullptr);
+#elif defined (SNUFF_LINUX) || defined (SNUFF_OSX)
+      void* buffer[kMaxFrames * 2];
+      int captured = backtrace(buffer, static_cast<int>(kMaxFrames * 2));
+
+      for (int i = kSkipFrames_; i < captured && num_frames < max_frames; ++i)
+      {
+        frames[num_frames++] = buffer[i];
+      }
+#endif
+
+      if (num_frames == 0)
+      {
+        frames[num_frames++] = nullptr;
+      }
+
+      return num_frames;
+    }
+
+    //--------------------------------------------------------------------------
+    uint32_t HeapProfiler::FindSite(void** frames, uint32_t num_frames)
+    {
+      uint32_t hash = 2166136261u;
+      const uint8_t* bytes = reinterpret_cast<const uint8_t*>(frames);
+
+      for (size_t i = 0; i < num_frames * sizeof(void*); ++i)
+      {
+        hash = (hash ^ bytes[i]) * 16777619u;
+      }
+
+      size_t index = hash % kMaxSites;
+
+      while (sites_[index].num_frames != 0)
+      {
+        const Site& site = sites_[index];
+
+        if (
+          site.hash == hash &&
+          site.num_frames == num_frames &&
+          memcmp(site.frames, frames, num_frames * sizeof(void*)) == 0)
+        {
+          return static_cast<uint32_t>(index);
+        }
+
+        index = (index + 1) % kMaxSites;
+      }
+
+      if (num_sites_ >= kMaxSites / 4 * 3)
+      {
+        return kMaxSites;
+      }
+
+      Site& site = sites_[index];
+
+      memcpy(site.frames, frames, num_frames * sizeof(void*));
+      site.num_frames = num_frames;
+      site.hash = hash;
+
+      ++num_sites_;
+
+      return static_cast<uint32_t>(index);
+    }
+
+    //--------------------------------------------------------------------------
+    size_t HeapProfiler::FindSample(void* ptr)
+    {
+      size_t index = HashPointer(ptr);
+
+      while (samples_[index].ptr != nullptr && samples_[index].ptr != ptr)
+      {
+        index = (index + 1) % kMaxSamples;
+      }
+
+      return index;
+    }
+
+    //--------------------------------------------------------------------------
+    void HeapProfiler::RemoveSample(size_t slot)
+    {
+      size_t hole = slot;
+      size_t next = slot;
+
+      --num_samples_;
+
+      while (true)
+      {
+        samples_[hole].ptr = nullptr;
+
+        while (true)
+        {
+          next = (next + 1) % kMaxSamples;
+
+          if (samples_[next].ptr == nullptr)
+          {
+            return;
+          }
+
+          size_t home = HashPointer(samples_[next].ptr);
+
+          bool stays = hole <= next ?
+            hole < home && home <= next :
+            hole < home || home <= next;
+
+          if (stays == false)
+          {
+            break;
+          }
+        }
+
+        samples_[hole] = samples_[next];
+        hole = next;
+      }
+    }
+
+    //--------------------------------------------------------------------------
+    size_t HeapProfiler::HashPointer(void* ptr)
+    {
+      uint64_t hash = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(ptr));
+      hash = (hash >> 4) * 0x9e3779b97f4a7c15ull;
+
+      return static_cast<size_t>(hash >> 32) % kMaxSamples;
+    }
+
+    //--------------------------------------------------------------------------
+    int64_t HeapProfiler::NextInterval()
+    {
+      seed_ ^= seed_ << 13;
+      seed_ ^= seed_ >> 7;
+      seed_ ^= seed_ << 17;
+
+      double u = static_cast<double>((seed_ >> 11) + 1) / 9007199254740992.0;
+      double rate = static_cast<double>(sample_rate());
+
+      return static_cast<int64_t>(-std::log(u) * rate) + 1;
+    }
+
+    //--------------------------------------------------------------------------
+    size_t HeapProfiler::Unsample(size_t count, size_t bytes)
+    {
+      if (count == 0)
+      {
+        return 0;
+      }
+
+      double average = static_cast<double>(bytes) / count;
+      double rate = static_cast<double>(sample_rate());
+      double probability = 1.0 - std::exp(-average / rate);
+
+      return static_cast<size_t>(static_cast<double>(bytes) / probability);
+    }
+
+    //--------------------------------------------------------------------------
+    void HeapProfiler::AppendFrame(void* frame, String* out)
+    {
+#if defined (SNUFF_LINUX) || defined (SNUFF_OSX)
+      Dl_info info;
+
+      if (dladdr(frame, &info) != 0 && info.dli_sname != nullptr)
+      {
+        int status = 0;
+        char* demangled =
+          abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+
+        *out += status == 0 ? demangled : info.dli_sname;
+        free(demangled);
+
+        return;
+      }
+#endif
+
+      char address[32];
+
+      snprintf(address, sizeof(address), "0x%llx",
+        static_cast<unsigned long long>(reinterpret_cast<uintptr_t>(frame)));
+
+      *out += address;
+    }
+  }
+}
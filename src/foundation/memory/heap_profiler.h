@@ -0,0 +1,303 @@
+#pragma once
+
+#include "foundation/containers/string.h"
+
+#include <atomic>
+#include <mutex>
+#include <cstdint>
+#include <cstddef>
+
+namespace snuffbox
+{
+  namespace foundation
+  {
+    /**
+    * @brief A sampling heap profiler that attributes allocations made through
+    *        Memory::Allocate to the call sites that made them
+    *
+    * When the profiler is started, one in every N allocated bytes is sampled
+    * on average, where N is the sample rate. The distance between two samples
+    * is drawn from an exponential distribution, so that allocations of every
+    * size are sampled without bias. For every sample a backtrace is captured,
+    * which identifies the call site. The live and total sampled bytes are then
+    * kept per call site.
+    *
+    * Sampled allocations are flagged in their Memory::AllocationHeader and
+    * are kept in a fixed-size side table, so that the profiler itself never
+    * allocates. When a table is full, samples are dropped and counted instead.
+    *
+    * The profile can be exported in the legacy pprof heap format, or in the
+    * collapsed stack format of flamegraph.pl. The pprof output contains raw
+    * addresses and the mapped libraries, so it can be symbolized offline.
+    *
+    * @remarks Symbol names in the flamegraph output are only resolved on
+    *          Linux, other platforms print raw addresses
+    *
+    * @author Daniel Konings
+    */
+    class HeapProfiler
+    {
+
+      friend class Memory;
+
+    public:
+
+      /**
+      * @brief The default average number of bytes between two samples
+      */
+      static const size_t kDefaultSampleRate = 512ul * 1024ul;
+
+      /**
+      * @brief The maximum number of frames captured per backtrace
+      */
+      static const size_t kMaxFrames = 32;
+
+      /**
+      * @brief The maximum number of unique call sites
+      */
+      static const size_t kMaxSites = 4096;
+
+      /**
+      * @brief The maximum number of sampled allocations that can be alive
+      *        at the same time
+      */
+      static const size_t kMaxSamples = 65536;
+
+      /**
+      * @brief Starts sampling allocations, clearing any previous profile
+      *
+      * @param[in] sample_rate The average number of bytes between two samples
+      */
+      static void Start(size_t sample_rate = kDefaultSampleRate);
+
+      /**
+      * @brief Stops sampling allocations
+      *
+      * Allocations that were sampled remain tracked until they are
+      * deallocated, so that the profile can still be exported.
+      */
+      static void Stop();
+
+      /**
+      * @return Is the profiler currently sampling allocations?
+      */
+      static bool enabled();
+
+      /**
+      * @return The average number of bytes between two samples
+      */
+      static size_t sample_rate();
+
+      /**
+      * @return The number of samples that were dropped because a side table
+      *         was full
+      */
+      static size_t dropped();
+
+      /**
+      * @brief Exports the profile in the legacy pprof heap format
+      *
+      * The in-use and allocated counts are raw sampled counts, which pprof
+      * scales back using the sample rate in the header.
+      *
+      * @return The profile as text
+      */
+      static String ToPprof();
+
+      /**
+      * @brief Exports the profile in the collapsed stack format that is
+      *        accepted by flamegraph.pl
+      *
+      * Every line contains the frames of a call site from the outermost
+      * caller inwards, followed by the estimated number of bytes.
+      *
+      * @param[in] live Should the live bytes be exported, rather than the
+      *                 total bytes that were ever allocated?
+      *
+      * @return The profile as text
+      */
+      static String ToFolded(bool live = true);
+
+    protected:
+
+      /**
+      * @brief Counts down the bytes until the next sample of the calling
+      *        thread
+      *
+      * @param[in] size The size of the allocation
+      *
+      * @return Should the allocation be sampled?
+      */
+      static bool Sample(size_t size);
+
+      /**
+      * @brief Captures the backtrace of a sampled allocation and attributes
+      *        it to its call site
+      *
+      * @param[in] ptr The pointer to the allocation
+      * @param[in] size The size of the allocation
+      *
+      * @return Is the allocation tracked? This is false if it was dropped.
+      */
+      static bool RecordAllocation(void* ptr, size_t size);
+
+      /**
+      * @brief Removes a sampled allocation from its call site
+      *
+      * @param[in] ptr The pointer to the allocation
+      */
+      static void RecordDeallocation(void* ptr);
+
+      /**
+      * @brief Moves a sampled allocation that was resized, keeping it at the
+      *        call site that originally allocated it
+      *
+      * @param[in] old_ptr The pointer before the allocation was resized
+      * @param[in] new_ptr The pointer after the allocation was resized
+      * @param[in] size The new size of the allocation
+      *
+      * @return Is the allocation still tracked?
+      */
+      static bool RecordReallocation(void* old_ptr, void* new_ptr, size_t size);
+
+      /**
+      * @brief The sampled statistics of a single call site
+      *
+      * @author Daniel Konings
+      */
+      struct Site
+      {
+        void* frames[kMaxFrames]; //!< The backtrace, innermost frame first
+        uint32_t num_frames; //!< The number of frames, 0 if unused
+        uint32_t hash; //!< The hash of the frames
+        size_t live_count; //!< The number of live samples
+        size_t live_bytes; //!< The number of live sampled bytes
+        size_t total_count; //!< The number of samples ever taken
+        size_t total_bytes; //!< The number of sampled bytes ever allocated
+      };
+
+      /**
+      * @brief A sampled allocation that is still alive
+      *
+      * @author Daniel Konings
+      */
+      struct LiveSample
+      {
+        void* ptr; //!< The pointer to the allocation, nullptr if unused
+        uint32_t site; //!< The index of the call site
+        size_t size; //!< The size of the allocation
+      };
+
+      /**
+      * @brief Captures the backtrace of the calling thread
+      *
+      * @param[out] frames The frames to fill
+      * @param[in] max_frames The maximum number of frames to capture
+      *
+      * @return The number of captured frames
+      */
+      static uint32_t CaptureBacktrace(void** frames, uint32_t max_frames);
+
+      /**
+      * @brief Finds the call site of a backtrace, or creates it if it didn't
+      *        exist yet
+      *
+      * @remarks This should only be called while holding the lock
+      *
+      * @param[in] frames The frames of the backtrace
+      * @param[in] num_frames The number of frames
+      *
+      * @return The index of the call site, or kMaxSites if the table is full
+      */
+      static uint32_t FindSite(void** frames, uint32_t num_frames);
+
+      /**
+      * @brief Finds the slot of a sampled allocation
+      *
+      * @remarks This should only be called while holding the lock
+      *
+      * @param[in] ptr The pointer to the allocation
+      *
+      * @return The slot, or the empty slot it would be inserted in
+      */
+      static size_t FindSample(void* ptr);
+
+      /**
+      * @brief Removes the sample in a slot, shifting back the samples
+      *        that collided with it
+      *
+      * @remarks This should only be called while holding the lock
+      *
+      * @param[in] slot The slot to remove
+      */
+      static void RemoveSample(size_t slot);
+
+      /**
+      * @brief Hashes a pointer to its home slot in the live sample table
+      *
+      * @param[in] ptr The pointer to hash
+      *
+      * @return The home slot
+      */
+      static size_t HashPointer(void* ptr);
+
+      /**
+      * @brief Draws the number of bytes until the next sample from an
+      *        exponential distribution around the sample rate
+      *
+      * @return The number of bytes until the next sample
+      */
+      static int64_t NextInterval();
+
+      /**
+      * @brief Estimates the unsampled number of bytes of a call site
+      *
+      * @param[in] count The number of samples
+      * @param[in] bytes The number of sampled bytes
+      *
+      * @return The estimated number of bytes that were actually allocated
+      */
+      static size_t Unsample(size_t count, size_t bytes);
+
+      /**
+      * @brief Appends the name of a frame to a string
+      *
+      * @param[in] frame The frame to append
+      * @param[out] out The string to append to
+      */
+      static void AppendFrame(void* frame, String* out);
+
+      /**
+      * @brief The number of frames of the profiler itself that are skipped
+      *        when capturing a backtrace
+      */
+      static const uint32_t kSkipFrames_;
+
+    private:
+
+      static std::mutex mutex_; //!< The lock around the side tables
+      static std::atomic<bool> enabled_; //!< Is the profiler sampling?
+      static std::atomic<size_t> sample_rate_; //!< The current sample rate
+      static size_t num_sites_; //!< The number of used call sites
+      static size_t num_samples_; //!< The number of live samples
+      static size_t dropped_; //!< The number of dropped samples
+      static Site sites_[kMaxSites]; //!< The call site table
+      static LiveSample samples_[kMaxSamples]; //!< The live sample table
+
+      /**
+      * @brief The number of bytes until the next sample of this thread
+      */
+      static thread_local int64_t bytes_until_sample_;
+
+      /**
+      * @brief The random state of this thread, 0 if not seeded yet
+      */
+      static thread_local uint64_t seed_;
+
+      /**
+      * @brief Is this thread currently inside the profiler?
+      */
+      static thread_local bool busy_;
+    };
+  }
+}
@@ -1,7 +1,11 @@
 #include "foundation/memory/memory.h"
+#include "foundation/memory/allocator_registry.h"
+#include "foundation/memory/heap_profiler.h"
 #include "foundation/auxiliary/pointer_math.h"
 #include "foundation/auxiliary/logger.h"
 
+#include <cstring>
+
 namespace snuffbox
 {
   namespace foundation
@@ -9,8 +13,19 @@ namespace snuffbox
     //--------------------------------------------------------------------------
     const size_t Memory::kDefaultHeapSize_ = 1024ul * 1024ul * 1024ul * 2ul;
     const size_t Memory::kDefaultAlignment_ = 16ul;
+    const size_t Memory::kMaxAlignment_ = 1ul << 15ul;
+    const size_t Memory::kFrameHeapSize_ = 1024ul * 1024ul * 4ul;
+
+    Memory::DefaultAllocator Memory::default_allocator_(
+      kDefaultHeapSize_,
+      true,
+      "default");
 
-    Memory::DefaultAllocator Memory::default_allocator_(kDefaultHeapSize_);
+    LinearAllocator Memory::frame_allocator_(kFrameHeapSize_, "frame");
+
+    DoubleBufferedAllocator Memory::double_buffered_allocator_(
+      kFrameHeapSize_,
+      "double_buffered");
 
     //--------------------------------------------------------------------------
     void* Memory::Allocate(size_t size, size_t align, IAllocator* allocator)
@@ -22,9 +37,20 @@ namespace snuffbox
         allocator = &default_allocator_;
       }
 
+      if (align > kMaxAlignment_)
+      {
+        Logger::Assert(false,
+          "Attempted to allocate with an alignment that is too large");
+        return nullptr;
+      }
+
       size_t header_size = sizeof(AllocationHeader);
-      void* base = reinterpret_cast<AllocationHeader*>(
-        allocator->Allocate(size + header_size + align - 1, align));
+      void* base = allocator->Allocate(AllocationSize(size, align), align);
+
+      if (base == nullptr)
+      {
+        return nullptr;
+      }
 
       void* ptr = PointerMath::Offset(base, header_size);
 
@@ -35,8 +61,17 @@ namespace snuffbox
         PointerMath::Offset(base, a));
 
       header->allocator = allocator;
+      header->align = static_cast<uint16_t>(align);
+      header->offset = static_cast<uint16_t>(a);
+      header->frame = AllocatorRegistry::frame();
       header->size = size;
-      header->align = a;
+      header->sampled = 0;
+
+      if (HeapProfiler::enabled() == true && HeapProfiler::Sample(size) == true)
+      {
+        header->sampled =
+          HeapProfiler::RecordAllocation(ptr, size) == true ? 1 : 0;
+      }
 
       return ptr;
     }
@@ -60,10 +95,100 @@ namespace snuffbox
 
       IAllocator* alloc = header->allocator;
 
+      if (header->sampled == 1)
+      {
+        HeapProfiler::RecordDeallocation(ptr);
+      }
+
+      size_t total = AllocationSize(header->size, header->align);
+      uint32_t lifetime = AllocatorRegistry::frame() - header->frame;
+
       alloc->Deallocate(PointerMath::Offset(
         header,
-        -static_cast<intptr_t>(header->align)
-      ));
+        -static_cast<intptr_t>(header->offset)
+      ), total, lifetime);
+    }
+
+    //--------------------------------------------------------------------------
+    void* Memory::Reallocate(void* ptr, size_t size, IAllocator* allocator)
+    {
+      if (ptr == nullptr)
+      {
+        return Allocate(size, allocator);
+      }
+
+      if (size == 0)
+      {
+        Deallocate(ptr);
+        return nullptr;
+      }
+
+      size_t header_size = sizeof(AllocationHeader);
+
+      AllocationHeader* header = reinterpret_cast<AllocationHeader*>(
+        PointerMath::Offset(ptr, -static_cast<intptr_t>(header_size)));
+
+      IAllocator* alloc = header->allocator;
+      size_t align = header->align;
+      size_t offset = header->offset;
+      size_t old_size = header->size;
+
+      void* base = PointerMath::Offset(header, -static_cast<intptr_t>(offset));
+
+      void* block = alloc->Reallocate(
+        base,
+        AllocationSize(old_size, align),
+        AllocationSize(size, align),
+        align);
+
+      if (block == nullptr)
+      {
+        void* moved = Allocate(size, align, alloc);
+
+        if (moved == nullptr)
+        {
+          return nullptr;
+        }
+
+        memcpy(moved, ptr, size < old_size ? size : old_size);
+        Deallocate(ptr);
+
+        return moved;
+      }
+
+      size_t a = PointerMath::AlignDelta(
+        PointerMath::Offset(block, header_size),
+        align);
+
+      if (a != offset)
+      {
+        memmove(
+          PointerMath::Offset(block, a),
+          PointerMath::Offset(block, offset),
+          header_size + (size < old_size ? size : old_size));
+      }
+
+      header = reinterpret_cast<AllocationHeader*>(
+        PointerMath::Offset(block, a));
+
+      header->offset = static_cast<uint16_t>(a);
+      header->size = size;
+
+      void* resized = PointerMath::Offset(header, header_size);
+
+      if (header->sampled == 1)
+      {
+        header->sampled =
+          HeapProfiler::RecordReallocation(ptr, resized, size) == true ? 1 : 0;
+      }
+
+      return resized;
+    }
+
+    //--------------------------------------------------------------------------
+    size_t Memory::AllocationSize(size_t size, size_t align)
+    {
+      return size + sizeof(AllocationHeader) + align - 1;
     }
 
     //--------------------------------------------------------------------------
@@ -71,5 +196,17 @@ namespace snuffbox
     {
       return default_allocator_;
     }
+
+    //--------------------------------------------------------------------------
+    LinearAllocator& Memory::frame_allocator()
+    {
+      return frame_allocator_;
+    }
+
+    //--------------------------------------------------------------------------
+    DoubleBufferedAllocator& Memory::double_buffered_allocator()
+    {
+      return double_buffered_allocator_;
+    }
   }
 }
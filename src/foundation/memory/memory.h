@@ -2,6 +2,8 @@
 
 #include "foundation/memory/allocators/eastl_allocator.h"
 #include "foundation/memory/allocators/malloc_allocator.h"
+#include "foundation/memory/allocators/linear_allocator.h"
+#include "foundation/memory/allocators/pool_allocator.h"
 
 #include <EASTL/memory.h>
 
@@ -132,6 +134,27 @@ namespace snuffbox
       */
       static void Deallocate(void* ptr);
 
+      /**
+      * @brief Resizes a memory block, preserving its contents
+      *
+      * The block is resized by its own allocator, which grows or shrinks
+      * it in place where possible. If the allocator can't resize the block,
+      * a new block is allocated and the contents are copied over.
+      *
+      * @remarks Like realloc, a nullptr block is allocated with the passed
+      *          allocator and a size of 0 deallocates the block
+      *
+      * @param[in] ptr The pointer to the memory block to resize
+      * @param[in] size The new size of the memory block
+      * @param[in] allocator The allocator to use if ptr is nullptr
+      *
+      * @return The pointer to the resized memory block
+      */
+      static void* Reallocate(
+        void* ptr,
+        size_t size,
+        IAllocator* allocator = &default_allocator());
+
       /**
       * @brief Constructs a class using and calls its constructor
       *
@@ -207,6 +230,53 @@ namespace snuffbox
       */
       static DefaultAllocator& default_allocator();
 
+      /**
+      * @brief The frame allocator, for transient data that only lives for
+      *        the duration of a single frame
+      *
+      * @remarks The allocator is reset at the end of every frame
+      *
+      * @return The frame allocator
+      */
+      static LinearAllocator& frame_allocator();
+
+      /**
+      * @brief The double-buffered frame allocator, for transient data that
+      *        has to stay alive during the next frame as well
+      *
+      * @return The double-buffered frame allocator
+      */
+      static DoubleBufferedAllocator& double_buffered_allocator();
+
+      /**
+      * @brief The pool allocator for objects of a specific type, which is
+      *        constructed on first use
+      *
+      * The block size of the pool fits a single T, including the allocation
+      * header of Memory::Allocate.
+      *
+      * @tparam T The type of objects that are allocated from the pool
+      *
+      * @param[in] name The name of the pool, only used on construction
+      *
+      * @return The pool allocator
+      */
+      template <typename T>
+      static PoolAllocator& pool_allocator(const char* name = "pool");
+
+      /**
+      * @brief Calculates the size that Memory::Allocate requests from an
+      *        allocator for a given allocation
+      *
+      * @param[in] size The size of the allocation
+      * @param[in] align The alignment of the allocation
+      *
+      * @return The size including the allocation header and padding
+      */
+      static size_t AllocationSize(
+        size_t size,
+        size_t align = kDefaultAlignment_);
+
     protected:
 
       /**
@@ -217,20 +287,32 @@ namespace snuffbox
       struct AllocationHeader
       {
         IAllocator* allocator; //!< The allocator used for the allocation
-        size_t align; //!< The alignment used during the allocation
-        size_t size; //!< The size of the allocation
+        uint16_t align; //!< The alignment used during the allocation
+        uint16_t offset : 15; //!< The offset from the block to the header
+        uint16_t sampled : 1; //!< Was this allocation sampled by HeapProfiler?
+        uint32_t frame; //!< The frame the allocation was made in
+        size_t size; //!< The size of the allocation, always the last field
       };
 
     private:
 
       static const size_t kDefaultHeapSize_; //!< The default heap size
       static const size_t kDefaultAlignment_; //!< The default alignment
+      static const size_t kMaxAlignment_; //!< The maximum alignment
+      static const size_t kFrameHeapSize_; //!< The size of a frame buffer
 
       /**
       * @brief The default allocator, 
       *        it is initialized with Memory::kDefaultHeapSize_
       */
       static DefaultAllocator default_allocator_;
+
+      static LinearAllocator frame_allocator_; //!< The frame allocator
+
+      /**
+      * @brief The double-buffered frame allocator
+      */
+      static DoubleBufferedAllocator double_buffered_allocator_;
     };
 
     //--------------------------------------------------------------------------
@@ -279,6 +361,14 @@ namespace snuffbox
       Deallocate(ptr);
     }
 
+    //--------------------------------------------------------------------------
+    template <typename T>
+    inline PoolAllocator& Memory::pool_allocator(const char* name)
+    {
+      static PoolAllocator pool(AllocationSize(sizeof(T)), name);
+      return pool;
+    }
+
     //--------------------------------------------------------------------------
     template <typename T>
     inline SharedPtr<T> Memory::MakeShared(T* ptr)
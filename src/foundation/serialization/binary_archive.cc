@@ -0,0 +1,844 @@
+#include "foundation/serialization/binary_archive.h"
+#include "foundation/auxiliary/logger.h"
+
+#include "foundation/memory/allocators/rapidjson_allocator.h"
+
+#ifdef SNUFF_LINUX
+#ifdef Bool
+#undef Bool
+#endif
+#endif
+
+#include <rapidjson/reader.h>
+#include <rapidjson/memorystream.h>
+#include <rapidjson/error/en.h>
+
+#include <cstring>
+
+namespace snuffbox
+{
+  namespace foundation
+  {
+    //--------------------------------------------------------------------------
+    struct BinaryArchive::JsonHandler :
+      public rapidjson::BaseReaderHandler<rapidjson::UTF8<>, JsonHandler>
+    {
+      BinaryArchive* archive; //!< The archive that is being built
+
+      /**
+      * @brief Adds a null value
+      */
+      bool Null()
+      {
+        archive->AddNode(ArchiveIdentifiers::kNull);
+        return true;
+      }
+
+      /**
+      * @brief Adds a boolean value
+      */
+      bool Bool(bool value)
+      {
+        uint32_t node = archive->AddNode(ArchiveIdentifiers::kBoolean);
+        archive->build_nodes_.at(node).number = value == true ? 1.0 : 0.0;
+
+        return true;
+      }
+
+      /**
+      * @brief Adds an integer as a number value
+      */
+      bool Int(int value)
+      {
+        return Double(static_cast<double>(value));
+      }
+
+      /**
+      * @brief Adds an unsigned integer as a number value
+      */
+      bool Uint(unsigned value)
+      {
+        return Double(static_cast<double>(value));
+      }
+
+      /**
+      * @brief Adds a 64-bit integer as a number value
+      */
+      bool Int64(int64_t value)
+      {
+        return Double(static_cast<double>(value));
+      }
+
+      /**
+      * @brief Adds an unsigned 64-bit integer as a number value
+      */
+      bool Uint64(uint64_t value)
+      {
+        return Double(static_cast<double>(value));
+      }
+
+      /**
+      * @brief Adds a number value
+      */
+      bool Double(double value)
+      {
+        uint32_t node = archive->AddNode(ArchiveIdentifiers::kNumber);
+        archive->build_nodes_.at(node).number = value;
+
+        return true;
+      }
+
+      /**
+      * @brief Adds a string value
+      */
+      bool String(const char* str, rapidjson::SizeType length, bool)
+      {
+        uint32_t offset = archive->AddString(str, length);
+        uint32_t node = archive->AddNode(ArchiveIdentifiers::kString);
+
+        archive->build_nodes_.at(node).string = offset;
+
+        return true;
+      }
+
+      /**
+      * @brief Opens an object
+      */
+      bool StartObject()
+      {
+        archive->AddNode(ArchiveIdentifiers::kObjectStart);
+        return true;
+      }
+
+      /**
+      * @brief Names the next member of an object
+      */
+      bool Key(const char* str, rapidjson::SizeType length, bool)
+      {
+        archive->SetName(str, length);
+        return true;
+      }
+
+      /**
+      * @brief Closes an object
+      */
+      bool EndObject(rapidjson::SizeType)
+      {
+        archive->EndContainer();
+        return true;
+      }
+
+      /**
+      * @brief Opens an array
+      */
+      bool StartArray()
+      {
+        archive->AddNode(ArchiveIdentifiers::kArray);
+        return true;
+      }
+
+      /**
+      * @brief Closes an array
+      */
+      bool EndArray(rapidjson::SizeType)
+      {
+        archive->EndContainer();
+        return true;
+      }
+    };
+
+    //--------------------------------------------------------------------------
+    const uint32_t BinaryArchive::kInvalidIndex;
+    const uint32_t BinaryArchive::kMagic;
+    const uint32_t BinaryArchive::kVersion;
+
+    //--------------------------------------------------------------------------
+    BinaryArchive::BinaryArchive() :
+      nodes_(nullptr),
+      slots_(nullptr),
+      strings_(nullptr),
+      num_nodes_(0),
+      num_slots_(0),
+      pending_name_(kInvalidIndex),
+      pending_key_(0)
+    {
+
+    }
+
+    //--------------------------------------------------------------------------
+    bool BinaryArchive::Build(const uint8_t* buffer, size_t size)
+    {
+      BeginBuild();
+
+      size_t i = 0;
+
+      if (buffer == nullptr || BuildValue(buffer, size, i) == false)
+      {
+        build_nodes_.clear();
+      }
+
+      return EndBuild();
+    }
+
+    //--------------------------------------------------------------------------
+    bool BinaryArchive::FromJson(const char* json, size_t length)
+    {
+      BeginBuild();
+
+      JsonHandler handler;
+      handler.archive = this;
+
+      rapidjson::MemoryStream stream(json, length);
+      rapidjson::GenericReader<
+        rapidjson::UTF8<>,
+        rapidjson::UTF8<>,
+        RapidJsonStackAllocator> reader;
+
+      rapidjson::ParseResult res = reader.Parse(stream, handler);
+
+      if (res.IsError() == true)
+      {
+        Logger::LogVerbosity<1>(
+          LogChannel::kEngine,
+          LogSeverity::kError,
+          "Could not parse JSON for an archive\n\nError(s):\n{0} ({1})",
+          rapidjson::GetParseError_En(res.Code()),
+          res.Offset());
+
+        build_nodes_.clear();
+      }
+
+      return EndBuild();
+    }
+
+    //--------------------------------------------------------------------------
+    bool BinaryArchive::Load(const uint8_t* data, size_t size)
+    {
+      data_.clear();
+      SetViews();
+
+      if (IsBinary(data, size) == false)
+      {
+        return false;
+      }
+
+      Header header;
+      memcpy(&header, data, sizeof(Header));
+
+      uint64_t expected =
+        sizeof(Header) +
+        static_cast<uint64_t>(header.num_nodes) * sizeof(Node) +
+        static_cast<uint64_t>(header.num_slots) * sizeof(Slot) +
+        header.strings_size;
+
+      if (
+        header.version != kVersion ||
+        expected != size ||
+        header.num_nodes == 0 ||
+        header.num_slots <= header.num_nodes ||
+        (header.num_slots & (header.num_slots - 1)) != 0 ||
+        header.strings_size == 0)
+      {
+        return false;
+      }
+
+      data_.resize(size);
+      memcpy(data_.data(), data, size);
+
+      SetViews();
+
+      bool valid = strings_[header.strings_size - 1] == '\0';
+
+      for (uint32_t i = 0; i < num_nodes_ && valid == true; ++i)
+      {
+        const Node& node = nodes_[i];
+
+        valid =
+          node.type != ArchiveIdentifiers::kName &&
+          node.type != ArchiveIdentifiers::kObjectEnd &&
+          node.type <= ArchiveIdentifiers::kNull &&
+          (node.name == kInvalidIndex || node.name < header.strings_size) &&
+          (node.type != ArchiveIdentifiers::kString ||
+          node.string < header.strings_size);
+      }
+
+      uint32_t empty = 0;
+
+      for (uint32_t i = 0; i < num_slots_ && valid == true; ++i)
+      {
+        const Slot& slot = slots_[i];
+
+        if (slot.node == kInvalidIndex)
+        {
+          ++empty;
+          continue;
+        }
+
+        valid = slot.node < num_nodes_ && slot.parent < num_nodes_;
+      }
+
+      if (valid == false || empty == 0)
+      {
+        data_.clear();
+        SetViews();
+
+        return false;
+      }
+
+      return true;
+    }
+
+    //--------------------------------------------------------------------------
+    bool BinaryArchive::IsBinary(const uint8_t* data, size_t size)
+    {
+      if (data == nullptr || size < sizeof(Header))
+      {
+        return false;
+      }
+
+      uint32_t magic;
+      memcpy(&magic, data, sizeof(uint32_t));
+
+      return magic == kMagic;
+    }
+
+    //--------------------------------------------------------------------------
+    uint32_t BinaryArchive::Find(uint32_t parent, const char* name) const
+    {
+      if (GetType(parent) != ArchiveIdentifiers::kObjectStart)
+      {
+        return kInvalidIndex;
+      }
+
+      return FindSlot(parent, HashName(name, strlen(name)), name);
+    }
+
+    //--------------------------------------------------------------------------
+    uint32_t BinaryArchive::Find(
+      uint32_t parent,
+      const char* name,
+      uint32_t hash) const
+    {
+      if (GetType(parent) != ArchiveIdentifiers::kObjectStart)
+      {
+        return kInvalidIndex;
+      }
+
+      return FindSlot(parent, hash, name);
+    }
+
+    //--------------------------------------------------------------------------
+    uint32_t BinaryArchive::At(uint32_t parent, uint32_t index) const
+    {
+      if (
+        GetType(parent) != ArchiveIdentifiers::kArray ||
+        index >= nodes_[parent].count)
+      {
+        return kInvalidIndex;
+      }
+
+      return FindSlot(parent, index, nullptr);
+    }
+
+    //--------------------------------------------------------------------------
+    ArchiveIdentifiers BinaryArchive::GetType(uint32_t node) const
+    {
+      if (node >= num_nodes_)
+      {
+        return ArchiveIdentifiers::kNull;
+      }
+
+      return nodes_[node].type;
+    }
+
+    //--------------------------------------------------------------------------
+    double BinaryArchive::GetNumber(uint32_t node) const
+    {
+      if (GetType(node) != ArchiveIdentifiers::kNumber)
+      {
+        return 0.0;
+      }
+
+      return nodes_[node].number;
+    }
+
+    //--------------------------------------------------------------------------
+    bool BinaryArchive::GetBoolean(uint32_t node) const
+    {
+      if (GetType(node) != ArchiveIdentifiers::kBoolean)
+      {
+        return false;
+      }
+
+      return nodes_[node].number != 0.0;
+    }
+
+    //--------------------------------------------------------------------------
+    const char* BinaryArchive::GetString(uint32_t node) const
+    {
+      if (GetType(node) != ArchiveIdentifiers::kString)
+      {
+        return "";
+      }
+
+      return strings_ + nodes_[node].string;
+    }
+
+    //--------------------------------------------------------------------------
+    uint32_t BinaryArchive::GetCount(uint32_t node) const
+    {
+      ArchiveIdentifiers type = GetType(node);
+
+      if (
+        type != ArchiveIdentifiers::kArray &&
+        type != ArchiveIdentifiers::kObjectStart)
+      {
+        return 0;
+      }
+
+      return nodes_[node].count;
+    }
+
+    //--------------------------------------------------------------------------
+    uint32_t BinaryArchive::root() const
+    {
+      return num_nodes_ > 0 ? 0 : kInvalidIndex;
+    }
+
+    //--------------------------------------------------------------------------
+    const Vector<uint8_t>& BinaryArchive::data() const
+    {
+      return data_;
+    }
+
+    //--------------------------------------------------------------------------
+    void BinaryArchive::BeginBuild()
+    {
+      data_.clear();
+      SetViews();
+
+      build_nodes_.clear();
+      build_keys_.clear();
+      build_parents_.clear();
+      open_.clear();
+      build_names_.clear();
+
+      build_strings_.clear();
+      build_strings_.push_back('\0');
+
+      pending_name_ = kInvalidIndex;
+      pending_key_ = 0;
+    }
+
+    //--------------------------------------------------------------------------
+    void BinaryArchive::SetName(const char* name, size_t length)
+    {
+      uint32_t key = HashName(name, length);
+      UMap<uint32_t, uint32_t>::iterator it = build_names_.find(key);
+
+      if (
+        it != build_names_.end() &&
+        build_strings_.size() - it->second > length &&
+        memcmp(build_strings_.data() + it->second, name, length) == 0 &&
+        build_strings_.at(it->second + length) == '\0')
+      {
+        pending_name_ = it->second;
+      }
+      else
+      {
+        pending_name_ = AddString(name, length);
+
+        if (it == build_names_.end())
+        {
+          build_names_.emplace(key, pending_name_);
+        }
+      }
+
+      pending_key_ = key;
+    }
+
+    //--------------------------------------------------------------------------
+    uint32_t BinaryArchive::AddNode(ArchiveIdentifiers type)
+    {
+      uint32_t index = static_cast<uint32_t>(build_nodes_.size());
+      uint32_t parent = open_.empty() == true ? kInvalidIndex : open_.back();
+
+      Node node;
+      memset(&node, 0, sizeof(Node));
+
+      node.type = type;
+      node.name = kInvalidIndex;
+
+      uint32_t key = 0;
+
+      if (parent != kInvalidIndex)
+      {
+        Node& container = build_nodes_.at(parent);
+
+        if (container.type == ArchiveIdentifiers::kArray)
+        {
+          key = container.count;
+        }
+        else
+        {
+          key = pending_key_;
+          node.name = pending_name_;
+        }
+
+        ++container.count;
+      }
+
+      pending_name_ = kInvalidIndex;
+      pending_key_ = 0;
+
+      build_nodes_.push_back(node);
+      build_keys_.push_back(key);
+      build_parents_.push_back(parent);
+
+      if (
+        type == ArchiveIdentifiers::kArray ||
+        type == ArchiveIdentifiers::kObjectStart)
+      {
+        open_.push_back(index);
+      }
+
+      return index;
+    }
+
+    //--------------------------------------------------------------------------
+    uint32_t BinaryArchive::AddString(const char* str, size_t length)
+    {
+      uint32_t offset = static_cast<uint32_t>(build_strings_.size());
+
+      build_strings_.append(str, length);
+      build_strings_.push_back('\0');
+
+      return offset;
+    }
+
+    //--------------------------------------------------------------------------
+    void BinaryArchive::EndContainer()
+    {
+      if (open_.empty() == true)
+      {
+        return;
+      }
+
+      open_.pop_back();
+    }
+
+    //--------------------------------------------------------------------------
+    bool BinaryArchive::EndBuild()
+    {
+      bool valid = build_nodes_.empty() == false && open_.empty() == true;
+
+      uint32_t num_nodes = static_cast<uint32_t>(build_nodes_.size());
+      uint32_t num_slots = 2;
+
+      while (num_slots <= num_nodes + num_nodes / 2)
+      {
+        num_slots <<= 1;
+      }
+
+      if (valid == true)
+      {
+        Header header;
+        header.magic = kMagic;
+        header.version = kVersion;
+        header.num_nodes = num_nodes;
+        header.num_slots = num_slots;
+        header.strings_size = static_cast<uint32_t>(build_strings_.size());
+        header.padding = 0;
+
+        size_t nodes_size = num_nodes * sizeof(Node);
+        size_t slots_size = num_slots * sizeof(Slot);
+
+        data_.resize(
+          sizeof(Header) + nodes_size + slots_size + build_strings_.size());
+
+        uint8_t* out = data_.data();
+
+        memcpy(out, &header, sizeof(Header));
+        out += sizeof(Header);
+
+        memcpy(out, build_nodes_.data(), nodes_size);
+        out += nodes_size;
+
+        Slot* slots = reinterpret_cast<Slot*>(out);
+        out += slots_size;
+
+        for (uint32_t i = 0; i < num_slots; ++i)
+        {
+          slots[i].parent = kInvalidIndex;
+          slots[i].key = 0;
+          slots[i].node = kInvalidIndex;
+        }
+
+        uint32_t mask = num_slots - 1;
+
+        for (uint32_t i = 1; i < num_nodes; ++i)
+        {
+          uint32_t parent = build_parents_.at(i);
+          uint32_t key = build_keys_.at(i);
+          uint32_t pos = HashSlot(parent, key) & mask;
+
+          while (slots[pos].node != kInvalidIndex)
+          {
+            pos = (pos + 1) & mask;
+          }
+
+          slots[pos].parent = parent;
+          slots[pos].key = key;
+          slots[pos].node = i;
+        }
+
+        memcpy(out, build_strings_.data(), build_strings_.size());
+      }
+
+      build_nodes_.clear();
+      build_keys_.clear();
+      build_parents_.clear();
+      open_.clear();
+      build_strings_.clear();
+      build_names_.clear();
+
+      SetViews();
+
+      return valid;
+    }
+
+    //--------------------------------------------------------------------------
+    bool BinaryArchive::BuildValue(
+      const uint8_t* buffer,
+      size_t size,
+      size_t& i)
+    {
+      if (i >= size)
+      {
+        return false;
+      }
+
+      ArchiveIdentifiers id = static_cast<ArchiveIdentifiers>(buffer[i]);
+      ++i;
+
+      uint32_t node;
+      uint32_t offset;
+      size_t length;
+      const char* str;
+
+      switch (id)
+      {
+
+      case ArchiveIdentifiers::kNumber:
+        if (size - i < sizeof(double))
+        {
+          return false;
+        }
+
+        node = AddNode(id);
+        memcpy(&build_nodes_.at(node).number, buffer + i, sizeof(double));
+        i += sizeof(double);
+
+        return true;
+
+      case ArchiveIdentifiers::kBoolean:
+        if (i >= size)
+        {
+          return false;
+        }
+
+        node = AddNode(id);
+        build_nodes_.at(node).number = buffer[i] != 0 ? 1.0 : 0.0;
+        ++i;
+
+        return true;
+
+      case ArchiveIdentifiers::kString:
+        str = ReadTaggedString(buffer, size, i, &length);
+
+        if (str == nullptr)
+        {
+          return false;
+        }
+
+        offset = AddString(str, length);
+        node = AddNode(id);
+
+        build_nodes_.at(node).string = offset;
+
+        return true;
+
+      case ArchiveIdentifiers::kArray:
+        if (size - i < sizeof(size_t))
+        {
+          return false;
+        }
+
+        memcpy(&length, buffer + i, sizeof(size_t));
+        i += sizeof(size_t);
+
+        AddNode(id);
+
+        for (size_t e = 0; e < length; ++e)
+        {
+          if (BuildValue(buffer, size, i) == false)
+          {
+            return false;
+          }
+        }
+
+        EndContainer();
+
+        return true;
+
+      case ArchiveIdentifiers::kObjectStart:
+        AddNode(id);
+
+        while (i < size)
+        {
+          id = static_cast<ArchiveIdentifiers>(buffer[i]);
+          ++i;
+
+          if (id == ArchiveIdentifiers::kObjectEnd)
+          {
+            EndContainer();
+            return true;
+          }
+
+          if (id != ArchiveIdentifiers::kName)
+          {
+            return false;
+          }
+
+          str = ReadTaggedString(buffer, size, i, &length);
+
+          if (str == nullptr)
+          {
+            return false;
+          }
+
+          SetName(str, length);
+
+          if (BuildValue(buffer, size, i) == false)
+          {
+            return false;
+          }
+        }
+
+        return false;
+
+      default:
+        return false;
+      }
+    }
+
+    //--------------------------------------------------------------------------
+    const char* BinaryArchive::ReadTaggedString(
+      const uint8_t* buffer,
+      size_t size,
+      size_t& i,
+      size_t* length)
+    {
+      const char* str = reinterpret_cast<const char*>(buffer + i);
+      const void* end = memchr(str, '\0', size - i);
+
+      if (end == nullptr)
+      {
+        return nullptr;
+      }
+
+      *length = static_cast<const char*>(end) - str;
+      i += *length + 1;
+
+      return str;
+    }
+
+    //--------------------------------------------------------------------------
+    uint32_t BinaryArchive::FindSlot(
+      uint32_t parent,
+      uint32_t key,
+      const char* name) const
+    {
+      if (num_slots_ == 0)
+      {
+        return kInvalidIndex;
+      }
+
+      uint32_t mask = num_slots_ - 1;
+      uint32_t pos = HashSlot(parent, key) & mask;
+
+      while (slots_[pos].node != kInvalidIndex)
+      {
+        const Slot& slot = slots_[pos];
+
+        if (slot.parent == parent && slot.key == key)
+        {
+          if (name == nullptr)
+          {
+            return slot.node;
+          }
+
+          uint32_t offset = nodes_[slot.node].name;
+
+          if (offset != kInvalidIndex && strcmp(strings_ + offset, name) == 0)
+          {
+            return slot.node;
+          }
+        }
+
+        pos = (pos + 1) & mask;
+      }
+
+      return kInvalidIndex;
+    }
+
+    //--------------------------------------------------------------------------
+    uint32_t BinaryArchive::HashName(const char* name, size_t length)
+    {
+      return ArchiveName::Hash(name, length);
+    }
+
+    //--------------------------------------------------------------------------
+    uint32_t BinaryArchive::HashSlot(uint32_t parent, uint32_t key)
+    {
+      uint32_t hash = (parent * 0x9e3779b1u) ^ key;
+
+      hash ^= hash >> 16;
+      hash *= 0x85ebca6bu;
+      hash ^= hash >> 13;
+      hash *= 0xc2b2ae35u;
+      hash ^= hash >> 16;
+
+      return hash;
+    }
+
+    //--------------------------------------------------------------------------
+    void BinaryArchive::SetViews()
+    {
+      if (data_.empty() == true)
+      {
+        nodes_ = nullptr;
+        slots_ = nullptr;
+        strings_ = nullptr;
+        num_nodes_ = 0;
+        num_slots_ = 0;
+
+        return;
+      }
+
+      const Header* header = reinterpret_cast<const Header*>(data_.data());
+
+      num_nodes_ = header->num_nodes;
+      num_slots_ = header->num_slots;
+
+      const uint8_t* at = data_.data() + sizeof(Header);
+      nodes_ = reinterpret_cast<const Node*>(at);
+
+      at += num_nodes_ * sizeof(Node);
+      slots_ = reinterpret_cast<const Slot*>(at);
+
+      at += num_slots_ * sizeof(Slot);
+      strings_ = reinterpret_cast<const char*>(at);
+    }
+  }
+}
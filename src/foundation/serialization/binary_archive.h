@@ -0,0 +1,365 @@
+#pragma once
+
+#include "foundation/definitions/archive.h"
+
+#include "foundation/containers/vector.h"
+#include "foundation/containers/string.h"
+#include "foundation/containers/map.h"
+
+#include <cinttypes>
+#include <cstddef>
+
+namespace snuffbox
+{
+  namespace foundation
+  {
+    /**
+    * @brief The binary representation of an archive, which can be persisted
+    *        and read back without generating or parsing any text
+    *
+    * Every value in the archive is stored as a fixed-size node, in the order
+    * in which the values were archived. All names and strings are stored in
+    * a single string pool, where every unique name is only stored once.
+    *
+    * Next to the nodes, the archive stores an open-addressed index that maps
+    * a parent node and a key to a child node. The key of an object member is
+    * the hash of its name, the key of an array element is its index. This
+    * makes looking up a property or an array element a constant time
+    * operation, regardless of the size of the archive.
+    *
+    * The archive is built from the tagged buffer of a SaveArchive or from
+    * a JSON string, and can be loaded directly from its binary data, which
+    * is validated before use.
+    *
+    * @remarks The binary data is stored in the byte order of the machine
+    *          that built it
+    *
+    * @author Daniel Konings
+    */
+    class BinaryArchive
+    {
+
+    public:
+
+      /**
+      * @brief The index of a node that doesn't exist
+      */
+      static const uint32_t kInvalidIndex = 0xffffffff;
+
+      /**
+      * @brief The magic number at the start of the binary data, "sARC"
+      */
+      static const uint32_t kMagic = 0x43524173;
+
+      /**
+      * @brief The version of the binary format
+      */
+      static const uint32_t kVersion = 1;
+
+      /**
+      * @brief The header at the start of the binary data
+      *
+      * @author Daniel Konings
+      */
+      struct Header
+      {
+        uint32_t magic; //!< Should be BinaryArchive::kMagic
+        uint32_t version; //!< Should be BinaryArchive::kVersion
+        uint32_t num_nodes; //!< The number of nodes
+        uint32_t num_slots; //!< The number of index slots, a power of two
+        uint32_t strings_size; //!< The size of the string pool in bytes
+        uint32_t padding; //!< Keeps the nodes 8-byte aligned
+      };
+
+      /**
+      * @brief A single archived value
+      *
+      * @author Daniel Konings
+      */
+      struct Node
+      {
+        ArchiveIdentifiers type; //!< The type of the value
+        uint8_t padding[3]; //!< Explicit padding, always zero
+        uint32_t name; //!< The name in the pool, or kInvalidIndex
+
+        union
+        {
+          double number; //!< The number value, or 1.0 for true booleans
+          uint32_t count; //!< The number of children of arrays and objects
+          uint32_t string; //!< The string value in the pool
+        };
+      };
+
+      /**
+      * @brief An entry in the index of child nodes
+      *
+      * @author Daniel Konings
+      */
+      struct Slot
+      {
+        uint32_t parent; //!< The parent node of the child
+        uint32_t key; //!< The name hash or array index of the child
+        uint32_t node; //!< The child node, or kInvalidIndex for empty slots
+      };
+
+      /**
+      * @brief Creates an empty archive
+      */
+      BinaryArchive();
+
+      /**
+      * @brief Builds the archive from the tagged buffer of a SaveArchive
+      *
+      * @param[in] buffer The tagged buffer
+      * @param[in] size The size of the buffer
+      *
+      * @return Was the buffer valid?
+      */
+      bool Build(const uint8_t* buffer, size_t size);
+
+      /**
+      * @brief Builds the archive from a JSON string
+      *
+      * @param[in] json The JSON string
+      * @param[in] length The length of the string
+      *
+      * @return Could the JSON be parsed?
+      */
+      bool FromJson(const char* json, size_t length);
+
+      /**
+      * @brief Loads the archive from binary data, as retrieved with
+      *        BinaryArchive::data
+      *
+      * @param[in] data The binary data
+      * @param[in] size The size of the data
+      *
+      * @return Was the data a valid binary archive?
+      */
+      bool Load(const uint8_t* data, size_t size);
+
+      /**
+      * @brief Checks if a buffer starts like a binary archive
+      *
+      * @param[in] data The buffer to check
+      * @param[in] size The size of the buffer
+      *
+      * @return Does the buffer start with the magic number?
+      */
+      static bool IsBinary(const uint8_t* data, size_t size);
+
+      /**
+      * @brief Finds a member of an object by name
+      *
+      * @param[in] parent The object node
+      * @param[in] name The name of the member
+      *
+      * @return The member node, or kInvalidIndex if it doesn't exist
+      */
+      uint32_t Find(uint32_t parent, const char* name) const;
+
+      /**
+      * @brief Finds a member of an object by name, with a precomputed hash
+      *
+      * @param[in] parent The object node
+      * @param[in] name The name of the member
+      * @param[in] hash The hash of the name, see ArchiveName::Hash
+      *
+      * @return The member node, or kInvalidIndex if it doesn't exist
+      */
+      uint32_t Find(uint32_t parent, const char* name, uint32_t hash) const;
+
+      /**
+      * @brief Finds an element of an array by index
+      *
+      * @param[in] parent The array node
+      * @param[in] index The index of the element
+      *
+      * @return The element node, or kInvalidIndex if it doesn't exist
+      */
+      uint32_t At(uint32_t parent, uint32_t index) const;
+
+      /**
+      * @brief Retrieves the type of a node
+      *
+      * @param[in] node The node to retrieve the type of
+      *
+      * @return The type, or ArchiveIdentifiers::kNull for invalid nodes
+      */
+      ArchiveIdentifiers GetType(uint32_t node) const;
+
+      /**
+      * @param[in] node The number node
+      *
+      * @return The number value
+      */
+      double GetNumber(uint32_t node) const;
+
+      /**
+      * @param[in] node The boolean node
+      *
+      * @return The boolean value
+      */
+      bool GetBoolean(uint32_t node) const;
+
+      /**
+      * @param[in] node The string node
+      *
+      * @return The null-terminated string value
+      */
+      const char* GetString(uint32_t node) const;
+
+      /**
+      * @param[in] node The array or object node
+      *
+      * @return The number of elements or members
+      */
+      uint32_t GetCount(uint32_t node) const;
+
+      /**
+      * @return The root node, or kInvalidIndex if the archive is empty
+      */
+      uint32_t root() const;
+
+      /**
+      * @return The binary data of the archive, to persist it
+      */
+      const Vector<uint8_t>& data() const;
+
+    protected:
+
+      /**
+      * @brief Handles the events of the rapidjson SAX reader
+      *
+      * @author Daniel Konings
+      */
+      struct JsonHandler;
+
+      /**
+      * @brief Clears the archive and starts building a new one
+      */
+      void BeginBuild();
+
+      /**
+      * @brief Sets the name of the next value that is added
+      *
+      * @param[in] name The name
+      * @param[in] length The length of the name
+      */
+      void SetName(const char* name, size_t length);
+
+      /**
+      * @brief Adds a value to the innermost open array or object
+      *
+      * @param[in] type The type of the value
+      *
+      * @return The added node
+      */
+      uint32_t AddNode(ArchiveIdentifiers type);
+
+      /**
+      * @brief Adds a string to the string pool
+      *
+      * @param[in] str The string
+      * @param[in] length The length of the string
+      *
+      * @return The offset of the string in the pool
+      */
+      uint32_t AddString(const char* str, size_t length);
+
+      /**
+      * @brief Closes the innermost open array or object
+      */
+      void EndContainer();
+
+      /**
+      * @brief Builds the index and writes the binary data
+      *
+      * @return Was a complete value built?
+      */
+      bool EndBuild();
+
+      /**
+      * @brief Adds a value from the tagged buffer of a SaveArchive
+      *
+      * @param[in] buffer The tagged buffer
+      * @param[in] size The size of the buffer
+      * @param[in|out] i The current index within the buffer
+      *
+      * @return Was the value valid?
+      */
+      bool BuildValue(const uint8_t* buffer, size_t size, size_t& i);
+
+      /**
+      * @brief Reads a null-terminated string from the tagged buffer
+      *
+      * @param[in] buffer The tagged buffer
+      * @param[in] size The size of the buffer
+      * @param[in|out] i The current index within the buffer
+      * @param[out] length The length of the string
+      *
+      * @return The string, or nullptr if it wasn't terminated
+      */
+      static const char* ReadTaggedString(
+        const uint8_t* buffer,
+        size_t size,
+        size_t& i,
+        size_t* length);
+
+      /**
+      * @brief Finds a slot in the index
+      *
+      * @param[in] parent The parent node
+      * @param[in] key The name hash or array index
+      * @param[in] name The name to match for object members, or nullptr
+      *
+      * @return The child node, or kInvalidIndex if it wasn't found
+      */
+      uint32_t FindSlot(uint32_t parent, uint32_t key, const char* name) const;
+
+      /**
+      * @brief Hashes a name into an index key
+      *
+      * @param[in] name The name
+      * @param[in] length The length of the name
+      *
+      * @return The key
+      */
+      static uint32_t HashName(const char* name, size_t length);
+
+      /**
+      * @brief Hashes a parent node and key into a slot position
+      *
+      * @param[in] parent The parent node
+      * @param[in] key The key
+      *
+      * @return The unmasked slot position
+      */
+      static uint32_t HashSlot(uint32_t parent, uint32_t key);
+
+      /**
+      * @brief Points the views into the binary data
+      */
+      void SetViews();
+
+    private:
+
+      Vector<uint8_t> data_; //!< The binary data
+
+      const Node* nodes_; //!< The nodes in the binary data
+      const Slot* slots_; //!< The index slots in the binary data
+      const char* strings_; //!< The string pool in the binary data
+      uint32_t num_nodes_; //!< The number of nodes
+      uint32_t num_slots_; //!< The number of index slots
+
+      Vector<Node> build_nodes_; //!< The nodes while building
+      Vector<uint32_t> build_keys_; //!< The index keys while building
+      Vector<uint32_t> build_parents_; //!< The parents while building
+      Vector<uint32_t> open_; //!< The open containers while building
+      String build_strings_; //!< The string pool while building
+      UMap<uint32_t, uint32_t> build_names_; //!< Pooled names by hash
+      uint32_t pending_name_; //!< The name of the next node
+      uint32_t pending_key_; //!< The name hash of the next node
+    };
+  }
+}
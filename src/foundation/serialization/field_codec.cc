@@ -0,0 +1,173 @@
+#include "foundation/serialization/field_codec.h"
+#include "foundation/serialization/save_archive.h"
+#include "foundation/serialization/load_archive.h"
+
+namespace snuffbox
+{
+  namespace foundation
+  {
+    //--------------------------------------------------------------------------
+    void FieldCodec::Save(
+      SaveArchive& archive,
+      const FieldTable& table,
+      const void* object)
+    {
+      Save(archive, table, object, 0, table.count);
+    }
+
+    //--------------------------------------------------------------------------
+    void FieldCodec::Save(
+      SaveArchive& archive,
+      const FieldTable& table,
+      const void* object,
+      size_t first,
+      size_t last)
+    {
+      const uint8_t* base = reinterpret_cast<const uint8_t*>(object);
+
+      last = last < table.count ? last : table.count;
+
+      for (size_t i = first; i < last; ++i)
+      {
+        const FieldDescriptor& field = table.fields[i];
+        const void* value = base + field.offset;
+
+        archive.WriteName(field.name, field.length);
+
+        switch (field.type)
+        {
+
+        case FieldType::kBool:
+          archive.WriteValue<bool>(*static_cast<const bool*>(value));
+          break;
+
+        case FieldType::kInt32:
+        case FieldType::kEnum:
+          archive.WriteValue<int32_t>(*static_cast<const int32_t*>(value));
+          break;
+
+        case FieldType::kUInt32:
+          archive.WriteValue<uint32_t>(*static_cast<const uint32_t*>(value));
+          break;
+
+        case FieldType::kFloat:
+          archive.WriteValue<float>(*static_cast<const float*>(value));
+          break;
+
+        case FieldType::kDouble:
+          archive.WriteValue<double>(*static_cast<const double*>(value));
+          break;
+
+        case FieldType::kString:
+          archive.WriteValue<String>(*static_cast<const String*>(value));
+          break;
+
+        case FieldType::kUUID:
+          archive.WriteValue<UUID>(*static_cast<const UUID*>(value));
+          break;
+
+        case FieldType::kVec2:
+          archive.WriteValue<glm::vec2>(*static_cast<const glm::vec2*>(value));
+          break;
+
+        case FieldType::kVec3:
+          archive.WriteValue<glm::vec3>(*static_cast<const glm::vec3*>(value));
+          break;
+
+        case FieldType::kVec4:
+          archive.WriteValue<glm::vec4>(*static_cast<const glm::vec4*>(value));
+          break;
+
+        case FieldType::kQuat:
+          archive.WriteValue<glm::quat>(*static_cast<const glm::quat*>(value));
+          break;
+
+        default:
+          break;
+        }
+      }
+    }
+
+    //--------------------------------------------------------------------------
+    void FieldCodec::Load(
+      LoadArchive& archive,
+      const FieldTable& table,
+      void* object)
+    {
+      if (archive.is_ok() == false)
+      {
+        return;
+      }
+
+      uint8_t* base = reinterpret_cast<uint8_t*>(object);
+
+      for (size_t i = 0; i < table.count; ++i)
+      {
+        const FieldDescriptor& field = table.fields[i];
+        void* value = base + field.offset;
+
+        archive.EnterScope(field.name, field.hash);
+
+        if (archive.HasScope() == false)
+        {
+          archive.ExitScope();
+          continue;
+        }
+
+        switch (field.type)
+        {
+
+        case FieldType::kBool:
+          archive.ReadValue<bool>(static_cast<bool*>(value));
+          break;
+
+        case FieldType::kInt32:
+        case FieldType::kEnum:
+          archive.ReadValue<int32_t>(static_cast<int32_t*>(value));
+          break;
+
+        case FieldType::kUInt32:
+          archive.ReadValue<uint32_t>(static_cast<uint32_t*>(value));
+          break;
+
+        case FieldType::kFloat:
+          archive.ReadValue<float>(static_cast<float*>(value));
+          break;
+
+        case FieldType::kDouble:
+          archive.ReadValue<double>(static_cast<double*>(value));
+          break;
+
+        case FieldType::kString:
+          archive.ReadValue<String>(static_cast<String*>(value));
+          break;
+
+        case FieldType::kUUID:
+          archive.ReadValue<UUID>(static_cast<UUID*>(value));
+          break;
+
+        case FieldType::kVec2:
+          archive.ReadValue<glm::vec2>(static_cast<glm::vec2*>(value));
+          break;
+
+        case FieldType::kVec3:
+          archive.ReadValue<glm::vec3>(static_cast<glm::vec3*>(value));
+          break;
+
+        case FieldType::kVec4:
+          archive.ReadValue<glm::vec4>(static_cast<glm::vec4*>(value));
+          break;
+
+        case FieldType::kQuat:
+          archive.ReadValue<glm::quat>(static_cast<glm::quat*>(value));
+          break;
+
+        default:
+          break;
+        }
+
+        archive.ExitScope();
+      }
+    }
+  }
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "foundation/definitions/field_table.h"
+
+namespace snuffbox
+{
+  namespace foundation
+  {
+    class SaveArchive;
+    class LoadArchive;
+
+    /**
+    * @brief Serializes objects by walking the field table of their class,
+    *        instead of unrolling a list of archive properties
+    *
+    * Every field is written and read in a single loop over its descriptors,
+    * by switching on the field type. The names and their hashes are
+    * precomputed in the field table, so no name is measured or hashed
+    * while archiving.
+    *
+    * As the fields are archived like any other property, objects that are
+    * serialized through their field table can be stored in both the JSON
+    * and the binary format, and remain compatible with properties that were
+    * archived by hand.
+    *
+    * @see FieldTable
+    *
+    * @author Daniel Konings
+    */
+    class FieldCodec
+    {
+
+    public:
+
+      /**
+      * @brief Writes all fields of an object into an archive
+      *
+      * @param[in] archive The archive to write to
+      * @param[in] table The field table of the object's class
+      * @param[in] object The object to write the fields of
+      */
+      static void Save(
+        SaveArchive& archive,
+        const FieldTable& table,
+        const void* object);
+
+      /**
+      * @brief Writes a range of the fields of an object into an archive
+      *
+      * This allows properties that are archived by hand to be written in
+      * between the fields of a table, to keep the order of the keys.
+      *
+      * @param[in] archive The archive to write to
+      * @param[in] table The field table of the object's class
+      * @param[in] object The object to write the fields of
+      * @param[in] first The index of the first field to write
+      * @param[in] last The index after the last field to write
+      */
+      static void Save(
+        SaveArchive& archive,
+        const FieldTable& table,
+        const void* object,
+        size_t first,
+        size_t last);
+
+      /**
+      * @brief Reads all fields of an object from an archive
+      *
+      * @remarks Fields that don't exist in the archive are left untouched
+      *
+      * @param[in] archive The archive to read from
+      * @param[in] table The field table of the object's class
+      * @param[out] object The object to read the fields of
+      */
+      static void Load(
+        LoadArchive& archive,
+        const FieldTable& table,
+        void* object);
+    };
+  }
+}
@@ -3,7 +3,7 @@
 
 #include "foundation/io/file.h"
 
-#include <rapidjson/error/en.h>
+#include <cstring>
 
 namespace snuffbox
 {
@@ -26,7 +26,7 @@ namespace snuffbox
     //--------------------------------------------------------------------------
     bool LoadArchive::FromFile(const Path& path)
     {
-      File fin(path);
+      File fin(path, FileFlags::kRead | FileFlags::kMapped);
 
       if (fin.is_ok() == false)
       {
@@ -36,81 +36,180 @@ namespace snuffbox
       size_t len;
       const uint8_t* buffer = fin.ReadBuffer(&len, true);
 
-      is_ok_ = FromJson(reinterpret_cast<const char*>(buffer));
-      return is_ok_;
+      return FromBuffer(buffer, len);
+    }
+
+    //--------------------------------------------------------------------------
+    bool LoadArchive::FromBuffer(const uint8_t* buffer, size_t size)
+    {
+      if (BinaryArchive::IsBinary(buffer, size) == true)
+      {
+        return FromBinary(buffer, size);
+      }
+
+      return FromJson(reinterpret_cast<const char*>(buffer), size);
     }
 
     //--------------------------------------------------------------------------
     bool LoadArchive::FromJson(const String& json)
     {
-      rapidjson::ParseResult res = document_.Parse(json.c_str());
+      return FromJson(json.c_str(), json.size());
+    }
 
-      if (res.IsError() == true)
+    //--------------------------------------------------------------------------
+    bool LoadArchive::FromJson(const char* json, size_t length)
+    {
+      nodes_.clear();
+      is_ok_ = binary_.FromJson(json, length);
+
+      return is_ok_;
+    }
+
+    //--------------------------------------------------------------------------
+    bool LoadArchive::FromBinary(const uint8_t* data, size_t size)
+    {
+      nodes_.clear();
+
+      is_ok_ = binary_.Load(data, size);
+
+      if (is_ok_ == false)
       {
         Logger::LogVerbosity<1>(
           LogChannel::kEngine,
           LogSeverity::kError,
-          "Could not parse JSON for deserialization\n\nError(s):\n{0} ({1})",
-          rapidjson::GetParseError_En(res.Code()),
-          res.Offset());
+          "Could not load an invalid binary archive for deserialization");
+      }
+
+      return is_ok_;
+    }
+
+    //--------------------------------------------------------------------------
+    bool LoadArchive::FromTagged(const uint8_t* buffer, size_t size)
+    {
+      nodes_.clear();
+
+      is_ok_ = binary_.Build(buffer, size);
+
+      if (is_ok_ == false)
+      {
+        Logger::LogVerbosity<1>(
+          LogChannel::kEngine,
+          LogSeverity::kError,
+          "Could not load an invalid tagged buffer for deserialization");
+      }
+
+      return is_ok_;
+    }
+
+    //--------------------------------------------------------------------------
+    size_t LoadArchive::GetArraySize(const char* name)
+    {
+      EnterScope(name);
+
+      size_t size = ScopeArraySize();
 
+      ExitScope();
+
+      return size;
+    }
+
+    //--------------------------------------------------------------------------
+    bool LoadArchive::ReadNumber(double* out)
+    {
+      uint32_t node = CurrentNode();
+
+      if (binary_.GetType(node) != ArchiveIdentifiers::kNumber)
+      {
         return false;
       }
 
-      is_ok_ = true;
+      *out = binary_.GetNumber(node);
+      return true;
+    }
+
+    //--------------------------------------------------------------------------
+    bool LoadArchive::ReadBoolean(bool* out)
+    {
+      uint32_t node = CurrentNode();
+
+      if (binary_.GetType(node) != ArchiveIdentifiers::kBoolean)
+      {
+        return false;
+      }
 
+      *out = binary_.GetBoolean(node);
       return true;
     }
 
     //--------------------------------------------------------------------------
-    size_t LoadArchive::GetArraySize(const char* name)
+    bool LoadArchive::ReadString(String* out)
+    {
+      uint32_t node = CurrentNode();
+
+      if (binary_.GetType(node) != ArchiveIdentifiers::kString)
+      {
+        return false;
+      }
+
+      *out = binary_.GetString(node);
+      return true;
+    }
+
+    //--------------------------------------------------------------------------
+    size_t LoadArchive::ScopeArraySize()
     {
-      const JsonValue& current = (*CurrentScope())[name];
+      uint32_t node = CurrentNode();
 
-      if (current.IsArray() == false)
+      if (binary_.GetType(node) != ArchiveIdentifiers::kArray)
       {
         return 0;
       }
 
-      rapidjson::SizeType size = current.GetArray().Size();
+      return binary_.GetCount(node);
+    }
+
+    //--------------------------------------------------------------------------
+    bool LoadArchive::HasScope()
+    {
+      return CurrentNode() != BinaryArchive::kInvalidIndex;
+    }
 
-      return static_cast<size_t>(size);
+    //--------------------------------------------------------------------------
+    void LoadArchive::EnterIndex(size_t i)
+    {
+      nodes_.push_back(binary_.At(CurrentNode(), static_cast<uint32_t>(i)));
     }
 
     //--------------------------------------------------------------------------
-    void LoadArchive::EnterScope(const String& token)
+    void LoadArchive::EnterScope(const char* name, uint32_t hash)
     {
-      scope_ += "/" + token;
+      nodes_.push_back(binary_.Find(CurrentNode(), name, hash));
     }
 
     //--------------------------------------------------------------------------
-    const LoadArchive::JsonValue* LoadArchive::CurrentScope()
+    void LoadArchive::EnterScope(const char* name)
     {
-      return rapidjson::GenericPointer<
-        JsonValue, 
-        RapidJsonStackAllocator>(scope_.c_str()).Get(document_);
+      EnterScope(name, ArchiveName::Hash(name, strlen(name)));
     }
 
     //--------------------------------------------------------------------------
-    void LoadArchive::ExitScope()
+    uint32_t LoadArchive::CurrentNode() const
     {
-      if (scope_.size() == 0)
+      if (nodes_.empty() == true)
       {
-        return;
+        return binary_.root();
       }
 
-      int erase = 0;
-      int i = static_cast<int>(scope_.size()) - 1;
+      return nodes_.back();
+    }
 
-      char current = scope_.at(i);
-      while (i >= 0 && current != '/')
+    //--------------------------------------------------------------------------
+    void LoadArchive::ExitScope()
+    {
+      if (nodes_.empty() == false)
       {
-        current = scope_.at(i);
-        ++erase;
-        --i;
+        nodes_.pop_back();
       }
-
-      scope_.erase(scope_.end() - erase, scope_.end());
     }
 
     //--------------------------------------------------------------------------
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "foundation/serialization/serializable.h"
+#include "foundation/serialization/binary_archive.h"
 #include "foundation/definitions/archive.h"
 
 #include "foundation/io/path.h"
@@ -8,21 +9,9 @@
 #include "foundation/auxiliary/string_utils.h"
 #include "foundation/containers/uuid.h"
 
-#include "foundation/memory/allocators/rapidjson_allocator.h"
-
 #include <glm/glm.hpp>
 #include <glm/gtc/quaternion.hpp>
 
-#ifdef SNUFF_LINUX
-#ifdef Bool
-#undef Bool
-#endif
-#endif
-
-#include <rapidjson/rapidjson.h>
-#include <rapidjson/document.h>
-#include <rapidjson/pointer.h>
-
 namespace snuffbox
 {
   namespace foundation
@@ -30,23 +19,24 @@ namespace snuffbox
     /**
     * @brief Used to load data archived by SaveArchive
     *
-    * The load archive requires a JSON format, created from the SaveArchive.
-    * All values can then be retrieved by their original name within the
-    * SaveArchive. This is order-independent and thus compatible over multiple
-    * versions of serialized data.
+    * The load archive requires a JSON format, created from the SaveArchive,
+    * or the binary format of a BinaryArchive. All values can then be
+    * retrieved by their original name within the SaveArchive. This is
+    * order-independent and thus compatible over multiple versions of
+    * serialized data.
+    *
+    * JSON is converted into a BinaryArchive in a single pass when it is
+    * loaded, binary archives are read directly. The archive keeps a stack of
+    * node cursors while deserializing, every property is looked up by the
+    * hash of its name and every array element by its index, through the
+    * index of the BinaryArchive in constant time.
     *
     * @author Daniel Konings
     */
     class LoadArchive
     {
 
-    private:
-
-      /**
-      * @brief Used to represent a rapidjson Value with a custom allocator
-      */
-      using JsonValue = 
-        rapidjson::GenericValue<rapidjson::UTF8<>, RapidJsonAllocator>;
+      friend class FieldCodec;
 
     public:
 
@@ -61,19 +51,56 @@ namespace snuffbox
       LoadArchive(const Path& path);
 
       /**
-      * @brief Loads an archive from a JSON file
+      * @brief Loads an archive from either a JSON or a binary file
       *
       * @param[in] path The path to the file
+      *
+      * @see LoadArchive::FromBuffer
       */
       bool FromFile(const Path& path);
 
       /**
-      * @brief Loads an archive from a JSON string
+      * @brief Loads an archive from a buffer, which is read as a binary
+      *        archive if it starts like one and as JSON otherwise
       *
-      * @param[in] json The JSON string
+      * @param[in] buffer The buffer to load
+      * @param[in] size The size of the buffer
+      */
+      bool FromBuffer(const uint8_t* buffer, size_t size);
+
+      /**
+      * @see LoadArchive::FromJson
       */
       bool FromJson(const String& json);
 
+      /**
+      * @brief Loads an archive from a JSON string, by converting it into
+      *        a binary archive
+      *
+      * @param[in] json The JSON string
+      * @param[in] length The length of the string
+      */
+      bool FromJson(const char* json, size_t length);
+
+      /**
+      * @brief Loads an archive from binary data, as created with
+      *        SaveArchive::ToBinary
+      *
+      * @param[in] data The binary data
+      * @param[in] size The size of the data
+      */
+      bool FromBinary(const uint8_t* data, size_t size);
+
+      /**
+      * @brief Loads an archive from the tagged buffer of a SaveArchive
+      *
+      * @see SaveArchive::buffer
+      *
+      * @param[in] buffer The tagged buffer
+      * @param[in] size The size of the buffer
+      */
+      bool FromTagged(const uint8_t* buffer, size_t size);
+
       /**
       * @brief Load a value from the archive
       *
@@ -139,96 +166,133 @@ namespace snuffbox
     protected:
 
       /**
-      * @brief Reads a JSON value when the requested value type is a number
+      * @brief Reads the current value when the requested value type is
+      *        a number
       *
       * @tparam A numerical type
       *
-      * @param[in] v The current JSON value
       * @param[in] out The retrieved value
       */
       template <typename T>
-      void ReadValue(
-        const JsonValue& v, 
-        T* out, 
-        enable_if_number<T>* = nullptr);
+      void ReadValue(T* out, enable_if_number<T>* = nullptr);
 
       /**
-      * @brief Reads a JSON value when the requested value type is an enumerator
+      * @brief Reads the current value when the requested value type is an
+      *        enumerator
       *
       * @tparam An enumerator type
       *
-      * @param[in] v The current JSON value
       * @param[in] out The retrieved value
       */
       template <typename T>
-      void ReadValue(
-        const JsonValue& v, 
-        T* out, 
-        enable_if_enum<T>* = nullptr);
+      void ReadValue(T* out, enable_if_enum<T>* = nullptr);
 
       /**
-      * @brief Reads a JSON value when the requested value type is a vector
+      * @brief Reads the current value when the requested value type is
+      *        a vector
       *
       * @tparam A vector type
       *
-      * @param[in] v The current JSON value
       * @param[in] out The retrieved value
       */
       template <typename T>
-      void ReadValue(
-        const JsonValue& v, 
-        T* out, 
-        enable_if_vector<T>* = nullptr);
+      void ReadValue(T* out, enable_if_vector<T>* = nullptr);
 
       /**
-      * @brief Reads a JSON value when the requested value type is serializable
+      * @brief Reads the current value when the requested value type is
+      *        serializable
       *
       * @tparam A serializable pointer type
       *
       * @remarks This call doesn't actually adjust the out parameter, it
       *          simply calls ISerializable::Deserialize on the pointer
       *
-      * @param[in] v The current JSON value
       * @param[in] out The retrieved value
       */
       template <typename T>
-      void ReadValue(
-        const JsonValue& v, 
-        T* out, 
-        enable_if_serializable<T>* = nullptr);
+      void ReadValue(T* out, enable_if_serializable<T>* = nullptr);
 
       /**
-      * @brief Reads a JSON value when the requested value type is unknown
+      * @brief Reads the current value when the requested value type is
+      *        unknown
       *
       * @tparam A user-defined type
       *
       * @remarks This call requires specialization of LoadArchive::Deserialize
       *          to compile
       *
-      * @param[in] v The current JSON value
       * @param[in] out The retrieved value
       */
       template <typename T>
-      void ReadValue(
-        const JsonValue& v, 
-        T* out, 
-        enable_if_n_serializable<T>* = nullptr);
+      void ReadValue(T* out, enable_if_n_serializable<T>* = nullptr);
+
+      /**
+      * @brief Reads the current value as a number
+      *
+      * @param[out] out The number
+      *
+      * @return Was the current value a number?
+      */
+      bool ReadNumber(double* out);
+
+      /**
+      * @brief Reads the current value as a boolean
+      *
+      * @param[out] out The boolean
+      *
+      * @return Was the current value a boolean?
+      */
+      bool ReadBoolean(bool* out);
+
+      /**
+      * @brief Reads the current value as a string
+      *
+      * @param[out] out The string
+      *
+      * @return Was the current value a string?
+      */
+      bool ReadString(String* out);
 
       /**
-      * @brief Enters a JSON object by token name
+      * @return The size of the current value if it is an array, or 0
+      */
+      size_t ScopeArraySize();
+
+      /**
+      * @return Does the current value exist?
+      */
+      bool HasScope();
+
+      /**
+      * @brief Enters an element of the current array
       *
-      * @param[in] token The token to traverse the JSON tree with
+      * @param[in] i The index of the element
       */
-      void EnterScope(const String& token);
+      void EnterIndex(size_t i);
 
       /**
-      * @return The current JSON scope we're in
+      * @brief Enters a member of the current object
+      *
+      * @param[in] name The name of the member
+      * @param[in] hash The hash of the name, see ArchiveName::Hash
+      */
+      void EnterScope(const char* name, uint32_t hash);
+
+      /**
+      * @see LoadArchive::EnterScope
+      *
+      * @remarks Hashes the name at runtime
       */
-      const JsonValue* CurrentScope();
+      void EnterScope(const char* name);
 
       /**
-      * @brief Exit the current scope and pop one token off of the current
-      *        token URI
+      * @return The current node, or BinaryArchive::kInvalidIndex if the
+      *         current value doesn't exist
+      */
+      uint32_t CurrentNode() const;
+
+      /**
+      * @brief Exits the current scope by popping a node off of the stack
       */
       void ExitScope();
 
@@ -243,12 +307,8 @@ namespace snuffbox
 
       bool is_ok_; //!< Can we use this archive for deserialization?
 
-      rapidjson::GenericDocument<
-        rapidjson::UTF8<>, 
-        RapidJsonAllocator,
-        RapidJsonStackAllocator> document_; //!< The loaded Json document
-
-      String scope_; //!< The current URI to the current JSON scope
+      BinaryArchive binary_; //!< The loaded archive
+      Vector<uint32_t> nodes_; //!< The stack of entered nodes
     };
 
     //--------------------------------------------------------------------------
@@ -272,11 +332,9 @@ namespace snuffbox
         "Out parameters for a LoadArchive should be of a de-referencable\
          pointer type");
 
-      if (CurrentScope() != nullptr)
+      if (HasScope() == true)
       {
-        ReadValue<typename eastl::remove_pointer<T>::type>(
-          *CurrentScope(),
-          value);
+        ReadValue<typename eastl::remove_pointer<T>::type>(value);
       }
 
       ExitScope();
@@ -286,67 +344,52 @@ namespace snuffbox
     template <>
     inline void LoadArchive::operator()(ArchiveName value)
     {
-      EnterScope(value.name);
+      EnterScope(value.name, value.hash);
     }
 
     //--------------------------------------------------------------------------
     template <typename T>
-    inline void LoadArchive::ReadValue(
-      const JsonValue& v,
-      T* out,
-      enable_if_number<T>*)
+    inline void LoadArchive::ReadValue(T* out, enable_if_number<T>*)
     {
-      if (v.IsNumber() == false)
+      double value;
+
+      if (ReadNumber(&value) == false)
       {
         return;
       }
 
-      *out = static_cast<T>(v.GetDouble());
+      *out = static_cast<T>(value);
     }
 
     //--------------------------------------------------------------------------
     template <typename T>
-    inline void LoadArchive::ReadValue(
-      const JsonValue& v,
-      T* out,
-      enable_if_enum<T>*)
+    inline void LoadArchive::ReadValue(T* out, enable_if_enum<T>*)
     {
-      ReadValue<int>(v, reinterpret_cast<int*>(out));
+      ReadValue<int>(reinterpret_cast<int*>(out));
     }
 
     //--------------------------------------------------------------------------
     template <typename T>
-    inline void LoadArchive::ReadValue(
-      const JsonValue& v,
-      T* out,
-      enable_if_vector<T>*)
+    inline void LoadArchive::ReadValue(T* out, enable_if_vector<T>*)
     {
-      if (v.IsArray() == false)
-      {
-        return;
-      }
-
-      const rapidjson::GenericArray<true, JsonValue::ValueType>& arr = 
-        v.GetArray();
-
-      rapidjson::SizeType size = arr.Size();
+      size_t size = ScopeArraySize();
 
       T& vec = *out;
 
       using Type = typename T::value_type;
 
-      for (rapidjson::SizeType i = 0; i < size; ++i)
+      for (size_t i = 0; i < size; ++i)
       {
-        EnterScope(StringUtils::ToString(i));
+        EnterIndex(i);
 
         if (vec.size() <= i)
         {
           vec.push_back(Type());
-          ReadValue<Type>(v[i], vec.end());
+          ReadValue<Type>(&vec.back());
         }
         else
         {
-          ReadValue<Type>(v[i], &vec.at(i));
+          ReadValue<Type>(&vec.at(i));
         }
 
         ExitScope();
@@ -355,20 +398,14 @@ namespace snuffbox
 
     //--------------------------------------------------------------------------
     template <typename T>
-    inline void LoadArchive::ReadValue(
-      const JsonValue& v,
-      T* out,
-      enable_if_serializable<T>*)
+    inline void LoadArchive::ReadValue(T* out, enable_if_serializable<T>*)
     {
       (*out)->Deserialize(*this);
     }
 
     //--------------------------------------------------------------------------
     template <typename T>
-    inline void LoadArchive::ReadValue(
-      const JsonValue& v,
-      T* out,
-      enable_if_n_serializable<T>*)
+    inline void LoadArchive::ReadValue(T* out, enable_if_n_serializable<T>*)
     {
       Deserialize<T>(*this, out);
     }
@@ -376,49 +413,42 @@ namespace snuffbox
     //--------------------------------------------------------------------------
     template <>
     inline void LoadArchive::ReadValue(
-      const JsonValue& v,
       bool* out,
       enable_if_n_serializable<bool>*)
     {
-      if (v.IsBool() == false)
+      if (ReadBoolean(out) == false)
       {
         *out = false;
-        return;
       }
-
-      *out = v.GetBool();
     }
 
     //--------------------------------------------------------------------------
     template <>
     inline void LoadArchive::ReadValue(
-      const JsonValue& v,
       String* out,
       enable_if_n_serializable<String>*)
     {
-      if (v.IsString() == false)
+      if (ReadString(out) == false)
       {
         *out = "";
-        return;
       }
-
-      *out = v.GetString();
     }
 
     //--------------------------------------------------------------------------
     template <>
     inline void LoadArchive::ReadValue(
-      const JsonValue& v,
       UUID* out,
       enable_if_n_serializable<UUID>*)
     {
-      if (v.IsString() == false)
+      String str;
+
+      if (ReadString(&str) == false)
       {
         *out = UUID();
         return;
       }
 
-      *out = UUID::FromString(v.GetString());
+      *out = UUID::FromString(str);
     }
 
     //--------------------------------------------------------------------------
@@ -427,28 +457,13 @@ namespace snuffbox
     {
       EnterScope(name);
 
-      const JsonValue& current = *CurrentScope();
-      
-      if (current.IsArray() == false)
+      if (i < ScopeArraySize())
       {
-        return;
-      }
-
-      const rapidjson::GenericArray<true, JsonValue::ValueType>& arr =
-        current.GetArray();
-
-      if (i > arr.Size())
-      {
-        return;
+        EnterIndex(i);
+        ReadValue<typename eastl::remove_pointer<T>::type>(out);
+        ExitScope();
       }
 
-      EnterScope(StringUtils::ToString(i));
-
-      ReadValue<typename eastl::remove_pointer<T>::type>(
-        arr[static_cast<rapidjson::SizeType>(i)], out);
-
-      ExitScope();
-
       ExitScope();
     }
 
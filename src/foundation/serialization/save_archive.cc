@@ -1,10 +1,12 @@
 #include "foundation/serialization/save_archive.h"
-#include "foundation/auxiliary/string_utils.h"
+#include "foundation/serialization/binary_archive.h"
 #include "foundation/auxiliary/logger.h"
 
-#include "foundation/io/file.h"
+#include "foundation/io/file_writer.h"
 
 #include <memory>
+#include <cmath>
+#include <cstdio>
 
 namespace snuffbox
 {
@@ -25,226 +27,320 @@ namespace snuffbox
 
     //--------------------------------------------------------------------------
     void SaveArchive::WriteName(const char* name)
+    {
+      WriteName(name, strlen(name));
+    }
+
+    //--------------------------------------------------------------------------
+    void SaveArchive::WriteName(const char* name, size_t length)
     {
       WriteIdentifier(Identifiers::kName);
 
-      size_t size = strlen(name);
-      size_t off = Reserve<uint8_t>(size + 1);
+      size_t size = length + 1;
+      size_t off = Reserve<uint8_t>(size);
+
+      memcpy(buffer_.data() + off, name, size);
+    }
+
+    //--------------------------------------------------------------------------
+    const char SaveArchive::JsonStream::kTabs_[] = 
+      "\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t";
+
+    //--------------------------------------------------------------------------
+    const int SaveArchive::JsonStream::kMaxTabs_ = 
+      static_cast<int>(sizeof(SaveArchive::JsonStream::kTabs_) - 1);
+
+    //--------------------------------------------------------------------------
+    SaveArchive::JsonStream::JsonStream(String* out) :
+      string_(out),
+      file_(nullptr)
+    {
+
+    }
+
+    //--------------------------------------------------------------------------
+    SaveArchive::JsonStream::JsonStream(FileWriter* out) :
+      string_(nullptr),
+      file_(out)
+    {
+
+    }
+
+    //--------------------------------------------------------------------------
+    void SaveArchive::JsonStream::Write(const char* str, size_t size)
+    {
+      if (string_ != nullptr)
+      {
+        string_->append(str, size);
+        return;
+      }
+
+      file_->Write(reinterpret_cast<const uint8_t*>(str), size);
+    }
+
+    //--------------------------------------------------------------------------
+    void SaveArchive::JsonStream::Write(char c)
+    {
+      if (string_ != nullptr)
+      {
+        string_->push_back(c);
+        return;
+      }
+
+      file_->Write(reinterpret_cast<const uint8_t*>(&c), 1);
+    }
+
+    //--------------------------------------------------------------------------
+    void SaveArchive::JsonStream::WriteIndent(int indent)
+    {
+      while (indent > 0)
+      {
+        int count = indent < kMaxTabs_ ? indent : kMaxTabs_;
+        Write(kTabs_, static_cast<size_t>(count));
+
+        indent -= count;
+      }
+    }
+
+    //--------------------------------------------------------------------------
+    void SaveArchive::JsonStream::WriteNumber(double value)
+    {
+      char buffer[32];
+
+      if (
+        value > -1e6 && 
+        value < 1e6 && 
+        value == static_cast<double>(static_cast<int32_t>(value)) &&
+        (value != 0.0 || std::signbit(value) == false))
+      {
+        int32_t integer = static_cast<int32_t>(value);
+        uint32_t magnitude = static_cast<uint32_t>(
+          integer < 0 ? -integer : integer);
+
+        char* end = buffer + sizeof(buffer);
+        char* at = end;
+
+        do
+        {
+          *--at = static_cast<char>('0' + magnitude % 10);
+          magnitude /= 10;
+        } while (magnitude > 0);
+
+        if (integer < 0)
+        {
+          *--at = '-';
+        }
+
+        Write(at, static_cast<size_t>(end - at));
+        return;
+      }
 
-      for (size_t i = 0; i < size; ++i)
+      int length = snprintf(buffer, sizeof(buffer), "%g", value);
+
+      if (length <= 0)
       {
-        buffer_.at(off + i) = name[i];
+        return;
+      }
+
+      for (int i = 0; i < length; ++i)
+      {
+        if (buffer[i] == ',')
+        {
+          buffer[i] = '.';
+        }
       }
 
-      buffer_.at(off + size) = '\0';
+      Write(buffer, static_cast<size_t>(length));
+    }
+
+    //--------------------------------------------------------------------------
+    void SaveArchive::WriteJson(JsonStream& out) const
+    {
+      if (buffer_.empty() == true)
+      {
+        return;
+      }
+
+      size_t i = 0;
+      WriteJsonValue(i, buffer_.data(), 0, out);
     }
 
     //--------------------------------------------------------------------------
-    String SaveArchive::WriteJsonValue(
+    void SaveArchive::WriteJsonValue(
       size_t& i, 
       const uint8_t* buffer,
-      int indent)
+      int indent,
+      JsonStream& out)
     {
-      Identifiers id = *reinterpret_cast<const Identifiers*>(buffer + i);
+      Identifiers id = static_cast<Identifiers>(buffer[i]);
       ++i;
 
-      String result;
-
       switch (id)
       {
 
       case Identifiers::kNumber:
-        result = WriteJsonNumber(i, buffer);
+        WriteJsonNumber(i, buffer, out);
         break;
 
       case Identifiers::kBoolean:
-        result = WriteJsonBoolean(i, buffer);
+        WriteJsonBoolean(i, buffer, out);
         break;
 
       case Identifiers::kString:
-        result = WriteJsonString(i, buffer);
+        WriteJsonString(i, buffer, out);
         break;
 
       case Identifiers::kArray:
-        result = WriteJsonArray(i, buffer, indent);
+        WriteJsonArray(i, buffer, indent, out);
         break;
 
       case Identifiers::kObjectStart:
-        result = WriteJsonObject(i, buffer, indent);
+        WriteJsonObject(i, buffer, indent, out);
         break;
 
       default:
         break;
       }
-
-      return result;
     }
 
     //--------------------------------------------------------------------------
-    String SaveArchive::WriteJsonNumber(size_t& i, const uint8_t* buffer)
+    void SaveArchive::WriteJsonNumber(
+      size_t& i, 
+      const uint8_t* buffer, 
+      JsonStream& out)
     {
-      const size_t size = sizeof(double);
-
-      double value = *reinterpret_cast<const double*>(buffer + i);
-      i += size;
+      double value;
+      memcpy(&value, buffer + i, sizeof(double));
 
-      String str = StringUtils::ToString<double>(value);
+      i += sizeof(double);
 
-      int idx;
-      if ((idx = StringUtils::Contains(str, ",")) >= 0)
-      {
-        str.at(idx) = '.';
-      }
-
-      return str;
+      out.WriteNumber(value);
     }
 
     //--------------------------------------------------------------------------
-    String SaveArchive::WriteJsonBoolean(size_t& i, const uint8_t* buffer)
+    void SaveArchive::WriteJsonBoolean(
+      size_t& i, 
+      const uint8_t* buffer, 
+      JsonStream& out)
     {
-      const size_t size = sizeof(bool);
+      bool value = buffer[i] != 0;
+      ++i;
 
-      bool value = *reinterpret_cast<const bool*>(buffer + i);
-      i += size;
+      if (value == true)
+      {
+        out.Write("true", 4);
+        return;
+      }
 
-      return value == true ? "true" : "false";
+      out.Write("false", 5);
     }
 
     //--------------------------------------------------------------------------
-    String SaveArchive::WriteJsonString(size_t& i, const uint8_t* buffer)
+    void SaveArchive::WriteJsonString(
+      size_t& i, 
+      const uint8_t* buffer, 
+      JsonStream& out)
     {
-      char current = buffer[i];
-
-      String result = "\"";
-      while (current != '\0')
-      {
-        result += current;
+      const char* str = reinterpret_cast<const char*>(buffer + i);
+      size_t length = strlen(str);
 
-        ++i;
-        current = buffer[i];
-      }
+      out.Write('"');
+      out.Write(str, length);
+      out.Write('"');
 
-      result += "\"";
-      ++i;
-
-      return result;
+      i += length + 1;
     }
 
     //--------------------------------------------------------------------------
-    String SaveArchive::WriteJsonArray(
+    void SaveArchive::WriteJsonArray(
       size_t& i, 
       const uint8_t* buffer, 
-      int indent)
+      int indent,
+      JsonStream& out)
     {
-      String result = IndentationString(indent) + "[";
+      out.WriteIndent(indent);
+      out.Write('[');
 
       ++indent;
 
-      size_t size = *reinterpret_cast<const size_t*>(buffer + i);
-      Identifiers id;
-      
-      i += sizeof(size_t);
+      size_t size;
+      memcpy(&size, buffer + i, sizeof(size_t));
 
-      size_t e = 0;
+      i += sizeof(size_t);
 
-      String indent_string = "\n" + IndentationString(indent);
+      Identifiers id;
 
-      while (e < size)
+      for (size_t e = 0; e < size; ++e)
       {
-        id = *reinterpret_cast<const Identifiers*>(buffer + i);
+        id = static_cast<Identifiers>(buffer[i]);
 
-        if (id == Identifiers::kObjectStart || id == Identifiers::kArray)
-        {
-          result += "\n" + WriteJsonValue(i, buffer, indent);
-        }
-        else
+        out.Write('\n');
+
+        if (id != Identifiers::kObjectStart && id != Identifiers::kArray)
         {
-          result += indent_string + WriteJsonValue(i, buffer, indent);
+          out.WriteIndent(indent);
         }
 
-        ++e;
+        WriteJsonValue(i, buffer, indent, out);
 
-        if (e == size)
+        if (e + 1 < size)
         {
-          continue;
+          out.Write(',');
         }
-
-        result += ",";
       }
 
-      result += "\n" + IndentationString(indent - 1) + "]";
-
-      return result;
+      out.Write('\n');
+      out.WriteIndent(indent - 1);
+      out.Write(']');
     }
 
     //--------------------------------------------------------------------------
-    String SaveArchive::WriteJsonObject(
+    void SaveArchive::WriteJsonObject(
       size_t& i, 
       const uint8_t* buffer, 
-      int indent)
+      int indent,
+      JsonStream& out)
     {
-      String result = IndentationString(indent) + "{";
+      out.WriteIndent(indent);
+      out.Write('{');
 
       ++indent;
 
-      Identifiers id = *reinterpret_cast<const Identifiers*>(buffer + i);
+      Identifiers id = static_cast<Identifiers>(buffer[i]);
 
-      auto GetName = [&i, &id, buffer]()
+      while (id != Identifiers::kObjectEnd)
       {
         Logger::Assert(id == Identifiers::kName, "Unexpected token in archive");
         ++i;
-        String result = WriteJsonString(i, buffer);
-        id = *reinterpret_cast<const Identifiers*>(buffer + i);
 
-        return result;
-      };
+        out.Write('\n');
+        out.WriteIndent(indent);
 
-      String indent_string = "\n" + IndentationString(indent);
-      Identifiers next = *reinterpret_cast<const Identifiers*>(buffer + i + 1);
+        WriteJsonString(i, buffer, out);
+        out.Write(" : ", 3);
 
-      if (next == Identifiers::kObjectEnd)
-      {
-        ++i;
-      }
-      else
-      {
-        while (id != Identifiers::kObjectEnd)
+        id = static_cast<Identifiers>(buffer[i]);
+
+        if (id == Identifiers::kObjectStart || id == Identifiers::kArray)
         {
-          result += indent_string + GetName() + " : ";
-          if (id == Identifiers::kObjectStart || id == Identifiers::kArray)
-          {
-            result += "\n";
-          }
-          result += WriteJsonValue(i, buffer, indent);
-
-          id = *reinterpret_cast<const Identifiers*>(buffer + i);
-
-          if (id == Identifiers::kObjectEnd)
-          {
-            ++i;
-            continue;
-          }
-
-          result += ",";
+          out.Write('\n');
         }
-      }
 
-      result += "\n" + IndentationString(indent - 1) + "}";
+        WriteJsonValue(i, buffer, indent, out);
 
-      return result;
-    }
+        id = static_cast<Identifiers>(buffer[i]);
 
-    //--------------------------------------------------------------------------
-    String SaveArchive::IndentationString(int indent)
-    {
-      String result = "";
-
-      for (int i = 0; i < indent; ++i)
-      {
-        result += '\t';
+        if (id != Identifiers::kObjectEnd)
+        {
+          out.Write(',');
+        }
       }
 
-      return result;
+      ++i;
+
+      out.Write('\n');
+      out.WriteIndent(indent - 1);
+      out.Write('}');
     }
 
     //--------------------------------------------------------------------------
@@ -256,30 +352,57 @@ namespace snuffbox
       buffer_.clear();
     }
 
+    //--------------------------------------------------------------------------
+    const Vector<uint8_t>& SaveArchive::buffer() const
+    {
+      return buffer_;
+    }
+
     //--------------------------------------------------------------------------
     bool SaveArchive::WriteFile(const Path& path) const
     {
-      String json = ToMemory();
+      FileWriter writer(path);
+      JsonStream stream(&writer);
 
-      File file(path, FileFlags::kWrite);
+      WriteJson(stream);
 
-      if (file.is_ok() == false)
-      {
-        return false;
-      }
+      return writer.Commit(true);
+    }
+
+    //--------------------------------------------------------------------------
+    bool SaveArchive::WriteBinaryFile(const Path& path) const
+    {
+      Vector<uint8_t> binary = ToBinary();
 
-      file.Write(reinterpret_cast<const uint8_t*>(json.c_str()), json.size());
+      FileWriter writer(path, true, binary.size());
+      writer.Write(binary.data(), binary.size());
 
-      return true;
+      return writer.Commit(true);
     }
 
     //--------------------------------------------------------------------------
     String SaveArchive::ToMemory() const
     {
-      size_t i = 0;
-      String json = WriteJsonValue(i, buffer_.data());
+      String json;
+      json.reserve(buffer_.size() * 2);
+
+      JsonStream stream(&json);
+      WriteJson(stream);
 
       return json;
     }
+
+    //--------------------------------------------------------------------------
+    Vector<uint8_t> SaveArchive::ToBinary() const
+    {
+      BinaryArchive binary;
+
+      if (binary.Build(buffer_.data(), buffer_.size()) == false)
+      {
+        return Vector<uint8_t>();
+      }
+
+      return binary.data();
+    }
   }
 }
@@ -12,12 +12,15 @@
 
 #include <cinttypes>
 #include <cstddef>
+#include <cstring>
 
 
 namespace snuffbox
 {
   namespace foundation
   {
+    class FileWriter;
+
     /**
     * @brief Used to archive values for serialization
     *
@@ -27,13 +30,17 @@ namespace snuffbox
     * kept intact for backwards compatibility.
     *
     * The archive stores its data as JSON on disk, which can then be loaded
-    * again through a LoadArchive
+    * again through a LoadArchive. For data that doesn't need to be human
+    * readable, the archive can be stored in the binary format of
+    * a BinaryArchive instead, which is loaded without any parsing.
     *
     * @author Daniel Konings
     */
     class SaveArchive
     {
 
+      friend class FieldCodec;
+
     public:
 
       /**
@@ -82,19 +89,9 @@ namespace snuffbox
     protected:
 
       /**
-      * @brief Common identifiers to represent what type of value is followed
-      *        in the archive's buffer
+      * @see ArchiveIdentifiers
       */
-      enum class Identifiers : uint8_t
-      {
-        kName,
-        kNumber,
-        kBoolean,
-        kString,
-        kArray,
-        kObjectStart,
-        kObjectEnd
-      };
+      using Identifiers = ArchiveIdentifiers;
 
       /**
       * @brief Reserves space in the archive's buffer
@@ -134,6 +131,13 @@ namespace snuffbox
       */
       void WriteName(const char* name);
 
+      /**
+      * @see SaveArchive::WriteName
+      *
+      * @param[in] length The length of the name
+      */
+      void WriteName(const char* name, size_t length);
+
       /**
       * @brief Writes a number value to the archive's buffer
       *
@@ -200,88 +204,165 @@ namespace snuffbox
       void WriteValue(const T& value, enable_if_n_serializable<T>* = nullptr);
 
       /**
-      * @brief Writes an unknown value as a JSON string
+      * @brief Streams JSON text into a string or straight into a file, so
+      *        that the JSON of an archive is written in a single pass
+      *
+      * @author Daniel Konings
+      */
+      class JsonStream
+      {
+
+      public:
+
+        /**
+        * @brief Creates a stream that appends to a string
+        *
+        * @param[in] out The string to append to
+        */
+        JsonStream(String* out);
+
+        /**
+        * @brief Creates a stream that writes to a file
+        *
+        * @param[in] out The opened file writer
+        */
+        JsonStream(FileWriter* out);
+
+        /**
+        * @brief Writes a block of characters
+        *
+        * @param[in] str The characters to write
+        * @param[in] size The number of characters
+        */
+        void Write(const char* str, size_t size);
+
+        /**
+        * @brief Writes a single character
+        *
+        * @param[in] c The character to write
+        */
+        void Write(char c);
+
+        /**
+        * @brief Writes the indentation for a level of nesting
+        *
+        * @param[in] indent The number of indentations to do
+        */
+        void WriteIndent(int indent);
+
+        /**
+        * @brief Writes a number the way a standard stream formats a double,
+        *        with a period as decimal separator
+        *
+        * Whole numbers that are printed without an exponent are formatted
+        * by hand, as they are by far the most common.
+        *
+        * @param[in] value The number to write
+        */
+        void WriteNumber(double value);
+
+      private:
+
+        String* string_; //!< The string to append to, or nullptr
+        FileWriter* file_; //!< The file to write to, or nullptr
+
+        /**
+        * @brief A run of tabs to write indentation from
+        */
+        static const char kTabs_[];
+
+        /**
+        * @brief The number of tabs in JsonStream::kTabs_
+        */
+        static const int kMaxTabs_;
+      };
+
+      /**
+      * @brief Writes the contents of the archive as JSON
+      *
+      * @param[in] out The stream to write to
+      */
+      void WriteJson(JsonStream& out) const;
+
+      /**
+      * @brief Writes an unknown value as JSON
       *
       * @param[in] i The current index within the buffer
       * @param[in] buffer The current buffer
       * @param[in] indent The amount of indentation
-      *
-      * @return The stringified JSON value
+      * @param[in] out The stream to write to
       */
-      static String WriteJsonValue(
+      static void WriteJsonValue(
         size_t& i, 
         const uint8_t* buffer, 
-        int indent = 0);
+        int indent,
+        JsonStream& out);
 
       /**
-      * @brief Writes a number value as a JSON string
+      * @brief Writes a number value as JSON
       *
       * @remarks These numbers are always of double precision
       *
       * @param[in] i The current index within the buffer
       * @param[in] buffer The current buffer
-      *
-      * @return The stringified JSON number
+      * @param[in] out The stream to write to
       */
-      static String WriteJsonNumber(size_t& i, const uint8_t* buffer);
+      static void WriteJsonNumber(
+        size_t& i, 
+        const uint8_t* buffer, 
+        JsonStream& out);
 
       /**
-      * @brief Writes a number value as a JSON boolean
+      * @brief Writes a boolean value as JSON
       *
       * @param[in] i The current index within the buffer
       * @param[in] buffer The current buffer
-      *
-      * @return The stringified JSON boolean
+      * @param[in] out The stream to write to
       */
-      static String WriteJsonBoolean(size_t& i, const uint8_t* buffer);
+      static void WriteJsonBoolean(
+        size_t& i, 
+        const uint8_t* buffer, 
+        JsonStream& out);
 
       /**
-      * @brief Writes a number value as a JSON string
+      * @brief Writes a string value as JSON
       *
       * @param[in] i The current index within the buffer
       * @param[in] buffer The current buffer
-      *
-      * @return The stringified JSON string
+      * @param[in] out The stream to write to
       */
-      static String WriteJsonString(size_t& i, const uint8_t* buffer);
+      static void WriteJsonString(
+        size_t& i, 
+        const uint8_t* buffer, 
+        JsonStream& out);
 
       /**
-      * @brief Writes a number value as a JSON array
+      * @brief Writes an array value as JSON
       *
       * @param[in] i The current index within the buffer
       * @param[in] buffer The current buffer
       * @param[in] indent The amount of indentation
-      *
-      * @return The stringified JSON array
+      * @param[in] out The stream to write to
       */
-      static String WriteJsonArray(
+      static void WriteJsonArray(
         size_t& i, 
         const uint8_t* buffer, 
-        int indent);
+        int indent,
+        JsonStream& out);
 
       /**
-      * @brief Writes a number value as a JSON object
+      * @brief Writes an object value as JSON
       *
       * @param[in] i The current index within the buffer
       * @param[in] buffer The current buffer
       * @param[in] indent The amount of indentation
-      *
-      * @return The stringified JSON object
+      * @param[in] out The stream to write to
       */
-      static String WriteJsonObject(
+      static void WriteJsonObject(
         size_t& i, 
         const uint8_t* buffer, 
-        int indent);
-
-      /**
-      * @brief Retrieves the indentation string to prepend based on the current
-      *        number of indentations
-      *
-      * @param[in] indent The number of indentations to do
-      *
-      * @return The resulting string
-      */
-      static String IndentationString(int indent);
+        int indent,
+        JsonStream& out);
 
     public:
 
@@ -297,17 +378,53 @@ namespace snuffbox
       /**
       * @brief Flushes the contents of the archive to a file, as a JSON string
       *
+      * The JSON is streamed into the file as it is generated, the file is
+      * only replaced once all of it was written and synced to disk.
+      *
       * @param[in] path The path to the file
       *
       * @return Were we able to save the file?
       */
       bool WriteFile(const Path& path) const;
 
+      /**
+      * @brief Flushes the contents of the archive to a file, in the binary
+      *        format of a BinaryArchive
+      *
+      * The file is only replaced once all of it was written and synced to
+      * disk.
+      *
+      * @param[in] path The path to the file
+      *
+      * @return Were we able to save the file?
+      */
+      bool WriteBinaryFile(const Path& path) const;
+
       /**
       * @return Retrieves the contents of the archive as a JSON string
       */
       String ToMemory() const;
 
+      /**
+      * @brief Retrieves the contents of the archive in the binary format of
+      *        a BinaryArchive, which a LoadArchive reads without parsing any
+      *        text
+      *
+      * @return The binary data, empty if the archive is empty
+      */
+      Vector<uint8_t> ToBinary() const;
+
+      /**
+      * @brief Retrieves the tagged buffer of the archive, to keep it in
+      *        memory and load it again with LoadArchive::FromTagged
+      *
+      * @remarks The tagged buffer is only meant to be used within the same
+      *          process, it should never be persisted
+      *
+      * @return The tagged buffer
+      */
+      const Vector<uint8_t>& buffer() const;
+
     private:
 
       int archiving_; //!< Are we currently archiving?
@@ -330,12 +447,7 @@ namespace snuffbox
     inline void SaveArchive::WriteRaw(const T& value, size_t size)
     {
       size_t start_at = Reserve<T>(size);
-      const uint8_t* data = reinterpret_cast<const uint8_t*>(&value);
-      
-      for (size_t i = 0; i < size; ++i)
-      {
-        buffer_.at(start_at + i) = data[i];
-      }
+      memcpy(buffer_.data() + start_at, &value, size);
     }
 
     //--------------------------------------------------------------------------
@@ -1,5 +1,6 @@
 #include "foundation/win32/win32_directory.h"
 #include "foundation/win32/win32_include.h"
+#include "foundation/io/metadata_cache.h"
 
 #include <shellapi.h>
 
@@ -87,6 +88,7 @@ namespace snuffbox
       };
 
       SHFileOperationA(&file_op);
+      MetadataCache::Invalidate(path);
     }
 
     //--------------------------------------------------------------------------
@@ -137,7 +139,14 @@ namespace snuffbox
         }
       }
 
-      return Create(path);
+      if (Create(path) == false)
+      {
+        return false;
+      }
+
+      MetadataCache::Store(path, true);
+
+      return true;
     }
 
     //--------------------------------------------------------------------------
@@ -165,6 +174,12 @@ namespace snuffbox
         }
 
         result.push_back(start_at / ffd.cFileName);
+
+        Path& child = result.back();
+        child.set_is_directory(
+          (ffd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) > 0);
+
+        MetadataCache::Store(child, child.is_directory());
       } while (FindNextFileA(current, &ffd) != 0);
 
       FindClose(current);
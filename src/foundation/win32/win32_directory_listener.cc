@@ -74,7 +74,7 @@ namespace snuffbox
               OnDirectoryChanged& cb = *callbacks[i];
               if (cb != nullptr)
               {
-                cb(path_);
+                cb(path_, DirectoryEvent::kUnknown);
               }
 
               if (FindNextChangeNotification(handles[i]) == FALSE)
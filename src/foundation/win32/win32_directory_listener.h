@@ -24,7 +24,8 @@ namespace snuffbox
     * The listener only tells the user the root directory or its subdirectories
     * have changed. There is however a distinction between tree changes and
     * file changes, for which there are different callbacks. The listener
-    * doesn't specifically list which file or directory has changed.
+    * doesn't specifically list which file or directory has changed, every
+    * change is reported as DirectoryEvent::kUnknown on the root.
     *
     * @author Daniel Konings
     */
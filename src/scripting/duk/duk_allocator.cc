@@ -11,7 +11,7 @@ namespace snuffbox
 
     //--------------------------------------------------------------------------
     DukAllocator::DukAllocator(size_t max_size) :
-      foundation::Memory::DefaultAllocator(max_size)
+      foundation::Memory::DefaultAllocator(max_size, false, "duktape")
     {
 
     }
@@ -37,21 +37,7 @@ namespace snuffbox
         return nullptr;
       }
 
-      size_t old_size = alloc->GetSize(ptr);
-      void* block = foundation::Memory::Allocate(size, alloc);
-
-      if (size >= old_size)
-      {
-        memcpy(block, ptr, old_size);
-      }
-      else
-      {
-        memcpy(block, ptr, size);
-      }
-
-      foundation::Memory::Deallocate(ptr);
-
-      return block;
+      return foundation::Memory::Reallocate(ptr, size, alloc);
     }
 
     //--------------------------------------------------------------------------
@@ -42,9 +42,7 @@ namespace snuffbox
       *        to a duktape heap
       *
       * The udata parameter will contain a pointer to this allocator.
-      * This functions is naively implemented by simply deallocating the
-      * previous pointer and allocating a new block with the new size.
-      * The memory in the old block is copied into this newly allocated block
+      * Blocks are resized in place where possible, see Memory::Reallocate
       */
       static void* DukReallocate(void* udata, void* ptr, size_t size);
 
@@ -84,9 +84,8 @@ namespace snuffbox
         duk_dup(context_, stack_idx - 2);
         duk_put_prop_string(context_, -2, DUK_HIDDEN_REF);
       }
-      
-      foundation::String string_id = foundation::StringUtils::ToString(id);
-      duk_put_prop_string(context_, -2, string_id.c_str());
+
+      duk_put_prop_index(context_, -2, static_cast<duk_uarridx_t>(id));
       
       duk_pop(context_);
     }
@@ -96,8 +95,7 @@ namespace snuffbox
     {
       duk_push_global_stash(context_);
 
-      foundation::String string_id = foundation::StringUtils::ToString(id);
-      if (duk_get_prop_string(context_, -1, string_id.c_str()) > 0)
+      if (duk_get_prop_index(context_, -1, static_cast<duk_uarridx_t>(id)) > 0)
       {
         duk_get_prop_string(context_, -1, DUK_HIDDEN_PTR);
         void* hptr = duk_get_pointer(context_, -1);
@@ -116,12 +114,12 @@ namespace snuffbox
     //--------------------------------------------------------------------------
     void DukWrapper::RemoveStashedObject(size_t id) const
     {
-      foundation::String string_id = foundation::StringUtils::ToString(id);
-      
+      duk_uarridx_t idx = static_cast<duk_uarridx_t>(id);
+
       duk_push_global_stash(context_);
-      if (duk_get_prop_string(context_, -1, string_id.c_str()) <= 0)
+      if (duk_get_prop_index(context_, -1, idx) <= 0)
       {
-        duk_pop(context_);
+        duk_pop_2(context_);
         return;
       }
 
@@ -134,7 +132,7 @@ namespace snuffbox
 
       duk_pop_3(context_);
 
-      duk_del_prop_string(context_, -1, string_id.c_str());
+      duk_del_prop_index(context_, -1, idx);
 
       duk_pop(context_);
     }
@@ -3,6 +3,8 @@
 #include <tools/compilers/utils/glslang.h>
 
 #include <foundation/io/file.h>
+#include <foundation/io/file_writer.h>
+#include <foundation/io/metadata_cache.h>
 #include <foundation/auxiliary/string_utils.h>
 
 namespace snuffbox
@@ -16,6 +18,7 @@ namespace snuffbox
     Builder::Builder() :
       is_ok_(false),
       build_directory_(""),
+      io_(1),
       on_finished_(nullptr),
       on_changed_(nullptr)
     {
@@ -80,13 +83,13 @@ namespace snuffbox
       FindFileChanges(source_tree_.items());
 
       listener_.SetCallbacks(
-        [&](const foundation::Path&)
+        [&](const foundation::Path& path, foundation::DirectoryEvent evt)
         { 
-          SyncDirectories(); 
+          HandleDirectoryChange(path, evt);
         },
-        [&](const foundation::Path&)
+        [&](const foundation::Path& path, foundation::DirectoryEvent evt)
         {
-          FindFileChanges(source_tree_.items());
+          HandleFileChange(path, evt);
         });
 
       listener_.Listen(source_dir);
@@ -98,6 +101,9 @@ namespace snuffbox
     void Builder::IdleNotification()
     {
       scheduler_.IdleNotification(this);
+
+      io_.Submit();
+      io_.Poll();
     }
 
     //--------------------------------------------------------------------------
@@ -113,28 +119,28 @@ namespace snuffbox
 
       foundation::Path build = build_directory_ / relative_build;
 
-      foundation::File fout(build, foundation::FileFlags::kWrite);
+      BuildItem built = item;
+      built.relative = relative_build;
 
-      if (fout.is_ok() == false)
+      io_.Write(build, buffer, size,
+        [this, built](const foundation::AsyncIO::Completion& completion)
       {
-        foundation::Logger::LogVerbosity<1>(
-          foundation::LogChannel::kBuilder,
-          foundation::LogSeverity::kError,
-          "Cannot save file '{0}'",
-          build);
-
-        return;
-      }
+        if (completion.success == false)
+        {
+          foundation::Logger::LogVerbosity<1>(
+            foundation::LogChannel::kBuilder,
+            foundation::LogSeverity::kError,
+            "Cannot save file '{0}'",
+            completion.path);
 
-      fout.Write(buffer, size);
-      
-      if (on_finished_ != nullptr)
-      {
-        BuildItem built = item;
-        built.relative = relative_build;
+          return;
+        }
 
-        on_finished_(built);
-      }
+        if (on_finished_ != nullptr)
+        {
+          on_finished_(built);
+        }
+      });
     }
 
     //--------------------------------------------------------------------------
@@ -146,6 +152,9 @@ namespace snuffbox
       }
 
       listener_.Stop();
+
+      io_.Submit();
+      io_.Wait();
     }
 
     //--------------------------------------------------------------------------
@@ -190,6 +199,9 @@ namespace snuffbox
       RemoveOld(build_tree_.items());
       build_tree_.Open(build_directory_);
 
+      stamps_.clear();
+      ReadStamps(build_tree_.items());
+
       source_tree_.Open(source_directory_);
       SyncItems(source_tree_.items());
 
@@ -227,7 +239,7 @@ namespace snuffbox
           continue;
         }
 
-        if (HasChanged(item_path) == true)
+        if (HasChanged(item_path, item.last_modified()) == true)
         {
           QueueForBuild(item_path);
         }
@@ -235,50 +247,280 @@ namespace snuffbox
     }
 
     //--------------------------------------------------------------------------
-    void Builder::SyncItems(const ItemList& source_items) const
+    void Builder::HandleDirectoryChange(
+      const foundation::Path& path,
+      foundation::DirectoryEvent evt)
     {
-      foundation::Path current = "";
-      foundation::Path current_build = "";
-      foundation::Directory dir;
+      foundation::MetadataCache::Invalidate(path);
+
+      if (
+        evt == foundation::DirectoryEvent::kUnknown ||
+        IsInDirectory(build_directory_, path) == true ||
+        IsInDirectory(source_directory_, path) == true)
+      {
+        SyncDirectories();
+        FindFileChanges(source_tree_.items());
+
+        return;
+      }
+
+      const foundation::DirectoryTreeItem* item = nullptr;
+
+      if (IsInDirectory(path, build_directory_) == true)
+      {
+        if (evt != foundation::DirectoryEvent::kRemoved)
+        {
+          return;
+        }
+
+        foundation::Path source = 
+          source_directory_ / path.StripPath(build_directory_);
+
+        RemoveStamps(path);
+
+        if (source_tree_.Rescan(source) == true)
+        {
+          item = source_tree_.Find(source);
+        }
+      }
+      else if (IsInDirectory(path, source_directory_) == true)
+      {
+        source_tree_.Rescan(path);
+
+        if (evt == foundation::DirectoryEvent::kRemoved)
+        {
+          RemoveBuiltDirectory(path);
+          return;
+        }
+
+        item = source_tree_.Find(path);
+      }
+
+      if (item == nullptr || item->is_directory() == false)
+      {
+        return;
+      }
+
+      SyncItem(*item);
+      FindFileChanges(item->children());
+    }
+
+    //--------------------------------------------------------------------------
+    void Builder::HandleFileChange(
+      const foundation::Path& path,
+      foundation::DirectoryEvent evt)
+    {
+      if (evt != foundation::DirectoryEvent::kModified)
+      {
+        foundation::MetadataCache::Invalidate(path);
+      }
+
+      if (evt == foundation::DirectoryEvent::kUnknown)
+      {
+        SyncDirectories();
+        FindFileChanges(source_tree_.items());
+
+        return;
+      }
+
+      if (IsInDirectory(path, build_directory_) == true)
+      {
+        if (
+          evt != foundation::DirectoryEvent::kRemoved ||
+          path.extension() != kStampExtension_)
+        {
+          return;
+        }
+
+        StampMap::iterator it = stamps_.find(path.ToString());
+
+        if (it == stamps_.end())
+        {
+          return;
+        }
+
+        stamps_.erase(it);
+
+        foundation::Path source = 
+          source_directory_ / path.StripPath(build_directory_).NoExtension();
+
+        if (HasChanged(source) == true)
+        {
+          QueueForBuild(source);
+        }
+
+        return;
+      }
+
+      if (IsInDirectory(path, source_directory_) == false)
+      {
+        return;
+      }
+
+      if (evt == foundation::DirectoryEvent::kRemoved)
+      {
+        RemoveBuilt(path);
+        return;
+      }
+
+      if (HasChanged(path) == true)
+      {
+        QueueForBuild(path);
+      }
+    }
+
+    //--------------------------------------------------------------------------
+    void Builder::RemoveBuilt(const foundation::Path& path)
+    {
+      compilers::AssetTypes type =
+        compilers::AssetTypesFromSourceExtension(path.extension().c_str());
+
+      foundation::Path relative = path.StripPath(source_directory_);
+      foundation::Path stamp = 
+        build_directory_ / relative + "." + kStampExtension_;
+
+      if (foundation::File::Exists(stamp) == true)
+      {
+        foundation::File::Remove(stamp);
+      }
+
+      stamps_.erase(stamp.ToString());
+
+      if (type == compilers::AssetTypes::kCount)
+      {
+        return;
+      }
 
+      BuildItem item;
+      item.in = path;
+      item.relative = 
+        relative.NoExtension() + 
+        "." + 
+        compilers::AssetTypesToBuildExtension(type);
+      item.type = type;
+
+      foundation::Path built = build_directory_ / item.relative;
+
+      if (foundation::File::Exists(built) == false)
+      {
+        return;
+      }
+
+      foundation::File::Remove(built);
+
+      if (on_changed_ != nullptr)
+      {
+        on_changed_(item);
+      }
+    }
+
+    //--------------------------------------------------------------------------
+    void Builder::RemoveBuiltDirectory(const foundation::Path& path)
+    {
+      foundation::Path relative = path.StripPath(source_directory_);
+      foundation::Path built = build_directory_ / relative;
+
+      RemoveStamps(built);
+
+      if (foundation::Directory::Exists(built) == false)
+      {
+        return;
+      }
+
+      foundation::Directory::Remove(built);
+
+      if (on_changed_ != nullptr)
+      {
+        BuildItem item;
+        item.in = path;
+        item.relative = relative;
+        item.type = compilers::AssetTypes::kDirectory;
+
+        on_changed_(item);
+      }
+    }
+
+    //--------------------------------------------------------------------------
+    void Builder::RemoveStamps(const foundation::Path& dir)
+    {
+      foundation::String prefix = dir.ToString() + "/";
+
+      StampMap::iterator first = stamps_.lower_bound(prefix);
+      StampMap::iterator last = first;
+
+      while (
+        last != stamps_.end() && 
+        last->first.compare(0, prefix.size(), prefix) == 0)
+      {
+        ++last;
+      }
+
+      stamps_.erase(first, last);
+    }
+
+    //--------------------------------------------------------------------------
+    bool Builder::IsInDirectory(
+      const foundation::Path& path, 
+      const foundation::Path& dir)
+    {
+      const foundation::String& p = path.ToString();
+      const foundation::String& d = dir.ToString();
+
+      if (p.size() < d.size() || p.compare(0, d.size(), d) != 0)
+      {
+        return false;
+      }
+
+      return p.size() == d.size() || p.at(d.size()) == '/';
+    }
+
+    //--------------------------------------------------------------------------
+    void Builder::SyncItems(const ItemList& source_items) const
+    {
       for (size_t i = 0; i < source_items.size(); ++i)
       {
         const foundation::DirectoryTreeItem& item = source_items.at(i);
 
         if (item.is_directory() == true)
         {
-          current = item.path().StripPath(source_directory_);
+          SyncItem(item);
+        }
+      }
+    }
 
-          if (current == build_)
-          {
-            continue;
-          }
+    //--------------------------------------------------------------------------
+    void Builder::SyncItem(const foundation::DirectoryTreeItem& item) const
+    {
+      foundation::Path current = item.path().StripPath(source_directory_);
 
-          current_build = build_directory_ / current;
+      if (current == build_)
+      {
+        return;
+      }
 
-          if (foundation::Directory::Exists(current_build) == false)
-          {
-            dir.Open(current_build);
+      foundation::Path current_build = build_directory_ / current;
 
-            if (dir.is_ok() == false)
-            {
-              continue;
-            }
+      if (foundation::Directory::Exists(current_build) == false)
+      {
+        foundation::Directory dir(current_build);
 
-            if (on_changed_ != nullptr)
-            {
-              BuildItem dir_item;
-              dir_item.in = item.path();
-              dir_item.relative = current;
-              dir_item.type = compilers::AssetTypes::kDirectory;
+        if (dir.is_ok() == false)
+        {
+          return;
+        }
 
-              on_changed_(dir_item);
-            }
-          }
+        if (on_changed_ != nullptr)
+        {
+          BuildItem dir_item;
+          dir_item.in = item.path();
+          dir_item.relative = current;
+          dir_item.type = compilers::AssetTypes::kDirectory;
 
-          SyncItems(item.children());
+          on_changed_(dir_item);
         }
       }
+
+      SyncItems(item.children());
     }
 
     //--------------------------------------------------------------------------
@@ -353,7 +595,27 @@ namespace snuffbox
     }
 
     //--------------------------------------------------------------------------
-    bool Builder::HasChanged(const foundation::Path& path) const
+    void Builder::ReadStamps(const ItemList& build_items)
+    {
+      for (size_t i = 0; i < build_items.size(); ++i)
+      {
+        const foundation::DirectoryTreeItem& item = build_items.at(i);
+
+        if (item.is_directory() == true)
+        {
+          ReadStamps(item.children());
+          continue;
+        }
+
+        if (item.path().extension() == kStampExtension_)
+        {
+          stamps_[item.path().ToString()] = item.last_modified();
+        }
+      }
+    }
+
+    //--------------------------------------------------------------------------
+    bool Builder::HasChanged(const foundation::Path& path)
     {
       if (
         foundation::File::Exists(path) == false ||
@@ -362,19 +624,27 @@ namespace snuffbox
         return false;
       }
 
-      foundation::Path relative = path.StripPath(source_directory_);
-
       foundation::File source(path, foundation::FileFlags::kRead);
-      time_t current_time = source.last_modified();
+      return HasChanged(path, source.last_modified());
+    }
 
+    //--------------------------------------------------------------------------
+    bool Builder::HasChanged(const foundation::Path& path, time_t last_modified)
+    {
+      foundation::Path relative = path.StripPath(source_directory_);
       foundation::Path stamp = 
         build_directory_ / relative + "." + kStampExtension_;
-      
-      foundation::File f;
 
-      if (foundation::File::Exists(stamp) == true)
+      StampMap::iterator it = stamps_.find(stamp.ToString());
+
+      if (it != stamps_.end())
       {
-        f.Open(stamp, foundation::FileFlags::kRead);
+        if (difftime(last_modified, it->second) <= 0.0)
+        {
+          return false;
+        }
+
+        foundation::File f(stamp, foundation::FileFlags::kRead);
 
         if (f.is_ok() == false)
         {
@@ -388,24 +658,26 @@ namespace snuffbox
         foundation::Logger::Assert(len == sizeof(FileTime),
           "Attempted to read an invalid time stamp in the builder");
 
-        if (difftime(current_time, ft->last_modified) <= 0.0)
+        if (difftime(last_modified, ft->last_modified) <= 0.0)
         {
+          it->second = ft->last_modified;
           return false;
         }
       }
 
-      f.Open(stamp, foundation::FileFlags::kWrite);
+      FileTime cft;
+      cft.last_modified = last_modified;
 
-      if (f.is_ok() == false)
+      foundation::FileWriter writer(stamp);
+      writer.Write(reinterpret_cast<uint8_t*>(&cft), sizeof(FileTime));
+      
+      if (writer.Commit() == false)
       {
         return false;
       }
 
-      FileTime cft;
-      cft.last_modified = current_time;
+      stamps_[stamp.ToString()] = last_modified;
 
-      f.Write(reinterpret_cast<uint8_t*>(&cft), sizeof(FileTime));
-      
       return true;
     }
 
@@ -4,9 +4,11 @@
 
 #include <foundation/io/path.h>
 #include <foundation/auxiliary/logger.h>
+#include <foundation/containers/map.h>
 
 #include <foundation/io/directory_tree.h>
 #include <foundation/io/directory_listener.h>
+#include <foundation/io/async_io.h>
 
 namespace snuffbox
 {
@@ -62,6 +64,12 @@ namespace snuffbox
       */
       using ItemList = foundation::Vector<foundation::DirectoryTreeItem>;
 
+      /**
+      * @brief A short hand for the known time stamps, by path, ordered so
+      *        that the stamps of a directory are a contiguous range
+      */
+      using StampMap = foundation::Map<foundation::String, time_t>;
+
       /**
       * @brief Creates an invalid builder
       */
@@ -109,6 +117,9 @@ namespace snuffbox
       /**
       * @brief Writes a build item's result to disk
       *
+      * The write is done on an I/O thread, the finished callback is called
+      * at the next idle notification after the write has completed.
+      *
       * @param[in] item The corresponding build item
       * @param[in] buffer The compiled buffer
       * @param[in] size The size of the buffer
@@ -159,6 +170,81 @@ namespace snuffbox
       */
       void FindFileChanges(const ItemList& items);
 
+      /**
+      * @brief Handles a directory that changed in the project
+      *
+      * Only the subtree of the changed directory is rescanned and synced.
+      * Directories created in the source tree are scanned for files to
+      * build, and the build results of removed directories are removed.
+      * Subdirectories that were removed from the build directory are
+      * rebuilt. When the source or build directory itself changed, or when
+      * the listener doesn't know what changed, everything is synced and
+      * scanned again.
+      *
+      * The cached metadata of the directory and everything below it is
+      * invalidated first, as the change was made outside of the engine.
+      *
+      * @param[in] path The directory that changed
+      * @param[in] evt The kind of change
+      */
+      void HandleDirectoryChange(
+        const foundation::Path& path,
+        foundation::DirectoryEvent evt);
+
+      /**
+      * @brief Handles a file that changed in the project
+      *
+      * Only the changed file is checked for a rebuild, or has its build
+      * results removed if the source file was removed.
+      *
+      * Time stamps that are removed by the builder itself are ignored. When
+      * any other time stamp is removed, only its source file is checked
+      * for a rebuild.
+      *
+      * The cached metadata of created and removed files is invalidated
+      * first, as the change was made outside of the engine.
+      *
+      * @param[in] path The file that changed
+      * @param[in] evt The kind of change
+      */
+      void HandleFileChange(
+        const foundation::Path& path,
+        foundation::DirectoryEvent evt);
+
+      /**
+      * @brief Removes the build result and time stamp of a source file
+      *
+      * @param[in] path The path to the removed source file
+      */
+      void RemoveBuilt(const foundation::Path& path);
+
+      /**
+      * @brief Removes the build directory of a removed source directory,
+      *        along with all of its build results and time stamps
+      *
+      * @param[in] path The path to the removed source directory
+      */
+      void RemoveBuiltDirectory(const foundation::Path& path);
+
+      /**
+      * @brief Forgets all known time stamps inside of a build directory
+      *
+      * @param[in] dir The directory in the build directory
+      */
+      void RemoveStamps(const foundation::Path& dir);
+
+      /**
+      * @brief Checks if a path is a directory or inside of it
+      *
+      * @param[in] path The path to check
+      * @param[in] dir The directory to check against
+      *
+      * @return Is the path equal to, or inside of the directory?
+      */
+      static bool IsInDirectory(
+        const foundation::Path& path, 
+        const foundation::Path& dir);
+
       /**
       * @brief Syncs the items from the source tree structure to the build
       *        tree
@@ -167,6 +253,14 @@ namespace snuffbox
       */
       void SyncItems(const ItemList& source_items) const;
 
+      /**
+      * @brief Syncs a single directory from the source tree, and all of its
+      *        subdirectories, to the build tree
+      *
+      * @param[in] item The source directory
+      */
+      void SyncItem(const foundation::DirectoryTreeItem& item) const;
+
       /**
       * @brief Removes folders that are not in the source tree anymore
       *
@@ -174,6 +268,26 @@ namespace snuffbox
       */
       void RemoveOld(const ItemList& build_items) const;
 
+      /**
+      * @brief Collects the time stamps in the build directory, along with
+      *        the modification times they were scanned with
+      *
+      * @param[in] build_items The list of build items
+      */
+      void ReadStamps(const ItemList& build_items);
+
+      /**
+      * @brief Checks a file for rebuild, retrieving its modification time
+      *        from the file system
+      *
+      * @see Builder::HasChanged(const foundation::Path&, time_t)
+      *
+      * @param[in] path The path to the file to check, in the source directory
+      *
+      * @return Should the file be rebuilt?
+      */
+      bool HasChanged(const foundation::Path& path);
+
       /**
       * @brief Finds the time stamp of a file and if it does not exist, it
       *        is created. It is then checked for rebuild.
@@ -185,11 +299,18 @@ namespace snuffbox
       * to see if their modification times match. If not, the file can be
       * marked for rebuild.
       *
+      * The modification time of the source file comes from the scanned
+      * source tree, and the time stamps that were scanned in the build tree
+      * are known to be up-to-date if they were written after the source was
+      * last modified. Only time stamps that are older than their source
+      * file are opened and compared by their contents.
+      *
       * @param[in] path The path to the file to check, in the source directory
+      * @param[in] last_modified When the source file was last modified
       *
       * @return Should the file be rebuilt?
       */
-      bool HasChanged(const foundation::Path& path) const;
+      bool HasChanged(const foundation::Path& path, time_t last_modified);
 
       /**
       * @brief Queues a file for build by path
@@ -244,6 +365,12 @@ namespace snuffbox
       foundation::DirectoryTree source_tree_; //!< The source directory tree
       foundation::DirectoryTree build_tree_; //!< The build directory tree
 
+      /**
+      * @brief The time stamps in the build directory, with the latest source
+      *        modification time each of them is known to cover
+      */
+      StampMap stamps_;
+
       foundation::Path source_directory_; //!< The current source directory
       foundation::Path build_directory_; //!< The current build directory
 
@@ -253,6 +380,11 @@ namespace snuffbox
       foundation::DirectoryListener listener_; //!< The directory listener
 
       BuildScheduler scheduler_; //!< The build scheduler to queue files in
+      /**
+      * @brief Writes the build results to disk, on a single thread so that
+      *        writes to the same path complete in the order they were queued
+      */
+      foundation::AsyncIO io_;
 
       /**
       * @brief The callback to call when the builder has finished building
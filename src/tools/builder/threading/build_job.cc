@@ -7,6 +7,7 @@
 #include <tools/compilers/compilers/model_compiler.h>
 
 #include <foundation/auxiliary/logger.h>
+#include <foundation/auxiliary/profiler.h>
 
 namespace snuffbox
 {
@@ -36,6 +37,9 @@ namespace snuffbox
 
       thread_ = std::thread([&]()
       {
+        foundation::Profiler::SetThreadName("Builder");
+        SNUFF_PROFILE_ZONE("BuildJob::Compile");
+
         result_.success = compiler_->Compile(current_item_.in);
         result_.error = compiler_->error();
         result_.buffer = compiler_->Data(&result_.length);
@@ -12,7 +12,8 @@ namespace snuffbox
     //--------------------------------------------------------------------------
     BuildScheduler::BuildScheduler() :
       was_building_(false),
-      build_count_(0)
+      build_count_(0),
+      queue_mutex_("BuildScheduler")
     {
       size_t count = std::thread::hardware_concurrency();
       jobs_.resize(count);
@@ -27,7 +28,7 @@ namespace snuffbox
     //--------------------------------------------------------------------------
     void BuildScheduler::Queue(const BuildItem& item)
     {
-      std::lock_guard<std::mutex> lock(queue_mutex_);
+      std::lock_guard<foundation::Mutex> lock(queue_mutex_);
       queue_.push(item);
 
       if (was_building_ == false)
@@ -69,7 +70,7 @@ namespace snuffbox
     //--------------------------------------------------------------------------
     void BuildScheduler::Flush()
     {
-      std::lock_guard<std::mutex> lock(queue_mutex_);
+      std::lock_guard<foundation::Mutex> lock(queue_mutex_);
       size_t progress;
 
       while (queue_.empty() == false)
@@ -4,8 +4,7 @@
 #include "tools/builder/threading/build_item.h"
 
 #include <foundation/containers/vector.h>
-
-#include <mutex>
+#include <foundation/auxiliary/mutex.h>
 
 namespace snuffbox
 {
@@ -111,7 +110,7 @@ namespace snuffbox
       * @brief Used to safely queue items in the build queue from a different
       *        thread
       */
-      std::mutex queue_mutex_;
+      foundation::Mutex queue_mutex_;
     };
   }
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include <foundation/memory/memory.h>
 #include <foundation/auxiliary/logger.h>
 #include <foundation/auxiliary/pointer_math.h>
+#include <foundation/compression/block_compression.h>
 
 #include <cassert>
 
@@ -13,7 +14,9 @@ namespace snuffbox
     //--------------------------------------------------------------------------
     ICompiler::ICompiler() :
       data_(nullptr),
-      offset_(0)
+      size_(0),
+      offset_(0),
+      owns_data_(false)
     {
 
     }
@@ -29,7 +32,14 @@ namespace snuffbox
         return false;
       }
 
-      return CompileImpl(file);
+      if (CompileImpl(file) == false)
+      {
+        return false;
+      }
+
+      CompressData();
+
+      return true;
     }
 
     //--------------------------------------------------------------------------
@@ -37,13 +47,12 @@ namespace snuffbox
     {
       Clear();
 
-      foundation::File file;
-      if (OpenFile(path, false, &file) == false)
+      if (OpenFile(path, false, &file_) == false)
       {
         return false;
       }
 
-      return DecompileImpl(file);
+      return DecompileImpl(file_);
     }
 
     //--------------------------------------------------------------------------
@@ -83,7 +92,14 @@ namespace snuffbox
         return false;
       }
 
-      if (file->Open(path, foundation::FileFlags::kRead) == false)
+      foundation::File::FileOpenMode mode = foundation::FileFlags::kRead;
+
+      if (compile == false)
+      {
+        mode |= foundation::FileFlags::kMapped;
+      }
+
+      if (file->Open(path, mode) == false)
       {
         set_error("Could not open file for reading during compilation");
 
@@ -96,23 +112,110 @@ namespace snuffbox
     //--------------------------------------------------------------------------
     void ICompiler::SetData(uint8_t* data, size_t size, size_t offset)
     {
-      Clear();
+      ReleaseData();
+
+      data_ = data;
+      size_ = size;
+      offset_ = offset;
+      owns_data_ = true;
+    }
+
+    //--------------------------------------------------------------------------
+    void ICompiler::SetView(const uint8_t* data, size_t size, size_t offset)
+    {
+      ReleaseData();
 
       data_ = data;
       size_ = size;
       offset_ = offset;
+      owns_data_ = false;
     }
 
     //--------------------------------------------------------------------------
     void ICompiler::Clear()
     {
-      if (data_ != nullptr)
+      ReleaseData();
+      file_.Close();
+    }
+
+    //--------------------------------------------------------------------------
+    void ICompiler::ReleaseData()
+    {
+      if (data_ != nullptr && owns_data_ == true)
       {
-        foundation::Memory::Deallocate(data_);
-        data_ = nullptr;
+        foundation::Memory::Deallocate(const_cast<uint8_t*>(data_));
       }
 
+      data_ = nullptr;
       size_ = 0;
+      offset_ = 0;
+      owns_data_ = false;
+    }
+
+    //--------------------------------------------------------------------------
+    void ICompiler::CompressData()
+    {
+      size_t header_size = sizeof(FileHeader);
+
+      if (data_ == nullptr || offset_ != 0 || size_ <= header_size)
+      {
+        return;
+      }
+
+      FileHeader header;
+      memcpy(&header, data_, header_size);
+
+      if (
+        header.flags != FileHeaderFlags::kNone ||
+        ShouldCompress(header.magic) == false)
+      {
+        return;
+      }
+
+      size_t block_size = size_ - header_size;
+      size_t bound =
+        header_size + foundation::BlockCompressor::Bound(block_size);
+
+      uint8_t* compressed =
+        reinterpret_cast<uint8_t*>(foundation::Memory::Allocate(bound));
+
+      size_t compressed_size = foundation::BlockCompressor::Compress(
+        data_ + header_size,
+        block_size,
+        compressed + header_size,
+        bound - header_size);
+
+      if (compressed_size == 0 || compressed_size >= block_size)
+      {
+        foundation::Memory::Deallocate(compressed);
+        return;
+      }
+
+      header.flags = FileHeaderFlags::kCompressed;
+      header.size = block_size;
+
+      memcpy(compressed, &header, header_size);
+
+      SetData(compressed, header_size + compressed_size);
+    }
+
+    //--------------------------------------------------------------------------
+    bool ICompiler::ShouldCompress(FileHeaderMagic magic)
+    {
+      switch (magic)
+      {
+      case FileHeaderMagic::kScene:
+      case FileHeaderMagic::kVertexShader:
+      case FileHeaderMagic::kPixelShader:
+      case FileHeaderMagic::kGeometryShader:
+      case FileHeaderMagic::kModel:
+        return true;
+
+      default:
+        break;
+      }
+
+      return false;
     }
 
     //--------------------------------------------------------------------------
@@ -122,7 +225,7 @@ namespace snuffbox
       uint8_t** block,
       size_t* total_size)
     {
-      size_t header_size = sizeof(FileHeaderMagic);
+      size_t header_size = sizeof(FileHeader);
 
       size_t new_size = size + header_size;
 
@@ -134,7 +237,12 @@ namespace snuffbox
       void* ptr = foundation::Memory::Allocate(new_size);
       uint8_t* full_block = reinterpret_cast<uint8_t*>(ptr);
 
-      memcpy(ptr, &magic, header_size);
+      FileHeader header;
+      header.magic = magic;
+      header.flags = FileHeaderFlags::kNone;
+      header.size = size;
+
+      memcpy(ptr, &header, header_size);
 
       if (block != nullptr)
       {
@@ -147,33 +255,71 @@ namespace snuffbox
     }
 
     //--------------------------------------------------------------------------
-    FileHeaderMagic ICompiler::AllocateWithoutMagic(
-      const uint8_t* buffer, 
+    bool ICompiler::ReadHeader(
+      const uint8_t* buffer,
       size_t size,
-      uint8_t** block,
-      size_t* block_size)
+      FileHeader* header)
     {
-      intptr_t header_size = static_cast<intptr_t>(sizeof(FileHeaderMagic));
-      size_t new_size = static_cast<size_t>(size) - header_size;
-      FileHeaderMagic magic = *reinterpret_cast<const FileHeaderMagic*>(buffer);
+      size_t header_size = sizeof(FileHeader);
 
-      if (block_size != nullptr)
+      if (buffer == nullptr || size < header_size)
       {
-        *block_size = new_size;
+        return false;
       }
 
-      if (block != nullptr)
+      memcpy(header, buffer, header_size);
+
+      size_t stored_size = size - header_size;
+
+      if (header->flags == FileHeaderFlags::kCompressed)
       {
-        const uint8_t* data = 
-          foundation::PointerMath::Offset(buffer, header_size);
+        size_t unpacked_size = 0;
+
+        return
+          foundation::BlockDecompressor::DecompressedSize(
+            buffer + header_size,
+            stored_size,
+            &unpacked_size) == true &&
+          header->size == unpacked_size;
+      }
+
+      return
+        header->flags == FileHeaderFlags::kNone &&
+        header->size == stored_size;
+    }
+
+    //--------------------------------------------------------------------------
+    uint8_t* ICompiler::UnpackBlock(
+      const FileHeader& header,
+      const uint8_t* buffer,
+      size_t size)
+    {
+      size_t header_size = sizeof(FileHeader);
+      size_t new_size = static_cast<size_t>(header.size);
 
-        *block = 
-          reinterpret_cast<uint8_t*>(foundation::Memory::Allocate(new_size));
+      const uint8_t* data = foundation::PointerMath::Offset(
+        buffer,
+        static_cast<intptr_t>(header_size));
 
-        memcpy(*block, data, new_size);
+      uint8_t* block =
+        reinterpret_cast<uint8_t*>(foundation::Memory::Allocate(new_size));
+
+      if (header.flags != FileHeaderFlags::kCompressed)
+      {
+        memcpy(block, data, new_size);
+      }
+      else if (
+        foundation::BlockDecompressor::Decompress(
+          data,
+          size - header_size,
+          block,
+          new_size) == false)
+      {
+        foundation::Memory::Deallocate(block);
+        return nullptr;
       }
 
-      return magic;
+      return block;
     }
 
     //--------------------------------------------------------------------------
@@ -222,28 +368,61 @@ namespace snuffbox
     }
 
     //--------------------------------------------------------------------------
-    bool ICompiler::ReadBuildFile(foundation::File& file, BuildFileData* fd)
+    bool ICompiler::ReadBuildFile(
+      foundation::File& file,
+      BuildFileData* fd,
+      bool writable)
     {
       if (fd == nullptr || file.is_ok() == false)
       {
         return false;
       }
 
+      fd->block = nullptr;
+      fd->data = nullptr;
+      fd->length = 0;
+
       size_t len;
       const uint8_t* buffer = file.ReadBuffer(&len);
 
-      FileHeaderMagic magic = AllocateWithoutMagic(
-        buffer, 
-        len, 
-        &fd->block,
-        &fd->length);
-
-      if (magic != fd->magic)
+      FileHeader header;
+      if (
+        ReadHeader(buffer, len, &header) == false ||
+        header.magic != fd->magic)
       {
         return false;
       }
 
-      return true;
+      fd->length = static_cast<size_t>(header.size);
+
+      if (header.flags == FileHeaderFlags::kNone && writable == false)
+      {
+        fd->block = foundation::PointerMath::Offset(
+          buffer,
+          static_cast<intptr_t>(sizeof(FileHeader)));
+
+        return true;
+      }
+
+      fd->data = UnpackBlock(header, buffer, len);
+      fd->block = fd->data;
+
+      return fd->data != nullptr;
+    }
+
+    //--------------------------------------------------------------------------
+    void ICompiler::SetBuildData(
+      const BuildFileData& fd,
+      size_t size,
+      size_t offset)
+    {
+      if (fd.data != nullptr)
+      {
+        SetData(fd.data, size, offset);
+        return;
+      }
+
+      SetView(fd.block, size, offset);
     }
 
     //--------------------------------------------------------------------------
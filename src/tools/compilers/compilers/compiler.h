@@ -49,6 +49,10 @@ namespace snuffbox
       * data of the compiler. The actual builder will write the file
       * to disk.
       *
+      * After a succesful compilation, the block after the file header is
+      * compressed if ICompiler::ShouldCompress allows it for the type of
+      * the file and if it actually gets smaller.
+      *
       * @param[in] path The path to the file to compile
       *
       * @return Was the compilation a success?
@@ -68,6 +72,10 @@ namespace snuffbox
       * memory, where the base compiler can use that data to interact with
       * the engine side of the application.
       *
+      * The build file is mapped into memory and stays open until the data of
+      * the compiler is cleared, so that uncompressed data can be used in
+      * place instead of being copied.
+      *
       * @param[in] path The path to the file to decompile
       *
       * @return Was the decompilation a success?
@@ -94,6 +102,10 @@ namespace snuffbox
       * @brief Opens a file, but checks first if the path meets all requirements
       *        for either compilation or decompilation
       *
+      * Build files are mapped for decompilation, as they are only ever
+      * replaced by a rename and never truncated while they are open. Source
+      * files are read through a stream, as the user might be editing them.
+      *
       * @param[in] path The path to the file
       * @param[in] compile Are we compiling or decompiling?
       * @param[out] file The loaded file if the path was valid
@@ -118,16 +130,53 @@ namespace snuffbox
       void SetData(uint8_t* data, size_t size, size_t offset = 0);
 
       /**
-      * @brief Clears the underlying buffer if there is currently data set
+      * @brief Used by the derived classes to set the underlying data of the
+      *        compiler to data it doesn't own
+      *
+      * @remarks This frees any previously set data
+      *
+      * @param[in] data The data to set, which should point into the file that
+      *                 is being decompiled
+      * @param[in] size The size of the data
+      * @param[in] offset An offset to read data from an offset
+      */
+      void SetView(const uint8_t* data, size_t size, size_t offset = 0);
+
+      /**
+      * @brief Clears the underlying buffer if there is currently data set and
+      *        closes the file that was decompiled
       */
       void Clear();
 
       /**
-      * @brief Allocates a buffer with a magic number as header
+      * @brief Frees the underlying buffer, if it is owned by the compiler
+      */
+      void ReleaseData();
+
+      /**
+      * @brief Compresses the block after the file header of the current
+      *        data, if the per-type policy allows it and it gets smaller
+      */
+      void CompressData();
+
+      /**
+      * @brief The per-type compression policy of compiled files
+      *
+      * Data that is already dense, like encrypted scripts, barely gets
+      * smaller and only costs time to decompress, so it is stored as is.
+      *
+      * @param[in] magic The type of the compiled file
       *
-      * @param[in] magic The magic number to put at the start of the block
-      * @param[in] size The size to allocate after the magic number
-      * @param[out] block The pointer to the address after the magic number
+      * @return Should the compiled file be compressed?
+      */
+      static bool ShouldCompress(FileHeaderMagic magic);
+
+      /**
+      * @brief Allocates a buffer with a FileHeader as header
+      *
+      * @param[in] magic The magic number to put in the header
+      * @param[in] size The size to allocate after the header
+      * @param[out] block The pointer to the address after the header
       * @param[out] total_size The total size of the newly allocated block
       *
       * @return The pointer to the first address of the total block
@@ -139,20 +188,34 @@ namespace snuffbox
         size_t* total_size);
 
       /**
-      * @brief Retrieves the magic number header from a memory block
+      * @brief Retrieves the FileHeader from a memory block and checks that
+      *        the block after it matches the header
       *
-      * @param[in] buffer The buffer to retrieve the magic number from
+      * @param[in] buffer The buffer to retrieve the header from
       * @param[in] size The size of the buffer
-      * @param[out] block The memory block after the magic number header
-      * @param[out] block_size The size of the data after the header
+      * @param[out] header The header that was found
       *
-      * @return The FileHeaderMagic value found at the start of the block
+      * @return Was the header valid?
       */
-      static FileHeaderMagic AllocateWithoutMagic(
+      static bool ReadHeader(
         const uint8_t* buffer,
         size_t size,
-        uint8_t** block,
-        size_t* block_size);
+        FileHeader* header);
+
+      /**
+      * @brief Copies the block after a FileHeader, decompressing it if it
+      *        was compressed
+      *
+      * @param[in] header The header, as validated by ICompiler::ReadHeader
+      * @param[in] buffer The buffer the header was read from
+      * @param[in] size The size of the buffer
+      *
+      * @return The unpacked block, or nullptr if it couldn't be unpacked
+      */
+      static uint8_t* UnpackBlock(
+        const FileHeader& header,
+        const uint8_t* buffer,
+        size_t size);
 
       /**
       * @brief Used to read source file data with a magic number in the header
@@ -176,7 +239,8 @@ namespace snuffbox
       struct BuildFileData
       {
         FileHeaderMagic magic; //!< The magic number to write
-        uint8_t* block; //!< The pointer to the block after the header
+        const uint8_t* block; //!< The pointer to the block after the header
+        uint8_t* data; //!< The block if it was allocated, or nullptr
         size_t length; //!< The length of the block after the header
       };
 
@@ -212,12 +276,35 @@ namespace snuffbox
       * @brief Reads a build file with a magic number header as a file data
       *        description
       *
+      * Uncompressed blocks point straight into the file, unless a writable
+      * copy is requested. Compressed blocks are always decompressed into
+      * newly allocated memory, which is set as the file data's data.
+      *
       * @param[in] file The file to read
       * @param[out] fd The file data
+      * @param[in] writable Should the block always be copied, so that it
+      *                     can be modified?
       *
       * @return Were we able to open the file and read the data?
       */
-      static bool ReadBuildFile(foundation::File& file, BuildFileData* fd);
+      static bool ReadBuildFile(
+        foundation::File& file,
+        BuildFileData* fd,
+        bool writable = false);
+
+      /**
+      * @brief Sets the underlying data to a block read by
+      *        ICompiler::ReadBuildFile, taking ownership of it if it was
+      *        allocated
+      *
+      * @param[in] fd The file data
+      * @param[in] size The size of the data
+      * @param[in] offset An offset to read data from an offset
+      */
+      void SetBuildData(
+        const BuildFileData& fd,
+        size_t size,
+        size_t offset = 0);
 
       /**
       * @see ICompiler::Compile
@@ -255,9 +342,12 @@ namespace snuffbox
 
       foundation::String error_; //!< The current error message of this compiler
 
-      uint8_t* data_; //!< The data currently contained in the compiler
+      const uint8_t* data_; //!< The data currently contained in the compiler
       size_t size_; //!< The size of the contained data
       size_t offset_; //!< A binary offset to read file data at an offset
+      bool owns_data_; //!< Should the data be freed by the compiler?
+
+      foundation::File file_; //!< The decompiled file, which views point into
     };
   }
 }
\ No newline at end of file
@@ -10,6 +10,9 @@ namespace snuffbox
     * @brief The material compiler that compiles serialized material data
     *        into a build format
     *
+    * The JSON is converted into a foundation::BinaryArchive, so that
+    * loading a material doesn't parse any text
+    *
     * @author Daniel Konings
     */
     class MaterialCompiler : public ICompiler
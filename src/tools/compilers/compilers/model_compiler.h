@@ -287,9 +287,9 @@ namespace snuffbox
         return false;
       }
 
-      SetData(fd.block, fd.length);
+      SetBuildData(fd, fd.length);
 
-      ModelHeader header = *reinterpret_cast<ModelHeader*>(fd.block);
+      ModelHeader header = *reinterpret_cast<const ModelHeader*>(fd.block);
       size_t offset = sizeof(ModelHeader);
 
       const NodeHeader* node_header;
@@ -313,7 +313,7 @@ namespace snuffbox
         if (node_header->name_length != 0)
         {
           node.name = foundation::String(
-            reinterpret_cast<char*>(&fd.block[offset]), 
+            reinterpret_cast<const char*>(&fd.block[offset]),
             node_header->name_length);
 
           offset += node_header->name_length;
@@ -1,5 +1,7 @@
 #include "tools/compilers/compilers/scene_compiler.h"
 
+#include <foundation/serialization/binary_archive.h>
+
 namespace snuffbox
 {
   namespace compilers
@@ -13,10 +15,24 @@ namespace snuffbox
     //--------------------------------------------------------------------------
     bool SceneCompiler::CompileImpl(foundation::File& file)
     {
+      size_t len;
+      const uint8_t* source = file.ReadBuffer(&len);
+
+      foundation::BinaryArchive archive;
+      if (
+        source == nullptr ||
+        archive.FromJson(reinterpret_cast<const char*>(source), len) == false)
+      {
+        set_error("Could not parse the scene, an invalid JSON was provided");
+        return false;
+      }
+
+      const foundation::Vector<uint8_t>& binary = archive.data();
+
       SourceFileData fd;
       fd.magic = FileHeaderMagic::kScene;
 
-      if (AllocateSourceFile(file, &fd) == false)
+      if (AllocateSourceFile(binary.data(), binary.size(), &fd) == false)
       {
         return false;
       }
@@ -37,7 +53,7 @@ namespace snuffbox
         return false;
       }
 
-      SetData(fd.block, fd.length);
+      SetBuildData(fd, fd.length);
 
       return true;
     }
@@ -11,9 +11,8 @@ namespace snuffbox
     *        a binary format, which the decompiler can convert back to
     *        a usable scene
     *
-    * @remarks A binary format is the most feasible, but for now the compiler
-    *          simply outputs the JSON into the build directory, with
-    *          a magic number prefixed that it is indeed a scene
+    * The JSON is converted into a foundation::BinaryArchive, so that
+    * loading a scene doesn't parse any text
     *
     * @author Daniel Konings
     */
@@ -38,15 +38,15 @@ namespace snuffbox
       BuildFileData fd;
       fd.magic = FileHeaderMagic::kScript;
 
-      if (ReadBuildFile(file, &fd) == false)
+      if (ReadBuildFile(file, &fd, true) == false)
       {
         return false;
       }
 
       foundation::RC4 rc4;
-      rc4.Decrypt(reinterpret_cast<int8_t*>(fd.block), fd.length);
+      rc4.Decrypt(reinterpret_cast<int8_t*>(fd.data), fd.length);
 
-      SetData(reinterpret_cast<uint8_t*>(fd.block), fd.length);
+      SetData(fd.data, fd.length);
 
       return true;
     }
@@ -133,7 +133,7 @@ namespace snuffbox
         "Unknown shader format requested, no supported renderer");
 #endif
 
-      SetData(reinterpret_cast<uint8_t*>(fd.block), size, offset);
+      SetBuildData(fd, size, offset);
 
       return true;
     }
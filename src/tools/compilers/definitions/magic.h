@@ -21,5 +21,26 @@ namespace snuffbox
       kModel = 0x444F4D73, //!< "sMOD" As a hexadecimal value
       kUnknown = 0
     };
+
+    /**
+    * @brief The flags in the header of a compiled file
+    */
+    enum class FileHeaderFlags : uint32_t
+    {
+      kNone = 0, //!< The block after the header is stored as is
+      kCompressed = 1 << 0 //!< The block is compressed by a BlockCompressor
+    };
+
+    /**
+    * @brief The header at the start of every compiled file
+    *
+    * @author Daniel Konings
+    */
+    struct FileHeader
+    {
+      FileHeaderMagic magic; //!< The type of the compiled file
+      FileHeaderFlags flags; //!< How the block after the header is stored
+      uint64_t size; //!< The size of the block when it is unpacked
+    };
   }
 }
\ No newline at end of file
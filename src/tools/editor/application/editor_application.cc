@@ -15,9 +15,13 @@
 #include <engine/services/renderer_service.h>
 #include <engine/services/asset_service.h>
 #include <engine/services/scene_service.h>
+#include <engine/services/metrics_service.h>
 
 #include <foundation/auxiliary/logger.h>
 #include <foundation/auxiliary/timer.h>
+#include <foundation/auxiliary/profiler.h>
+#include <foundation/memory/memory.h>
+#include <foundation/memory/allocator_registry.h>
 
 #include <foundation/serialization/save_archive.h>
 #include <foundation/serialization/load_archive.h>
@@ -43,11 +47,12 @@ namespace snuffbox
       project_(nullptr),
       build_change_timer_("BuildChangeTimer"),
       build_dir_changed_(false),
+      build_mutex_("EditorApplication"),
       main_window_(nullptr),
       asset_importer_(nullptr),
       project_changed_(false),
       state_(EditorStates::kEditing),
-      serialized_scene_(""),
+      serialized_scene_(),
       has_script_error_(false)
     {
       QCoreApplication::setOrganizationName(
@@ -124,14 +129,18 @@ namespace snuffbox
 
       engine::RendererService* renderer = GetService<engine::RendererService>();
       engine::SceneService* scene_service = GetService<engine::SceneService>();
+      engine::MetricsService* metrics = GetService<engine::MetricsService>();
 
       foundation::Timer delta_time("delta_time");
       float dt = 0.0f;
 
       ReloadScripts();
 
+      foundation::Profiler::SetThreadName("Main");
+
       while (should_quit() == false && main_window_->isVisible() == true)
       {
+        foundation::Profiler::MarkFrame();
         delta_time.Start();
 
         qapp_.processEvents();
@@ -155,6 +164,12 @@ namespace snuffbox
         delta_time.Stop();
         dt = delta_time.Elapsed(foundation::TimeUnits::kSecond);
 
+        foundation::Memory::frame_allocator().Reset();
+        foundation::Memory::double_buffered_allocator().Reset();
+        foundation::AllocatorRegistry::EndFrame();
+
+        metrics->EndFrame(dt);
+
         builder.IdleNotification();
 
         CheckForBuildChanges();
@@ -356,7 +371,7 @@ namespace snuffbox
     //--------------------------------------------------------------------------
     void EditorApplication::BuildChanged()
     {
-      std::unique_lock<std::mutex> lock_guard(build_mutex_);
+      std::unique_lock<foundation::Mutex> lock_guard(build_mutex_);
 
       build_change_timer_.Stop();
       build_change_timer_.Start();
@@ -416,7 +431,7 @@ namespace snuffbox
       foundation::SaveArchive archive;
       archive(GetService<engine::SceneService>()->current_scene());
 
-      serialized_scene_ = archive.ToMemory();
+      serialized_scene_ = archive.ToBinary();
     }
 
     //--------------------------------------------------------------------------
@@ -428,7 +443,7 @@ namespace snuffbox
       }
 
       foundation::LoadArchive archive;
-      archive.FromJson(serialized_scene_);
+      archive.FromBinary(serialized_scene_.data(), serialized_scene_.size());
 
       engine::Scene* current =
         GetService<engine::SceneService>()->current_scene();
@@ -6,6 +6,7 @@
 
 #include <engine/application/application.h>
 #include <foundation/auxiliary/timer.h>
+#include <foundation/auxiliary/mutex.h>
 
 #include <QApplication>
 #include <QSettings>
@@ -210,7 +211,7 @@ namespace snuffbox
       */
       foundation::Timer build_change_timer_;
       bool build_dir_changed_; //!< Has the build directory changed?
-      std::mutex build_mutex_; //!< The mutex for any building callbacks
+      foundation::Mutex build_mutex_; //!< The mutex for any building callbacks
 
       std::unique_ptr<MainWindow> main_window_; //!< The main window
       std::unique_ptr<AssetImporter> asset_importer_; //!< The asset importer
@@ -218,7 +219,11 @@ namespace snuffbox
       bool project_changed_; //!< Was the project changed and should we restart?
 
       EditorStates state_; //!< The current state of the editor application
-      foundation::String serialized_scene_; //!< The currently serialized scene
+
+      /**
+      * @brief The currently serialized scene, as a binary archive
+      */
+      foundation::Vector<uint8_t> serialized_scene_;
 
       bool has_script_error_; //!< Do we currently have a scripting error?
 
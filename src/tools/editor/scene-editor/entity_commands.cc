@@ -162,7 +162,7 @@ namespace snuffbox
       hierarchy->OnEntityDeleted(ent);
       hierarchy->blockSignals(true);
 
-      serialization_data_ = archive.ToMemory().c_str();
+      snapshot_.Capture(archive);
       ent->Destroy();
     }
 
@@ -173,14 +173,13 @@ namespace snuffbox
         engine::Entity* ent = 
           hierarchy->CreateNewEntity()->entity();
 
-      if (serialization_data_.isEmpty() == true)
+      foundation::LoadArchive archive;
+
+      if (snapshot_.Restore(&archive) == false)
       {
         return;
       }
 
-      foundation::LoadArchive archive;
-      archive.FromJson(serialization_data_.toLatin1().data());
-
       archive(&ent);
 
       if (deleted_from_.IsNull() == false)
@@ -388,7 +387,7 @@ namespace snuffbox
       foundation::SaveArchive archive;
       archive(c);
 
-      serialization_data_ = archive.ToMemory().c_str();
+      snapshot_.Capture(archive);
     }
 
     //--------------------------------------------------------------------------
@@ -404,7 +403,11 @@ namespace snuffbox
       engine::IComponent* c = ent->AddComponentAt(comp_, removed_from_);
 
       foundation::LoadArchive archive;
-      archive.FromJson(serialization_data_.toLatin1().data());
+
+      if (snapshot_.Restore(&archive) == false)
+      {
+        return;
+      }
 
       archive(&c);
     }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "tools/editor/property-editor/property_value.h"
+#include "tools/editor/scene-editor/entity_snapshot.h"
 
 #include <engine/definitions/components.h>
 
@@ -169,7 +170,7 @@ namespace snuffbox
 
     private:
 
-      QString serialization_data_; //!< The data of the deleted entity
+      EntitySnapshot snapshot_; //!< The data of the deleted entity
 
       foundation::UUID deleted_from_; //!< The entity we were deleted from
       int deleted_index_; //!< The index this entity was deleted from
@@ -312,7 +313,7 @@ namespace snuffbox
       engine::Components comp_; //!< The component to be removed
       int removed_from_; //!< The index the component was removed from
 
-      QString serialization_data_; //!< The serialized component
+      EntitySnapshot snapshot_; //!< The serialized component
     };
 
     //--------------------------------------------------------------------------
@@ -0,0 +1,207 @@
+#include "tools/editor/scene-editor/entity_snapshot.h"
+
+#include <foundation/serialization/save_archive.h>
+#include <foundation/serialization/load_archive.h>
+#include <foundation/containers/string_id.h>
+
+#include <cstring>
+
+namespace snuffbox
+{
+  namespace editor
+  {
+    //--------------------------------------------------------------------------
+    const size_t EntitySnapshot::kMinChunkSize_ = 64;
+    const size_t EntitySnapshot::kMaxChunkSize_ = 4096;
+    const uint64_t EntitySnapshot::kBoundaryMask_ = 0xff00000000000000ull;
+
+    //--------------------------------------------------------------------------
+    EntitySnapshot::EntitySnapshot() :
+      size_(0)
+    {
+
+    }
+
+    //--------------------------------------------------------------------------
+    void EntitySnapshot::Capture(const foundation::SaveArchive& archive)
+    {
+      const foundation::Vector<uint8_t>& buffer = archive.buffer();
+
+      const uint8_t* data = buffer.data();
+      size_t left = buffer.size();
+
+      foundation::Vector<ChunkPtr> chunks;
+
+      while (left > 0)
+      {
+        size_t chunk = FindChunkSize(data, left);
+        chunks.push_back(Share(data, chunk));
+
+        data += chunk;
+        left -= chunk;
+      }
+
+      chunks_.swap(chunks);
+      size_ = buffer.size();
+
+      chunks.clear();
+      Prune();
+    }
+
+    //--------------------------------------------------------------------------
+    bool EntitySnapshot::Restore(foundation::LoadArchive* archive) const
+    {
+      if (empty() == true)
+      {
+        return false;
+      }
+
+      foundation::Vector<uint8_t> buffer;
+      buffer.resize(size_);
+
+      size_t offset = 0;
+
+      for (size_t i = 0; i < chunks_.size(); ++i)
+      {
+        const foundation::Vector<uint8_t>& data = chunks_.at(i)->data;
+        memcpy(buffer.data() + offset, data.data(), data.size());
+
+        offset += data.size();
+      }
+
+      return archive->FromTagged(buffer.data(), buffer.size());
+    }
+
+    //--------------------------------------------------------------------------
+    void EntitySnapshot::Clear()
+    {
+      chunks_.clear();
+      size_ = 0;
+    }
+
+    //--------------------------------------------------------------------------
+    bool EntitySnapshot::empty() const
+    {
+      return size_ == 0;
+    }
+
+    //--------------------------------------------------------------------------
+    size_t EntitySnapshot::size() const
+    {
+      return size_;
+    }
+
+    //--------------------------------------------------------------------------
+    size_t EntitySnapshot::FindChunkSize(const uint8_t* data, size_t size)
+    {
+      if (size <= kMinChunkSize_)
+      {
+        return size;
+      }
+
+      size_t max = size < kMaxChunkSize_ ? size : kMaxChunkSize_;
+
+      const uint64_t* table = gear();
+      uint64_t hash = 0;
+
+      for (size_t i = 0; i < max; ++i)
+      {
+        hash = (hash << 1) + table[data[i]];
+
+        if (i >= kMinChunkSize_ && (hash & kBoundaryMask_) == 0)
+        {
+          return i + 1;
+        }
+      }
+
+      return max;
+    }
+
+    //--------------------------------------------------------------------------
+    EntitySnapshot::ChunkPtr EntitySnapshot::Share(
+      const uint8_t* data,
+      size_t size)
+    {
+      uint64_t hash = foundation::StringId::Hash(
+        reinterpret_cast<const char*>(data),
+        size);
+
+      ChunkPool& chunks = pool();
+      ChunkPool::iterator it = chunks.find(hash);
+
+      if (it != chunks.end())
+      {
+        const foundation::Vector<uint8_t>& shared = it->second->data;
+
+        if (
+          shared.size() == size &&
+          memcmp(shared.data(), data, size) == 0)
+        {
+          return it->second;
+        }
+      }
+
+      ChunkPtr chunk = foundation::Memory::ConstructShared<Chunk>(
+        &foundation::Memory::default_allocator());
+
+      chunk->hash = hash;
+      chunk->data.assign(data, data + size);
+
+      if (it == chunks.end())
+      {
+        chunks.insert(eastl::make_pair(hash, chunk));
+      }
+
+      return chunk;
+    }
+
+    //--------------------------------------------------------------------------
+    void EntitySnapshot::Prune()
+    {
+      ChunkPool& chunks = pool();
+
+      for (ChunkPool::iterator it = chunks.begin(); it != chunks.end();)
+      {
+        if (it->second.use_count() == 1)
+        {
+          it = chunks.erase(it);
+          continue;
+        }
+
+        ++it;
+      }
+    }
+
+    //--------------------------------------------------------------------------
+    EntitySnapshot::ChunkPool& EntitySnapshot::pool()
+    {
+      static ChunkPool chunks;
+      return chunks;
+    }
+
+    //--------------------------------------------------------------------------
+    const uint64_t* EntitySnapshot::gear()
+    {
+      static const GearTable table = []()
+      {
+        GearTable result;
+        uint64_t state = 0x9e3779b97f4a7c15ull;
+
+        for (size_t i = 0; i < 256; ++i)
+        {
+          state += 0x9e3779b97f4a7c15ull;
+
+          uint64_t z = state;
+          z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+          z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+
+          result.values[i] = z ^ (z >> 31);
+        }
+
+        return result;
+      }();
+
+      return table.values;
+    }
+  }
+}
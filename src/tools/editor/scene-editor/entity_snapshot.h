@@ -0,0 +1,160 @@
+#pragma once
+
+#include <foundation/containers/vector.h>
+#include <foundation/containers/map.h>
+#include <foundation/memory/memory.h>
+
+#include <cinttypes>
+#include <cstddef>
+
+namespace snuffbox
+{
+  namespace foundation
+  {
+    class SaveArchive;
+    class LoadArchive;
+  }
+
+  namespace editor
+  {
+    /**
+    * @brief A compact, in-memory snapshot of serialized entity data, used by
+    *        the entity commands to undo and redo changes
+    *
+    * The snapshot stores the tagged buffer of a SaveArchive, which is
+    * restored into a LoadArchive without generating or parsing any JSON.
+    *
+    * The buffer is split into chunks at content-defined boundaries, so that
+    * the same data produces the same chunks regardless of where it is
+    * located within the buffer. Every unique chunk is stored once and shared
+    * between all snapshots that contain it, which means that snapshots of
+    * overlapping hierarchies, or repeated snapshots of the same entities,
+    * only cost the data that actually differs.
+    *
+    * @author Daniel Konings
+    */
+    class EntitySnapshot
+    {
+
+    public:
+
+      /**
+      * @brief Creates an empty snapshot
+      */
+      EntitySnapshot();
+
+      /**
+      * @brief Captures the contents of an archive, replacing any data that
+      *        was captured before
+      *
+      * @param[in] archive The archive to capture
+      */
+      void Capture(const foundation::SaveArchive& archive);
+
+      /**
+      * @brief Restores the captured data into an archive to deserialize
+      *        from
+      *
+      * @param[out] archive The archive to restore into
+      *
+      * @return Was there any data to restore, and was it loaded succesfully?
+      */
+      bool Restore(foundation::LoadArchive* archive) const;
+
+      /**
+      * @brief Releases the captured data
+      */
+      void Clear();
+
+      /**
+      * @return Is there any captured data?
+      */
+      bool empty() const;
+
+      /**
+      * @return The size of the captured data in bytes
+      */
+      size_t size() const;
+
+    protected:
+
+      /**
+      * @brief A unique piece of captured data
+      *
+      * @author Daniel Konings
+      */
+      struct Chunk
+      {
+        uint64_t hash; //!< The hash of the data
+        foundation::Vector<uint8_t> data; //!< The data
+      };
+
+      /**
+      * @brief Shorthand for a shared chunk
+      */
+      using ChunkPtr = foundation::SharedPtr<Chunk>;
+
+      /**
+      * @brief Shorthand for the pool of unique chunks, by hash
+      */
+      using ChunkPool = foundation::UMap<uint64_t, ChunkPtr>;
+
+      /**
+      * @brief The random values per byte for the rolling hash
+      *
+      * @author Daniel Konings
+      */
+      struct GearTable
+      {
+        uint64_t values[256]; //!< The value per byte
+      };
+
+      /**
+      * @brief Finds the end of the chunk that starts at the beginning of
+      *        the data, using a rolling hash over its contents
+      *
+      * @param[in] data The data to find the chunk in
+      * @param[in] size The size of the data
+      *
+      * @return The size of the chunk
+      */
+      static size_t FindChunkSize(const uint8_t* data, size_t size);
+
+      /**
+      * @brief Retrieves the shared chunk for a piece of data, adding it to
+      *        the pool if it doesn't exist yet
+      *
+      * @param[in] data The data of the chunk
+      * @param[in] size The size of the chunk
+      *
+      * @return The shared chunk
+      */
+      static ChunkPtr Share(const uint8_t* data, size_t size);
+
+      /**
+      * @brief Removes all chunks that aren't used by any snapshot anymore
+      *        from the pool
+      */
+      static void Prune();
+
+      /**
+      * @return The pool of unique chunks
+      */
+      static ChunkPool& pool();
+
+      /**
+      * @return The random values per byte for the rolling hash
+      */
+      static const uint64_t* gear();
+
+    private:
+
+      foundation::Vector<ChunkPtr> chunks_; //!< The chunks, in order
+      size_t size_; //!< The size of the captured data
+
+      static const size_t kMinChunkSize_; //!< The smallest chunk size
+      static const size_t kMaxChunkSize_; //!< The largest chunk size
+      static const uint64_t kBoundaryMask_; //!< The mask for boundaries
+    };
+  }
+}
@@ -91,7 +91,7 @@ namespace snuffbox
 
       foundation::HashSet<engine::Entity*> current_entities;
 
-      foundation::Vector<engine::TransformComponent*> top_level = 
+      foundation::FrameVector<engine::TransformComponent*> top_level =
         scene->TopLevelTransforms();
 
       auto Sorter = [](
@@ -581,7 +581,8 @@ namespace snuffbox
     HierarchyViewItem* HierarchyView::CreateNewEntity()
     {
       engine::Entity* ent = foundation::Memory::Construct<engine::Entity>(
-        &foundation::Memory::default_allocator(), GetCurrentScene());
+        &foundation::Memory::pool_allocator<engine::Entity>("Entity"),
+        GetCurrentScene());
 
       HierarchyViewItem* item = TryAddEntity(ent);
 
@@ -0,0 +1,24 @@
+#include "tools/packer/packer.h"
+
+#include <iostream>
+
+using namespace snuffbox;
+using namespace packer;
+
+int main(int argc, char** argv)
+{
+  if (argc < 3)
+  {
+    std::cerr << "Usage: snuffbox-packer build_directory output_file"
+      << std::endl;
+
+    return 1;
+  }
+
+  if (Packer::Pack(argv[1], argv[2]) == false)
+  {
+    return 2;
+  }
+
+  return 0;
+}
@@ -0,0 +1,103 @@
+#include "tools/packer/packer.h"
+
+#include <tools/compilers/definitions/asset_types.h>
+
+#include <foundation/io/file.h>
+
+#include <iostream>
+
+namespace snuffbox
+{
+  namespace packer
+  {
+    //--------------------------------------------------------------------------
+    bool Packer::Pack(
+      const foundation::Path& build_dir,
+      const foundation::Path& output)
+    {
+      if (build_dir.is_directory() == false)
+      {
+        std::cerr << "'" << build_dir.ToString().c_str() <<
+          "' is not a directory" << std::endl;
+
+        return false;
+      }
+
+      foundation::DirectoryTree tree(build_dir);
+      foundation::PackWriter writer;
+
+      if (AddItems(tree.items(), build_dir, &writer) == false)
+      {
+        return false;
+      }
+
+      if (writer.Write(output) == false)
+      {
+        std::cerr << "Could not write the pack to '" <<
+          output.ToString().c_str() << "'" << std::endl;
+
+        return false;
+      }
+
+      std::cout << "Packed " << writer.size() << " asset(s) into '" <<
+        output.ToString().c_str() << "'" << std::endl;
+
+      return true;
+    }
+
+    //--------------------------------------------------------------------------
+    bool Packer::AddItems(
+      const foundation::Vector<foundation::DirectoryTreeItem>& items,
+      const foundation::Path& root,
+      foundation::PackWriter* writer)
+    {
+      for (size_t i = 0; i < items.size(); ++i)
+      {
+        const foundation::DirectoryTreeItem& item = items.at(i);
+        const foundation::Path& path = item.path();
+
+        if (item.is_directory() == true)
+        {
+          if (AddItems(item.children(), root, writer) == false)
+          {
+            return false;
+          }
+
+          continue;
+        }
+
+        compilers::AssetTypes type =
+          compilers::AssetTypesFromBuildExtension(path.extension().c_str());
+
+        if (type == compilers::AssetTypes::kCount)
+        {
+          continue;
+        }
+
+        foundation::File file(
+          path,
+          foundation::FileFlags::kRead | foundation::FileFlags::kMapped);
+
+        if (file.is_ok() == false)
+        {
+          std::cerr << "Could not read '" << path.ToString().c_str() << "'" <<
+            std::endl;
+
+          return false;
+        }
+
+        size_t length;
+        const uint8_t* buffer = file.ReadBuffer(&length);
+
+        writer->Add(
+          path.StripPath(root).ToString(),
+          buffer,
+          length,
+          static_cast<uint32_t>(type),
+          true);
+      }
+
+      return true;
+    }
+  }
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <foundation/io/path.h>
+#include <foundation/io/pack.h>
+#include <foundation/io/directory_tree.h>
+
+namespace snuffbox
+{
+  namespace packer
+  {
+    /**
+    * @brief Packs the built assets of a build directory into a single pack
+    *
+    * Every built asset in the build directory is added to the pack under
+    * its path relative to the build directory, with its asset type as the
+    * type of the entry. Any other file, like the time stamps of the builder,
+    * is left out.
+    *
+    * Every asset is compressed with a BlockCompressor where that makes it
+    * smaller. Assets that the compilers already compressed are stored as is.
+    *
+    * @see foundation::Pack
+    *
+    * @author Daniel Konings
+    */
+    class Packer
+    {
+
+    public:
+
+      /**
+      * @brief Packs a build directory
+      *
+      * @param[in] build_dir The build directory to pack
+      * @param[in] output The path to write the pack to
+      *
+      * @return Was the pack written succesfully?
+      */
+      static bool Pack(
+        const foundation::Path& build_dir,
+        const foundation::Path& output);
+
+    protected:
+
+      /**
+      * @brief Adds the built assets in a directory to the pack, recursively
+      *
+      * @param[in] items The items in the directory
+      * @param[in] root The build directory the entry names are relative to
+      * @param[in] writer The pack writer to add the assets to
+      *
+      * @return Could every asset be read?
+      */
+      static bool AddItems(
+        const foundation::Vector<foundation::DirectoryTreeItem>& items,
+        const foundation::Path& root,
+        foundation::PackWriter* writer);
+    };
+  }
+}
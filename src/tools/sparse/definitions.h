@@ -69,6 +69,24 @@ namespace snuffbox
       std::vector<ArgumentDefinition> arguments;
     };
 
+    /**
+    * @brief Used to store information of each member variable of a class
+    *        that is marked with SNUFF_FIELD
+    *
+    * This struct is created every time the parser finds a property in
+    * "ParseClassMembers" and "ParseField" is called.
+    *
+    * @see ClassDefinition
+    *
+    * @author Daniel Konings
+    */
+    struct FieldDefinition
+    {
+      std::string name; //!< The name of the member variable
+      TypeDefinition type; //!< The type of the member variable
+      bool is_enum; //!< Was the field marked as an enumerator?
+    };
+
     /**
     * @brief Used to store class information of the current class
     *        being parsed
@@ -89,6 +107,7 @@ namespace snuffbox
       bool is_component; //!< Does this class derive from ComponentBase?
 
       std::vector<FunctionDefinition> functions; //!< The functions of the class
+      std::vector<FieldDefinition> fields; //!< The fields of the class
     };
 
     /**
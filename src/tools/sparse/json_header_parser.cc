@@ -362,6 +362,14 @@ namespace snuffbox
               return false;
             }
           }
+          else if (strcmp(type, "property") == 0)
+          {
+            if (ParseField(d, val) == false)
+            {
+              success = false;
+              return false;
+            }
+          }
           else if (strcmp(type, "enum") == 0)
           {
             if (ParseEnum(val, d->ns, d) == false)
@@ -510,6 +518,35 @@ namespace snuffbox
       return true;
     }
 
+    //--------------------------------------------------------------------------
+    bool JsonHeaderParser::ParseField(ClassDefinition* d, RapidValue v)
+    {
+      if (
+        v.HasMember("name") == false ||
+        v.HasMember("dataType") == false)
+      {
+        std::cerr << "Invalid field found in class '" << d->c_name << "'" <<
+          std::endl;
+
+        return false;
+      }
+
+      FieldDefinition f;
+
+      f.name = v["name"].GetString();
+      f.type = ParseTypeValue(v["dataType"]);
+      f.is_enum = false;
+
+      if (v.HasMember("meta") == true && v["meta"].IsObject() == true)
+      {
+        f.is_enum = v["meta"].HasMember("enum") == true;
+      }
+
+      d->fields.push_back(f);
+
+      return true;
+    }
+
     //--------------------------------------------------------------------------
     TypeDefinition JsonHeaderParser::ParseTypeValue(RapidValue v)
     {
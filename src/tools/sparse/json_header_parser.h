@@ -203,6 +203,16 @@ namespace snuffbox
       */
       bool ParseFunction(ClassDefinition* d, RapidValue v);
 
+      /**
+      * @brief Parses a .json property value of a class as a field
+      *
+      * @param[out] d The class definition to modify
+      * @param[in] v The property value
+      *
+      * @return Was the parsing a success?
+      */
+      bool ParseField(ClassDefinition* d, RapidValue v);
+
       /**
       * @brief Parses a .json type definition into an actual type definition
       *
@@ -12,6 +12,7 @@ int main(int argc, char** argv)
   std::string input = "";
   std::string output = "";
   std::string header = "";
+  std::string tables = "";
 
   auto GetArgument = [argc, argv](const char* id)
   {
@@ -29,16 +30,32 @@ int main(int argc, char** argv)
   input = GetArgument("-i");
   output = GetArgument("-o");
   header = GetArgument("-h");
+  tables = GetArgument("-t");
 
   JsonHeaderParser p;
   int result = p.Parse(input) == false ? 1 : 0;
 
-  if (result == 0)
+  if (result == 0 && output.size() > 0)
   {
     SparseWriter w;
     w.Write(&p, header, output);
     std::cout << "sparse -> " << output << std::endl;
   }
 
+  if (result == 0 && tables.size() > 0)
+  {
+    SparseWriter w;
+
+    if (w.WriteFieldTables(&p, header, tables) == false)
+    {
+      std::cerr << "Could not write field tables: " << tables << std::endl;
+      result = 1;
+    }
+    else
+    {
+      std::cout << "sparse -> " << tables << std::endl;
+    }
+  }
+
   return result;
 }
\ No newline at end of file
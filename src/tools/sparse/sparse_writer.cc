@@ -2,6 +2,7 @@
 #include "tools/sparse/json_header_parser.h"
 
 #include <iostream>
+#include <cstdio>
 
 namespace snuffbox
 {
@@ -23,6 +24,31 @@ namespace snuffbox
       { "mat", 'O' }
     };
 
+    //--------------------------------------------------------------------------
+    SparseWriter::FieldTypes SparseWriter::kFieldTypes_ =
+    {
+      { "bool", { "kBool", "bool" } },
+      { "int", { "kInt32", "int32_t" } },
+      { "int32_t", { "kInt32", "int32_t" } },
+      { "unsigned int", { "kUInt32", "uint32_t" } },
+      { "uint32_t", { "kUInt32", "uint32_t" } },
+      { "float", { "kFloat", "float" } },
+      { "double", { "kDouble", "double" } },
+      { "String", { "kString", "snuffbox::foundation::String" } },
+      { "UUID", { "kUUID", "snuffbox::foundation::UUID" } },
+      { "vec2", { "kVec2", "glm::vec2" } },
+      { "vec3", { "kVec3", "glm::vec3" } },
+      { "vec4", { "kVec4", "glm::vec4" } },
+      { "quat", { "kQuat", "glm::quat" } }
+    };
+
+    //--------------------------------------------------------------------------
+    const SparseWriter::FieldType SparseWriter::kEnumFieldType_ =
+    {
+      "kEnum",
+      "int32_t"
+    };
+
     //--------------------------------------------------------------------------
     SparseWriter::SparseWriter() :
       indent_(0),
@@ -42,6 +68,94 @@ namespace snuffbox
         return false;
       }
 
+      if (Open(output) == false)
+      {
+        return false;
+      }
+
+      WriteAll(header, parser->definitions());
+
+      output_.flush();
+      output_.close();
+
+      return true;
+    }
+
+    //--------------------------------------------------------------------------
+    bool SparseWriter::WriteFieldTables(
+      JsonHeaderParser* parser,
+      const std::string& header,
+      const std::string& output)
+    {
+      if (parser == nullptr || parser->HasDocument() == false)
+      {
+        return false;
+      }
+
+      if (Open(output) == false)
+      {
+        return false;
+      }
+
+      const ScriptDefinitions& defs = parser->definitions();
+
+      WriteComment(defs);
+
+      output_ << "#include \"" << header << "\"" << std::endl;
+      output_ << "#include <foundation/definitions/field_table.h>" << std::endl;
+      output_ << std::endl;
+      output_ << "#include <cstddef>" << std::endl;
+
+      WriteLine("");
+      WriteLine("#ifdef __GNUC__");
+      WriteLine("#pragma GCC diagnostic push");
+      WriteLine("#pragma GCC diagnostic ignored \"-Winvalid-offsetof\"");
+      WriteLine("#endif");
+      WriteLine("");
+
+      bool success = true;
+
+      for (size_t i = 0; i < defs.classes.size(); ++i)
+      {
+        const ClassDefinition& d = defs.classes.at(i);
+
+        if (d.fields.size() == 0)
+        {
+          continue;
+        }
+
+        EnterNamespaces(d.ns);
+
+        if (WriteFieldTable(d) == false)
+        {
+          success = false;
+        }
+
+        ExitNamespaces();
+        WriteLine("");
+      }
+
+      WriteLine("#ifdef __GNUC__");
+      WriteLine("#pragma GCC diagnostic pop");
+      WriteLine("#endif");
+
+      output_.flush();
+      output_.close();
+
+      if (success == false)
+      {
+        remove(output.c_str());
+      }
+
+      return success;
+    }
+
+    //--------------------------------------------------------------------------
+    bool SparseWriter::Open(const std::string& output)
+    {
+      indent_ = 0;
+      namespaces_ = 0;
+
       output_ = std::ofstream(
         output,
         std::fstream::out | std::ios::binary | std::fstream::trunc);
@@ -53,11 +167,6 @@ namespace snuffbox
         return false;
       }
 
-      WriteAll(header, parser->definitions());
-
-      output_.flush();
-      output_.close();
-
       return true;
     }
 
@@ -206,6 +315,145 @@ namespace snuffbox
       WriteLine("}");
     }
 
+    //--------------------------------------------------------------------------
+    bool SparseWriter::WriteFieldTable(const ClassDefinition& d)
+    {
+      WriteLine(("const snuffbox::foundation::FieldTable& " + d.c_name +
+        "::SerializedFields()").c_str());
+      WriteLine("{");
+      ++indent_;
+
+      bool success = true;
+
+      for (size_t i = 0; i < d.fields.size(); ++i)
+      {
+        if (WriteFieldCheck(d.fields.at(i), d) == false)
+        {
+          success = false;
+        }
+      }
+
+      if (success == false)
+      {
+        --indent_;
+        WriteLine("}");
+
+        return false;
+      }
+
+      WriteLine("");
+      WriteLine(
+        "static const snuffbox::foundation::FieldDescriptor fields[] =");
+      WriteLine("{");
+      ++indent_;
+
+      for (size_t i = 0; i < d.fields.size(); ++i)
+      {
+        WriteFieldDescriptor(d.fields.at(i), d);
+      }
+
+      --indent_;
+      WriteLine("};");
+      WriteLine("");
+
+      WriteLine("static const snuffbox::foundation::FieldTable table =");
+      WriteLine("{");
+      ++indent_;
+      WriteLine(("\"" + d.c_name + "\",").c_str());
+      WriteLine("fields,");
+      WriteLine("sizeof(fields) / sizeof(fields[0])");
+      --indent_;
+      WriteLine("};");
+      WriteLine("");
+      WriteLine("return table;");
+
+      --indent_;
+      WriteLine("}");
+
+      return true;
+    }
+
+    //--------------------------------------------------------------------------
+    bool SparseWriter::WriteFieldCheck(
+      const FieldDefinition& f,
+      const ClassDefinition& cl)
+    {
+      const FieldType* type = FindFieldType(f);
+
+      if (type == nullptr)
+      {
+        std::cerr << "Unsupported type '" << f.type.name << "' for field '" <<
+          cl.c_name << "::" << f.name << "'" << std::endl;
+
+        return false;
+      }
+
+      std::string field = cl.c_name + "::" + f.name;
+
+      WriteLine(("static_assert(sizeof(decltype(" + field + ")) == sizeof(" +
+        type->size_type + "),").c_str());
+      ++indent_;
+      WriteLine(("\"The size of '" + field + "' does not match FieldType::" +
+        type->code + "\");").c_str());
+      --indent_;
+
+      return true;
+    }
+
+    //--------------------------------------------------------------------------
+    void SparseWriter::WriteFieldDescriptor(
+      const FieldDefinition& f,
+      const ClassDefinition& cl)
+    {
+      const FieldType* type = FindFieldType(f);
+
+      std::string name = "\"" + f.name + "\"";
+      std::string length = std::to_string(f.name.size());
+
+      WriteLine("{");
+      ++indent_;
+      WriteLine((name + ",").c_str());
+      WriteLine((length + ",").c_str());
+      WriteLine(("snuffbox::foundation::ArchiveName::Hash(" +
+        name + ", " + length + "),").c_str());
+      WriteLine(("offsetof(" + cl.c_name + ", " + f.name + "),").c_str());
+      WriteLine(("snuffbox::foundation::FieldType::" + type->code).c_str());
+      --indent_;
+      WriteLine("},");
+    }
+
+    //--------------------------------------------------------------------------
+    const SparseWriter::FieldType* SparseWriter::FindFieldType(
+      const FieldDefinition& f)
+    {
+      if (f.is_enum == true)
+      {
+        return &kEnumFieldType_;
+      }
+
+      if (f.type.ref_type != RefType::kLiteral)
+      {
+        return nullptr;
+      }
+
+      std::string name = f.type.name;
+      size_t ns = name.rfind("::");
+
+      if (ns != std::string::npos)
+      {
+        name = name.substr(ns + 2);
+      }
+
+      FieldTypes::const_iterator it = kFieldTypes_.find(name);
+
+      if (it == kFieldTypes_.end())
+      {
+        return nullptr;
+      }
+
+      return &it->second;
+    }
+
     //--------------------------------------------------------------------------
     void SparseWriter::WriteEnum(const EnumDefinition& d)
     {
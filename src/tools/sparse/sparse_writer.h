@@ -15,6 +15,10 @@ namespace snuffbox
     * @brief Writes the definitions from JsonHeaderParser as a C++ source file
     *        for the scripting environment to compile
     *
+    * The writer can also write the field tables of the parsed classes into
+    * a separate source file, which is compiled regardless of whether
+    * scripting is enabled.
+    *
     * @author Daniel Konings
     */
     class SparseWriter
@@ -46,8 +50,36 @@ namespace snuffbox
         const std::string& header,
         const std::string& output);
 
+      /**
+      * @brief Writes the field tables of the classes in the output of
+      *        a parser to a C++ source file
+      *
+      * Every class that has fields marked with SNUFF_FIELD gets a definition
+      * of the accessor declared by SNUFF_FIELD_TABLE, returning a table
+      * with the name hash, offset and type of each field.
+      *
+      * @param[in] parser The parser that parsed an input header file
+      * @param[in] header The path of the original header
+      * @param[in] output The output path to write the generated file to
+      *
+      * @return Was the writing a success?
+      */
+      bool WriteFieldTables(
+        JsonHeaderParser* parser,
+        const std::string& header,
+        const std::string& output);
+
     protected:
 
+      /**
+      * @brief Opens the output file
+      *
+      * @param[in] output The output path to write the generated file to
+      *
+      * @return Was the file opened succesfully?
+      */
+      bool Open(const std::string& output);
+
       /**
       * @brief Writes a line with the current indentation to the output file
       *
@@ -91,6 +123,44 @@ namespace snuffbox
       */
       void WriteFunctionRegister(const ClassDefinition& d);
 
+      /**
+      * @brief Writes the field table accessor of a class
+      *
+      * @param[in] d The class definition to write the field table of
+      *
+      * @return Could a type be found for every field?
+      */
+      bool WriteFieldTable(const ClassDefinition& d);
+
+      /**
+      * @brief Writes a compile-time check that the size of a field matches
+      *        the size of its field type
+      *
+      * @remarks This catches members whose declared type was resolved to a
+      *          field type of a different size, e.g. a narrower enum
+      *
+      * @param[in] f The field definition
+      * @param[in] cl The class definition the field is a member of
+      *
+      * @return Could a type be found for the field?
+      */
+      bool WriteFieldCheck(
+        const FieldDefinition& f,
+        const ClassDefinition& cl);
+
+      /**
+      * @brief Writes the descriptor of a single field
+      *
+      * @remarks The type of the field should have been checked with
+      *          SparseWriter::WriteFieldCheck first
+      *
+      * @param[in] f The field definition
+      * @param[in] cl The class definition the field is a member of
+      */
+      void WriteFieldDescriptor(
+        const FieldDefinition& f,
+        const ClassDefinition& cl);
+
       /**
       * @brief Writes an enum's function bodies to the output file
       *
@@ -190,6 +260,42 @@ namespace snuffbox
       *          qualified string
       */
       static ArgFormats kFormats_;
+
+      /**
+      * @brief A field type that can be stored in a field table
+      *
+      * @author Daniel Konings
+      */
+      struct FieldType
+      {
+        std::string code; //!< The FieldType enumerator
+        std::string size_type; //!< The C++ type the field should match
+      };
+
+      /**
+      * @brief Finds the field type of a field definition
+      *
+      * @param[in] f The field definition
+      *
+      * @return The field type, or nullptr if the type is not supported
+      */
+      static const FieldType* FindFieldType(const FieldDefinition& f);
+
+      /**
+      * @brief Shorthand for a map of field types based on a supported type
+      */
+      using FieldTypes = std::unordered_map<std::string, FieldType>;
+
+      /**
+      * @brief The field type per supported type, without any namespaces
+      */
+      static FieldTypes kFieldTypes_;
+
+      /**
+      * @brief The field type of enumerators, which are stored as 32-bit
+      *        integers
+      */
+      static const FieldType kEnumFieldType_;
     };
   }
 }
\ No newline at end of file